@@ -0,0 +1,15 @@
+// Global bindless heap, mirrors bindless_heap_t in src/Engine/RHI/Backends/Vulkan/VulkanBindless.h.
+// Handles arrive through push constants or buffers; wrap an index that varies within a draw in nonuniformEXT().
+#extension GL_EXT_nonuniform_qualifier : require
+
+layout(set = 0, binding = 0) uniform texture2D g_Textures[];
+layout(set = 0, binding = 0) uniform texture2DArray g_TextureArrays[];   // same slots, for array views
+layout(set = 0, binding = 1) uniform sampler g_Samplers[];
+
+// Storage buffers live at binding 2; declare them with the element type the shader needs, e.g.
+// layout(set = 0, binding = 2) readonly buffer Instances { instance_t data[]; } g_Instances[];
+
+vec4 sampleBindless(uint textureIndex, uint samplerIndex, vec2 uv)
+{
+    return texture(sampler2D(g_Textures[textureIndex], g_Samplers[samplerIndex]), uv);
+}
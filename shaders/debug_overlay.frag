@@ -1,11 +1,28 @@
 #version 460
+#extension GL_GOOGLE_include_directive : require
+#include "bindless.glsl"
+
 layout(location = 0) in vec2 inUV;
+layout(location = 1) in vec4 inColor;
 layout(location = 0) out vec4 outColor;
 
-layout(set = 0, binding = 0) uniform sampler2D fontSampler;
+layout(push_constant) uniform Push {
+    vec2 u_Canvas;
+    uint u_FontTexture;
+    uint u_FontSampler;
+    uint u_GlyphMetrics;
+    float u_BasePixelHeight;
+} push;
+
+// Distance of the outline in the field, matches k_sdf_on_edge in src/Engine/Debug/GlyphAtlas.cpp
+const float k_OnEdge = 128.0 / 255.0;
 
 void main()
 {
-    float a = texture(fontSampler, inUV).r;
-    outColor = vec4(1.0, 0.0, 0.0, a);  // red with alpha from font atlas
-}
\ No newline at end of file
+    float d = sampleBindless(push.u_FontTexture, push.u_FontSampler, inUV).r;
+
+    // Anti-alias over one screen pixel whatever the text size
+    float w = max(fwidth(d), 1e-4);
+    float a = smoothstep(k_OnEdge - w, k_OnEdge + w, d);
+    outColor = vec4(inColor.rgb, inColor.a * a);
+}
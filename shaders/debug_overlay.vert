@@ -1,20 +1,49 @@
 #version 460
-layout(location = 0) in vec2 inPos;
-layout(location = 1) in vec2 inUV;
+#extension GL_GOOGLE_include_directive : require
+#include "bindless.glsl"
+
+// One instance per glyph, mirrors glyph_instance_t in src/Engine/Debug/DebugOverlay.cpp
+layout(location = 0) in vec2 inPen;     // baseline pen position, overlay units from the top-left corner
+layout(location = 1) in uint inGlyph;   // atlas slot in the low 16 bits, size in units as 12.4 fixed point above
+layout(location = 2) in uint inColor;   // unorm8x4, red in the low byte
+
 layout(location = 0) out vec2 outUV;
+layout(location = 1) out vec4 outColor;
+
+// Distance field boxes, mirrors glyph_metrics_t in src/Engine/Debug/GlyphAtlas.h
+struct GlyphMetrics
+{
+    vec2 offset;    // top-left corner relative to the pen, pixels at u_BasePixelHeight
+    vec2 size;      // pixels at u_BasePixelHeight
+    vec4 uvRect;    // u0, v0, u1, v1
+};
+layout(set = 0, binding = 2) readonly buffer Glyphs { GlyphMetrics glyphs[]; } g_Glyphs[];
 
 layout(push_constant) uniform Push {
-    vec2 u_Resolution;
+    vec2 u_Canvas;      // swapchain extent in overlay units
+    uint u_FontTexture;
+    uint u_FontSampler;
+    uint u_GlyphMetrics;
+    float u_BasePixelHeight;
 } push;
 
+// Two triangles, as corners in 0..1
+const vec2 k_Corners[6] = vec2[](
+    vec2(0.0, 0.0), vec2(1.0, 0.0), vec2(1.0, 1.0),
+    vec2(0.0, 0.0), vec2(1.0, 1.0), vec2(0.0, 1.0)
+);
+
 void main()
 {
-    vec2 pos = inPos;
-    pos.y = push.u_Resolution.y - pos.y;  // convert to top-left origin
-    pos /= push.u_Resolution;
-    pos = pos * 2.0 - 1.0;
-    pos.y = -pos.y;  // ← THIS IS THE MISSING LINE — Vulkan Y is down!
-
-    gl_Position = vec4(pos, 0.0, 1.0);
-    outUV = inUV;
-}
\ No newline at end of file
+    GlyphMetrics glyph = g_Glyphs[push.u_GlyphMetrics].glyphs[inGlyph & 0xFFFFu];
+    vec2 corner = k_Corners[gl_VertexIndex];
+
+    // The distance field is resampled at any size, so there is no texel alignment to preserve
+    float scale = float(inGlyph >> 16) / 16.0 / push.u_BasePixelHeight;
+    vec2 position = inPen + (glyph.offset + corner * glyph.size) * scale;
+
+    // Units from the top-left corner to NDC; Vulkan's y already points down
+    gl_Position = vec4(position / push.u_Canvas * 2.0 - 1.0, 0.0, 1.0);
+    outUV = mix(glyph.uvRect.xy, glyph.uvRect.zw, corner);
+    outColor = unpackUnorm4x8(inColor);
+}
@@ -0,0 +1,17 @@
+#version 460
+
+// One vertex of an overlay primitive, mirrors primitive_vertex_t in src/Engine/Debug/DebugOverlay.cpp
+layout(location = 0) in vec3 inPosition;   // overlay units, or world space for 3D lines
+layout(location = 1) in uint inColor;      // unorm8x4, red in the low byte
+
+layout(location = 0) out vec4 outColor;
+
+layout(push_constant) uniform Push {
+    mat4 u_Transform;   // overlay units to NDC, or the camera's view-projection
+} push;
+
+void main()
+{
+    gl_Position = push.u_Transform * vec4(inPosition, 1.0);
+    outColor = unpackUnorm4x8(inColor);
+}
@@ -0,0 +1,32 @@
+// GPU scene layouts, mirror gpu_instance_t and gpu_mesh_t in src/Engine/RHI/Backends/Vulkan/VulkanGpuScene.h.
+// Every buffer is reached through the bindless heap, include bindless.glsl first.
+
+struct Instance
+{
+    vec3 position;
+    float scale;
+    float rotation;
+    uint mesh;
+    uint pad0;
+    uint pad1;
+};
+
+struct Mesh
+{
+    uint indexCount;    // 0 until the geometry upload completed
+    uint firstIndex;
+    int vertexOffset;
+    float radius;
+};
+
+// VkDrawIndexedIndirectCommand
+struct DrawCommand
+{
+    uint indexCount;
+    uint instanceCount;
+    uint firstIndex;
+    int vertexOffset;
+    uint firstInstance;
+};
+
+layout(set = 0, binding = 2) readonly buffer Instances { Instance data[]; } g_Instances[];
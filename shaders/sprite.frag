@@ -0,0 +1,25 @@
+#version 460
+#extension GL_GOOGLE_include_directive : require
+#include "bindless.glsl"
+
+layout(location = 0) in vec2 inUV;
+layout(location = 1) flat in uint inLayer;
+layout(location = 2) in vec4 inColor;
+
+layout(location = 0) out vec4 outColor;
+
+layout(push_constant) uniform Push {
+    vec2 u_ViewScale;
+    uint u_Streams;
+    uint u_Capacity;
+    uint u_TextureArray;
+    uint u_Sampler;
+} push;
+
+void main()
+{
+    // The atlas is uniform across a draw, only the layer varies per sprite
+    vec4 texel = texture(sampler2DArray(g_TextureArrays[push.u_TextureArray], g_Samplers[push.u_Sampler]),
+                         vec3(inUV, float(inLayer)));
+    outColor = texel * inColor;
+}
@@ -0,0 +1,55 @@
+#version 460
+#extension GL_GOOGLE_include_directive : require
+#include "bindless.glsl"
+
+// Streams of one frame slot, mirrors sprite_batcher_t in src/Engine/RHI/Backends/Vulkan/VulkanSpriteBatcher.h.
+// Each stream is u_Capacity elements long, in this order: position (2 words), rotation, size (2 words),
+// UV rect (2 x unorm16x2), color (unorm8x4), layer.
+layout(set = 0, binding = 2) readonly buffer SpriteStreams { uint words[]; } g_SpriteStreams[];
+
+layout(push_constant) uniform Push {
+    vec2 u_ViewScale;   // 2 / framebuffer extent
+    uint u_Streams;
+    uint u_Capacity;
+    uint u_TextureArray;
+    uint u_Sampler;
+} push;
+
+layout(location = 0) out vec2 outUV;
+layout(location = 1) flat out uint outLayer;
+layout(location = 2) out vec4 outColor;
+
+// Two triangles, as (corner, uv corner) in 0..1
+const vec2 k_Corners[6] = vec2[](
+    vec2(0.0, 0.0), vec2(1.0, 0.0), vec2(1.0, 1.0),
+    vec2(0.0, 0.0), vec2(1.0, 1.0), vec2(0.0, 1.0)
+);
+
+uint streamWord(uint stream, uint index)
+{
+    return g_SpriteStreams[push.u_Streams].words[stream * push.u_Capacity + index];
+}
+
+void main()
+{
+    // firstInstance points at the batch inside the sorted streams
+    uint sprite = gl_InstanceIndex;
+
+    vec2 position = uintBitsToFloat(uvec2(streamWord(0, sprite * 2), streamWord(0, sprite * 2 + 1)));
+    float rotation = uintBitsToFloat(streamWord(2, sprite));
+    vec2 size = uintBitsToFloat(uvec2(streamWord(3, sprite * 2), streamWord(3, sprite * 2 + 1)));
+    vec2 uv0 = unpackUnorm2x16(streamWord(5, sprite * 2));
+    vec2 uv1 = unpackUnorm2x16(streamWord(5, sprite * 2 + 1));
+
+    vec2 corner = k_Corners[gl_VertexIndex];
+    float c = cos(rotation);
+    float s = sin(rotation);
+    vec2 local = (corner - 0.5) * size;
+    vec2 pixel = position + vec2(c * local.x - s * local.y, s * local.x + c * local.y);
+
+    // Pixels from the top-left corner to NDC; Vulkan's y already points down
+    gl_Position = vec4(pixel * push.u_ViewScale - 1.0, 0.0, 1.0);
+    outUV = mix(uv0, uv1, corner);
+    outColor = unpackUnorm4x8(streamWord(7, sprite));
+    outLayer = streamWord(8, sprite);
+}
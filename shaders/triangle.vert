@@ -1,30 +1,33 @@
 #version 460
+#extension GL_GOOGLE_include_directive : require
+#include "bindless.glsl"
+#include "scene.glsl"
+
+// Keyword: renderer::shader_keyword::spin
+layout(constant_id = 0) const bool SPIN = false;
 
 layout(push_constant) uniform PushConstants {
+    mat4 viewProjection;
     uint frameCount;
+    uint instanceBuffer;
 } pc;
 
-layout(location = 0) out vec3 color;
-
-const vec2 positions[3] = vec2[](
-    vec2( 0.0, -0.8),
-    vec2(-0.7,  0.7),
-    vec2( 0.7,  0.7)
-);
+layout(location = 0) in vec3 inPosition;
+layout(location = 1) in vec3 inColor;
 
-const vec3 colors[3] = vec3[](
-    vec3(1.0, 0.5, 0.0), // carrot orange
-    vec3(1.0, 0.6, 0.2),
-    vec3(1.0, 0.7, 0.3)
-);
+layout(location = 0) out vec3 color;
 
 void main()
 {
-    gl_Position = vec4(positions[gl_VertexIndex], 0.0, 1.0);
-    color = colors[gl_VertexIndex];
+    // Drawn through the cull pass's indirect commands, firstInstance is the instance index
+    Instance inst = g_Instances[pc.instanceBuffer].data[gl_InstanceIndex];
+
+    float angle = inst.rotation;
+    if (SPIN) angle += float(pc.frameCount) * 0.02;   // SPINNING — using push constant
 
-    // SPINNING — using push constant
-    float angle = float(pc.frameCount) * 0.02 + float(gl_VertexIndex) * 1.0;
     mat2 rot = mat2(cos(angle), -sin(angle), sin(angle), cos(angle));
-    gl_Position.xy = rot * gl_Position.xy;
+    vec3 world = inst.position + vec3(rot * inPosition.xy, inPosition.z) * inst.scale;
+
+    gl_Position = pc.viewProjection * vec4(world, 1.0);
+    color = inColor;
 }
@@ -0,0 +1,133 @@
+//
+// Created by zshrout on 10/18/26.
+// Copyright (c) 2026 BunnySofty. All rights reserved.
+//
+
+#include "BenchOptions.h"
+
+#include <charconv>
+#include <cstdio>
+#include <cstdlib>
+
+namespace bench {
+    namespace {
+        constexpr const char* k_scene_names[]{ "triangles", "text", "sprites", "reload" };
+        static_assert(std::size(k_scene_names) == static_cast<size_t>(bench_scene::count));
+
+        constexpr uint32_t k_default_counts[]{ 10000, 200, 10000, 1 };
+        static_assert(std::size(k_default_counts) == static_cast<size_t>(bench_scene::count));
+
+        // Matches "--name=value" and returns the value
+        [[nodiscard]] bool option_value(const std::string_view argument, const std::string_view name,
+                                        std::string_view& value) noexcept
+        {
+            if (!argument.starts_with(name) || argument.size() <= name.size() || argument[name.size()] != '=')
+                return false;
+
+            value = argument.substr(name.size() + 1);
+            return true;
+        }
+
+        template<typename T>
+        [[nodiscard]] bool parse_number(const std::string_view text, T& number) noexcept
+        {
+            T parsed{ 0 };
+            const auto [end, error]{ std::from_chars(text.data(), text.data() + text.size(), parsed) };
+            if (error != std::errc{ } || end != text.data() + text.size() || parsed < T{ 0 }) return false;
+
+            number = parsed;
+            return true;
+        }
+
+        // Floating-point from_chars is not available in every standard library we build with
+        [[nodiscard]] bool parse_number(const std::string_view text, double& number)
+        {
+            const std::string copy{ text };
+            char* end{ nullptr };
+            const double parsed{ std::strtod(copy.c_str(), &end) };
+            if (copy.empty() || end != copy.c_str() + copy.size() || !(parsed >= 0.0)) return false;
+
+            number = parsed;
+            return true;
+        }
+
+        [[nodiscard]] bool parse_scene(const std::string_view text, bench_scene& scene) noexcept
+        {
+            for (size_t i{ 0 }; i < std::size(k_scene_names); ++i)
+            {
+                if (text != k_scene_names[i]) continue;
+
+                scene = static_cast<bench_scene>(i);
+                return true;
+            }
+            return false;
+        }
+    } // anonymous namespace
+
+    const char* scene_name(const bench_scene scene) noexcept
+    {
+        return scene < bench_scene::count ? k_scene_names[static_cast<size_t>(scene)] : "unknown";
+    }
+
+    uint32_t default_count(const bench_scene scene) noexcept
+    {
+        return scene < bench_scene::count ? k_default_counts[static_cast<size_t>(scene)] : 0;
+    }
+
+    bool parse_options(const int argc, const char* const* argv, bench_options_t& options)
+    {
+        options.engine_arguments.assign(argv, argv + (argc > 0 ? 1 : 0));
+
+        for (int i{ 1 }; i < argc; ++i)
+        {
+            const std::string_view argument{ argv[i] };
+            std::string_view value;
+
+            bool parsed{ true };
+            if (argument == "--windowed")
+                options.windowed = true;
+            else if (option_value(argument, "--scene", value))
+                parsed = parse_scene(value, options.scene);
+            else if (option_value(argument, "--count", value))
+                parsed = parse_number(value, options.count);
+            else if (option_value(argument, "--frames", value))
+                parsed = parse_number(value, options.frames) && options.frames != 0;
+            else if (option_value(argument, "--warmup", value))
+                parsed = parse_number(value, options.warmup);
+            else if (option_value(argument, "--out", value))
+                options.out = value;
+            else if (option_value(argument, "--baseline", value))
+                options.baseline = value;
+            else if (option_value(argument, "--threshold", value))
+                parsed = parse_number(value, options.threshold_pct);
+            else if (option_value(argument, "--memory-threshold", value))
+                parsed = parse_number(value, options.memory_threshold_pct);
+            else if (option_value(argument, "--min-delta-ms", value))
+                parsed = parse_number(value, options.min_delta_ms);
+            else
+            {
+                options.engine_arguments.push_back(argv[i]);
+                continue;
+            }
+
+            if (!parsed)
+            {
+                std::fprintf(stderr, "Invalid option: %s\n", argv[i]);
+                return false;
+            }
+        }
+
+        if (options.count == 0) options.count = default_count(options.scene);
+        return true;
+    }
+
+    void print_usage(const char* program)
+    {
+        std::fprintf(stderr,
+                     "Usage: %s [--scene=triangles|text|sprites|reload] [--count=N] [--frames=N] [--warmup=N]\n"
+                     "          [--out=FILE] [--baseline=FILE] [--threshold=PCT] [--memory-threshold=PCT]\n"
+                     "          [--min-delta-ms=MS] [--windowed] [engine options...]\n"
+                     "Exit code: 0 ok, 1 regression against the baseline, 2 usage or I/O error\n",
+                     program);
+    }
+} // namespace bench
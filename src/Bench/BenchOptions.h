@@ -0,0 +1,46 @@
+//
+// Created by zshrout on 10/18/26.
+// Copyright (c) 2026 BunnySofty. All rights reserved.
+//
+
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace bench {
+    enum class bench_scene : uint8_t
+    {
+        triangles,  // `count` persistent scene instances
+        text,       // `count` overlay text lines per frame
+        sprites,    // `count` moving sprites per frame
+        reload,     // `count` full pipeline reloads per frame
+
+        count
+    };
+
+    struct bench_options_t
+    {
+        bench_scene                 scene{ bench_scene::triangles };
+        uint32_t                    count{ 0 };                 // 0 picks the scene's default load
+        uint32_t                    frames{ 600 };              // measured frames
+        uint32_t                    warmup{ 60 };               // frames run before measuring starts
+        std::string                 out;                        // JSON report path, stdout when empty
+        std::string                 baseline;                   // report to compare against, none when empty
+        double                      threshold_pct{ 10.0 };      // allowed frame/zone time growth
+        double                      memory_threshold_pct{ 10.0 };
+        double                      min_delta_ms{ 0.05 };       // smaller changes are noise, whatever the percentage
+        bool                        windowed{ false };
+
+        std::vector<const char*>    engine_arguments;           // everything else, handed to the engine
+    };
+
+    [[nodiscard]] const char* scene_name(bench_scene scene) noexcept;
+    [[nodiscard]] uint32_t default_count(bench_scene scene) noexcept;
+
+    // Consumes the bench options and keeps argv[0] plus the rest in engine_arguments. Returns false on a bad value
+    [[nodiscard]] bool parse_options(int argc, const char* const* argv, bench_options_t& options);
+    void print_usage(const char* program);
+} // namespace bench
@@ -0,0 +1,250 @@
+//
+// Created by zshrout on 10/18/26.
+// Copyright (c) 2026 BunnySofty. All rights reserved.
+//
+
+#include "BenchReport.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <format>
+#include <fstream>
+#include <numeric>
+#include <sstream>
+#include <string_view>
+
+#if defined(__linux__) || defined(__APPLE__)
+#include <sys/resource.h>
+#endif
+
+namespace bench {
+    namespace {
+        constexpr double k_ns_per_ms{ 1'000'000.0 };
+
+        // Nearest-rank percentile of sorted samples
+        [[nodiscard]] uint64_t percentile(const std::vector<uint64_t>& sorted, const double pct) noexcept
+        {
+            if (sorted.empty()) return 0;
+
+            const auto rank{ static_cast<size_t>(std::ceil(pct / 100.0 * static_cast<double>(sorted.size()))) };
+            return sorted[std::clamp<size_t>(rank, 1, sorted.size()) - 1];
+        }
+
+        [[nodiscard]] time_summary_t summarize(std::vector<uint64_t> samples)
+        {
+            time_summary_t summary{ };
+            if (samples.empty()) return summary;
+
+            std::ranges::sort(samples);
+            const double total{ std::accumulate(samples.begin(), samples.end(), 0.0) };
+            summary.mean_ms = total / static_cast<double>(samples.size()) / k_ns_per_ms;
+            summary.p50_ms = static_cast<double>(percentile(samples, 50.0)) / k_ns_per_ms;
+            summary.p95_ms = static_cast<double>(percentile(samples, 95.0)) / k_ns_per_ms;
+            summary.p99_ms = static_cast<double>(percentile(samples, 99.0)) / k_ns_per_ms;
+            summary.max_ms = static_cast<double>(samples.back()) / k_ns_per_ms;
+            return summary;
+        }
+
+        [[nodiscard]] uint64_t peak_rss_kb() noexcept
+        {
+#if defined(__linux__) || defined(__APPLE__)
+            rusage usage{ };
+            if (getrusage(RUSAGE_SELF, &usage) != 0) return 0;
+#if defined(__APPLE__)
+            return static_cast<uint64_t>(usage.ru_maxrss) / 1024; // bytes on macOS
+#else
+            return static_cast<uint64_t>(usage.ru_maxrss);
+#endif
+#else
+            return 0;
+#endif
+        }
+
+        void append_summary(std::string& json, const time_summary_t& time)
+        {
+            json += std::format(R"("mean_ms": {:.4f}, "p50_ms": {:.4f}, "p95_ms": {:.4f}, "p99_ms": {:.4f}, )"
+                                R"("max_ms": {:.4f})",
+                                time.mean_ms, time.p50_ms, time.p95_ms, time.p99_ms, time.max_ms);
+        }
+
+        // ── reading back
+
+        // Returns the text right after `"key":`, or an empty view
+        [[nodiscard]] std::string_view find_value(const std::string_view text, const std::string_view key)
+        {
+            const std::string quoted{ std::format("\"{}\"", key) };
+            size_t at{ text.find(quoted) };
+            if (at == std::string_view::npos) return { };
+
+            at = text.find(':', at + quoted.size());
+            if (at == std::string_view::npos) return { };
+
+            at = text.find_first_not_of(" \t\r\n", at + 1);
+            return at == std::string_view::npos ? std::string_view{ } : text.substr(at);
+        }
+
+        [[nodiscard]] bool read_number(const std::string_view text, const std::string_view key, double& number)
+        {
+            const std::string_view value{ find_value(text, key) };
+            if (value.empty()) return false;
+
+            const std::string copy{ value.substr(0, value.find_first_of(",}\n")) };
+            char* end{ nullptr };
+            number = std::strtod(copy.c_str(), &end);
+            return end != copy.c_str();
+        }
+
+        [[nodiscard]] bool read_string(const std::string_view text, const std::string_view key, std::string& string)
+        {
+            const std::string_view value{ find_value(text, key) };
+            if (value.size() < 2 || value.front() != '"') return false;
+
+            const size_t end{ value.find('"', 1) };
+            if (end == std::string_view::npos) return false;
+
+            string = value.substr(1, end - 1);
+            return true;
+        }
+
+        // The innermost {...} object starting at or after `from`
+        [[nodiscard]] std::string_view next_object(const std::string_view text, const size_t from)
+        {
+            const size_t begin{ text.find('{', from) };
+            if (begin == std::string_view::npos) return { };
+
+            const size_t end{ text.find('}', begin) };
+            return end == std::string_view::npos ? std::string_view{ } : text.substr(begin, end - begin + 1);
+        }
+
+        [[nodiscard]] bool read_summary(const std::string_view object, time_summary_t& time)
+        {
+            return read_number(object, "mean_ms", time.mean_ms) && read_number(object, "p50_ms", time.p50_ms) &&
+                   read_number(object, "p95_ms", time.p95_ms) && read_number(object, "p99_ms", time.p99_ms) &&
+                   read_number(object, "max_ms", time.max_ms);
+        }
+
+        // ── comparison
+
+        [[nodiscard]] bool regressed(const double current, const double baseline, const double pct,
+                                     const double min_delta) noexcept
+        {
+            return current - baseline > min_delta && current > baseline * (1.0 + pct / 100.0);
+        }
+
+        [[nodiscard]] bool compare_time(const std::string_view label, const time_summary_t& current,
+                                        const time_summary_t& baseline, const bench_options_t& options)
+        {
+            bool ok{ true };
+            const auto check{ [&](const std::string_view stat, const double now, const double before) {
+                if (!regressed(now, before, options.threshold_pct, options.min_delta_ms)) return;
+
+                LOG_CORE_ERROR("[Bench] {} {} regressed: {:.4f} ms -> {:.4f} ms (+{:.1f}%)", label, stat, before, now,
+                               before > 0.0 ? (now / before - 1.0) * 100.0 : 100.0);
+                ok = false;
+            } };
+
+            check("p50", current.p50_ms, baseline.p50_ms);
+            check("p95", current.p95_ms, baseline.p95_ms);
+            check("p99", current.p99_ms, baseline.p99_ms);
+            return ok;
+        }
+    } // anonymous namespace
+
+    bench_report_t build_report(const bench_options_t& options, const bench_samples_t& samples)
+    {
+        bench_report_t report{ };
+        report.scene = scene_name(options.scene);
+        report.count = options.count;
+        report.frames = static_cast<uint32_t>(samples.frame_ns.size());
+        report.frame = summarize(samples.frame_ns);
+        report.peak_rss_kb = peak_rss_kb();
+
+        for (uint32_t zone{ 0 }; zone < samples.zone_ns.size(); ++zone)
+            report.zones.push_back({ carrot::core::profiler::zone_name(zone), summarize(samples.zone_ns[zone]) });
+
+        return report;
+    }
+
+    std::string to_json(const bench_report_t& report)
+    {
+        std::string json{ "{\n" };
+        json += std::format("  \"scene\": \"{}\",\n  \"count\": {},\n  \"frames\": {},\n", report.scene, report.count,
+                            report.frames);
+        json += "  \"frame\": { ";
+        append_summary(json, report.frame);
+        json += std::format(" }},\n  \"peak_rss_kb\": {},\n  \"zones\": [", report.peak_rss_kb);
+
+        for (size_t i{ 0 }; i < report.zones.size(); ++i)
+        {
+            json += std::format("{}\n    {{ \"name\": \"{}\", ", i == 0 ? "" : ",", report.zones[i].name);
+            append_summary(json, report.zones[i].time);
+            json += " }";
+        }
+
+        json += report.zones.empty() ? "]\n}\n" : "\n  ]\n}\n";
+        return json;
+    }
+
+    bool load_report(const std::filesystem::path& path, bench_report_t& report)
+    {
+        std::ifstream file{ path };
+        if (!file.is_open()) return false;
+
+        std::stringstream contents;
+        contents << file.rdbuf();
+        const std::string text{ contents.str() };
+
+        report = { };
+        double count{ 0.0 }, frames{ 0.0 }, rss{ 0.0 };
+        if (!read_string(text, "scene", report.scene) || !read_number(text, "count", count) ||
+            !read_number(text, "frames", frames) || !read_number(text, "peak_rss_kb", rss) ||
+            !read_summary(next_object(text, text.find("\"frame\"")), report.frame))
+            return false;
+
+        report.count = static_cast<uint32_t>(count);
+        report.frames = static_cast<uint32_t>(frames);
+        report.peak_rss_kb = static_cast<uint64_t>(rss);
+
+        const size_t zones_at{ text.find("\"zones\"") };
+        const size_t zones_end{ text.find(']', zones_at) };
+        if (zones_at == std::string::npos || zones_end == std::string::npos) return false;
+
+        for (size_t at{ zones_at };;)
+        {
+            const std::string_view object{ next_object(text, at) };
+            if (object.empty() || static_cast<size_t>(object.data() - text.data()) > zones_end) break;
+
+            zone_summary_t zone{ };
+            if (!read_string(object, "name", zone.name) || !read_summary(object, zone.time)) return false;
+            report.zones.push_back(std::move(zone));
+            at = static_cast<size_t>(object.data() - text.data()) + object.size();
+        }
+
+        return true;
+    }
+
+    bool compare_reports(const bench_report_t& current, const bench_report_t& baseline,
+                         const bench_options_t& options)
+    {
+        bool ok{ compare_time("frame", current.frame, baseline.frame, options) };
+
+        for (const zone_summary_t& zone: current.zones)
+        {
+            const auto it{ std::ranges::find(baseline.zones, zone.name, &zone_summary_t::name) };
+            if (it == baseline.zones.end()) continue;
+
+            ok &= compare_time(std::format("zone '{}'", zone.name), zone.time, it->time, options);
+        }
+
+        const double rss{ static_cast<double>(current.peak_rss_kb) };
+        const double baseline_rss{ static_cast<double>(baseline.peak_rss_kb) };
+        if (baseline.peak_rss_kb != 0 && rss > baseline_rss * (1.0 + options.memory_threshold_pct / 100.0))
+        {
+            LOG_CORE_ERROR("[Bench] Peak RSS regressed: {} KiB -> {} KiB", baseline.peak_rss_kb, current.peak_rss_kb);
+            ok = false;
+        }
+
+        return ok;
+    }
+} // namespace bench
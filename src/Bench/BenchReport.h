@@ -0,0 +1,50 @@
+//
+// Created by zshrout on 10/18/26.
+// Copyright (c) 2026 BunnySofty. All rights reserved.
+//
+
+#pragma once
+
+#include "BenchOptions.h"
+#include "BenchScenes.h"
+
+#include <filesystem>
+#include <string>
+#include <vector>
+
+namespace bench {
+    struct time_summary_t
+    {
+        double                      mean_ms{ 0.0 };
+        double                      p50_ms{ 0.0 };
+        double                      p95_ms{ 0.0 };
+        double                      p99_ms{ 0.0 };
+        double                      max_ms{ 0.0 };
+    };
+
+    struct zone_summary_t
+    {
+        std::string                 name;
+        time_summary_t              time;
+    };
+
+    struct bench_report_t
+    {
+        std::string                 scene;
+        uint32_t                    count{ 0 };
+        uint32_t                    frames{ 0 };        // frames actually measured
+        time_summary_t              frame;
+        std::vector<zone_summary_t> zones;
+        uint64_t                    peak_rss_kb{ 0 };   // process high-water mark, CPU side only
+    };
+
+    [[nodiscard]] bench_report_t build_report(const bench_options_t& options, const bench_samples_t& samples);
+
+    [[nodiscard]] std::string to_json(const bench_report_t& report);
+    // Reads back what to_json() wrote; not a general JSON parser
+    [[nodiscard]] bool load_report(const std::filesystem::path& path, bench_report_t& report);
+
+    // Logs every frame, zone and memory figure that grew past the thresholds. Returns false on any regression
+    [[nodiscard]] bool compare_reports(const bench_report_t& current, const bench_report_t& baseline,
+                                       const bench_options_t& options);
+} // namespace bench
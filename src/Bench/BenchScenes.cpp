@@ -0,0 +1,152 @@
+//
+// Created by zshrout on 10/18/26.
+// Copyright (c) 2026 BunnySofty. All rights reserved.
+//
+
+#include "BenchScenes.h"
+
+#include <Debug/DebugOverlay.h>
+
+#include <cmath>
+
+namespace bench {
+    namespace {
+        constexpr uint32_t k_text_lines_per_column{ 64 };
+        constexpr float k_text_line_height{ 10.f };
+        constexpr float k_text_column_width{ 160.f };
+        constexpr float k_sprite_size{ 8.f };
+        constexpr int16_t k_sprite_orders{ 8 }; // enough distinct orders that the batcher has to sort
+
+        // Deterministic, so every run of a scene produces the same load
+        [[nodiscard]] float hash_unit(uint32_t x) noexcept
+        {
+            x ^= x >> 16;
+            x *= 0x7FEB352Du;
+            x ^= x >> 15;
+            x *= 0x846CA68Bu;
+            x ^= x >> 16;
+            return static_cast<float>(x >> 8) / static_cast<float>(1u << 24);
+        }
+    } // anonymous namespace
+
+    // PUBLIC
+    bench_app_t::bench_app_t(const bench_options_t& options)
+        : _options{ options },
+          _listener{ carrot::core::profiler::frame_listener_t::bind<&bench_app_t::on_frame>(this) }
+    {
+        _samples.frame_ns.reserve(_options.frames);
+        carrot::core::profiler::add_frame_listener(_listener);
+    }
+
+    bench_app_t::~bench_app_t()
+    {
+        carrot::core::profiler::remove_frame_listener(_listener);
+    }
+
+    void bench_app_t::on_tick([[maybe_unused]] const float delta_time)
+    {
+        if (!_set_up) setup();
+
+        switch (_options.scene)
+        {
+        case bench_scene::text:
+            tick_text();
+            break;
+        case bench_scene::sprites:
+            tick_sprites();
+            break;
+        case bench_scene::reload:
+            for (uint32_t i{ 0 }; i < _options.count; ++i)
+                carrot::engine_t::get().get_renderer().reload_pipeline();
+            break;
+        default:
+            break;
+        }
+
+        ++_tick;
+    }
+
+    // PRIVATE
+    void bench_app_t::setup()
+    {
+        _set_up = true;
+        carrot::renderer::renderer_t& renderer{ carrot::engine_t::get().get_renderer() };
+
+        if (_options.scene == bench_scene::triangles)
+        {
+            // A square grid over the view, scaled so neighbours do not overlap
+            const uint32_t side{ static_cast<uint32_t>(std::ceil(std::sqrt(static_cast<double>(_options.count)))) };
+            const float step{ 1.8f / static_cast<float>(side) };
+
+            std::vector<carrot::renderer::triangle_instance_t> triangles(_options.count);
+            for (uint32_t i{ 0 }; i < _options.count; ++i)
+            {
+                carrot::renderer::triangle_instance_t& triangle{ triangles[i] };
+                triangle.position[0] = -0.9f + step * (static_cast<float>(i % side) + 0.5f);
+                triangle.position[1] = -0.9f + step * (static_cast<float>(i / side) + 0.5f);
+                triangle.scale = step * 0.45f;
+                triangle.rotation = hash_unit(i) * 6.2831853f;
+            }
+
+            const uint32_t added{ renderer.add_triangles(triangles) };
+            if (added != _options.count)
+                LOG_CORE_WARN("[Bench] Scene only took {} of {} triangles", added, _options.count);
+        }
+        else if (_options.scene == bench_scene::sprites)
+        {
+            const uint32_t white{ 0xFFFFFFFF };
+            const void* const layers[]{ &white };
+            _atlas = renderer.create_sprite_atlas(1, 1, layers);
+            _sprites.resize(_options.count);
+        }
+    }
+
+    void bench_app_t::tick_text() const
+    {
+        if (!carrot::debug::is_initialized()) return;
+
+        // Columns of k_text_lines_per_column lines
+        for (uint32_t i{ 0 }; i < _options.count; ++i)
+        {
+            const float x{ 8.f + static_cast<float>(i / k_text_lines_per_column) * k_text_column_width };
+            const float y{ 8.f + static_cast<float>(i % k_text_lines_per_column) * k_text_line_height };
+            carrot::debug::text(x, y, "line %u frame %llu", i, static_cast<unsigned long long>(_tick));
+        }
+    }
+
+    void bench_app_t::tick_sprites()
+    {
+        if (!_atlas.is_valid()) return;
+
+        // Resubmitted every frame, the way a game would; each sprite circles around its own anchor
+        const float t{ static_cast<float>(_tick) * 0.02f };
+        for (uint32_t i{ 0 }; i < _options.count; ++i)
+        {
+            carrot::renderer::sprite_t& sprite{ _sprites[i] };
+            const float phase{ hash_unit(i) * 6.2831853f };
+            sprite.position[0] = 40.f + hash_unit(i * 2 + 1) * 1200.f + std::cos(t + phase) * 20.f;
+            sprite.position[1] = 40.f + hash_unit(i * 2 + 2) * 640.f + std::sin(t + phase) * 20.f;
+            sprite.size[0] = k_sprite_size;
+            sprite.size[1] = k_sprite_size;
+            sprite.rotation = t + phase;
+            sprite.color = 0xFF000000u | (i * 2654435761u & 0x00FFFFFFu);
+            sprite.order = static_cast<int16_t>(i % k_sprite_orders);
+        }
+
+        carrot::engine_t::get().get_renderer().draw_sprites(_sprites, _atlas);
+    }
+
+    void bench_app_t::on_frame(const carrot::core::profiler::frame_profile_t& frame)
+    {
+        if (frame.frame_index < _options.warmup || _samples.frame_ns.size() >= _options.frames) return;
+
+        // Zones registered late (first hit after the warm-up) count as zero for the frames before
+        const size_t measured{ _samples.frame_ns.size() };
+        if (_samples.zone_ns.size() < frame.zone_ns.size())
+            _samples.zone_ns.resize(frame.zone_ns.size(), std::vector<uint64_t>(measured, 0));
+
+        _samples.frame_ns.push_back(frame.frame_ns);
+        for (size_t zone{ 0 }; zone < _samples.zone_ns.size(); ++zone)
+            _samples.zone_ns[zone].push_back(zone < frame.zone_ns.size() ? frame.zone_ns[zone] : 0);
+    }
+} // namespace bench
@@ -0,0 +1,48 @@
+//
+// Created by zshrout on 10/18/26.
+// Copyright (c) 2026 BunnySofty. All rights reserved.
+//
+
+#pragma once
+
+#include "BenchOptions.h"
+
+#include <CarrotEngine.h>
+
+#include <vector>
+
+namespace bench {
+    // CPU timings of the measured frames, nanoseconds
+    struct bench_samples_t
+    {
+        std::vector<uint64_t>               frame_ns;
+        std::vector<std::vector<uint64_t>>  zone_ns;    // [zone id][measured frame]
+    };
+
+    // Generates the scene's load from on_tick and records every profiled frame past the warm-up
+    class bench_app_t final : public carrot::core::ce_application_t
+    {
+    public:
+        explicit bench_app_t(const bench_options_t& options);
+        ~bench_app_t() override;
+
+        void on_tick(float delta_time) override;
+
+        [[nodiscard]] const bench_samples_t& samples() const noexcept { return _samples; }
+
+    private:
+        void setup();
+        void tick_text() const;
+        void tick_sprites();
+        void on_frame(const carrot::core::profiler::frame_profile_t& frame);
+
+        bench_options_t                             _options;
+        carrot::core::profiler::frame_listener_t    _listener;
+        bench_samples_t                             _samples;
+
+        bool                                        _set_up{ false };
+        uint64_t                                    _tick{ 0 };
+        carrot::renderer::sprite_atlas_id_t         _atlas;
+        std::vector<carrot::renderer::sprite_t>     _sprites;
+    };
+} // namespace bench
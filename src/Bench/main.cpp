@@ -0,0 +1,74 @@
+//
+// Created by zshrout on 10/18/26.
+// Copyright (c) 2026 BunnySofty. All rights reserved.
+//
+
+#include "BenchOptions.h"
+#include "BenchReport.h"
+#include "BenchScenes.h"
+
+#include <CarrotEngine.h>
+
+#include <cstdio>
+#include <fstream>
+
+int main(const int argc, const char* argv[])
+{
+    bench::bench_options_t options{ };
+    if (!bench::parse_options(argc, argv, options))
+    {
+        bench::print_usage(argv[0]);
+        return 2;
+    }
+
+    carrot::core::engine_config_t config{
+        carrot::core::parse_command_line(static_cast<int>(options.engine_arguments.size()),
+                                         options.engine_arguments.data())
+    };
+    config.renderer.headless = !options.windowed;
+    config.frame_count = uint64_t{ options.warmup } + options.frames;
+    carrot::engine_t::configure(std::move(config));
+
+    bench::bench_app_t app{ options };
+    carrot::engine_t::get().run(&app);
+
+    const bench::bench_report_t report{ bench::build_report(options, app.samples()) };
+
+    // The window can close the run early, a partial run is not comparable
+    if (report.frames != options.frames)
+    {
+        LOG_CORE_ERROR("[Bench] Only {} of {} frames were measured", report.frames, options.frames);
+        return 2;
+    }
+
+    LOG_CORE_INFO("[Bench] {} x{}: p50 {:.3f} ms, p95 {:.3f} ms, p99 {:.3f} ms, peak RSS {} KiB", report.scene,
+                  report.count, report.frame.p50_ms, report.frame.p95_ms, report.frame.p99_ms, report.peak_rss_kb);
+
+    const std::string json{ bench::to_json(report) };
+    if (options.out.empty())
+        std::fputs(json.c_str(), stdout);
+    else if (std::ofstream file{ options.out, std::ios::trunc }; !(file << json))
+    {
+        LOG_CORE_ERROR("[Bench] Failed to write {}", options.out);
+        return 2;
+    }
+
+    if (options.baseline.empty()) return 0;
+
+    bench::bench_report_t baseline{ };
+    if (!bench::load_report(options.baseline, baseline))
+    {
+        LOG_CORE_ERROR("[Bench] Failed to read baseline {}", options.baseline);
+        return 2;
+    }
+    if (baseline.scene != report.scene || baseline.count != report.count)
+    {
+        LOG_CORE_ERROR("[Bench] Baseline measured {} x{}, not comparable", baseline.scene, baseline.count);
+        return 2;
+    }
+
+    if (!bench::compare_reports(report, baseline, options)) return 1;
+
+    LOG_CORE_INFO("[Bench] Within thresholds of {}", options.baseline);
+    return 0;
+}
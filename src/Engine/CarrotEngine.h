@@ -6,4 +6,5 @@
 #pragma once
 
 #include "Core/Application.h"
+#include "Core/Profiler.h"
 #include "Engine.h"
\ No newline at end of file
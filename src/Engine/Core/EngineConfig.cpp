@@ -0,0 +1,103 @@
+//
+// Created by zshrout on 10/18/26.
+// Copyright (c) 2026 BunnySofty. All rights reserved.
+//
+
+#include "EngineConfig.h"
+
+#include <charconv>
+#include <cstdlib>
+#include <limits>
+#include <string>
+#include <string_view>
+
+namespace carrot::core {
+    namespace {
+        // Matches "--name=value" and returns the value
+        [[nodiscard]] bool option_value(const std::string_view argument, const std::string_view name,
+                                        std::string_view& value) noexcept
+        {
+            if (!argument.starts_with(name) || argument.size() <= name.size() || argument[name.size()] != '=')
+                return false;
+
+            value = argument.substr(name.size() + 1);
+            return true;
+        }
+
+        template<typename T>
+        [[nodiscard]] bool parse_number(const std::string_view text, T& number) noexcept
+        {
+            T parsed{ 0 };
+            const auto [end, error]{ std::from_chars(text.data(), text.data() + text.size(), parsed) };
+            if (error != std::errc{ } || end != text.data() + text.size() || parsed == 0) return false;
+
+            number = parsed;
+            return true;
+        }
+
+        // Floating-point from_chars is not available in every standard library we build with
+        [[nodiscard]] bool parse_number(const std::string_view text, float& number)
+        {
+            const std::string copy{ text };
+            char* end{ nullptr };
+            const float parsed{ std::strtof(copy.c_str(), &end) };
+            if (copy.empty() || end != copy.c_str() + copy.size() || !(parsed > 0.f)) return false;
+
+            number = parsed;
+            return true;
+        }
+
+        // "tag:mebibytes"; budgets whose byte count does not fit in 64 bits are rejected
+        [[nodiscard]] bool parse_budget(const std::string_view text, engine_config_t& config) noexcept
+        {
+            const size_t colon{ text.find(':') };
+            memory::memory_tag tag{ };
+            uint64_t mebibytes{ 0 };
+            if (colon == std::string_view::npos || !memory::tag_from_string(text.substr(0, colon), tag) ||
+                !parse_number(text.substr(colon + 1), mebibytes) ||
+                mebibytes > std::numeric_limits<uint64_t>::max() >> 20)
+                return false;
+
+            config.memory_budgets[static_cast<size_t>(tag)] = mebibytes * 1024 * 1024;
+            return true;
+        }
+    } // anonymous namespace
+
+    engine_config_t parse_command_line(const int argc, const char* const* argv)
+    {
+        engine_config_t config{ };
+
+        for (int i{ 1 }; i < argc; ++i)
+        {
+            const std::string_view argument{ argv[i] };
+            std::string_view value;
+
+            bool parsed{ true };
+            if (argument == "--headless")
+                config.renderer.headless = true;
+            else if (option_value(argument, "--frames", value))
+                parsed = parse_number(value, config.frame_count);
+            else if (option_value(argument, "--width", value))
+                parsed = parse_number(value, config.renderer.width);
+            else if (option_value(argument, "--height", value))
+                parsed = parse_number(value, config.renderer.height);
+            else if (option_value(argument, "--ui-scale", value))
+                parsed = parse_number(value, config.renderer.ui_scale);
+            else if (option_value(argument, "--memory-budget", value))
+                parsed = parse_budget(value, config);
+            else if (option_value(argument, "--capture", value))
+                config.renderer.capture_directory = value;
+            else if (option_value(argument, "--capture-format", value))
+            {
+                parsed = value == "ppm" || value == "png";
+                if (value == "png") config.renderer.capture_format = renderer::image_file_format::png;
+            }
+            else
+                parsed = false;
+
+            if (!parsed) config.unknown_arguments.emplace_back(argument);
+        }
+
+        return config;
+    }
+} // namespace carrot::core
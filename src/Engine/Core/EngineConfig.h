@@ -0,0 +1,33 @@
+//
+// Created by zshrout on 10/18/26.
+// Copyright (c) 2026 BunnySofty. All rights reserved.
+//
+
+#pragma once
+
+#include "Memory/MemoryTracker.h"
+#include "Renderer/RendererConfig.h"
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace carrot::core {
+    // Everything selectable at startup; hand it to engine_t::configure() before the engine is first used
+    struct engine_config_t
+    {
+        renderer::renderer_config_t renderer;
+        uint64_t                    frame_count{ 0 };   // quit after this many frames, 0 runs until closed
+        memory::tag_budgets_t       memory_budgets{ };
+        std::vector<std::string>    unknown_arguments;  // unrecognized or malformed, reported once logging is up
+    };
+
+    // --headless                   render offscreen, without a window or surface
+    // --frames=N                   quit after N frames
+    // --width=N, --height=N        window or offscreen target size
+    // --capture=DIR                write every frame to DIR (headless only)
+    // --capture-format=ppm|png
+    // --ui-scale=F                 framebuffer pixels per debug overlay unit
+    // --memory-budget=TAG:MIB      warn when a memory tag (graphics, asset...) holds more; repeatable
+    [[nodiscard]] engine_config_t parse_command_line(int argc, const char* const* argv);
+} // namespace carrot::core
@@ -82,7 +82,8 @@ namespace carrot::core {
 
     // ── async_sink_t ────────────────────────────────────────────
     // PUBLIC
-    async_sink_t::async_sink_t(std::unique_ptr<log_sink_t> wrapped_sink) : _sink{ std::move(wrapped_sink) }
+    async_sink_t::async_sink_t(std::unique_ptr<log_sink_t> wrapped_sink)
+        : _sink{ std::move(wrapped_sink) }, _text{ std::make_unique<char[]>(k_text_capacity) }, _queue(k_max_queued)
     {
         _thread = std::thread(&async_sink_t::worker_thread, this);
     }
@@ -93,6 +94,7 @@ namespace carrot::core {
             std::lock_guard<std::mutex> lock(_mutex);
             _quit = true;
             _cv.notify_one();
+            _space_cv.notify_all();
         }
         if (_thread.joinable())
             _thread.join();
@@ -100,19 +102,44 @@ namespace carrot::core {
 
     void async_sink_t::write(const log_message& msg)
     {
-        std::lock_guard<std::mutex> lock(_mutex);
-        _queue.push({ msg, false });
-        _cv.notify_one();
+        push(msg, false);
     }
 
     void async_sink_t::flush()
     {
-        std::lock_guard<std::mutex> lock(_mutex);
-        _queue.push({ { }, true });
-        _cv.notify_one();
+        push({ }, true);
     }
 
     // PRIVATE
+    void async_sink_t::push(const log_message& msg, const bool flush_request)
+    {
+        const size_t length{ std::min(msg.message.size(), k_text_capacity) };
+
+        std::unique_lock<std::mutex> lock(_mutex);
+
+        // Text is kept contiguous: when it does not fit before the end of the ring it starts over at 0, and the
+        // skipped tail is released together with it
+        const auto reserve{ [this, length](size_t& offset) {
+            offset = _text_head + length <= k_text_capacity ? _text_head : 0;
+            return length + (offset == 0 && _text_head != 0 ? k_text_capacity - _text_head : 0);
+        } };
+
+        size_t offset{ 0 };
+        _space_cv.wait(lock, [&] {
+            return _quit || (_queue_count < k_max_queued && reserve(offset) <= k_text_capacity - _text_used);
+        });
+        if (_quit) return; // the worker is gone, nothing would write it
+
+        const size_t reserved{ reserve(offset) };
+        std::copy_n(msg.message.data(), length, _text.get() + offset);
+        _text_head = (offset + length) % k_text_capacity;
+        _text_used += reserved;
+
+        _queue[(_queue_front + _queue_count) % k_max_queued] = { msg, offset, length, reserved, flush_request };
+        ++_queue_count;
+        _cv.notify_one();
+    }
+
     void async_sink_t::worker_thread()
     {
         while (true)
@@ -120,37 +147,33 @@ namespace carrot::core {
             queue_item item;
             {
                 std::unique_lock<std::mutex> lock(_mutex);
-                _cv.wait(lock, [this] { return !_queue.empty() || _quit; });
+                _cv.wait(lock, [this] { return _queue_count != 0 || _quit; });
 
-                if (_queue.empty())
-                {
-                    if (_quit) break;
-                    continue;
-                }
+                // Remaining messages are drained before quitting
+                if (_queue_count == 0) break;
 
-                item = std::move(_queue.front());
-                _queue.pop();
+                item = _queue[_queue_front];
             }
 
+            // Writers only touch the free part of the ring, so the text is read without the lock
             if (item.flush_request)
             {
                 _sink->flush();
             }
             else
             {
+                item.msg.message = { _text.get() + item.offset, item.length };
                 _sink->write(item.msg);
             }
-        }
 
-        // Drain remaining messages on quit
-        std::lock_guard<std::mutex> lock(_mutex);
-        while (!_queue.empty())
-        {
-            auto& item = _queue.front();
-            if (!item.flush_request)
-                _sink->write(item.msg);
-            _queue.pop();
+            std::lock_guard<std::mutex> lock(_mutex);
+            _queue_front = (_queue_front + 1) % k_max_queued;
+            --_queue_count;
+            _text_used -= item.reserved;
+            if (_text_used == 0) _text_head = 0;
+            _space_cv.notify_all();
         }
+
         _sink->flush();
     }
 } // namespace carrot::core
@@ -7,12 +7,13 @@
 
 #include "Logger.h"
 
+#include <algorithm>
 #include <string>
 #include <memory>
 #include <thread>
 #include <condition_variable>
 #include <mutex>
-#include <queue>
+#include <vector>
 #include <atomic>
 
 namespace carrot::core {
@@ -35,10 +36,14 @@ namespace carrot::core {
         static void reset_console_color();
     };
 
-    // Async sink that wraps any other sink
+    // Async sink that wraps any other sink. Message text is copied into a ring the sink allocates up front, so
+    // writing never touches the heap; writers wait for the worker when the ring or the queue is full
     class async_sink_t : public log_sink_t
     {
     public:
+        static constexpr size_t k_text_capacity{ 64 * 1024 };   // longer messages are truncated to this
+        static constexpr size_t k_max_queued{ 1024 };
+
         explicit async_sink_t(std::unique_ptr<log_sink_t> wrapped_sink);
         ~async_sink_t() override;
 
@@ -46,19 +51,31 @@ namespace carrot::core {
         void flush() override;
 
     private:
-        void worker_thread();
-
-        std::unique_ptr<log_sink_t> _sink;
-
         struct queue_item
         {
             log_message msg;
+            size_t offset{ 0 };     // msg.message lives at _text[offset, offset + length)
+            size_t length{ 0 };
+            size_t reserved{ 0 };   // length plus the ring tail skipped to keep the text contiguous
             bool flush_request{ false };
         };
 
-        std::queue<queue_item> _queue;
+        void worker_thread();
+        void push(const log_message& msg, bool flush_request);
+
+        std::unique_ptr<log_sink_t> _sink;
+
+        std::unique_ptr<char[]> _text;
+        size_t _text_head{ 0 };
+        size_t _text_used{ 0 };
+
+        std::vector<queue_item> _queue;     // fixed ring of k_max_queued items
+        size_t _queue_front{ 0 };
+        size_t _queue_count{ 0 };
+
         std::mutex _mutex;
         std::condition_variable _cv;
+        std::condition_variable _space_cv;
         std::thread _thread;
         std::atomic<bool> _quit{ false };
     };
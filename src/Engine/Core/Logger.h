@@ -5,12 +5,16 @@
 
 #pragma once
 
+#include "Memory/FrameArena.h"
+
 #include <cstdint>
 #include <format>
+#include <iterator>
 #include <mutex>
 #include <print>
 #include <source_location>
 #include <string>
+#include <string_view>
 
 namespace carrot::core {
     struct log_message;
@@ -46,7 +50,7 @@ namespace carrot::core {
     {
         log_category category;
         log_severity severity;
-        std::string message;
+        std::string_view message;   // only valid for the duration of log_sink_t::write()
         std::source_location location;
     };
 
@@ -139,7 +143,9 @@ namespace carrot::core {
         if (severity < _min_severity) return;
         if ((category & _enabled_categories) == static_cast<log_category>(0)) return;
 
-        const std::string message{ std::format(fmt, std::forward<Args>(args)...) };
+        // Formatted into the frame arena, so logging does not hit the heap; sinks copy what they keep
+        memory::frame_string_t message{ memory::frame_allocator_t<char>{ } };
+        std::format_to(std::back_inserter(message), fmt, std::forward<Args>(args)...);
         const log_message msg{ category, severity, message, loc };
 
         internal_log(msg);
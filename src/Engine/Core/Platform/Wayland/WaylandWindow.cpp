@@ -8,6 +8,8 @@
 
 #include <wayland-client-protocol.h>
 #include <cstring>
+#include <poll.h>
+#include <unistd.h>
 
 namespace carrot::platform {
     namespace {
@@ -18,10 +20,23 @@ namespace carrot::platform {
 
         constexpr xdg_wm_base_listener xdg_wm_base_listener{ .ping = xdg_wm_base_ping };
 
-        void xdg_surface_configure(void*, xdg_surface*, uint32_t) {}
+        // A configure sequence ends with the surface event; the toplevel's size only applies once it is acked
+        void xdg_surface_configure(void* data, xdg_surface* surface, const uint32_t serial)
+        {
+            xdg_surface_ack_configure(surface, serial);
+            static_cast<wayland_window_t *>(data)->apply_configure();
+        }
+
         constexpr xdg_surface_listener xdg_surface_listener{ .configure = xdg_surface_configure };
 
-        void xdg_toplevel_configure(void*, xdg_toplevel*, int32_t, int32_t, wl_array*) {}
+        void xdg_toplevel_configure(void* data, xdg_toplevel*, const int32_t width, const int32_t height, wl_array*)
+        {
+            // Zero leaves the size to us, the current one is kept
+            if (width > 0 && height > 0)
+                static_cast<wayland_window_t *>(data)->on_configure(static_cast<uint32_t>(width),
+                                                                     static_cast<uint32_t>(height));
+        }
+
         void xdg_toplevel_close(void*, xdg_toplevel*) {}
 
         constexpr xdg_toplevel_listener xdg_toplevel_listener{
@@ -31,6 +46,52 @@ namespace carrot::platform {
             .wm_capabilities = nullptr,
         };
 
+        // Only key presses are used, as raw evdev codes, so the keymap is never mapped
+        void keyboard_keymap(void*, wl_keyboard*, uint32_t, const int32_t fd, uint32_t) { close(fd); }
+        void keyboard_enter(void*, wl_keyboard*, uint32_t, wl_surface*, wl_array*) {}
+        void keyboard_leave(void*, wl_keyboard*, uint32_t, wl_surface*) {}
+        void keyboard_modifiers(void*, wl_keyboard*, uint32_t, uint32_t, uint32_t, uint32_t, uint32_t) {}
+        void keyboard_repeat_info(void*, wl_keyboard*, int32_t, int32_t) {}
+
+        void keyboard_key(void* data, wl_keyboard*, uint32_t, uint32_t, const uint32_t key, const uint32_t state)
+        {
+            if (state == WL_KEYBOARD_KEY_STATE_PRESSED) static_cast<wayland_window_t *>(data)->on_key(key);
+        }
+
+        constexpr wl_keyboard_listener keyboard_listener{
+            .keymap = keyboard_keymap,
+            .enter = keyboard_enter,
+            .leave = keyboard_leave,
+            .key = keyboard_key,
+            .modifiers = keyboard_modifiers,
+            .repeat_info = keyboard_repeat_info,
+        };
+
+        void seat_capabilities(void* data, wl_seat* seat, const uint32_t capabilities)
+        {
+            wayland_window_t* win{ static_cast<wayland_window_t *>(data) };
+
+            const bool has_keyboard{ (capabilities & WL_SEAT_CAPABILITY_KEYBOARD) != 0 };
+            if (has_keyboard && !win->get_keyboard())
+            {
+                wl_keyboard* keyboard{ wl_seat_get_keyboard(seat) };
+                wl_keyboard_add_listener(keyboard, &keyboard_listener, win);
+                win->set_keyboard(keyboard);
+            }
+            else if (!has_keyboard && win->get_keyboard())
+            {
+                wl_keyboard_destroy(win->get_keyboard());
+                win->set_keyboard(nullptr);
+            }
+        }
+
+        void seat_name(void*, wl_seat*, const char*) {}
+
+        constexpr wl_seat_listener seat_listener{
+            .capabilities = seat_capabilities,
+            .name = seat_name,
+        };
+
         void registry_global(void* data, wl_registry* registry, const uint32_t name,
                              const char* interface, uint32_t) noexcept
         {
@@ -48,6 +109,12 @@ namespace carrot::platform {
                 win->set_xdg_wm_base(base);
                 xdg_wm_base_add_listener(base, &xdg_wm_base_listener, nullptr);
             }
+            else if (std::strcmp(interface, wl_seat_interface.name) == 0)
+            {
+                auto* seat = static_cast<wl_seat *>(wl_registry_bind(registry, name, &wl_seat_interface, 1));
+                win->set_seat(seat);
+                wl_seat_add_listener(seat, &seat_listener, win);
+            }
         }
 
         void registry_global_remove(void*, wl_registry*, uint32_t) noexcept {}
@@ -58,7 +125,8 @@ namespace carrot::platform {
         };
     } // anonymous
 
-    wayland_window_t::wayland_window_t([[maybe_unused]] uint32_t width, [[maybe_unused]] uint32_t height, const char* title) noexcept
+    wayland_window_t::wayland_window_t(const uint32_t width, const uint32_t height, const char* title) noexcept
+        : _width{ width }, _height{ height }, _pending_width{ width }, _pending_height{ height }
     {
         _display = wl_display_connect(nullptr);
         if (!_display) return;
@@ -71,10 +139,10 @@ namespace carrot::platform {
 
         _surface = wl_compositor_create_surface(_compositor);
         _xdg_surface = xdg_wm_base_get_xdg_surface(_xdg_wm_base, _surface);
-        xdg_surface_add_listener(_xdg_surface, &xdg_surface_listener, nullptr);
+        xdg_surface_add_listener(_xdg_surface, &xdg_surface_listener, this);
 
         _xdg_toplevel = xdg_surface_get_toplevel(_xdg_surface);
-        xdg_toplevel_add_listener(_xdg_toplevel, &xdg_toplevel_listener, nullptr);
+        xdg_toplevel_add_listener(_xdg_toplevel, &xdg_toplevel_listener, this);
         xdg_toplevel_set_title(_xdg_toplevel, title);
 
         wl_surface_commit(_surface);
@@ -83,6 +151,8 @@ namespace carrot::platform {
 
     wayland_window_t::~wayland_window_t() noexcept
     {
+        if (_keyboard) wl_keyboard_destroy(_keyboard);
+        if (_seat) wl_seat_destroy(_seat);
         if (_xdg_toplevel) xdg_toplevel_destroy(_xdg_toplevel);
         if (_xdg_surface) xdg_surface_destroy(_xdg_surface);
         if (_xdg_wm_base) xdg_wm_base_destroy(_xdg_wm_base);
@@ -90,8 +160,22 @@ namespace carrot::platform {
         if (_display) wl_display_disconnect(_display);
     }
 
-    void wayland_window_t::poll_events() const noexcept
+    void wayland_window_t::poll_events() noexcept
     {
+        _pressed.reset();
+        if (!_display) return;
+
+        // Reads whatever the compositor has sent without blocking, then dispatches it
+        while (wl_display_prepare_read(_display) != 0)
+            wl_display_dispatch_pending(_display);
+        wl_display_flush(_display);
+
+        pollfd fd{ wl_display_get_fd(_display), POLLIN, 0 };
+        if (poll(&fd, 1, 0) > 0)
+            wl_display_read_events(_display);
+        else
+            wl_display_cancel_read(_display);
+
         wl_display_dispatch_pending(_display);
     }
 } // namespace carrot::platform
@@ -7,6 +7,8 @@
 
 #include <wayland-client.h>
 
+#include <bitset>
+
 struct xdg_wm_base;
 struct xdg_surface;
 struct xdg_toplevel;
@@ -17,23 +19,61 @@ namespace carrot::platform {
         explicit wayland_window_t(uint32_t width, uint32_t height, const char* title) noexcept;
         ~wayland_window_t() noexcept;
 
-        void poll_events() const noexcept;
+        void poll_events() noexcept;
         [[nodiscard]] bool should_close() const noexcept { return _should_close; }
 
+        // Keys are Linux evdev codes, as the compositor reports them; true for keys that went down since the
+        // previous poll_events()
+        [[nodiscard]] bool was_key_pressed(const uint32_t key) const noexcept
+        {
+            return key < k_max_keys && _pressed[key];
+        }
+
+        // Surface size in pixels: the one asked for until the compositor configures another
+        [[nodiscard]] uint32_t width() const noexcept { return _width; }
+        [[nodiscard]] uint32_t height() const noexcept { return _height; }
+
         [[nodiscard]] wl_display* get_wl_display() const noexcept { return _display; }
         [[nodiscard]] wl_surface* get_wl_surface() const noexcept { return _surface; }
 
         // These two are only for the registry callback
         void set_compositor(wl_compositor* c) noexcept { _compositor = c; }
         void set_xdg_wm_base(xdg_wm_base* base) noexcept { _xdg_wm_base = base; }
+        void set_seat(wl_seat* seat) noexcept { _seat = seat; }
+        // And these for the seat and keyboard callbacks
+        void set_keyboard(wl_keyboard* keyboard) noexcept { _keyboard = keyboard; }
+        [[nodiscard]] wl_keyboard* get_keyboard() const noexcept { return _keyboard; }
+        void on_key(const uint32_t key) noexcept { if (key < k_max_keys) _pressed.set(key); }
+        // And these for the xdg configure sequence
+        void on_configure(const uint32_t width, const uint32_t height) noexcept
+        {
+            _pending_width = width;
+            _pending_height = height;
+        }
+        void apply_configure() noexcept
+        {
+            _width = _pending_width;
+            _height = _pending_height;
+        }
 
     private:
+        static constexpr uint32_t k_max_keys{ 256 };
+
         wl_display* _display{ nullptr };
         wl_compositor* _compositor{ nullptr };
         wl_surface* _surface{ nullptr };
         xdg_wm_base* _xdg_wm_base{ nullptr };
         xdg_surface* _xdg_surface{ nullptr };
         xdg_toplevel* _xdg_toplevel{ nullptr };
+        wl_seat* _seat{ nullptr };
+        wl_keyboard* _keyboard{ nullptr };
+
+        std::bitset<k_max_keys> _pressed;
+
+        uint32_t _width{ 0 };
+        uint32_t _height{ 0 };
+        uint32_t _pending_width{ 0 };
+        uint32_t _pending_height{ 0 };
 
         bool _should_close{ false };
     };
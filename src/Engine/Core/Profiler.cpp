@@ -0,0 +1,233 @@
+//
+// Created by zshrout on 10/18/26.
+// Copyright (c) 2026 BunnySofty. All rights reserved.
+//
+
+#include "Profiler.h"
+
+#include "Common/CommonHeaders.h"
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cstring>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace carrot::core::profiler {
+    namespace {
+        std::mutex                                          g_register_mutex;
+        std::array<const char*, k_max_zones>                g_zone_names{ };
+        std::atomic<uint32_t>                               g_zone_count{ 0 };
+
+        // Accumulated by any thread during the frame, swapped out by end_frame()
+        std::array<std::atomic<uint64_t>, k_max_zones>      g_accumulated{ };
+        std::array<uint64_t, k_max_zones>                   g_frame_zones{ };
+
+        // The latest GPU frame, copied out by end_frame()
+        std::mutex                                          g_gpu_mutex;
+        std::vector<gpu_scope_t>                            g_gpu_scopes;
+        std::vector<gpu_scope_t>                            g_frame_gpu_scopes;
+
+        thread_local uint32_t                               t_depth{ 0 };
+
+#ifndef CARROT_SHIPPING
+        // Zone instances closed by one thread during the frame. Only the owning thread and end_frame() take the
+        // lock, so it is uncontended for the rest of the frame
+        struct thread_events_t
+        {
+            std::mutex                  mutex;
+            std::vector<zone_event_t>   events;
+            bool                        retired{ false };   // its thread exited, the next new thread reuses it
+        };
+
+        // Registered on a thread's first zone; buffers outlive their threads so end_frame() never races an exit
+        std::mutex                                          g_thread_mutex;
+        std::vector<std::unique_ptr<thread_events_t>>       g_threads;
+        std::vector<zone_event_t>                           g_frame_events;
+
+        struct thread_slot_t
+        {
+            thread_events_t*            buffer{ nullptr };
+            uint32_t                    index{ 0 };
+
+            thread_slot_t() = default;
+            thread_slot_t(const thread_slot_t&) = delete;
+            thread_slot_t& operator=(const thread_slot_t&) = delete;
+            ~thread_slot_t()
+            {
+                if (!buffer) return;
+                std::scoped_lock lock{ g_thread_mutex };
+                buffer->retired = true;
+            }
+        };
+        thread_local thread_slot_t                          t_slot;
+
+        thread_slot_t& thread_slot()
+        {
+            if (t_slot.buffer) return t_slot;
+
+            std::scoped_lock lock{ g_thread_mutex };
+            for (uint32_t index{ 0 }; index < g_threads.size(); ++index)
+            {
+                if (!g_threads[index]->retired) continue;
+                g_threads[index]->retired = false;
+                t_slot.buffer = g_threads[index].get();
+                t_slot.index = index;
+                return t_slot;
+            }
+
+            g_threads.push_back(std::make_unique<thread_events_t>());
+            g_threads.back()->events.reserve(k_max_events_per_frame);
+            t_slot.buffer = g_threads.back().get();
+            t_slot.index = static_cast<uint32_t>(g_threads.size() - 1);
+            return t_slot;
+        }
+
+        // Moves every thread's events into g_frame_events in the order they closed
+        void merge_thread_events()
+        {
+            g_frame_events.clear();
+            {
+                std::scoped_lock lock{ g_thread_mutex };
+                for (const std::unique_ptr<thread_events_t>& thread: g_threads)
+                {
+                    std::scoped_lock thread_lock{ thread->mutex };
+                    const size_t room{ k_max_events_per_frame - g_frame_events.size() };
+                    const size_t count{ std::min(thread->events.size(), room) };
+                    g_frame_events.insert(g_frame_events.end(), thread->events.begin(), thread->events.begin() + count);
+                    thread->events.clear();
+                }
+            }
+
+            std::ranges::stable_sort(g_frame_events, { }, &zone_event_t::end_ns);
+        }
+#endif
+
+        std::atomic<int64_t>                                g_frame_start_ns{ 0 };
+        std::chrono::steady_clock::time_point               g_frame_start;
+        uint64_t                                            g_frame_index{ 0 };
+        utils::multicast_delegate_t<void(const frame_profile_t&)> g_listeners;
+
+        [[nodiscard]] int64_t to_ns(const std::chrono::steady_clock::time_point time) noexcept
+        {
+            return std::chrono::duration_cast<std::chrono::nanoseconds>(time.time_since_epoch()).count();
+        }
+    } // anonymous namespace
+
+    uint32_t register_zone(const char* name) noexcept
+    {
+        std::scoped_lock lock{ g_register_mutex };
+
+        const uint32_t count{ g_zone_count.load(std::memory_order_relaxed) };
+        for (uint32_t zone{ 0 }; zone < count; ++zone)
+            if (std::strcmp(g_zone_names[zone], name) == 0) return zone;
+
+        if (count == k_max_zones)
+        {
+            LOG_CORE_WARN("[Profiler] Zone table full, '{}' is not timed", name);
+            return k_invalid_zone;
+        }
+
+        g_zone_names[count] = name;
+        g_zone_count.store(count + 1, std::memory_order_release);
+        return count;
+    }
+
+    uint32_t zone_count() noexcept
+    {
+        return g_zone_count.load(std::memory_order_acquire);
+    }
+
+    const char* zone_name(const uint32_t zone) noexcept
+    {
+        return zone < zone_count() ? g_zone_names[zone] : "";
+    }
+
+    void record(const uint32_t zone, const uint64_t ns) noexcept
+    {
+        if (zone < k_max_zones) g_accumulated[zone].fetch_add(ns, std::memory_order_relaxed);
+    }
+
+    void submit_gpu_frame(const std::span<const gpu_scope_t> scopes)
+    {
+        std::scoped_lock lock{ g_gpu_mutex };
+        g_gpu_scopes.assign(scopes.begin(), scopes.end());
+    }
+
+    void begin_frame() noexcept
+    {
+        g_frame_start = std::chrono::steady_clock::now();
+        g_frame_start_ns.store(to_ns(g_frame_start), std::memory_order_relaxed);
+    }
+
+    void end_frame()
+    {
+        const auto elapsed{ std::chrono::steady_clock::now() - g_frame_start };
+
+        // Zones still open on other threads land in the next frame
+        const uint32_t count{ zone_count() };
+        for (uint32_t zone{ 0 }; zone < count; ++zone)
+            g_frame_zones[zone] = g_accumulated[zone].exchange(0, std::memory_order_relaxed);
+
+        {
+            std::scoped_lock lock{ g_gpu_mutex };
+            g_frame_gpu_scopes = g_gpu_scopes; // repeated until a newer GPU frame arrives
+        }
+
+#ifndef CARROT_SHIPPING
+        // Every buffer keeps its capacity, recording stays allocation-free once warmed up
+        merge_thread_events();
+        const std::span<const zone_event_t> events{ g_frame_events };
+#else
+        const std::span<const zone_event_t> events{ };
+#endif
+
+        const frame_profile_t frame{
+            g_frame_index++,
+            static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count()),
+            { g_frame_zones.data(), count },
+            events,
+            g_frame_gpu_scopes
+        };
+        g_listeners.broadcast(frame);
+    }
+
+    void add_frame_listener(const frame_listener_t& listener)
+    {
+        g_listeners.add(listener);
+    }
+
+    void remove_frame_listener(const frame_listener_t& listener)
+    {
+        g_listeners.remove(listener);
+    }
+
+    scoped_zone_t::scoped_zone_t(const uint32_t zone) noexcept
+        : _zone{ zone }, _depth{ t_depth++ }, _start{ std::chrono::steady_clock::now() }
+    {
+    }
+
+    scoped_zone_t::~scoped_zone_t()
+    {
+        const auto end{ std::chrono::steady_clock::now() };
+        --t_depth;
+        if (_zone >= k_max_zones) return;
+
+        record(_zone, static_cast<uint64_t>(to_ns(end) - to_ns(_start)));
+
+#ifndef CARROT_SHIPPING
+        const thread_slot_t& slot{ thread_slot() };
+        const int64_t frame_start{ g_frame_start_ns.load(std::memory_order_relaxed) };
+        const zone_event_t event{
+            _zone, slot.index, _depth,
+            static_cast<uint64_t>(std::max<int64_t>(to_ns(_start) - frame_start, 0)),
+            static_cast<uint64_t>(std::max<int64_t>(to_ns(end) - frame_start, 0))
+        };
+
+        std::scoped_lock lock{ slot.buffer->mutex };
+        if (slot.buffer->events.size() < k_max_events_per_frame) slot.buffer->events.push_back(event);
+#endif
+    }
+} // namespace carrot::core::profiler
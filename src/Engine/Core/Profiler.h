@@ -0,0 +1,90 @@
+//
+// Created by zshrout on 10/18/26.
+// Copyright (c) 2026 BunnySofty. All rights reserved.
+//
+
+#pragma once
+
+#include "Utils/MulticastDelegate.h"
+
+#include <chrono>
+#include <cstdint>
+#include <span>
+
+namespace carrot::core::profiler {
+    constexpr uint32_t k_max_zones{ 64 };
+    constexpr uint32_t k_invalid_zone{ ~0u };
+    constexpr uint32_t k_max_events_per_frame{ 4096 };    // per thread and merged; the rest only count towards zone_ns
+
+    // One closed zone instance; times are relative to begin_frame(), clamped to 0 for zones opened before it
+    struct zone_event_t
+    {
+        uint32_t                    zone{ 0 };
+        uint32_t                    thread{ 0 };    // small per-thread index, reused once its thread exits
+        uint32_t                    depth{ 0 };     // zones open on the thread around it
+        uint64_t                    start_ns{ 0 };
+        uint64_t                    end_ns{ 0 };
+    };
+
+    // One GPU scope; times are relative to the first timestamp of its GPU frame
+    struct gpu_scope_t
+    {
+        uint32_t                    zone{ 0 };
+        uint64_t                    start_ns{ 0 };
+        uint64_t                    end_ns{ 0 };
+    };
+
+    struct frame_profile_t
+    {
+        uint64_t                    frame_index{ 0 };
+        uint64_t                    frame_ns{ 0 };  // begin_frame() to end_frame()
+        std::span<const uint64_t>   zone_ns;        // inclusive time per zone id, summed over all threads
+        std::span<const zone_event_t> events;       // in the order they closed; always empty in shipping builds
+        // The latest GPU frame read back; GPU timings land a few frames after the CPU frame that recorded them
+        std::span<const gpu_scope_t> gpu_scopes;
+    };
+
+    using frame_listener_t = utils::single_delegate_t<void(const frame_profile_t&)>;
+
+    // Zones with the same name share an id. Returns k_invalid_zone once the table is full
+    [[nodiscard]] uint32_t register_zone(const char* name) noexcept;
+    [[nodiscard]] uint32_t zone_count() noexcept;
+    [[nodiscard]] const char* zone_name(uint32_t zone) noexcept;
+
+    // Thread-safe, adds to the zone's total for the current frame
+    void record(uint32_t zone, uint64_t ns) noexcept;
+    // Thread-safe, replaces the GPU scopes handed to the next end_frame()
+    void submit_gpu_frame(std::span<const gpu_scope_t> scopes);
+
+    // Called by the engine around every iteration of its loop; end_frame() hands the frame to the listeners
+    void begin_frame() noexcept;
+    void end_frame();
+    void add_frame_listener(const frame_listener_t& listener);
+    void remove_frame_listener(const frame_listener_t& listener);
+
+    // Adds to the zone's total and, outside shipping builds, records the instance in its thread's timeline buffer
+    class scoped_zone_t
+    {
+    public:
+        explicit scoped_zone_t(uint32_t zone) noexcept;
+        ~scoped_zone_t();
+
+        scoped_zone_t(const scoped_zone_t&) = delete;
+        scoped_zone_t& operator=(const scoped_zone_t&) = delete;
+
+    private:
+        uint32_t                                _zone;
+        uint32_t                                _depth;
+        std::chrono::steady_clock::time_point   _start;
+    };
+} // namespace carrot::core::profiler
+
+#define CE_PROFILE_CONCAT_IMPL(a, b) a##b
+#define CE_PROFILE_CONCAT(a, b) CE_PROFILE_CONCAT_IMPL(a, b)
+
+// Times the rest of the enclosing scope; the name is registered once per call site
+#define CE_PROFILE_ZONE(name)                                                                                   \
+        static const uint32_t CE_PROFILE_CONCAT(ce_profile_id_, __LINE__){                                      \
+                carrot::core::profiler::register_zone(name) };                                                 \
+        const carrot::core::profiler::scoped_zone_t CE_PROFILE_CONCAT(ce_profile_zone_, __LINE__){              \
+                CE_PROFILE_CONCAT(ce_profile_id_, __LINE__) }
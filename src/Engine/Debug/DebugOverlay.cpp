@@ -5,151 +5,161 @@
 
 #include "DebugOverlay.h"
 
+#include "GlyphAtlas.h"
 #include "RHI/Backends/Vulkan/VulkanRenderer.h"
 #include "RHI/Backends/Vulkan/VulkanContext.h"
 #include "Utils/ShaderUtils.h"
+#include "Renderer/ShaderReflection.h"
+#include "Core/Profiler.h"
 #include "Common/CommonHeaders.h"
 
-#define STB_TRUETYPE_IMPLEMENTATION
-#include <stb_truetype.h>
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cmath>
 #include <cstdarg>
+#include <deque>
+#include <numbers>
+#include <span>
+#include <string>
+#include <string_view>
+#include <unordered_map>
 #include <vector>
 #include <fstream>
 
 namespace carrot::debug {
     namespace {
-        constexpr int k_atlas_width = 1024;
-        constexpr int k_atlas_height = 1024;
-        constexpr int k_first_char = 32;
-        constexpr int k_char_count = 96;
-        constexpr float k_font_pixel_height = 32.0f;
-
-        // stbtt_fontinfo g_font;
-        unsigned char* g_ttf_buffer{ nullptr };
-        unsigned char* g_atlas_pixels{ nullptr };
+        constexpr const char* k_font_path{ "assets/Fonts/Roboto-Regular.ttf" };
+        constexpr const char* k_glyph_cache_path{ "cache/Roboto-Regular.sdf" };
+        constexpr float k_default_pixel_height{ 32.0f };
+        constexpr float k_max_pixel_height{ 4095.0f };  // 12.4 fixed point in the instance
+        constexpr uint32_t k_first_ascii{ 32 };
+        constexpr uint32_t k_last_ascii{ 126 };
+
         bool g_initialized{ false };
 
-        struct glyph_t
-        {
-            float x0, y0, x1, y1; // atlas coords (pixels)
-            float xoff, yoff; // bearing
-            float advance;
-        };
+        // The shaders map units to the framebuffer through push constants, so nothing cached on the CPU depends
+        // on either of these and resizing or rescaling never invalidates a layout
+        float g_ui_scale{ 1.f };
+        canvas_t g_canvas{ 1280.f, 720.f };
+
+        glyph_atlas_t g_atlas;
+        uint32_t g_rg_atlas{ ~0u };                             // this frame's render graph resource
+        std::vector<VkBufferImageCopy> g_glyph_copies;          // this frame's atlas updates, from the ring
+        VkBuffer g_glyph_staging{ VK_NULL_HANDLE };
 
-        glyph_t g_glyphs[k_char_count];
+        VkBuffer g_glyph_buffer{ VK_NULL_HANDLE };
+        rhi::vulkan::gpu_allocation_t g_glyph_memory;
+        rhi::vulkan::storage_buffer_handle_t g_glyph_handle;
 
         VkImage g_font_image{ VK_NULL_HANDLE };
         VkImageView g_font_view{ VK_NULL_HANDLE };
-        VkDeviceMemory g_font_memory{ VK_NULL_HANDLE };
+        rhi::vulkan::gpu_allocation_t g_font_memory;
+        rhi::vulkan::upload_ticket_t g_font_ticket;
         VkSampler g_font_sampler{ VK_NULL_HANDLE };
+        rhi::vulkan::texture_handle_t g_font_texture_handle;
+        rhi::vulkan::sampler_handle_t g_font_sampler_handle;
 
-        VkDescriptorSetLayout g_desc_layout{ VK_NULL_HANDLE };
-        VkDescriptorPool g_desc_pool{ VK_NULL_HANDLE };
-        VkDescriptorSet g_desc_set{ VK_NULL_HANDLE };
+        // Owned by the context's layout cache
+        struct overlay_layout_t
+        {
+            VkPipelineLayout pipeline_layout{ VK_NULL_HANDLE };
+            VkShaderStageFlags push_stages{ 0 };
+        };
 
-        VkPipelineLayout g_pipeline_layout{ VK_NULL_HANDLE };
+        overlay_layout_t g_text_layout;
         VkPipeline g_pipeline{ VK_NULL_HANDLE };
 
-        struct vertex_t
+        overlay_layout_t g_primitive_layout;
+        VkPipeline g_fill_pipeline{ VK_NULL_HANDLE };   // triangle list, every 2D primitive
+        VkPipeline g_line_pipeline{ VK_NULL_HANDLE };   // line list, the 3D ones
+
+        // One per glyph, read as per-instance vertex input; the vertex shader expands it into a quad from the
+        // glyph metrics. Mirrors the inputs of shaders/debug_overlay.vert
+        struct glyph_instance_t
         {
-            float x, y, u, v;
+            float pen[2];       // baseline pen position, overlay units
+            uint32_t glyph;     // atlas slot in the low 16 bits, size in units as 12.4 fixed point in the high 16
+            uint32_t color;     // RGBA8, red in the low byte
         };
+        static_assert(sizeof(glyph_instance_t) == 16);
 
-        std::vector<vertex_t> g_vertices;
-        std::vector<uint16_t> g_indices;
+        constexpr uint32_t k_text_color{ 0xFF0000FF }; // red
 
-        VkBuffer g_vb{ VK_NULL_HANDLE };
-        VkDeviceMemory g_vb_mem{ VK_NULL_HANDLE };
-        VkBuffer g_ib{ VK_NULL_HANDLE };
-        VkDeviceMemory g_ib_mem{ VK_NULL_HANDLE };
-
-        void create_font_texture()
+        // ── Primitives
+        // Rebuilt from scratch every frame and drawn with one call per list. Mirrors the inputs of
+        // shaders/debug_primitive.vert
+        struct primitive_vertex_t
         {
-            rhi::vulkan::vulkan_context_t* ctx{ rhi::vulkan::vulkan_context_t::get() };
+            float position[3];  // overlay units for the fill list, world space for the line list
+            uint32_t color;     // RGBA8, red in the low byte
+        };
+        static_assert(sizeof(primitive_vertex_t) == 16);
 
-            // ── Create staging buffer
-            VkDeviceSize atlas_size{ k_atlas_width * k_atlas_height };
+        std::vector<primitive_vertex_t> g_fill_vertices;
+        std::vector<primitive_vertex_t> g_line_vertices;
+        float g_view_projection[16]{ 1, 0, 0, 0, 0, 1, 0, 0, 0, 0, 1, 0, 0, 0, 0, 1 };
 
-            VkBuffer staging_buf{ };
-            VkDeviceMemory staging_mem{ };
+        // ── Text layout cache
+        // Glyphs are kept per text() call site, keyed by position and size, and reused for as long as the string
+        // is the same and the atlas has not reassigned any slot. A changed string keeps the glyphs of its
+        // unchanged prefix and only lays out the rest, so a counter like the FPS line re-lays out a digit or two
+        // instead of the whole line. Only positions also drawn the frame before are cached: text that moves, like
+        // the profiler's timeline labels, is laid out into scratch layouts that are reused every frame.
+        constexpr uint64_t k_layout_max_idle_frames{ 120 };    // dropped after this many frames without a draw
 
-            VkBufferCreateInfo buf_info{ };
-            buf_info.sType = VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO;
-            buf_info.size = atlas_size;
-            buf_info.usage = VK_BUFFER_USAGE_TRANSFER_SRC_BIT;
-            vkCreateBuffer(ctx->device(), &buf_info, nullptr, &staging_buf);
+        struct layout_cursor_t
+        {
+            float x, y;             // pen position before the byte
+            uint32_t glyph_count;   // glyphs emitted before the byte
+        };
 
-            VkMemoryRequirements mem_req{ };
-            vkGetBufferMemoryRequirements(ctx->device(), staging_buf, &mem_req);
+        struct text_layout_t
+        {
+            uint64_t generation{ 0 };               // atlas generation the slots were taken from
+            float pixel_height{ k_default_pixel_height };
+            std::string text;
+            std::vector<glyph_instance_t> glyphs;   // one per visible character
+            std::vector<layout_cursor_t> cursors;   // one per byte of text plus the end; bytes inside a UTF-8
+                                                    // sequence are never resumed from
+            uint64_t last_frame{ 0 };
+        };
 
-            VkMemoryAllocateInfo alloc_info{ };
-            alloc_info.sType = VK_STRUCTURE_TYPE_MEMORY_ALLOCATE_INFO;
-            alloc_info.allocationSize = mem_req.size;
-            alloc_info.memoryTypeIndex = ctx->find_memory_type(mem_req.memoryTypeBits,
-                                                               VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT);
-            vkAllocateMemory(ctx->device(), &alloc_info, nullptr, &staging_mem);
-            vkBindBufferMemory(ctx->device(), staging_buf, staging_mem, 0);
+        std::unordered_map<uint64_t, text_layout_t> g_layouts;
+        std::deque<text_layout_t> g_scratch_layouts;    // uncached text; kept with their capacity across frames
+        size_t g_scratch_used{ 0 };
+        std::vector<uint64_t> g_frame_keys;             // keys drawn this frame
+        std::vector<uint64_t> g_previous_keys;          // keys drawn last frame, sorted
+        std::vector<const text_layout_t*> g_draw_list;  // this frame's text() calls, in order; nodes never move
+        uint64_t g_overlay_frame{ 1 };
 
-            void* mapped;
-            vkMapMemory(ctx->device(), staging_mem, 0, atlas_size, 0, &mapped);
-            memcpy(mapped, g_atlas_pixels, atlas_size);
-            vkUnmapMemory(ctx->device(), staging_mem);
+        void create_font_texture()
+        {
+            rhi::vulkan::vulkan_context_t* ctx{ rhi::vulkan::vulkan_context_t::get() };
 
             // ── Create device-local image
             VkImageCreateInfo img_info{ };
             img_info.sType = VK_STRUCTURE_TYPE_IMAGE_CREATE_INFO;
             img_info.imageType = VK_IMAGE_TYPE_2D;
             img_info.format = VK_FORMAT_R8_UNORM;
-            img_info.extent = { k_atlas_width, k_atlas_height, 1 };
+            img_info.extent = { glyph_atlas_t::k_width, glyph_atlas_t::k_height, 1 };
             img_info.mipLevels = 1;
             img_info.arrayLayers = 1;
             img_info.samples = VK_SAMPLE_COUNT_1_BIT;
             img_info.tiling = VK_IMAGE_TILING_OPTIMAL;
             img_info.usage = VK_IMAGE_USAGE_SAMPLED_BIT | VK_IMAGE_USAGE_TRANSFER_DST_BIT;
             img_info.initialLayout = VK_IMAGE_LAYOUT_UNDEFINED;
-            vkCreateImage(ctx->device(), &img_info, nullptr, &g_font_image);
-
-            vkGetImageMemoryRequirements(ctx->device(), g_font_image, &mem_req);
-            alloc_info.allocationSize = mem_req.size;
-            alloc_info.memoryTypeIndex = ctx->find_memory_type(mem_req.memoryTypeBits,
-                                                               VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT);
-            vkAllocateMemory(ctx->device(), &alloc_info, nullptr, &g_font_memory);
-            vkBindImageMemory(ctx->device(), g_font_image, g_font_memory, 0);
-
-            // ── Transition + copy
-            VkCommandBuffer cmd{ ctx->begin_one_time_commands() };
-
-            VkImageMemoryBarrier barrier{ };
-            barrier.sType = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER;
-            barrier.oldLayout = VK_IMAGE_LAYOUT_UNDEFINED;
-            barrier.newLayout = VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL;
-            barrier.srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
-            barrier.dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
-            barrier.image = g_font_image;
-            barrier.subresourceRange = { VK_IMAGE_ASPECT_COLOR_BIT, 0, 1, 0, 1 };
-            barrier.srcAccessMask = 0;
-            barrier.dstAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
-            vkCmdPipelineBarrier(cmd, VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT,
-                                 VK_PIPELINE_STAGE_TRANSFER_BIT, 0, 0, nullptr, 0, nullptr, 1, &barrier);
-
-            VkBufferImageCopy region{ };
-            region.imageSubresource.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
-            region.imageSubresource.layerCount = 1;
-            region.imageExtent = { k_atlas_width, k_atlas_height, 1 };
-            vkCmdCopyBufferToImage(cmd, staging_buf, g_font_image, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, 1, &region);
-
-            barrier.oldLayout = VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL;
-            barrier.newLayout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
-            barrier.srcAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
-            barrier.dstAccessMask = VK_ACCESS_SHADER_READ_BIT;
-            vkCmdPipelineBarrier(cmd, VK_PIPELINE_STAGE_TRANSFER_BIT,
-                                 VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT, 0, 0, nullptr, 0, nullptr, 1, &barrier);
-
-            ctx->end_one_time_commands(cmd);
-
-            // cleanup staging
-            vkDestroyBuffer(ctx->device(), staging_buf, nullptr);
-            vkFreeMemory(ctx->device(), staging_mem, nullptr);
+            if (!ctx->allocator().create_image(img_info, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT, g_font_image, g_font_memory))
+                return;
+
+            // ── Queue the cached or pre-baked atlas; the renderer flushes the batch and text shows up once the
+            // copy has landed. Glyphs baked later are copied in by the glyph_upload graph pass.
+            rhi::vulkan::image_upload_t upload{ };
+            upload.image = g_font_image;
+            upload.extent = { glyph_atlas_t::k_width, glyph_atlas_t::k_height, 1 };
+            g_font_ticket = ctx->uploads().upload_image(upload, g_atlas.pixels().data(), g_atlas.pixels().size());
+            if (!g_font_ticket.is_valid())
+                LOG_GRAPHICS_ERROR("[Debug] Failed to queue the font atlas upload, overlay text is disabled");
 
             // view + sampler
             VkImageViewCreateInfo view_info{ };
@@ -172,71 +182,106 @@ namespace carrot::debug {
             sampler_info.minLod = 0.0f;
             sampler_info.maxLod = 1.0f;
             vkCreateSampler(ctx->device(), &sampler_info, nullptr, &g_font_sampler);
+
+            // Sampled through the bindless heap; the fragment shader gets both indices as push constants
+            g_font_texture_handle = ctx->bindless().add_texture(g_font_view);
+            g_font_sampler_handle = ctx->bindless().add_sampler(g_font_sampler);
         }
 
-        void create_descriptor_objects()
+        // Host-visible: a slot is only rewritten once no frame in flight reads it, so it is patched in place
+        void create_glyph_metrics()
         {
-            const rhi::vulkan::vulkan_context_t* ctx{ rhi::vulkan::vulkan_context_t::get() };
+            rhi::vulkan::vulkan_context_t* ctx{ rhi::vulkan::vulkan_context_t::get() };
+
+            if (!ctx->create_buffer(sizeof(glyph_metrics_t) * glyph_atlas_t::k_max_glyphs,
+                                    VK_BUFFER_USAGE_STORAGE_BUFFER_BIT,
+                                    VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT,
+                                    g_glyph_buffer, g_glyph_memory))
+                return;
 
-            VkDescriptorSetLayoutBinding binding{ };
-            binding.binding = 0;
-            binding.descriptorType = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER;
-            binding.descriptorCount = 1;
-            binding.stageFlags = VK_SHADER_STAGE_FRAGMENT_BIT;
-
-            VkDescriptorSetLayoutCreateInfo layout_info{ };
-            layout_info.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_LAYOUT_CREATE_INFO;
-            layout_info.bindingCount = 1;
-            layout_info.pBindings = &binding;
-            vkCreateDescriptorSetLayout(ctx->device(), &layout_info, nullptr, &g_desc_layout);
-
-            constexpr VkDescriptorPoolSize pool_size{ VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER, 1 };
-            VkDescriptorPoolCreateInfo pool_info{ };
-            pool_info.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_POOL_CREATE_INFO;
-            pool_info.maxSets = 1;
-            pool_info.poolSizeCount = 1;
-            pool_info.pPoolSizes = &pool_size;
-            vkCreateDescriptorPool(ctx->device(), &pool_info, nullptr, &g_desc_pool);
-
-            VkDescriptorSetAllocateInfo alloc_info{ };
-            alloc_info.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_ALLOCATE_INFO;
-            alloc_info.descriptorPool = g_desc_pool;
-            alloc_info.descriptorSetCount = 1;
-            alloc_info.pSetLayouts = &g_desc_layout;
-            vkAllocateDescriptorSets(ctx->device(), &alloc_info, &g_desc_set);
-
-            VkDescriptorImageInfo img_info{ };
-            img_info.sampler = g_font_sampler;
-            img_info.imageView = g_font_view;
-            img_info.imageLayout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
-
-            VkWriteDescriptorSet write{ };
-            write.sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
-            write.dstSet = g_desc_set;
-            write.dstBinding = 0;
-            write.descriptorCount = 1;
-            write.descriptorType = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER;
-            write.pImageInfo = &img_info;
-            vkUpdateDescriptorSets(ctx->device(), 1, &write, 0, nullptr);
+            std::ranges::copy(g_atlas.metrics(), static_cast<glyph_metrics_t*>(g_glyph_memory.mapped));
+            g_glyph_handle = ctx->bindless().add_storage_buffer(g_glyph_buffer);
         }
 
-        void create_pipeline()
+        // Moves what the atlas baked since the last frame to the GPU: metrics straight into their slots, pixels
+        // into the transient ring for the glyph_upload pass. Everything stays pending when the ring is full.
+        void stage_glyph_uploads()
+        {
+            g_glyph_copies.clear();
+
+            rhi::vulkan::transient_ring_t& ring{ rhi::vulkan::vulkan_context_t::get()->transient_ring() };
+            for (const glyph_upload_t& upload: g_atlas.pending_uploads())
+            {
+                // Copy offsets have to be multiples of 4
+                const size_t size{ size_t{ upload.width } * upload.height };
+                const rhi::vulkan::transient_slice_t staging{
+                    ring.push(g_atlas.pending_pixels().subspan(upload.offset, size), 4)
+                };
+                if (!staging.is_valid())
+                {
+                    g_glyph_copies.clear();
+                    return;
+                }
+
+                VkBufferImageCopy& copy{ g_glyph_copies.emplace_back() };
+                copy.bufferOffset = staging.offset;
+                copy.imageSubresource = { VK_IMAGE_ASPECT_COLOR_BIT, 0, 0, 1 };
+                copy.imageOffset = { static_cast<int32_t>(upload.x), static_cast<int32_t>(upload.y), 0 };
+                copy.imageExtent = { upload.width, upload.height, 1 };
+                g_glyph_staging = staging.buffer;
+            }
+
+            // Only once every copy is staged: text must not point at cells whose pixels are not on their way
+            auto* metrics{ static_cast<glyph_metrics_t*>(g_glyph_memory.mapped) };
+            for (const uint32_t slot: g_atlas.dirty_slots())
+                metrics[slot] = g_atlas.metrics()[slot];
+
+            g_atlas.clear_pending();
+        }
+
+        void record_glyph_upload(VkCommandBuffer cmd)
+        {
+            if (g_glyph_copies.empty()) return;
+
+            vkCmdCopyBufferToImage(cmd, g_glyph_staging, g_font_image, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL,
+                                   static_cast<uint32_t>(g_glyph_copies.size()), g_glyph_copies.data());
+            g_glyph_copies.clear();
+        }
+
+        // Everything the overlay draws is alpha-blended over the frame, without depth
+        [[nodiscard]] VkPipeline create_pipeline(const char* vert_path, const char* frag_path,
+                                                 const VkPrimitiveTopology topology,
+                                                 const VkVertexInputRate input_rate, const uint32_t vertex_size,
+                                                 overlay_layout_t& layout_out)
         {
             rhi::vulkan::vulkan_context_t* ctx{ rhi::vulkan::vulkan_context_t::get() };
 
-            std::vector<uint32_t> vert_spv{ load_spv("shaders/debug_overlay.vert.spv") };
-            std::vector<uint32_t> frag_spv{ load_spv("shaders/debug_overlay.frag.spv") };
+            const spv_blob_t vert_spv{ load_spv(vert_path) };
+            const spv_blob_t frag_spv{ load_spv(frag_path) };
+
+            // Pipeline layout (the bindless set), push constants and vertex layout all come from the shaders
+            renderer::shader_reflection_t reflection{ };
+            if (!rhi::vulkan::reflect_stages({ vert_spv, frag_spv }, reflection)) return VK_NULL_HANDLE;
+
+            const rhi::vulkan::reflected_layout_t layout{ ctx->layout_cache().pipeline_layout(reflection) };
+            layout_out.pipeline_layout = layout.pipeline_layout;
+            layout_out.push_stages = layout.push_range.stageFlags;
+
+            rhi::vulkan::vertex_input_layout_t vertex_layout{ rhi::vulkan::build_vertex_input(reflection) };
+            vertex_layout.binding.inputRate = input_rate;
+            CE_ASSERT(vertex_layout.binding.stride == vertex_size,
+                      "Overlay vertex struct does not match the shader inputs");
 
             VkShaderModule vert_mod{ VK_NULL_HANDLE };
             VkShaderModule frag_mod{ VK_NULL_HANDLE };
 
             VkShaderModuleCreateInfo mod_info{ };
             mod_info.sType = VK_STRUCTURE_TYPE_SHADER_MODULE_CREATE_INFO;
-            mod_info.codeSize = vert_spv.size() * sizeof(uint32_t);
+            mod_info.codeSize = vert_spv.size_bytes();
             mod_info.pCode = vert_spv.data();
             vkCreateShaderModule(ctx->device(), &mod_info, nullptr, &vert_mod);
 
-            mod_info.codeSize = frag_spv.size() * sizeof(uint32_t);
+            mod_info.codeSize = frag_spv.size_bytes();
             mod_info.pCode = frag_spv.data();
             vkCreateShaderModule(ctx->device(), &mod_info, nullptr, &frag_mod);
 
@@ -251,21 +296,11 @@ namespace carrot::debug {
                 }
             };
 
-            VkVertexInputBindingDescription binding{ 0, sizeof(vertex_t), VK_VERTEX_INPUT_RATE_VERTEX };
-            VkVertexInputAttributeDescription attrs[2]{
-                { 0, 0, VK_FORMAT_R32G32_SFLOAT, offsetof(vertex_t, x) },
-                { 1, 0, VK_FORMAT_R32G32_SFLOAT, offsetof(vertex_t, u) }
-            };
-            VkPipelineVertexInputStateCreateInfo vertex_input{ };
-            vertex_input.sType = VK_STRUCTURE_TYPE_PIPELINE_VERTEX_INPUT_STATE_CREATE_INFO;
-            vertex_input.vertexBindingDescriptionCount = 1;
-            vertex_input.pVertexBindingDescriptions = &binding;
-            vertex_input.vertexAttributeDescriptionCount = 2;
-            vertex_input.pVertexAttributeDescriptions = attrs;
+            const VkPipelineVertexInputStateCreateInfo vertex_input{ vertex_layout.create_info() };
 
             VkPipelineInputAssemblyStateCreateInfo ia{ };
             ia.sType = VK_STRUCTURE_TYPE_PIPELINE_INPUT_ASSEMBLY_STATE_CREATE_INFO;
-            ia.topology = VK_PRIMITIVE_TOPOLOGY_TRIANGLE_LIST;
+            ia.topology = topology;
 
             VkPipelineViewportStateCreateInfo vp{ };
             vp.sType = VK_STRUCTURE_TYPE_PIPELINE_VIEWPORT_STATE_CREATE_INFO;
@@ -301,16 +336,12 @@ namespace carrot::debug {
             dynamic.dynamicStateCount = 2;
             dynamic.pDynamicStates = dyn;
 
-            // PUSH CONSTANT + DESCRIPTOR SET
-            VkPushConstantRange push_range{ VK_SHADER_STAGE_VERTEX_BIT, 0, sizeof(float) * 2 };
-
-            VkPipelineLayoutCreateInfo layout_info{ };
-            layout_info.sType = VK_STRUCTURE_TYPE_PIPELINE_LAYOUT_CREATE_INFO;
-            layout_info.setLayoutCount = 1;
-            layout_info.pSetLayouts = &g_desc_layout;
-            layout_info.pushConstantRangeCount = 1;
-            layout_info.pPushConstantRanges = &push_range;
-            vkCreatePipelineLayout(ctx->device(), &layout_info, nullptr, &g_pipeline_layout);
+            // Dynamic rendering: compatible with any pass drawing into a swapchain-format color target
+            const VkFormat color_format{ ctx->swapchain_format() };
+            VkPipelineRenderingCreateInfo rendering{ };
+            rendering.sType = VK_STRUCTURE_TYPE_PIPELINE_RENDERING_CREATE_INFO;
+            rendering.colorAttachmentCount = 1;
+            rendering.pColorAttachmentFormats = &color_format;
 
             VkGraphicsPipelineCreateInfo pipe{ };
             pipe.sType = VK_STRUCTURE_TYPE_GRAPHICS_PIPELINE_CREATE_INFO;
@@ -323,53 +354,316 @@ namespace carrot::debug {
             pipe.pMultisampleState = &ms;
             pipe.pColorBlendState = &cb;
             pipe.pDynamicState = &dynamic;
-            pipe.layout = g_pipeline_layout;
-            pipe.renderPass = ctx->render_pass();
-            pipe.subpass = 0;
+            pipe.layout = layout_out.pipeline_layout;
+            pipe.pNext = &rendering;
 
-            vkCreateGraphicsPipelines(ctx->device(), VK_NULL_HANDLE, 1, &pipe, nullptr, &g_pipeline);
+            VkPipeline pipeline{ VK_NULL_HANDLE };
+            vkCreateGraphicsPipelines(ctx->device(), ctx->pipeline_cache(), 1, &pipe, nullptr, &pipeline);
 
             vkDestroyShaderModule(ctx->device(), vert_mod, nullptr);
             vkDestroyShaderModule(ctx->device(), frag_mod, nullptr);
+            return pipeline;
+        }
+
+        void create_text_pipeline()
+        {
+            g_pipeline = create_pipeline("shaders/debug_overlay.vert.spv", "shaders/debug_overlay.frag.spv",
+                                         VK_PRIMITIVE_TOPOLOGY_TRIANGLE_LIST, VK_VERTEX_INPUT_RATE_INSTANCE,
+                                         sizeof(glyph_instance_t), g_text_layout);
+        }
+
+        void create_primitive_pipelines()
+        {
+            g_fill_pipeline = create_pipeline("shaders/debug_primitive.vert.spv", "shaders/debug_primitive.frag.spv",
+                                              VK_PRIMITIVE_TOPOLOGY_TRIANGLE_LIST, VK_VERTEX_INPUT_RATE_VERTEX,
+                                              sizeof(primitive_vertex_t), g_primitive_layout);
+            g_line_pipeline = create_pipeline("shaders/debug_primitive.vert.spv", "shaders/debug_primitive.frag.spv",
+                                              VK_PRIMITIVE_TOPOLOGY_LINE_LIST, VK_VERTEX_INPUT_RATE_VERTEX,
+                                              sizeof(primitive_vertex_t), g_primitive_layout);
+        }
+
+        void rebuild_text_pipeline()
+        {
+            const rhi::vulkan::vulkan_context_t* ctx{ rhi::vulkan::vulkan_context_t::get() };
+
+            vkDestroyPipeline(ctx->device(), g_pipeline, nullptr);
+            g_pipeline = VK_NULL_HANDLE;
+
+            create_text_pipeline();
+        }
+
+        void rebuild_primitive_pipelines()
+        {
+            const rhi::vulkan::vulkan_context_t* ctx{ rhi::vulkan::vulkan_context_t::get() };
+
+            vkDestroyPipeline(ctx->device(), g_fill_pipeline, nullptr);
+            vkDestroyPipeline(ctx->device(), g_line_pipeline, nullptr);
+            g_fill_pipeline = g_line_pipeline = VK_NULL_HANDLE;
+
+            create_primitive_pipelines();
+        }
+
+        [[nodiscard]] bool is_continuation(const char c) noexcept
+        {
+            return (static_cast<unsigned char>(c) & 0xC0) == 0x80;
+        }
+
+        // Decodes the UTF-8 sequence at `i` and moves past it; malformed input yields U+FFFD
+        [[nodiscard]] uint32_t decode_utf8(const std::string_view text, size_t& i) noexcept
+        {
+            const auto lead{ static_cast<unsigned char>(text[i++]) };
+            if (lead < 0x80) return lead;
+
+            const uint32_t length{ lead >= 0xF0 ? 4u : lead >= 0xE0 ? 3u : lead >= 0xC0 ? 2u : 0u };
+            if (length == 0 || i + length - 1 > text.size()) return 0xFFFD;
+
+            uint32_t codepoint{ lead & (0x7Fu >> length) };
+            for (uint32_t n{ 1 }; n < length; ++n)
+            {
+                if (!is_continuation(text[i])) return 0xFFFD;
+                codepoint = codepoint << 6 | (static_cast<unsigned char>(text[i++]) & 0x3Fu);
+            }
+            return codepoint;
         }
 
-        void rasterize_text(float x, float y, const char* text)
+        // Lays out layout.text from byte `first` on; everything before it is kept as it is
+        void layout_text(text_layout_t& layout, const size_t first)
         {
-            const float start_x{ x };
+            const float start_x{ layout.cursors.front().x };
+            layout.glyphs.resize(layout.cursors[first].glyph_count);
+            layout.cursors.resize(first + 1);
+
+            const float scale{ layout.pixel_height / glyph_atlas_t::k_base_pixel_height };
+            const uint32_t size_bits{ static_cast<uint32_t>(layout.pixel_height * 16.0f) << 16 };
 
-            for (; *text; ++text)
+            float x{ layout.cursors.back().x };
+            float y{ layout.cursors.back().y };
+            for (size_t i{ first }; i < layout.text.size();)
             {
-                if (*text == '\n')
+                const size_t start{ i };
+                const uint32_t codepoint{ decode_utf8(layout.text, i) };
+                if (codepoint == '\n')
                 {
                     x = start_x;
-                    y += k_font_pixel_height * 1.4f;
-                    continue;
+                    y += g_atlas.line_height() * scale;
                 }
-                if (static_cast<unsigned char>(*text) < k_first_char ||
-                    static_cast<unsigned char>(*text) >= k_first_char + k_char_count)
-                    continue;
-
-                const int idx{ *text - k_first_char };
-                stbtt_aligned_quad q;
-                stbtt_GetBakedQuad(reinterpret_cast<stbtt_bakedchar *>(g_glyphs), k_atlas_width, k_atlas_height,
-                                   idx, &x, &y, &q, 1);
-
-                const uint16_t base{ static_cast<uint16_t>(g_vertices.size()) };
-
-                g_vertices.push_back({ q.x0, q.y0, q.s0, q.t0 });
-                g_vertices.push_back({ q.x1, q.y0, q.s1, q.t0 });
-                g_vertices.push_back({ q.x1, q.y1, q.s1, q.t1 });
-                g_vertices.push_back({ q.x0, q.y1, q.s0, q.t1 });
-
-                g_indices.insert(g_indices.end(), {
-                                     static_cast<uint16_t>(base + 0), static_cast<uint16_t>(base + 1),
-                                     static_cast<uint16_t>(base + 2),
-                                     static_cast<uint16_t>(base + 0), static_cast<uint16_t>(base + 2),
-                                     static_cast<uint16_t>(base + 3)
-                                 });
+                else if (codepoint >= k_first_ascii)
+                {
+                    // The quad itself is built on the GPU; only the pen advances here
+                    if (const glyph_t* glyph{ g_atlas.acquire(codepoint, g_overlay_frame) })
+                    {
+                        layout.glyphs.push_back({ { x, y }, glyph->slot | size_bits, k_text_color });
+                        x += glyph->advance * scale;
+                    }
+                }
+
+                const layout_cursor_t cursor{ x, y, static_cast<uint32_t>(layout.glyphs.size()) };
+                layout.cursors.insert(layout.cursors.end(), i - start, cursor);
             }
         }
 
+        void queue_text(const float x, const float y, const float pixel_height, const std::string_view text)
+        {
+            // Position and size identify a call site. A second call with both equal within one frame probes on
+            // to its own entry instead of thrashing the first.
+            uint64_t key{ std::bit_cast<uint32_t>(x) | uint64_t{ std::bit_cast<uint32_t>(y) } << 32 };
+            key ^= std::bit_cast<uint32_t>(pixel_height) * 0x9E3779B97F4A7C15ull;
+            auto it{ g_layouts.find(key) };
+            while (it != g_layouts.end() && it->second.last_frame == g_overlay_frame)
+                it = g_layouts.find(key = key * 0x100000001B3ull + 1);
+
+            g_frame_keys.push_back(key);
+
+            // A position not drawn last frame is likely moving; caching it would only churn the map
+            if (it == g_layouts.end() && !std::ranges::binary_search(g_previous_keys, key))
+            {
+                if (g_scratch_used == g_scratch_layouts.size()) g_scratch_layouts.emplace_back();
+                text_layout_t& scratch{ g_scratch_layouts[g_scratch_used++] };
+                scratch.cursors.assign(1, { x, y, 0 });
+                scratch.pixel_height = pixel_height;
+                scratch.text = text;
+                layout_text(scratch, 0);
+                g_draw_list.push_back(&scratch);
+                return;
+            }
+
+            text_layout_t& layout{ g_layouts[key] };
+            if (layout.cursors.empty() || layout.generation != g_atlas.generation())
+            {
+                // New, or some slot it holds may now belong to another glyph
+                layout.cursors.assign(1, { x, y, 0 });
+                layout.pixel_height = pixel_height;
+                layout.text = text;
+                layout_text(layout, 0);
+            }
+            else if (layout.text != text)
+            {
+                size_t kept{
+                    static_cast<size_t>(std::ranges::mismatch(layout.text, text).in1 - layout.text.begin())
+                };
+                // Resume at the start of the UTF-8 sequence the difference falls into
+                while (kept > 0 && ((kept < text.size() && is_continuation(text[kept])) ||
+                                    (kept < layout.text.size() && is_continuation(layout.text[kept]))))
+                    --kept;
+
+                layout.text = text;
+                layout_text(layout, kept);
+            }
+            else
+            {
+                // Reused as it is; keeps its glyphs from being evicted while it is on screen
+                for (const glyph_instance_t& glyph: layout.glyphs)
+                    g_atlas.touch(glyph.glyph & 0xFFFF, g_overlay_frame);
+            }
+
+            layout.generation = g_atlas.generation();
+            layout.last_frame = g_overlay_frame;
+            g_draw_list.push_back(&layout);
+        }
+
+        // ── Primitive helpers, in overlay units
+        void fill_quad(const float (&corners)[4][2], const uint32_t color)
+        {
+            // Two triangles: 0 1 2, 0 2 3
+            for (const uint32_t i: { 0u, 1u, 2u, 0u, 2u, 3u })
+                g_fill_vertices.push_back({ { corners[i][0], corners[i][1], 0.f }, color });
+        }
+
+        void push_line_3d(const float (&from)[3], const float (&to)[3], const uint32_t color)
+        {
+            g_line_vertices.push_back({ { from[0], from[1], from[2] }, color });
+            g_line_vertices.push_back({ { to[0], to[1], to[2] }, color });
+        }
+
+        // Units from the top-left corner to NDC; Vulkan's y already points down
+        void units_to_clip(const canvas_t& canvas, float (&matrix)[16]) noexcept
+        {
+            std::ranges::fill(matrix, 0.f);
+            matrix[0] = 2.f / canvas.width;
+            matrix[5] = 2.f / canvas.height;
+            matrix[10] = 1.f;
+            matrix[12] = -1.f;
+            matrix[13] = -1.f;
+            matrix[15] = 1.f;
+        }
+
+        // 3D lines first so 2D panels cover them, text last
+        void draw_primitives(VkCommandBuffer cmd, const canvas_t& canvas)
+        {
+            const size_t vertex_count{ g_fill_vertices.size() + g_line_vertices.size() };
+            if (vertex_count == 0 || g_fill_pipeline == VK_NULL_HANDLE || g_line_pipeline == VK_NULL_HANDLE) return;
+
+            rhi::vulkan::vulkan_context_t* ctx{ rhi::vulkan::vulkan_context_t::get() };
+
+            // Both lists share one slice: lines first, fills after them
+            const rhi::vulkan::transient_slice_t vertices{
+                ctx->transient_ring().allocate(vertex_count * sizeof(primitive_vertex_t), alignof(primitive_vertex_t))
+            };
+            if (!vertices.is_valid()) return;
+
+            auto* out{ static_cast<primitive_vertex_t*>(vertices.data) };
+            std::ranges::copy(g_fill_vertices, std::ranges::copy(g_line_vertices, out).out);
+
+            vkCmdBindVertexBuffers(cmd, 0, 1, &vertices.buffer, &vertices.offset);
+
+            if (!g_line_vertices.empty())
+            {
+                vkCmdBindPipeline(cmd, VK_PIPELINE_BIND_POINT_GRAPHICS, g_line_pipeline);
+                vkCmdPushConstants(cmd, g_primitive_layout.pipeline_layout, g_primitive_layout.push_stages, 0,
+                                   sizeof(g_view_projection), g_view_projection);
+                vkCmdDraw(cmd, static_cast<uint32_t>(g_line_vertices.size()), 1, 0, 0);
+            }
+
+            if (!g_fill_vertices.empty())
+            {
+                float transform[16];
+                units_to_clip(canvas, transform);
+
+                vkCmdBindPipeline(cmd, VK_PIPELINE_BIND_POINT_GRAPHICS, g_fill_pipeline);
+                vkCmdPushConstants(cmd, g_primitive_layout.pipeline_layout, g_primitive_layout.push_stages, 0,
+                                   sizeof(transform), transform);
+                vkCmdDraw(cmd, static_cast<uint32_t>(g_fill_vertices.size()), 1,
+                          static_cast<uint32_t>(g_line_vertices.size()), 0);
+            }
+        }
+
+        void draw_text(VkCommandBuffer cmd, const canvas_t& canvas)
+        {
+            if (g_draw_list.empty() || !rhi::vulkan::vulkan_context_t::get()->uploads().is_complete(g_font_ticket))
+                return;
+
+            size_t glyph_count{ 0 };
+            for (const text_layout_t* layout: g_draw_list)
+                glyph_count += layout->glyphs.size();
+            if (glyph_count == 0 || !g_glyph_handle.is_valid()) return;
+
+            rhi::vulkan::vulkan_context_t* ctx{ rhi::vulkan::vulkan_context_t::get() };
+
+            // Instances live in this frame's slice of the transient ring, so the previous frame's draw is never
+            // overwritten while the GPU may still be reading it. The cached glyphs are copied straight into it.
+            const rhi::vulkan::transient_slice_t instances{
+                ctx->transient_ring().allocate(glyph_count * sizeof(glyph_instance_t), alignof(glyph_instance_t))
+            };
+            if (!instances.is_valid()) return;
+
+            auto* out{ static_cast<glyph_instance_t*>(instances.data) };
+            for (const text_layout_t* layout: g_draw_list)
+                out = std::ranges::copy(layout->glyphs, out).out;
+
+            // Matches the shaders' Push block
+            struct
+            {
+                float canvas[2];
+                uint32_t font_texture;
+                uint32_t font_sampler;
+                uint32_t glyph_metrics;
+                float base_pixel_height;
+            } const push{
+                { canvas.width, canvas.height }, g_font_texture_handle.index, g_font_sampler_handle.index,
+                g_glyph_handle.index, glyph_atlas_t::k_base_pixel_height
+            };
+            vkCmdPushConstants(cmd, g_text_layout.pipeline_layout, g_text_layout.push_stages, 0, sizeof(push), &push);
+
+            vkCmdBindVertexBuffers(cmd, 0, 1, &instances.buffer, &instances.offset);
+            vkCmdBindPipeline(cmd, VK_PIPELINE_BIND_POINT_GRAPHICS, g_pipeline);
+            ctx->bindless().bind(cmd, VK_PIPELINE_BIND_POINT_GRAPHICS, g_text_layout.pipeline_layout);
+
+            vkCmdDraw(cmd, 6, static_cast<uint32_t>(glyph_count), 0, 0);
+        }
+
+        // Called once per frame, whether or not anything was drawn
+        void end_overlay_frame()
+        {
+            g_draw_list.clear();
+            g_fill_vertices.clear();
+            g_line_vertices.clear();
+
+            g_scratch_used = 0;
+            std::ranges::sort(g_frame_keys);
+            std::swap(g_previous_keys, g_frame_keys);
+            g_frame_keys.clear();
+
+            if (++g_overlay_frame % k_layout_max_idle_frames == 0)
+            {
+                std::erase_if(g_layouts, [](const auto& entry) {
+                    return g_overlay_frame - entry.second.last_frame > k_layout_max_idle_frames;
+                });
+            }
+        }
+
+        void vtext(const float x, const float y, const float pixel_height, const char* fmt, va_list args) noexcept
+        {
+            // Glyph metrics only exist once the font is loaded; layouts made before that would be cached empty
+            if (!g_initialized) return;
+
+            char buffer[1024];
+            const int length{ vsnprintf(buffer, sizeof(buffer), fmt, args) };
+            if (length < 0) return;
+
+            queue_text(x, y, std::clamp(pixel_height, 1.0f, k_max_pixel_height),
+                       { buffer, std::min(static_cast<size_t>(length), sizeof(buffer) - 1) });
+        }
+
         renderer::renderer_t* _renderer{ nullptr };
     } // anonymous namespace
 
@@ -377,69 +671,36 @@ namespace carrot::debug {
     {
         _renderer = renderer;
 
-        FILE* f = fopen("assets/Fonts/Roboto-Regular.ttf", "rb");
-        if (!f)
+        std::ifstream file{ k_font_path, std::ios::binary };
+        if (!file.is_open())
         {
-            LOG_GRAPHICS_ERROR("Failed to open Roboto-Regular.ttf");
+            LOG_GRAPHICS_ERROR("Failed to open {}", k_font_path);
             return;
         }
+        std::vector<unsigned char> ttf{ std::istreambuf_iterator<char>{ file }, std::istreambuf_iterator<char>{ } };
 
-        fseek(f, 0, SEEK_END);
-        const size_t sz{ static_cast<size_t>(ftell(f)) };
-        fseek(f, 0, SEEK_SET);
-        g_ttf_buffer = new unsigned char[sz];
-        fread(g_ttf_buffer, 1, sz, f);
-        fclose(f);
-
-        g_atlas_pixels = new unsigned char[k_atlas_width * k_atlas_height];
-        stbtt_BakeFontBitmap(g_ttf_buffer, 0, k_font_pixel_height,
-                             g_atlas_pixels, k_atlas_width, k_atlas_height,
-                             k_first_char, k_char_count, reinterpret_cast<stbtt_bakedchar *>(g_glyphs));
+        // A glyph may be evicted once every frame that could have drawn it has completed
+        if (!g_atlas.init(std::move(ttf), rhi::vulkan::k_max_frames_in_flight)) return;
 
-        const rhi::vulkan::vulkan_context_t* ctx{ rhi::vulkan::vulkan_context_t::get() };
+        // Without a cache, ASCII is baked up front; anything else is baked the first time it is drawn
+        if (!g_atlas.load_cache(k_glyph_cache_path))
+        {
+            for (uint32_t codepoint{ k_first_ascii }; codepoint <= k_last_ascii; ++codepoint)
+                static_cast<void>(g_atlas.acquire(codepoint, 0));
+            g_atlas.clear_pending();
+        }
 
         create_font_texture();
-        create_descriptor_objects();
-        create_pipeline();
-
-        // After create_pipeline() — CREATE BUFFERS AFTER EVERYTHING ELSE EXISTS
-        constexpr VkDeviceSize vb_size{ 16 * 1024 * 1024 }; // 16 MiB
-        constexpr VkDeviceSize ib_size{ 8 * 1024 * 1024 }; // 8 MiB
-
-        // Vertex buffer
-        VkBufferCreateInfo buf_info{ };
-        buf_info.sType = VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO;
-        buf_info.size = vb_size;
-        buf_info.usage = VK_BUFFER_USAGE_VERTEX_BUFFER_BIT;
-        buf_info.sharingMode = VK_SHARING_MODE_EXCLUSIVE;
-        vkCreateBuffer(ctx->device(), &buf_info, nullptr, &g_vb);
-
-        VkMemoryRequirements mem_req;
-        vkGetBufferMemoryRequirements(ctx->device(), g_vb, &mem_req);
-
-        VkMemoryAllocateInfo alloc_info{ };
-        alloc_info.sType = VK_STRUCTURE_TYPE_MEMORY_ALLOCATE_INFO;
-        alloc_info.allocationSize = mem_req.size;
-        alloc_info.memoryTypeIndex = ctx->find_memory_type(mem_req.memoryTypeBits,
-                                                           VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT |
-                                                           VK_MEMORY_PROPERTY_HOST_COHERENT_BIT);
-
-        vkAllocateMemory(ctx->device(), &alloc_info, nullptr, &g_vb_mem);
-        vkBindBufferMemory(ctx->device(), g_vb, g_vb_mem, 0);
-
-        // Index buffer
-        buf_info.size = ib_size;
-        buf_info.usage = VK_BUFFER_USAGE_INDEX_BUFFER_BIT;
-        vkCreateBuffer(ctx->device(), &buf_info, nullptr, &g_ib);
-
-        vkGetBufferMemoryRequirements(ctx->device(), g_ib, &mem_req);
-        alloc_info.allocationSize = mem_req.size;
-        alloc_info.memoryTypeIndex = ctx->find_memory_type(mem_req.memoryTypeBits,
-                                                           VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT |
-                                                           VK_MEMORY_PROPERTY_HOST_COHERENT_BIT);
-
-        vkAllocateMemory(ctx->device(), &alloc_info, nullptr, &g_ib_mem);
-        vkBindBufferMemory(ctx->device(), g_ib, g_ib_mem, 0);
+        create_glyph_metrics();
+        create_text_pipeline();
+        create_primitive_pipelines();
+
+        auto* vulkan_renderer{ static_cast<rhi::vulkan::vulkan_renderer_t *>(renderer) };
+        vulkan_renderer->register_pipeline({ "debug_overlay.vert.spv", "debug_overlay.frag.spv" },
+                                           rhi::vulkan::pipeline_rebuild_delegate_t::bind<&rebuild_text_pipeline>());
+        vulkan_renderer->register_pipeline(
+            { "debug_primitive.vert.spv", "debug_primitive.frag.spv" },
+            rhi::vulkan::pipeline_rebuild_delegate_t::bind<&rebuild_primitive_pipelines>());
 
         g_initialized = true; // ← SET THIS AT THE END
         LOG_GRAPHICS_INFO("DEBUG OVERLAY FULLY INITIALIZED — READY TO RENDER");
@@ -447,56 +708,84 @@ namespace carrot::debug {
 
     void shutdown() noexcept
     {
-        const rhi::vulkan::vulkan_context_t* ctx{ rhi::vulkan::vulkan_context_t::get() };
+        rhi::vulkan::vulkan_context_t* ctx{ rhi::vulkan::vulkan_context_t::get() };
         vkDeviceWaitIdle(ctx->device());
 
         vkDestroyPipeline(ctx->device(), g_pipeline, nullptr);
-        vkDestroyPipelineLayout(ctx->device(), g_pipeline_layout, nullptr);
-        vkDestroyDescriptorSetLayout(ctx->device(), g_desc_layout, nullptr);
-        vkDestroyDescriptorPool(ctx->device(), g_desc_pool, nullptr);
+        vkDestroyPipeline(ctx->device(), g_fill_pipeline, nullptr);
+        vkDestroyPipeline(ctx->device(), g_line_pipeline, nullptr);
+        ctx->bindless().release(g_font_texture_handle);
+        ctx->bindless().release(g_font_sampler_handle);
+        ctx->bindless().release(g_glyph_handle);
+        ctx->destroy_buffer(g_glyph_buffer, g_glyph_memory);
         vkDestroySampler(ctx->device(), g_font_sampler, nullptr);
         vkDestroyImageView(ctx->device(), g_font_view, nullptr);
-        vkDestroyImage(ctx->device(), g_font_image, nullptr);
-        vkFreeMemory(ctx->device(), g_font_memory, nullptr);
-        vkDestroyBuffer(ctx->device(), g_vb, nullptr);
-        vkFreeMemory(ctx->device(), g_vb_mem, nullptr);
-        vkDestroyBuffer(ctx->device(), g_ib, nullptr);
-        vkFreeMemory(ctx->device(), g_ib_mem, nullptr);
-
-        delete[] g_ttf_buffer;
-        delete[] g_atlas_pixels;
+        ctx->allocator().destroy_image(g_font_image, g_font_memory);
+
+        if (!g_atlas.save_cache(k_glyph_cache_path))
+            LOG_GRAPHICS_WARN("Failed to write the glyph cache {}", k_glyph_cache_path);
+        g_atlas.shutdown();
+
+        g_layouts.clear();
+        g_scratch_layouts.clear();
+        g_scratch_used = 0;
+        g_frame_keys.clear();
+        g_previous_keys.clear();
+        g_draw_list.clear();
+        g_glyph_copies.clear();
+        g_fill_vertices.clear();
+        g_line_vertices.clear();
+        g_initialized = false;
     }
 
-    void render(void* cmd_buffer) noexcept
+    uint32_t add_passes(void* render_graph) noexcept
     {
-        if (g_vertices.empty()) return;
+        // Taken once per frame on the render thread, before any recording job reads it
+        const VkExtent2D extent{ rhi::vulkan::vulkan_context_t::get()->swapchain_extent() };
+        g_canvas = { static_cast<float>(extent.width) / g_ui_scale, static_cast<float>(extent.height) / g_ui_scale };
 
-        const rhi::vulkan::vulkan_context_t* ctx{ rhi::vulkan::vulkan_context_t::get() };
-        VkCommandBuffer cmd{ static_cast<VkCommandBuffer>(cmd_buffer) };
+        // Until the initial atlas upload has landed the image belongs to the upload service
+        if (!g_initialized || !rhi::vulkan::vulkan_context_t::get()->uploads().is_complete(g_font_ticket))
+            return ~0u;
 
-        constexpr float resolution[2]{ 1280.0f, 720.0f };
-        vkCmdPushConstants(cmd, g_pipeline_layout, VK_SHADER_STAGE_VERTEX_BIT, 0, sizeof(resolution), resolution);
+        stage_glyph_uploads();
 
-        // Upload real text geometry
-        void* data;
-        vkMapMemory(ctx->device(), g_vb_mem, 0, g_vertices.size() * sizeof(vertex_t), 0, &data);
-        memcpy(data, g_vertices.data(), g_vertices.size() * sizeof(vertex_t));
-        vkUnmapMemory(ctx->device(), g_vb_mem);
+        auto& graph{ *static_cast<rhi::vulkan::render_graph_t*>(render_graph) };
 
-        vkMapMemory(ctx->device(), g_ib_mem, 0, g_indices.size() * sizeof(uint16_t), 0, &data);
-        memcpy(data, g_indices.data(), g_indices.size() * sizeof(uint16_t));
-        vkUnmapMemory(ctx->device(), g_ib_mem);
+        rhi::vulkan::rg_imported_texture_t atlas{ };
+        atlas.image = g_font_image;
+        atlas.view = g_font_view;
+        atlas.format = VK_FORMAT_R8_UNORM;
+        atlas.extent = { glyph_atlas_t::k_width, glyph_atlas_t::k_height };
+        atlas.initial = { VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL, VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT,
+                          VK_ACCESS_SHADER_READ_BIT };
+        atlas.final = atlas.initial;
+        g_rg_atlas = graph.import_texture("glyph_atlas", atlas).index;
 
-        constexpr VkDeviceSize offset{ 0 };
-        vkCmdBindVertexBuffers(cmd, 0, 1, &g_vb, &offset);
-        vkCmdBindIndexBuffer(cmd, g_ib, 0, VK_INDEX_TYPE_UINT16);
-        vkCmdBindPipeline(cmd, VK_PIPELINE_BIND_POINT_GRAPHICS, g_pipeline);
-        vkCmdBindDescriptorSets(cmd, VK_PIPELINE_BIND_POINT_GRAPHICS, g_pipeline_layout, 0, 1, &g_desc_set, 0, nullptr);
+        // Always declared, even when nothing was baked, so the graph topology stays stable
+        graph.add_pass("glyph_upload", rhi::vulkan::record_delegate_t::bind<&record_glyph_upload>())
+             .use({ g_rg_atlas }, rhi::vulkan::rg_access::transfer_write);
 
-        vkCmdDrawIndexed(cmd, static_cast<uint32_t>(g_indices.size()), 1, 0, 0, 0);
+        return g_rg_atlas;
+    }
 
-        g_vertices.clear();
-        g_indices.clear();
+    void set_view_projection(const float* matrix) noexcept
+    {
+        std::copy_n(matrix, 16, g_view_projection);
+    }
+
+    void render(void* cmd_buffer) noexcept
+    {
+        CE_PROFILE_ZONE("debug_overlay");
+
+        VkCommandBuffer cmd{ static_cast<VkCommandBuffer>(cmd_buffer) };
+        if (g_canvas.width > 0.f && g_canvas.height > 0.f)
+        {
+            draw_primitives(cmd, g_canvas);
+            draw_text(cmd, g_canvas);
+        }
+
+        end_overlay_frame();
     }
 
     bool is_initialized() noexcept
@@ -504,14 +793,138 @@ namespace carrot::debug {
         return g_initialized;
     }
 
+    void set_ui_scale(const float scale) noexcept
+    {
+        if (scale > 0.f) g_ui_scale = scale;
+    }
+
+    float ui_scale() noexcept
+    {
+        return g_ui_scale;
+    }
+
+    canvas_t canvas() noexcept
+    {
+        return g_canvas;
+    }
+
     void text(float x, float y, const char* fmt, ...) noexcept
     {
-        char buffer[1024];
         va_list args;
         va_start(args, fmt);
-        vsnprintf(buffer, sizeof(buffer), fmt, args);
+        vtext(x, y, k_default_pixel_height, fmt, args);
         va_end(args);
+    }
+
+    void text(float x, float y, float size, const char* fmt, ...) noexcept
+    {
+        va_list args;
+        va_start(args, fmt);
+        vtext(x, y, size, fmt, args);
+        va_end(args);
+    }
+
+#ifndef CARROT_SHIPPING
+    void line(const float x0, const float y0, const float x1, const float y1, const uint32_t color,
+              const float thickness) noexcept
+    {
+        if (!g_initialized) return;
+
+        const float length{ std::hypot(x1 - x0, y1 - y0) };
+        if (length <= 0.f) return;
+
+        // Widened along the normal, centred on the line
+        const float nx{ (y0 - y1) / length * thickness * 0.5f };
+        const float ny{ (x1 - x0) / length * thickness * 0.5f };
+        fill_quad({ { x0 + nx, y0 + ny }, { x1 + nx, y1 + ny }, { x1 - nx, y1 - ny }, { x0 - nx, y0 - ny } }, color);
+    }
+
+    void rect(const float x, const float y, const float width, const float height, const uint32_t color,
+              const float thickness) noexcept
+    {
+        // Drawn inside the box, the sides fit between top and bottom so no pixel is blended twice
+        const float t{ std::min({ thickness, width * 0.5f, height * 0.5f }) };
+        filled_rect(x, y, width, t, color);
+        filled_rect(x, y + height - t, width, t, color);
+        filled_rect(x, y + t, t, height - 2.f * t, color);
+        filled_rect(x + width - t, y + t, t, height - 2.f * t, color);
+    }
 
-        rasterize_text(x, y, buffer);
+    void filled_rect(const float x, const float y, const float width, const float height,
+                     const uint32_t color) noexcept
+    {
+        if (!g_initialized || width <= 0.f || height <= 0.f) return;
+
+        fill_quad({ { x, y }, { x + width, y }, { x + width, y + height }, { x, y + height } }, color);
+    }
+
+    void circle(const float x, const float y, const float radius, const uint32_t color,
+                const float thickness) noexcept
+    {
+        if (!g_initialized || radius <= 0.f) return;
+
+        // A ring of quads between the inner and outer edge, so thick outlines have no gaps at the joints
+        const uint32_t segments{ std::clamp(static_cast<uint32_t>(radius), 12u, 64u) };
+        const float inner{ std::max(radius - thickness * 0.5f, 0.f) };
+        const float outer{ radius + thickness * 0.5f };
+        const float step{ 2.f * std::numbers::pi_v<float> / static_cast<float>(segments) };
+
+        float c0{ 1.f }, s0{ 0.f };
+        for (uint32_t i{ 1 }; i <= segments; ++i)
+        {
+            const float c1{ std::cos(step * static_cast<float>(i)) };
+            const float s1{ std::sin(step * static_cast<float>(i)) };
+            fill_quad({ { x + c0 * inner, y + s0 * inner }, { x + c0 * outer, y + s0 * outer },
+                        { x + c1 * outer, y + s1 * outer }, { x + c1 * inner, y + s1 * inner } }, color);
+            c0 = c1;
+            s0 = s1;
+        }
+    }
+
+    void line_3d(const float (&from)[3], const float (&to)[3], const uint32_t color) noexcept
+    {
+        if (!g_initialized) return;
+
+        push_line_3d(from, to, color);
+    }
+
+    void aabb(const float (&min)[3], const float (&max)[3], const uint32_t color) noexcept
+    {
+        if (!g_initialized) return;
+
+        // Corner i takes max on the axes whose bit is set
+        float corners[8][3];
+        for (uint32_t i{ 0 }; i < 8; ++i)
+            for (uint32_t axis{ 0 }; axis < 3; ++axis)
+                corners[i][axis] = (i >> axis & 1) ? max[axis] : min[axis];
+
+        // Every edge joins two corners differing in one axis
+        for (uint32_t i{ 0 }; i < 8; ++i)
+            for (uint32_t axis{ 0 }; axis < 3; ++axis)
+                if ((i >> axis & 1) == 0) push_line_3d(corners[i], corners[i | 1u << axis], color);
+    }
+
+    void graph(const float x, const float y, const float width, const float height, const sample_ring_t& samples,
+               const float max_value, const uint32_t color) noexcept
+    {
+        if (!g_initialized || max_value <= 0.f) return;
+
+        filled_rect(x, y, width, height, rgba(0, 0, 0, 160));
+
+        // Newest sample on the right edge; a ring that is not full yet starts part-way in
+        const float step{ width / static_cast<float>(sample_ring_t::k_capacity - 1) };
+        const auto point = [&](const uint32_t i) {
+            const float value{ std::clamp(samples[i] / max_value, 0.f, 1.f) };
+            return std::array{ x + width - step * static_cast<float>(samples.size() - 1 - i),
+                               y + height - value * height };
+        };
+
+        for (uint32_t i{ 1 }; i < samples.size(); ++i)
+        {
+            const auto [x0, y0]{ point(i - 1) };
+            const auto [x1, y1]{ point(i) };
+            line(x0, y0, x1, y1, color);
+        }
     }
+#endif
 } // namespace carrot::debug
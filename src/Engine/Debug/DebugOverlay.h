@@ -7,13 +7,97 @@
 
 #include "Renderer/Renderer.h"
 
+#include <algorithm>
+#include <array>
+#include <cstdint>
+
 namespace carrot::debug {
     void init(renderer::renderer_t* renderer) noexcept;
     void shutdown() noexcept;
+    // Declares the glyph atlas upload for this frame and returns the atlas' render graph resource, which the pass
+    // calling render() has to sample. ~0u while the overlay is not ready to draw
+    uint32_t add_passes(void* render_graph) noexcept;
+    // Camera for the 3D primitives, column-major like the scene's
+    void set_view_projection(const float* matrix) noexcept;
     void render(void* cmd_buffer) noexcept; // call every frame after scene
 
     bool is_initialized() noexcept;
 
-    // Immediate-mode printf-style text
+    // Everything below is placed in overlay units from the top-left corner. One unit is `scale` framebuffer
+    // pixels; the scale is only what the user configured, the output's scale is not queried. The canvas follows
+    // the live swapchain extent, so resizing never stretches it.
+    struct canvas_t
+    {
+        float width{ 0.f };
+        float height{ 0.f };
+    };
+
+    void set_ui_scale(float scale) noexcept;
+    [[nodiscard]] float ui_scale() noexcept;
+    // Swapchain extent in units, as of the last frame rendered
+    [[nodiscard]] canvas_t canvas() noexcept;
+
+    // Immediate-mode printf-style text, UTF-8, with the baseline at y. Glyphs missing from the atlas are baked the
+    // first time they are drawn. `size` is the font's pixel height at a ui_scale() of 1, 32 by default
     void text(float x, float y, const char* fmt, ...) noexcept;
+    void text(float x, float y, float size, const char* fmt, ...) noexcept;
+
+    // RGBA8, red in the low byte
+    [[nodiscard]] constexpr uint32_t rgba(const uint8_t r, const uint8_t g, const uint8_t b,
+                                          const uint8_t a = 255) noexcept
+    {
+        return uint32_t{ r } | uint32_t{ g } << 8 | uint32_t{ b } << 16 | uint32_t{ a } << 24;
+    }
+
+    // Fixed-size history for graph(); once full, every push() overwrites the oldest sample
+    class sample_ring_t
+    {
+    public:
+        static constexpr uint32_t k_capacity{ 256 };
+
+        void push(const float value) noexcept
+        {
+            _samples[_head] = value;
+            _head = (_head + 1) % k_capacity;
+            _count = std::min(_count + 1, k_capacity);
+        }
+
+        [[nodiscard]] uint32_t size() const noexcept { return _count; }
+        // Oldest first
+        [[nodiscard]] float operator[](const uint32_t i) const noexcept
+        {
+            return _samples[(_head + k_capacity - _count + i) % k_capacity];
+        }
+
+    private:
+        std::array<float, k_capacity>   _samples{ };
+        uint32_t                        _head{ 0 };
+        uint32_t                        _count{ 0 };
+    };
+
+    // Immediate-mode primitives, drawn below the text. Coordinates are overlay units, except for the 3D ones,
+    // which go through set_view_projection(). Shipping builds compile them out.
+#ifndef CARROT_SHIPPING
+    void line(float x0, float y0, float x1, float y1, uint32_t color, float thickness = 1.f) noexcept;
+    void rect(float x, float y, float width, float height, uint32_t color, float thickness = 1.f) noexcept;
+    void filled_rect(float x, float y, float width, float height, uint32_t color) noexcept;
+    void circle(float x, float y, float radius, uint32_t color, float thickness = 1.f) noexcept;
+
+    void line_3d(const float (&from)[3], const float (&to)[3], uint32_t color) noexcept;
+    void aabb(const float (&min)[3], const float (&max)[3], uint32_t color) noexcept;
+
+    // Plots `samples` oldest to newest over the box, scaled so `max_value` reaches the top
+    void graph(float x, float y, float width, float height, const sample_ring_t& samples, float max_value,
+               uint32_t color) noexcept;
+#else
+    inline void line(float, float, float, float, uint32_t, float = 1.f) noexcept {}
+    inline void rect(float, float, float, float, uint32_t, float = 1.f) noexcept {}
+    inline void filled_rect(float, float, float, float, uint32_t) noexcept {}
+    inline void circle(float, float, float, uint32_t, float = 1.f) noexcept {}
+
+    inline void line_3d(const float (&)[3], const float (&)[3], uint32_t) noexcept {}
+    inline void aabb(const float (&)[3], const float (&)[3], uint32_t) noexcept {}
+
+    inline void graph(float, float, float, float, const sample_ring_t&, float, uint32_t) noexcept {}
+#endif
 } // namespace carrot::debug
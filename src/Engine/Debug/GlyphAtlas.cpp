@@ -0,0 +1,333 @@
+//
+// Created by zshrout on 10/18/26.
+// Copyright (c) 2026 BunnySofty. All rights reserved.
+//
+
+#include "GlyphAtlas.h"
+
+#include "Utils/MappedFile.h"
+#include "Common/CommonHeaders.h"
+
+#define STB_TRUETYPE_IMPLEMENTATION
+#include <stb_truetype.h>
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <type_traits>
+
+namespace carrot::debug {
+    namespace {
+        constexpr uint32_t k_no_slot{ ~0u };
+
+        // Distance field: `k_sdf_padding` pixels of falloff around the outline, the outline itself at 128
+        constexpr int k_sdf_padding{ 6 };
+        constexpr unsigned char k_sdf_on_edge{ 128 };
+        constexpr float k_sdf_distance_scale{ 128.f / k_sdf_padding };
+
+        constexpr uint32_t k_gutter{ 1 };   // empty texels between cells, so filtering never reads a neighbour
+
+        // A shelf taller than this many times the glyph wastes too much space; a new one is opened instead
+        constexpr uint32_t k_shelf_waste_ratio{ 2 };
+
+        constexpr uint32_t k_cache_magic{ 0x46445343 }; // "CSDF"
+        constexpr uint32_t k_cache_version{ 1 };
+
+        struct cache_header_t
+        {
+            uint32_t    magic{ k_cache_magic };
+            uint32_t    version{ k_cache_version };
+            uint64_t    font_hash{ 0 };
+            uint32_t    width{ glyph_atlas_t::k_width };
+            uint32_t    height{ glyph_atlas_t::k_height };
+            float       base_pixel_height{ glyph_atlas_t::k_base_pixel_height };
+            int32_t     sdf_padding{ k_sdf_padding };
+            uint32_t    shelf_count{ 0 };
+            uint32_t    slot_count{ 0 };
+        };
+
+        [[nodiscard]] uint64_t hash_bytes(const std::span<const unsigned char> bytes) noexcept
+        {
+            uint64_t hash{ 0xCBF29CE484222325ull }; // FNV-1a
+            for (const unsigned char byte: bytes)
+                hash = (hash ^ byte) * 0x100000001B3ull;
+            return hash;
+        }
+
+        template<typename T>
+        void write_array(std::ofstream& file, const std::span<const T> values)
+        {
+            static_assert(std::is_trivially_copyable_v<T>);
+            file.write(reinterpret_cast<const char*>(values.data()), static_cast<std::streamsize>(values.size_bytes()));
+        }
+
+        // Copies `count` elements out of `bytes` and advances past them; false when the file is too short
+        template<typename T>
+        [[nodiscard]] bool read_array(std::span<const std::byte>& bytes, T* values, const size_t count) noexcept
+        {
+            static_assert(std::is_trivially_copyable_v<T>);
+            if (bytes.size() < count * sizeof(T)) return false;
+
+            std::memcpy(values, bytes.data(), count * sizeof(T));
+            bytes = bytes.subspan(count * sizeof(T));
+            return true;
+        }
+    } // anonymous namespace
+
+    // PUBLIC
+    bool glyph_atlas_t::init(std::vector<unsigned char> ttf, const uint64_t eviction_delay)
+    {
+        _ttf = std::move(ttf);
+        const int offset{ _ttf.empty() ? -1 : stbtt_GetFontOffsetForIndex(_ttf.data(), 0) };
+        if (offset < 0 || !stbtt_InitFont(&_font, _ttf.data(), offset))
+        {
+            LOG_GRAPHICS_ERROR("[Debug] Not a TrueType font, the overlay has no glyphs");
+            return false;
+        }
+
+        _scale = stbtt_ScaleForPixelHeight(&_font, k_base_pixel_height);
+        int ascent{ 0 }, descent{ 0 }, line_gap{ 0 };
+        stbtt_GetFontVMetrics(&_font, &ascent, &descent, &line_gap);
+        _line_height = static_cast<float>(ascent - descent + line_gap) * _scale;
+
+        _font_hash = hash_bytes(_ttf);
+        _eviction_delay = eviction_delay;
+        _pixels.assign(size_t{ k_width } * k_height, 0);
+        return true;
+    }
+
+    void glyph_atlas_t::shutdown() noexcept
+    {
+        *this = { };
+    }
+
+    bool glyph_atlas_t::load_cache(const std::filesystem::path& path)
+    {
+        utils::mapped_file_t file;
+        if (!file.open(path.string())) return false;
+
+        std::span<const std::byte> bytes{ file.bytes() };
+        cache_header_t header{ };
+        const cache_header_t expected{ .font_hash = _font_hash };
+        if (!read_array(bytes, &header, 1) || header.magic != expected.magic || header.version != expected.version ||
+            header.font_hash != expected.font_hash || header.width != expected.width ||
+            header.height != expected.height || header.base_pixel_height != expected.base_pixel_height ||
+            header.sdf_padding != expected.sdf_padding || header.slot_count > k_max_glyphs ||
+            header.shelf_count > k_height)
+        {
+            LOG_GRAPHICS_INFO("[Debug] Glyph cache {} is stale, glyphs are baked again", path.string());
+            return false;
+        }
+
+        std::vector<shelf_t> shelves(header.shelf_count);
+        std::vector<slot_t> slots(header.slot_count);
+        std::vector<glyph_metrics_t> metrics(header.slot_count);
+        pixel_buffer_t pixels(_pixels.size());
+        if (!read_array(bytes, shelves.data(), shelves.size()) || !read_array(bytes, slots.data(), slots.size()) ||
+            !read_array(bytes, metrics.data(), metrics.size()) || !read_array(bytes, pixels.data(), pixels.size()))
+        {
+            LOG_GRAPHICS_WARN("[Debug] Glyph cache {} is truncated", path.string());
+            return false;
+        }
+
+        // Cells are written into the atlas at these coordinates, so a corrupt file must not point outside it
+        const bool shelves_inside{
+            std::ranges::all_of(shelves, [](const shelf_t& shelf) {
+                return shelf.y <= k_height && shelf.height <= k_height - shelf.y && shelf.next_x <= k_width;
+            })
+        };
+        bool slots_inside{ shelves_inside };
+        for (uint32_t slot{ 0 }; slot < slots.size() && slots_inside; ++slot)
+        {
+            const slot_t& entry{ slots[slot] };
+            slots_inside = entry.glyph.slot == slot && entry.x <= k_width && entry.cell_width <= k_width - entry.x &&
+                           entry.y <= k_height && entry.cell_height <= k_height - entry.y;
+        }
+        if (!slots_inside)
+        {
+            LOG_GRAPHICS_WARN("[Debug] Glyph cache {} is corrupt, glyphs are baked again", path.string());
+            return false;
+        }
+
+        _shelves = std::move(shelves);
+        _slots = std::move(slots);
+        _metrics = std::move(metrics);
+        _pixels = std::move(pixels);
+
+        _lookup.clear();
+        for (uint32_t slot{ 0 }; slot < _slots.size(); ++slot)
+        {
+            _slots[slot].last_used = 0;
+            _lookup[_slots[slot].codepoint] = slot;
+        }
+
+        // Everything is uploaded whole from pixels() and metrics()
+        clear_pending();
+        LOG_GRAPHICS_INFO("[Debug] Loaded {} cached glyphs from {}", _slots.size(), path.string());
+        return true;
+    }
+
+    bool glyph_atlas_t::save_cache(const std::filesystem::path& path) const
+    {
+        if (_ttf.empty()) return false;
+
+        std::error_code ec;
+        std::filesystem::create_directories(path.parent_path(), ec);
+
+        std::ofstream file{ path, std::ios::binary | std::ios::trunc };
+        if (!file.is_open()) return false;
+
+        cache_header_t header{ };
+        header.font_hash = _font_hash;
+        header.shelf_count = static_cast<uint32_t>(_shelves.size());
+        header.slot_count = static_cast<uint32_t>(_slots.size());
+
+        write_array(file, std::span<const cache_header_t>{ &header, 1 });
+        write_array(file, std::span<const shelf_t>{ _shelves });
+        write_array(file, std::span<const slot_t>{ _slots });
+        write_array(file, std::span<const glyph_metrics_t>{ _metrics });
+        write_array(file, std::span<const unsigned char>{ _pixels });
+        return file.good();
+    }
+
+    const glyph_t* glyph_atlas_t::acquire(const uint32_t codepoint, const uint64_t frame)
+    {
+        if (const auto it{ _lookup.find(codepoint) }; it != _lookup.end())
+        {
+            slot_t& slot{ _slots[it->second] };
+            slot.last_used = frame;
+            return &slot.glyph;
+        }
+
+        if (_ttf.empty()) return nullptr;
+
+        // Characters the font lacks show up as '?'
+        const int index{ stbtt_FindGlyphIndex(&_font, static_cast<int>(codepoint)) };
+        if (index == 0) return codepoint == '?' ? nullptr : acquire('?', frame);
+
+        int advance{ 0 }, bearing{ 0 };
+        stbtt_GetGlyphHMetrics(&_font, index, &advance, &bearing);
+
+        // Null for glyphs without an outline, such as the space; they still get a slot, with an empty cell
+        int width{ 0 }, height{ 0 }, offset_x{ 0 }, offset_y{ 0 };
+        unsigned char* bitmap{
+            stbtt_GetGlyphSDF(&_font, _scale, index, k_sdf_padding, k_sdf_on_edge, k_sdf_distance_scale, &width,
+                              &height, &offset_x, &offset_y)
+        };
+        if (bitmap == nullptr) width = height = 0;
+
+        const auto w{ static_cast<uint32_t>(width) };
+        const auto h{ static_cast<uint32_t>(height) };
+
+        uint32_t slot{ k_no_slot };
+        uint32_t x{ 0 }, y{ 0 };
+        if (_slots.size() < k_max_glyphs && (w == 0 || pack(w, h, x, y)))
+        {
+            slot = static_cast<uint32_t>(_slots.size());
+            _slots.push_back({ 0, x, y, w, h, { }, 0 });
+            _metrics.emplace_back();
+        }
+        else
+            slot = evict(w, h, frame);
+
+        if (slot != k_no_slot)
+        {
+            slot_t& entry{ _slots[slot] };
+            entry.codepoint = codepoint;
+            entry.glyph = { slot, static_cast<float>(advance) * _scale };
+            entry.last_used = frame;
+            _lookup[codepoint] = slot;
+
+            store(slot, bitmap, w, h, static_cast<float>(offset_x), static_cast<float>(offset_y));
+        }
+
+        if (bitmap != nullptr) stbtt_FreeSDF(bitmap, nullptr);
+        return slot != k_no_slot ? &_slots[slot].glyph : nullptr;
+    }
+
+    void glyph_atlas_t::clear_pending() noexcept
+    {
+        _dirty_slots.clear();
+        _uploads.clear();
+        _upload_pixels.clear();
+    }
+
+    // PRIVATE
+    bool glyph_atlas_t::pack(const uint32_t width, const uint32_t height, uint32_t& x, uint32_t& y)
+    {
+        const uint32_t cell_width{ width + k_gutter };
+        const uint32_t cell_height{ height + k_gutter };
+
+        // Best fit: the lowest shelf the glyph fits on
+        shelf_t* best{ nullptr };
+        for (shelf_t& shelf: _shelves)
+        {
+            if (shelf.height < cell_height || shelf.next_x + cell_width > k_width) continue;
+            if (best == nullptr || shelf.height < best->height) best = &shelf;
+        }
+
+        const uint32_t free_y{ _shelves.empty() ? 0 : _shelves.back().y + _shelves.back().height };
+        const bool can_open{ free_y + cell_height <= k_height };
+        if ((best == nullptr || best->height > cell_height * k_shelf_waste_ratio) && can_open)
+            best = &_shelves.emplace_back(shelf_t{ free_y, cell_height, 0 });
+
+        if (best == nullptr) return false;
+
+        x = best->next_x;
+        y = best->y;
+        best->next_x += cell_width;
+        return true;
+    }
+
+    uint32_t glyph_atlas_t::evict(const uint32_t width, const uint32_t height, const uint64_t frame)
+    {
+        // The least recently used cell that is large enough and no longer read by any frame in flight
+        uint32_t victim{ k_no_slot };
+        for (uint32_t slot{ 0 }; slot < _slots.size(); ++slot)
+        {
+            const slot_t& candidate{ _slots[slot] };
+            if (candidate.last_used + _eviction_delay >= frame || candidate.cell_width < width ||
+                candidate.cell_height < height)
+                continue;
+
+            if (victim == k_no_slot || candidate.last_used < _slots[victim].last_used) victim = slot;
+        }
+
+        if (victim == k_no_slot) return k_no_slot;
+
+        _lookup.erase(_slots[victim].codepoint);
+        ++_generation;
+        return victim;
+    }
+
+    void glyph_atlas_t::store(const uint32_t slot, const unsigned char* bitmap, const uint32_t width,
+                              const uint32_t height, const float offset_x, const float offset_y)
+    {
+        const slot_t& entry{ _slots[slot] };
+
+        // The whole cell is rewritten, so nothing of an evicted, larger glyph is left around the new one
+        if (entry.cell_width != 0 && entry.cell_height != 0)
+        {
+            _uploads.push_back({ entry.x, entry.y, entry.cell_width, entry.cell_height, _upload_pixels.size() });
+            for (uint32_t row{ 0 }; row < entry.cell_height; ++row)
+            {
+                unsigned char* dst{ &_pixels[size_t{ entry.y + row } * k_width + entry.x] };
+                std::fill_n(dst, entry.cell_width, 0);
+                if (row < height) std::copy_n(bitmap + size_t{ row } * width, width, dst);
+
+                _upload_pixels.insert(_upload_pixels.end(), dst, dst + entry.cell_width);
+            }
+        }
+
+        constexpr float inv_width{ 1.f / k_width };
+        constexpr float inv_height{ 1.f / k_height };
+        _metrics[slot] = {
+            { offset_x, offset_y },
+            { static_cast<float>(width), static_cast<float>(height) },
+            {
+                static_cast<float>(entry.x) * inv_width, static_cast<float>(entry.y) * inv_height,
+                static_cast<float>(entry.x + width) * inv_width, static_cast<float>(entry.y + height) * inv_height
+            }
+        };
+        _dirty_slots.push_back(slot);
+    }
+} // namespace carrot::debug
@@ -0,0 +1,129 @@
+//
+// Created by zshrout on 10/18/26.
+// Copyright (c) 2026 BunnySofty. All rights reserved.
+//
+
+#pragma once
+
+#include "Memory/HeapAllocator.h"
+
+#include <cstdint>
+#include <filesystem>
+#include <span>
+#include <unordered_map>
+#include <vector>
+
+#include <stb_truetype.h>
+
+namespace carrot::debug {
+    // Mirrors GlyphMetrics in shaders/debug_overlay.vert (std430). Offset and size are in pixels at
+    // glyph_atlas_t::k_base_pixel_height; the shader scales them to the requested text size.
+    struct glyph_metrics_t
+    {
+        float offset[2];    // top-left corner relative to the pen
+        float size[2];
+        float uv_rect[4];   // u0, v0, u1, v1
+    };
+    static_assert(sizeof(glyph_metrics_t) == 32);
+
+    // A region of the atlas to copy from pending_pixels(), tightly packed from `offset` on
+    struct glyph_upload_t
+    {
+        uint32_t    x{ 0 };
+        uint32_t    y{ 0 };
+        uint32_t    width{ 0 };
+        uint32_t    height{ 0 };
+        size_t      offset{ 0 };
+    };
+
+    struct glyph_t
+    {
+        uint32_t    slot{ 0 };      // index into metrics(), what the shader is handed
+        float       advance{ 0.f }; // pixels at k_base_pixel_height
+    };
+
+    // Signed-distance-field glyph cache over one R8 texture. Glyphs are baked on first use at a single base size
+    // and drawn at any size from it, since the distance field stays sharp when scaled. They are packed on shelves
+    // of similar height; when the atlas is full, the least recently used glyph whose cell is large enough is
+    // evicted, but only once no frame in flight can still sample it. The atlas (pixels, glyph table and shelves)
+    // is written to disk on shutdown and read back on startup, so glyphs are only baked once per font.
+    class glyph_atlas_t
+    {
+    public:
+        static constexpr uint32_t   k_width{ 1024 };
+        static constexpr uint32_t   k_height{ 1024 };
+        static constexpr uint32_t   k_max_glyphs{ 4096 };
+        static constexpr float      k_base_pixel_height{ 32.f };
+
+        // `eviction_delay` is the number of frames a glyph has to go unused before its cell may be reused
+        [[nodiscard]] bool init(std::vector<unsigned char> ttf, uint64_t eviction_delay);
+        void shutdown() noexcept;
+
+        // Both are keyed on the font's contents; a cache of another font or format version is ignored
+        [[nodiscard]] bool load_cache(const std::filesystem::path& path);
+        [[nodiscard]] bool save_cache(const std::filesystem::path& path) const;
+
+        // Bakes and packs the glyph on first use and marks it used in `frame`. Null when the font has no such
+        // glyph or it cannot be placed this frame
+        [[nodiscard]] const glyph_t* acquire(uint32_t codepoint, uint64_t frame);
+        void touch(const uint32_t slot, const uint64_t frame) noexcept { _slots[slot].last_used = frame; }
+
+        // Bumped whenever a slot is reused for another glyph; layouts holding slots from an older generation
+        // have to be redone
+        [[nodiscard]] uint64_t generation() const noexcept { return _generation; }
+        [[nodiscard]] float line_height() const noexcept { return _line_height; }
+
+        [[nodiscard]] std::span<const unsigned char> pixels() const noexcept { return _pixels; }
+        [[nodiscard]] std::span<const glyph_metrics_t> metrics() const noexcept { return _metrics; }
+
+        // Changes since the last clear_pending(): slots whose metrics changed, and atlas regions to upload
+        [[nodiscard]] std::span<const uint32_t> dirty_slots() const noexcept { return _dirty_slots; }
+        [[nodiscard]] std::span<const glyph_upload_t> pending_uploads() const noexcept { return _uploads; }
+        [[nodiscard]] std::span<const unsigned char> pending_pixels() const noexcept { return _upload_pixels; }
+        void clear_pending() noexcept;
+
+    private:
+        // The CPU copy of the atlas is the overlay's largest allocation
+        using pixel_buffer_t = std::vector<unsigned char,
+                                           memory::tagged_allocator_t<unsigned char, memory::memory_tag::ui>>;
+
+        struct shelf_t
+        {
+            uint32_t    y{ 0 };
+            uint32_t    height{ 0 };
+            uint32_t    next_x{ 0 };
+        };
+
+        struct slot_t
+        {
+            uint32_t    codepoint{ 0 };
+            uint32_t    x{ 0 }, y{ 0 };
+            uint32_t    cell_width{ 0 }, cell_height{ 0 };  // space reserved in the atlas, may exceed the glyph
+            glyph_t     glyph;
+            uint64_t    last_used{ 0 };
+        };
+
+        [[nodiscard]] bool pack(uint32_t width, uint32_t height, uint32_t& x, uint32_t& y);
+        [[nodiscard]] uint32_t evict(uint32_t width, uint32_t height, uint64_t frame);
+        void store(uint32_t slot, const unsigned char* bitmap, uint32_t width, uint32_t height, float offset_x,
+                   float offset_y);
+
+        std::vector<unsigned char>                  _ttf;
+        stbtt_fontinfo                              _font{ };
+        float                                       _scale{ 0.f };
+        float                                       _line_height{ 0.f };
+        uint64_t                                    _font_hash{ 0 };
+        uint64_t                                    _eviction_delay{ 0 };
+
+        pixel_buffer_t                              _pixels;
+        std::vector<shelf_t>                        _shelves;
+        std::vector<slot_t>                         _slots;
+        std::vector<glyph_metrics_t>                _metrics;       // parallel to _slots
+        std::unordered_map<uint32_t, uint32_t>      _lookup;        // codepoint → slot
+        uint64_t                                    _generation{ 0 };
+
+        std::vector<uint32_t>                       _dirty_slots;
+        std::vector<glyph_upload_t>                 _uploads;
+        pixel_buffer_t                              _upload_pixels;
+    };
+} // namespace carrot::debug
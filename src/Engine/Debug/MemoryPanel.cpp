@@ -0,0 +1,108 @@
+//
+// Created by zshrout on 10/18/26.
+// Copyright (c) 2026 BunnySofty. All rights reserved.
+//
+
+#include "MemoryPanel.h"
+
+#ifndef CARROT_SHIPPING
+
+#include "DebugOverlay.h"
+#include "Memory/MemoryTracker.h"
+
+#include <algorithm>
+
+namespace carrot::debug::memory_panel {
+    namespace {
+        constexpr float k_padding{ 6.f };
+        constexpr float k_header_height{ 18.f };
+        constexpr float k_row_height{ 16.f };
+        constexpr float k_label_height{ 12.f };
+        constexpr float k_name_width{ 76.f };
+        constexpr float k_numbers_width{ 200.f };
+        constexpr float k_bar_width{ 140.f };
+        constexpr float k_width{ k_name_width + k_numbers_width + k_bar_width };
+        constexpr float k_warning_ratio{ 0.8f };
+        static_assert(k_width + 2.f * k_padding == k_panel_width);
+
+        constexpr uint32_t k_background{ rgba(0, 0, 0, 170) };
+        constexpr uint32_t k_bar_background{ rgba(255, 255, 255, 40) };
+
+        bool g_visible{ false };
+
+        [[nodiscard]] float to_mib(const uint64_t bytes) noexcept
+        {
+            return static_cast<float>(bytes) / (1024.f * 1024.f);
+        }
+
+        [[nodiscard]] uint32_t usage_color(const memory::tag_stats_t& stats) noexcept
+        {
+            if (stats.budget_bytes == 0) return rgba(86, 180, 233);
+            if (stats.over_budget()) return rgba(230, 70, 60);
+            return static_cast<float>(stats.live_bytes) > k_warning_ratio * static_cast<float>(stats.budget_bytes)
+                       ? rgba(230, 200, 60)
+                       : rgba(80, 200, 80);
+        }
+
+        // Live against the budget, or against the peak for tags without one; the peak is marked on the bar
+        void draw_bar(const float x, const float y, const memory::tag_stats_t& stats)
+        {
+            const float height{ k_row_height - 4.f };
+            filled_rect(x, y, k_bar_width, height, k_bar_background);
+
+            const uint64_t reference{ stats.budget_bytes != 0 ? stats.budget_bytes : stats.peak_bytes };
+            const uint64_t scale{ std::max(reference, uint64_t{ 1 }) };
+            const auto fraction = [&](const uint64_t bytes) {
+                return std::min(static_cast<float>(bytes) / static_cast<float>(scale), 1.f) * k_bar_width;
+            };
+
+            filled_rect(x, y, fraction(stats.live_bytes), height, usage_color(stats));
+            const float peak_x{ x + fraction(stats.peak_bytes) };
+            line(peak_x, y, peak_x, y + height, rgba(255, 255, 255));
+        }
+    } // anonymous namespace
+
+    void toggle_visible() noexcept
+    {
+        g_visible = !g_visible;
+    }
+
+    bool is_visible() noexcept
+    {
+        return g_visible;
+    }
+
+    void draw(const float x, const float y) noexcept
+    {
+        if (!g_visible) return;
+
+        // Primitives draw in submission order, so the background goes first
+        const float rows{ static_cast<float>(memory::k_tag_count) * k_row_height };
+        const float height{ k_header_height + rows + 2.f * k_padding };
+        filled_rect(x, y, k_panel_width, height, k_background);
+
+        const float left{ x + k_padding };
+        float cursor{ y + k_padding + k_header_height };
+        text(left, cursor - 4.f, 14.f, "memory  %.1f MiB live", to_mib(memory::total_live_bytes()));
+
+        for (size_t i{ 0 }; i < memory::k_tag_count; ++i)
+        {
+            const auto tag{ static_cast<memory::memory_tag>(i) };
+            const memory::tag_stats_t stats{ memory::tag_stats(tag) };
+            const float baseline{ cursor + k_label_height };
+
+            text(left, baseline, k_label_height, "%s", memory::tag_to_string(tag));
+            if (stats.budget_bytes != 0)
+                text(left + k_name_width, baseline, k_label_height, "%.1f / %.1f MiB  peak %.1f",
+                     to_mib(stats.live_bytes), to_mib(stats.budget_bytes), to_mib(stats.peak_bytes));
+            else
+                text(left + k_name_width, baseline, k_label_height, "%.1f MiB  peak %.1f", to_mib(stats.live_bytes),
+                     to_mib(stats.peak_bytes));
+            draw_bar(left + k_name_width + k_numbers_width, cursor + 2.f, stats);
+
+            cursor += k_row_height;
+        }
+    }
+} // namespace carrot::debug::memory_panel
+
+#endif
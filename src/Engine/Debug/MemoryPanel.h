@@ -0,0 +1,26 @@
+//
+// Created by zshrout on 10/18/26.
+// Copyright (c) 2026 BunnySofty. All rights reserved.
+//
+
+#pragma once
+
+// In-game view of the memory tracker: live, peak and budget of every memory tag, with a bar per tag that turns
+// red once the tag is over its budget. Drawn with the debug overlay's primitives; shipping builds compile it out.
+namespace carrot::debug::memory_panel {
+    // Outer width in overlay units, to anchor the panel against the right edge of the canvas
+    constexpr float k_panel_width{ 428.f };
+
+#ifndef CARROT_SHIPPING
+    void toggle_visible() noexcept;
+    [[nodiscard]] bool is_visible() noexcept;
+
+    // Top-left corner in overlay units; call once per frame while visible
+    void draw(float x, float y) noexcept;
+#else
+    inline void toggle_visible() noexcept {}
+    [[nodiscard]] inline bool is_visible() noexcept { return false; }
+
+    inline void draw(float, float) noexcept {}
+#endif
+} // namespace carrot::debug::memory_panel
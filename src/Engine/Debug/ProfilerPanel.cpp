@@ -0,0 +1,247 @@
+//
+// Created by zshrout on 10/18/26.
+// Copyright (c) 2026 BunnySofty. All rights reserved.
+//
+
+#include "ProfilerPanel.h"
+
+#ifndef CARROT_SHIPPING
+
+#include "DebugOverlay.h"
+#include "Core/Profiler.h"
+
+#include <algorithm>
+#include <array>
+#include <vector>
+
+namespace carrot::debug::profiler_panel {
+    namespace {
+        constexpr uint32_t k_history_frames{ 240 };
+        constexpr float k_width{ 720.f };
+        constexpr float k_padding{ 6.f };
+        constexpr float k_header_height{ 18.f };
+        constexpr float k_strip_height{ 60.f };
+        constexpr float k_strip_max_ms{ 50.f };
+        constexpr float k_target_ms{ 1000.f / 60.f };
+        constexpr float k_row_height{ 14.f };
+        constexpr float k_label_height{ 12.f };
+        constexpr float k_min_label_width{ 48.f };         // narrower zones go unlabelled
+        constexpr uint32_t k_histogram_buckets{ 25 };
+        constexpr float k_bucket_ms{ k_strip_max_ms / k_histogram_buckets };
+        constexpr float k_histogram_height{ 48.f };
+
+        constexpr uint32_t k_background{ rgba(0, 0, 0, 170) };
+        constexpr uint32_t k_text_color{ rgba(230, 230, 230) };
+        constexpr std::array k_zone_colors{
+            rgba(86, 180, 233), rgba(230, 159, 0), rgba(0, 158, 115), rgba(204, 121, 167),
+            rgba(240, 228, 66), rgba(0, 114, 178), rgba(213, 94, 0), rgba(150, 150, 150),
+        };
+
+        struct captured_frame_t
+        {
+            uint64_t                                    index{ 0 };
+            uint64_t                                    frame_ns{ 0 };
+            std::vector<core::profiler::zone_event_t>   events;
+            std::vector<core::profiler::gpu_scope_t>    gpu_scopes;
+            uint32_t                                    thread_count{ 0 };
+            uint32_t                                    max_depth{ 0 };
+        };
+
+        // Ring of the last k_history_frames frames; vectors keep their capacity as slots are reused
+        std::array<captured_frame_t, k_history_frames> g_frames;
+        uint32_t g_head{ 0 };       // slot the next frame goes to
+        uint32_t g_count{ 0 };
+        uint32_t g_selected{ 0 };   // frames back from the newest
+        bool g_visible{ false };
+        bool g_paused{ false };
+        core::profiler::frame_listener_t g_listener;
+
+        [[nodiscard]] const captured_frame_t& frame_at(const uint32_t back) noexcept
+        {
+            return g_frames[(g_head + k_history_frames - 1 - back) % k_history_frames];
+        }
+
+        [[nodiscard]] float to_ms(const uint64_t ns) noexcept
+        {
+            return static_cast<float>(ns) / 1'000'000.f;
+        }
+
+        [[nodiscard]] uint32_t frame_color(const float ms) noexcept
+        {
+            if (ms <= k_target_ms) return rgba(80, 200, 80);
+            return ms <= 2.f * k_target_ms ? rgba(230, 200, 60) : rgba(230, 70, 60);
+        }
+
+        void on_frame(const core::profiler::frame_profile_t& frame)
+        {
+            if (g_paused) return;
+
+            captured_frame_t& out{ g_frames[g_head] };
+            out.index = frame.frame_index;
+            out.frame_ns = frame.frame_ns;
+            out.events.assign(frame.events.begin(), frame.events.end());
+            out.gpu_scopes.assign(frame.gpu_scopes.begin(), frame.gpu_scopes.end());
+            out.thread_count = 0;
+            out.max_depth = 0;
+            for (const core::profiler::zone_event_t& event: out.events)
+            {
+                out.thread_count = std::max(out.thread_count, event.thread + 1);
+                out.max_depth = std::max(out.max_depth, event.depth);
+            }
+
+            g_head = (g_head + 1) % k_history_frames;
+            g_count = std::min(g_count + 1, k_history_frames);
+        }
+
+        // Bars of every captured frame's time, oldest on the left; the inspected one is highlighted
+        float draw_strip(const float x, const float y)
+        {
+            const float bar_width{ k_width / static_cast<float>(k_history_frames) };
+            for (uint32_t back{ 0 }; back < g_count; ++back)
+            {
+                const float ms{ to_ms(frame_at(back).frame_ns) };
+                const float height{ std::min(ms / k_strip_max_ms, 1.f) * k_strip_height };
+                const float left{ x + k_width - bar_width * static_cast<float>(back + 1) };
+                filled_rect(left, y + k_strip_height - height, bar_width, height,
+                            back == g_selected ? rgba(255, 255, 255) : frame_color(ms));
+            }
+
+            const float target_y{ y + k_strip_height * (1.f - k_target_ms / k_strip_max_ms) };
+            line(x, target_y, x + k_width, target_y, rgba(255, 255, 255, 90));
+            return y + k_strip_height;
+        }
+
+        [[nodiscard]] float timeline_height(const captured_frame_t& frame) noexcept
+        {
+            const float cpu{ static_cast<float>(frame.thread_count * (frame.max_depth + 1)) * k_row_height };
+            return frame.gpu_scopes.empty() ? cpu : cpu + k_padding + k_row_height;
+        }
+
+        // CPU threads one band each, nested zones one row deeper; GPU scopes below on the same time axis
+        float draw_timeline(const float x, float y, const captured_frame_t& frame)
+        {
+            uint64_t span_ns{ frame.frame_ns };
+            for (const core::profiler::gpu_scope_t& scope: frame.gpu_scopes)
+                span_ns = std::max(span_ns, scope.end_ns);
+            if (span_ns == 0) return y;
+
+            const float ns_to_px{ k_width / static_cast<float>(span_ns) };
+            const auto bar = [&](const float top, const uint32_t zone, const uint64_t start, const uint64_t end) {
+                const float left{ x + static_cast<float>(start) * ns_to_px };
+                const float width{ std::max(static_cast<float>(end - start) * ns_to_px, 1.f) };
+                filled_rect(left, top, width, k_row_height - 1.f, k_zone_colors[zone % k_zone_colors.size()]);
+                if (width >= k_min_label_width)
+                    text(left + 2.f, top + k_label_height - 2.f, k_label_height, "%s %.2f",
+                         core::profiler::zone_name(zone), to_ms(end - start));
+            };
+
+            const float band_height{ static_cast<float>(frame.max_depth + 1) * k_row_height };
+            for (const core::profiler::zone_event_t& event: frame.events)
+                bar(y + static_cast<float>(event.thread) * band_height + static_cast<float>(event.depth) * k_row_height,
+                    event.zone, event.start_ns, event.end_ns);
+            y += static_cast<float>(frame.thread_count) * band_height;
+
+            if (!frame.gpu_scopes.empty())
+            {
+                y += k_padding;
+                for (const core::profiler::gpu_scope_t& scope: frame.gpu_scopes)
+                    bar(y, scope.zone, scope.start_ns, scope.end_ns);
+                y += k_row_height;
+            }
+            return y;
+        }
+
+        // How often each frame time occurred over the history, in k_bucket_ms buckets
+        void draw_histogram(const float x, const float y)
+        {
+            std::array<uint32_t, k_histogram_buckets> buckets{ };
+            for (uint32_t back{ 0 }; back < g_count; ++back)
+            {
+                const auto bucket{ static_cast<uint32_t>(to_ms(frame_at(back).frame_ns) / k_bucket_ms) };
+                ++buckets[std::min(bucket, k_histogram_buckets - 1)];
+            }
+
+            const uint32_t peak{ std::max(*std::ranges::max_element(buckets), 1u) };
+            const float bucket_width{ k_width / static_cast<float>(k_histogram_buckets) };
+            for (uint32_t i{ 0 }; i < k_histogram_buckets; ++i)
+            {
+                const float height{ static_cast<float>(buckets[i]) / static_cast<float>(peak) * k_histogram_height };
+                filled_rect(x + bucket_width * static_cast<float>(i), y + k_histogram_height - height,
+                            bucket_width - 1.f, height, frame_color((static_cast<float>(i) + 0.5f) * k_bucket_ms));
+            }
+
+            text(x, y + k_histogram_height + k_label_height, k_label_height, "0 ms");
+            text(x + k_width - 40.f, y + k_histogram_height + k_label_height, k_label_height, "%.0f+ ms",
+                 k_strip_max_ms);
+        }
+    } // anonymous namespace
+
+    void init() noexcept
+    {
+        g_listener = core::profiler::frame_listener_t::bind<&on_frame>();
+        core::profiler::add_frame_listener(g_listener);
+    }
+
+    void shutdown() noexcept
+    {
+        core::profiler::remove_frame_listener(g_listener);
+        g_count = 0;
+        g_head = 0;
+    }
+
+    void toggle_visible() noexcept
+    {
+        g_visible = !g_visible;
+    }
+
+    bool is_visible() noexcept
+    {
+        return g_visible;
+    }
+
+    void toggle_pause() noexcept
+    {
+        g_paused = !g_paused;
+        if (!g_paused) g_selected = 0; // follows the newest frame again
+    }
+
+    bool is_paused() noexcept
+    {
+        return g_paused;
+    }
+
+    void scrub(const int32_t frames) noexcept
+    {
+        if (g_count == 0) return;
+
+        // Towards older frames means further back from the newest
+        const int64_t selected{ static_cast<int64_t>(g_selected) - frames };
+        g_selected = static_cast<uint32_t>(std::clamp<int64_t>(selected, 0, g_count - 1));
+    }
+
+    void draw(const float x, const float y) noexcept
+    {
+        if (!g_visible || g_count == 0) return;
+
+        const captured_frame_t& frame{ frame_at(g_selected) };
+
+        // Primitives draw in submission order, so the background goes first
+        const float height{
+            k_header_height + k_strip_height + timeline_height(frame) + k_histogram_height + k_label_height +
+            5.f * k_padding
+        };
+        filled_rect(x, y, k_width + 2.f * k_padding, height, k_background);
+
+        const float left{ x + k_padding };
+        float cursor{ y + k_padding + k_header_height };
+        text(left, cursor - 4.f, 14.f, "frame %llu  %.2f ms  %u thread(s)%s",
+             static_cast<unsigned long long>(frame.index), to_ms(frame.frame_ns), frame.thread_count,
+             g_paused ? "  [paused]" : "");
+
+        cursor = draw_strip(left, cursor) + k_padding;
+        cursor = draw_timeline(left, cursor, frame) + k_padding;
+        draw_histogram(left, cursor);
+    }
+} // namespace carrot::debug::profiler_panel
+
+#endif
@@ -0,0 +1,44 @@
+//
+// Created by zshrout on 10/18/26.
+// Copyright (c) 2026 BunnySofty. All rights reserved.
+//
+
+#pragma once
+
+#include <cstdint>
+
+// In-game view of core::profiler: the recent frame times, a histogram of them, and the CPU zones of every thread
+// and the GPU scopes of one frame on a shared timeline. Frames are captured continuously, so a hitch can be
+// inspected after the fact by pausing and scrubbing back to it. Drawn with the debug overlay's primitives;
+// shipping builds compile it out.
+namespace carrot::debug::profiler_panel {
+#ifndef CARROT_SHIPPING
+    // Starts capturing frames; the panel itself is hidden until toggled
+    void init() noexcept;
+    void shutdown() noexcept;
+
+    void toggle_visible() noexcept;
+    [[nodiscard]] bool is_visible() noexcept;
+
+    // While paused no frames are captured and scrub() walks the history
+    void toggle_pause() noexcept;
+    [[nodiscard]] bool is_paused() noexcept;
+    // Moves the inspected frame by `frames`, negative towards older ones
+    void scrub(int32_t frames) noexcept;
+
+    // Top-left corner in overlay units; call once per frame while visible
+    void draw(float x, float y) noexcept;
+#else
+    inline void init() noexcept {}
+    inline void shutdown() noexcept {}
+
+    inline void toggle_visible() noexcept {}
+    [[nodiscard]] inline bool is_visible() noexcept { return false; }
+
+    inline void toggle_pause() noexcept {}
+    [[nodiscard]] inline bool is_paused() noexcept { return false; }
+    inline void scrub(int32_t) noexcept {}
+
+    inline void draw(float, float) noexcept {}
+#endif
+} // namespace carrot::debug::profiler_panel
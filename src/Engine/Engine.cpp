@@ -6,19 +6,29 @@
 #include "Engine.h"
 
 #include "Debug/DebugOverlay.h"
+#include "Debug/MemoryPanel.h"
+#include "Debug/ProfilerPanel.h"
 #include "HotReload/ShaderWatcher.h"
+#include "Memory/FrameArena.h"
+#include "Memory/MemoryTracker.h"
 #include "RHI/Backends/Vulkan/VulkanRenderer.h"
 #include "Utils/MulticastDelegate.h"
+#include "Utils/ShaderUtils.h"
 #include "Window/Window.h"
 #include "Core/Application.h"
+#include "Core/Profiler.h"
+
+#include <algorithm>
 
 namespace carrot {
     namespace {
         uint64_t                                    _last_tick_time{ 0 };
         uint32_t                                    _frame_counter{ 0 };
         float                                       _fps_timer{ 0.f };
+        debug::sample_ring_t                        _frame_times;   // milliseconds
         bool                                        _debug_overlay_initialized{ false };
         core::ce_application_t*                     _application{ nullptr };
+        core::engine_config_t                       _config;
         utils::multicast_delegate_t<void(float dt)> _on_tick;
     } // anonymous namespace
 
@@ -26,14 +36,27 @@ namespace carrot {
     engine_t::engine_t() noexcept
     {
         core::logger_t::init();
-        window::create_primary_window(1280, 720, "Carrot Engine – Month 1");
+        for (const std::string& argument: _config.unknown_arguments)
+            LOG_CORE_WARN("Ignoring unknown or malformed argument '{}'", argument);
+        for (size_t i{ 0 }; i < memory::k_tag_count; ++i)
+            memory::set_budget(static_cast<memory::memory_tag>(i), _config.memory_budgets[i]);
+
+        const renderer::renderer_config_t& render_config{ _config.renderer };
+        if (!render_config.headless)
+            window::create_primary_window(render_config.width, render_config.height, "Carrot Engine – Month 1");
+
+        mount_shader_archive("shaders/shaders.pak");
+        debug::profiler_panel::init();
 
         _renderer = renderer::create_backend();
-        _renderer->init();
+        _renderer->init(render_config);
 
-        hot_reload::shader_watcher_t::init([this]([[maybe_unused]] const std::string& spv_path) {
-                _renderer->reload_pipeline();
-            });
+        // Headless runs are benchmarks and CI, their shaders must not change underneath them
+        if (!render_config.headless)
+        {
+            hot_reload::shader_watcher_t::init(
+                hot_reload::shader_reload_callback_t::bind<&renderer::renderer_t::reload_shaders>(_renderer));
+        }
 
         LOG_CORE_INFO("Carrot Engine Initialized");
     }
@@ -42,15 +65,18 @@ namespace carrot {
     {
         LOG_CORE_INFO("Shutting down...");
 
-        hot_reload::shader_watcher_t::shutdown();
+        if (!_config.renderer.headless) hot_reload::shader_watcher_t::shutdown();
+        debug::profiler_panel::shutdown();
+        if (_debug_overlay_initialized) debug::shutdown();
         _renderer->shutdown();
+        unmount_shader_archive();
         window::destroy_primary_window();
         core::logger_t::shutdown();
     }
 
     void engine_t::run(core::ce_application_t* app)
     {
-        const auto& main_window = window::get_primary_window();
+        const bool headless{ _config.renderer.headless };
         _application = app;
 
         _last_tick_time = std::chrono::duration_cast<std::chrono::milliseconds>(
@@ -60,10 +86,13 @@ namespace carrot {
         // Bind the on_tick function in the engine's application class, to be inherited
         _on_tick.add(utils::single_delegate_t<void(float)>::bind<&core::ce_application_t::on_tick>(_application));
 
-        while (!_should_quit && !main_window.should_close())
+        uint64_t frames_rendered{ 0 };
+        while (!_should_quit && (headless || !window::should_close()))
         {
+            core::profiler::begin_frame();
+
             window::poll_events();
-            hot_reload::shader_watcher_t::poll();
+            if (!headless) hot_reload::shader_watcher_t::poll();
             tick();
 
             _renderer->begin_frame();
@@ -73,10 +102,16 @@ namespace carrot {
             if (!_debug_overlay_initialized)
             {
                 debug::init(_renderer);
+                debug::set_ui_scale(_config.renderer.ui_scale);
                 _debug_overlay_initialized = true;
             }
 
             _renderer->end_frame();
+            core::profiler::end_frame();
+            // Last: everything allocated from a frame arena this iteration is released here
+            memory::end_frame();
+
+            if (_config.frame_count != 0 && ++frames_rendered >= _config.frame_count) _should_quit = true;
         }
     }
 
@@ -86,9 +121,16 @@ namespace carrot {
         return instance;
     }
 
+    void engine_t::configure(core::engine_config_t config) noexcept
+    {
+        _config = std::move(config);
+    }
+
     // PRIVATE
     void engine_t::tick()
     {
+        CE_PROFILE_ZONE("engine_tick");
+
         const long long now_ms = std::chrono::duration_cast<std::chrono::milliseconds>(
             std::chrono::steady_clock::now().time_since_epoch()).count();
 
@@ -107,6 +149,20 @@ namespace carrot {
 
         debug::text(20.f, 30.f, "FPS: %u", _current_fps);
         debug::text(20.f, 65.f, "Frame: %.3f ms", _delta_time * 1000.f);
+        _frame_times.push(_delta_time * 1000.f);
+        debug::graph(20.f, 80.f, 256.f, 64.f, _frame_times, 33.3f, debug::rgba(80, 255, 80));
+
+        // F3 shows the profiler, P freezes it, the arrow keys step through the frozen history
+        if (window::was_key_pressed(window::key::f3)) debug::profiler_panel::toggle_visible();
+        if (window::was_key_pressed(window::key::p)) debug::profiler_panel::toggle_pause();
+        if (window::was_key_pressed(window::key::left)) debug::profiler_panel::scrub(-1);
+        if (window::was_key_pressed(window::key::right)) debug::profiler_panel::scrub(1);
+        debug::profiler_panel::draw(20.f, 160.f);
+
+        if (window::was_key_pressed(window::key::f4)) debug::memory_panel::toggle_visible();
+        // Kept against the right edge of the canvas, or the left margin when the canvas is narrower than the panel
+        debug::memory_panel::draw(std::max(debug::canvas().width - debug::memory_panel::k_panel_width - 20.f, 20.f),
+                                  160.f);
 
         _on_tick.broadcast(_delta_time);
     }
@@ -6,6 +6,7 @@
 #pragma once
 
 #include "Common/CommonHeaders.h"
+#include "Core/EngineConfig.h"
 #include "Renderer/Renderer.h"
 
 namespace carrot {
@@ -23,11 +24,14 @@ namespace carrot {
 
         void run(core::ce_application_t* app);
         [[nodiscard]] static engine_t& get() noexcept;
+        // Only takes effect before the first get(), which creates the engine
+        static void configure(core::engine_config_t config) noexcept;
 
         void request_quit() noexcept { _should_quit = true; }
         [[nodiscard]] bool should_quit() const noexcept { return _should_quit; }
         [[nodiscard]] float get_delta_time() const noexcept { return _delta_time; }
         [[nodiscard]] uint32_t get_fps() const noexcept { return _current_fps; }
+        [[nodiscard]] renderer::renderer_t& get_renderer() const noexcept { return *_renderer; }
 
     private:
         void tick();
@@ -0,0 +1,139 @@
+//
+// Created by zshrout on 10/18/26.
+// Copyright (c) 2026 BunnySofty. All rights reserved.
+//
+
+#include "ShaderDependencyGraph.h"
+
+#include "Core/Logger.h"
+
+#include <filesystem>
+#include <fstream>
+
+namespace carrot::hot_reload {
+    namespace {
+        namespace fs = std::filesystem;
+
+        // Returns the path inside an `#include "..."` / `#include <...>` directive, or an empty view
+        std::string_view include_target(std::string_view line) noexcept
+        {
+            const size_t first{ line.find_first_not_of(" \t") };
+            if (first == std::string_view::npos || line[first] != '#') return { };
+
+            line.remove_prefix(first + 1);
+            const size_t directive{ line.find_first_not_of(" \t") };
+            if (directive == std::string_view::npos || !line.substr(directive).starts_with("include")) return { };
+
+            line.remove_prefix(directive + 7);
+            const size_t open{ line.find_first_of("\"<") };
+            if (open == std::string_view::npos) return { };
+
+            const char close_char{ line[open] == '"' ? '"' : '>' };
+            const size_t close{ line.find(close_char, open + 1) };
+            if (close == std::string_view::npos) return { };
+
+            return line.substr(open + 1, close - open - 1);
+        }
+    } // anonymous namespace
+
+    // PUBLIC
+    void shader_dependency_graph_t::scan(const std::string& shader_dir)
+    {
+        clear();
+        _shader_dir = shader_dir;
+
+        // Error-code overloads throughout: this runs from the watcher's noexcept init and poll
+        std::error_code ec;
+        for (fs::recursive_directory_iterator it{ _shader_dir, ec }, end; !ec && it != end; it.increment(ec))
+        {
+            std::error_code entry_ec;
+            if (!it->is_regular_file(entry_ec)) continue;
+
+            const fs::path relative{ fs::relative(it->path(), _shader_dir, entry_ec) };
+            if (entry_ec) continue;
+
+            const std::string name{ relative.generic_string() };
+            if (is_shader_source(name)) update_file(name);
+        }
+
+        if (ec) LOG_GRAPHICS_WARN("[HotReload] Failed to scan shader directory {}: {}", _shader_dir, ec.message());
+    }
+
+    void shader_dependency_graph_t::update_file(const std::string& file_name)
+    {
+        // Drop the old outgoing edges, the include list may have changed with this edit
+        if (const auto it{ _includes.find(file_name) }; it != _includes.end())
+        {
+            for (const auto& include: it->second)
+                _included_by[include].erase(file_name);
+        }
+
+        std::vector<std::string> includes{ parse_includes(file_name) };
+        for (const auto& include: includes)
+            _included_by[include].insert(file_name);
+
+        _includes[file_name] = std::move(includes);
+    }
+
+    void shader_dependency_graph_t::clear() noexcept
+    {
+        _includes.clear();
+        _included_by.clear();
+    }
+
+    std::vector<std::string> shader_dependency_graph_t::affected_stages(const std::string& file_name) const
+    {
+        std::vector<std::string> stages;
+        std::vector<std::string> pending{ file_name };
+        std::unordered_set<std::string> visited{ file_name };
+
+        while (!pending.empty())
+        {
+            const std::string current{ std::move(pending.back()) };
+            pending.pop_back();
+
+            if (is_shader_stage(current)) stages.push_back(current);
+
+            const auto it{ _included_by.find(current) };
+            if (it == _included_by.end()) continue;
+
+            for (const auto& parent: it->second)
+                if (visited.insert(parent).second) pending.push_back(parent);
+        }
+
+        return stages;
+    }
+
+    bool shader_dependency_graph_t::is_shader_stage(const std::string_view file_name) noexcept
+    {
+        return file_name.ends_with(".vert") || file_name.ends_with(".frag") || file_name.ends_with(".comp");
+    }
+
+    bool shader_dependency_graph_t::is_shader_source(const std::string_view file_name) noexcept
+    {
+        return is_shader_stage(file_name) || file_name.ends_with(".glsl");
+    }
+
+    // PRIVATE
+    std::vector<std::string> shader_dependency_graph_t::parse_includes(const std::string& file_name) const
+    {
+        std::vector<std::string> includes;
+
+        std::ifstream file{ fs::path{ _shader_dir } / file_name };
+        if (!file.is_open()) return includes;
+
+        // Include paths are resolved relative to the including file, the same way glslangValidator does it
+        const fs::path parent_dir{ fs::path{ file_name }.parent_path() };
+
+        std::string line;
+        while (std::getline(file, line))
+        {
+            const std::string_view target{ include_target(line) };
+            if (target.empty()) continue;
+
+            includes.push_back((parent_dir / target).lexically_normal().generic_string());
+        }
+
+        return includes;
+    }
+} // namespace carrot::hot_reload
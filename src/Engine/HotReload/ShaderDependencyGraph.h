@@ -0,0 +1,37 @@
+//
+// Created by zshrout on 10/18/26.
+// Copyright (c) 2026 BunnySofty. All rights reserved.
+//
+
+#pragma once
+
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+namespace carrot::hot_reload {
+    // Tracks `#include` edges between GLSL files so that an edit only recompiles the stages that actually
+    // (transitively) depend on the changed file. All names are relative to the shader root directory.
+    class shader_dependency_graph_t
+    {
+    public:
+        void scan(const std::string& shader_dir);
+        void update_file(const std::string& file_name);
+        void clear() noexcept;
+
+        // Every compilable stage (.vert/.frag/.comp) that is the file itself or includes it, directly or not
+        [[nodiscard]] std::vector<std::string> affected_stages(const std::string& file_name) const;
+
+        [[nodiscard]] static bool is_shader_stage(std::string_view file_name) noexcept;
+        [[nodiscard]] static bool is_shader_source(std::string_view file_name) noexcept;
+
+    private:
+        [[nodiscard]] std::vector<std::string> parse_includes(const std::string& file_name) const;
+
+        std::string                                                              _shader_dir;
+        std::unordered_map<std::string, std::vector<std::string>>                _includes;
+        std::unordered_map<std::string, std::unordered_set<std::string>>         _included_by;
+    };
+} // namespace carrot::hot_reload
@@ -9,9 +9,25 @@
 
 #include <sys/inotify.h>
 #include <unistd.h>
+#include <algorithm>
+#include <filesystem>
 #include <string>
 
 namespace carrot::hot_reload {
+    namespace {
+        constexpr const char* k_shader_dir{ "shaders" };
+        constexpr const char* k_spv_dir{ "bin/debug/shaders" };
+        constexpr uint32_t k_watch_mask{ IN_CLOSE_WRITE | IN_MOVED_TO | IN_CREATE };
+
+        namespace fs = std::filesystem;
+
+        // Names are relative to the shader root, the same keys the dependency graph uses
+        std::string join(const std::string& dir, const std::string_view name)
+        {
+            return dir.empty() ? std::string{ name } : dir + "/" + std::string{ name };
+        }
+    } // anonymous namespace
+
     void shader_watcher_t::init(const shader_reload_callback_t& callback) noexcept
     {
         _callback = callback;
@@ -19,14 +35,17 @@ namespace carrot::hot_reload {
         _inotify_fd = inotify_init1(IN_NONBLOCK);
         if (_inotify_fd == -1) return;
 
-        _watch_desc = inotify_add_watch(_inotify_fd, "shaders", IN_CLOSE_WRITE | IN_MOVED_TO);
+        watch_directory({ });
+        _dependencies.scan(k_shader_dir);
     }
     void shader_watcher_t::shutdown() noexcept
     {
-        if (_watch_desc != -1) inotify_rm_watch(_inotify_fd, _watch_desc);
+        for (const auto& [desc, dir]: _watch_dirs)
+            inotify_rm_watch(_inotify_fd, desc);
         if (_inotify_fd != -1) close(_inotify_fd);
         _inotify_fd = -1;
-        _watch_desc = -1;
+        _watch_dirs.clear();
+        _dependencies.clear();
     }
     void shader_watcher_t::poll() noexcept
     {
@@ -36,39 +55,103 @@ namespace carrot::hot_reload {
         const ssize_t len{ read(_inotify_fd, buffer, sizeof(buffer)) };
         if (len <= 0) return;
 
+        // Collect first: editors often emit several events per save, and one include can feed many stages
+        std::vector<std::string> dirty_stages;
+        bool rescan{ false };
+
         const inotify_event* event;
         for (const char* ptr = buffer; ptr < buffer + len; ptr += sizeof(inotify_event) + event->len)
         {
             event = reinterpret_cast<const inotify_event *>(ptr);
 
+            // The directory was deleted or moved away, its watch is gone
+            if (event->mask & IN_IGNORED)
+            {
+                _watch_dirs.erase(event->wd);
+                continue;
+            }
+
+            const auto dir{ _watch_dirs.find(event->wd) };
+            if (dir == _watch_dirs.end() || event->len == 0) continue;
+
+            const std::string name{ join(dir->second, event->name) };
+            if (event->mask & IN_ISDIR)
+            {
+                // A new or moved-in directory may already hold shaders, the graph has to learn about them
+                watch_directory(name);
+                rescan = true;
+                continue;
+            }
+
             if (!(event->mask & (IN_CLOSE_WRITE | IN_MOVED_TO))) continue;
-            if (!(event->mask & IN_ISDIR) && (std::string(event->name).ends_with(".vert") ||
-                                              std::string(event->name).ends_with(".frag")))
+            if (!shader_dependency_graph_t::is_shader_source(name)) continue;
+
+            _dependencies.update_file(name);
+
+            for (auto& stage: _dependencies.affected_stages(name))
             {
-                std::string glsl_path{ "shaders/" + std::string(event->name) };
-                std::string spv_path{ "bin/debug/shaders/" + std::string(event->name) + ".spv" };
-
-                // Recompile immediately
-                std::string cmd{ "glslangValidator -V \"" + glsl_path + "\" -o \"" + spv_path + "\"" };
-
-                if (const int result{ system(cmd.c_str()) }; result == 0)
-                {
-                    LOG_GRAPHICS_INFO("[HotReload] Recompiled {}", std::string(event->name));
-                    // Give filesystem a moment
-                    usleep(50000);
-                    if (_callback) _callback(spv_path);
-                }
-                else
-                {
-                    LOG_GRAPHICS_ERROR("[HotReload] Failed to compile {}", std::string(event->name));
-                }
+                if (std::ranges::find(dirty_stages, stage) == dirty_stages.end())
+                    dirty_stages.push_back(std::move(stage));
             }
         }
+
+        if (rescan) _dependencies.scan(k_shader_dir);
+
+        std::vector<std::string> rebuilt_modules;
+        for (const auto& stage: dirty_stages)
+        {
+            std::string glsl_path{ std::string{ k_shader_dir } + "/" + stage };
+            std::string spv_path{ std::string{ k_spv_dir } + "/" + stage + ".spv" };
+
+            // Recompile immediately
+            std::string cmd{ "glslangValidator -V \"" + glsl_path + "\" -o \"" + spv_path + "\"" };
+
+            if (const int result{ system(cmd.c_str()) }; result == 0)
+            {
+                LOG_GRAPHICS_INFO("[HotReload] Recompiled {}", stage);
+                rebuilt_modules.push_back(std::move(spv_path));
+            }
+            else
+            {
+                LOG_GRAPHICS_ERROR("[HotReload] Failed to compile {}", stage);
+            }
+        }
+
+        if (rebuilt_modules.empty()) return;
+
+        // Give filesystem a moment
+        usleep(50000);
+        if (_callback) _callback.invoke(rebuilt_modules);
+    }
+
+    // PRIVATE
+    void shader_watcher_t::watch_directory(const std::string& relative_dir) noexcept
+    {
+        const std::string path{ join(k_shader_dir, relative_dir) };
+        const int desc{ inotify_add_watch(_inotify_fd, path.c_str(), k_watch_mask) };
+        if (desc == -1)
+        {
+            LOG_GRAPHICS_WARN("[HotReload] Failed to watch {}", path);
+            return;
+        }
+        _watch_dirs[desc] = relative_dir;
+
+        // Symlinks are skipped like the dependency graph's scan does, a link loop would never end
+        std::error_code ec;
+        for (fs::directory_iterator it{ path, ec }, end; !ec && it != end; it.increment(ec))
+        {
+            std::error_code entry_ec;
+            if (it->is_symlink(entry_ec) || !it->is_directory(entry_ec)) continue;
+
+            watch_directory(join(relative_dir, it->path().filename().string()));
+        }
     }
 
     int shader_watcher_t::_inotify_fd{ -1 };
 
-    int shader_watcher_t::_watch_desc{ -1 };
+    std::unordered_map<int, std::string> shader_watcher_t::_watch_dirs;
 
     shader_reload_callback_t shader_watcher_t::_callback;
+
+    shader_dependency_graph_t shader_watcher_t::_dependencies;
 } // namespace carrot::hot_reload
@@ -5,11 +5,16 @@
 
 #pragma once
 
+#include "ShaderDependencyGraph.h"
+#include "Utils/MulticastDelegate.h"
+
 #include <string>
-#include <functional>
+#include <unordered_map>
+#include <vector>
 
 namespace carrot::hot_reload {
-    using shader_reload_callback_t = std::function<void(const std::string& spv_path)>;
+    // Receives every SPIR-V module rebuilt during one poll, so a pipeline using several of them is rebuilt once
+    using shader_reload_callback_t = utils::single_delegate_t<void(const std::vector<std::string>& spv_paths)>;
 
     class shader_watcher_t
     {
@@ -19,8 +24,12 @@ namespace carrot::hot_reload {
         static void poll() noexcept; // call every frame from application_t::run()
 
     private:
-        static int                      _inotify_fd;
-        static int                      _watch_desc;
-        static shader_reload_callback_t _callback;
+        // inotify is not recursive: watches the directory and every subdirectory below it
+        static void watch_directory(const std::string& relative_dir) noexcept;
+
+        static int                          _inotify_fd;
+        static std::unordered_map<int, std::string> _watch_dirs; // watch descriptor → path below the shader root
+        static shader_reload_callback_t     _callback;
+        static shader_dependency_graph_t    _dependencies;
     };
 } // namespace carrot::hot_reload
@@ -0,0 +1,74 @@
+//
+// Created by zshrout on 10/18/26.
+// Copyright (c) 2026 BunnySofty. All rights reserved.
+//
+
+#pragma once
+
+#include "MemoryTracker.h"
+#include "Common/CommonHeaders.h"
+
+#include <cstddef>
+#include <cstdlib>
+
+namespace carrot::memory {
+    // Common interface of the engine's allocators, for code that takes whichever one its owner picked. Every
+    // allocator is bound to the tag its system memory is charged to. None of them is thread-safe.
+    class allocator_t
+    {
+    public:
+        explicit allocator_t(const memory_tag tag) noexcept : _tag{ tag } {}
+        virtual ~allocator_t() = default;
+
+        DISABLE_COPY_AND_MOVE(allocator_t);
+
+        // `alignment` must be a power of two. Null when the allocator is out of memory
+        [[nodiscard]] virtual void* allocate(size_t size, size_t alignment = alignof(std::max_align_t)) noexcept = 0;
+        // `size` is what was passed to allocate()
+        virtual void deallocate(void* pointer, size_t size) noexcept = 0;
+
+        [[nodiscard]] memory_tag tag() const noexcept { return _tag; }
+
+    protected:
+        memory_tag  _tag;
+    };
+
+    [[nodiscard]] constexpr size_t align_up(const size_t value, const size_t alignment) noexcept
+    {
+        return (value + alignment - 1) & ~(alignment - 1);
+    }
+
+    // Standard allocator over any allocator_t, for containers kept inside a sub-allocator's reservation, e.g.
+    // std::vector<T, allocator_ref_t<T>> items{ allocator_ref_t<T>{ stack } }. The allocator must outlive them
+    template<typename T>
+    class allocator_ref_t
+    {
+    public:
+        using value_type = T;
+
+        explicit allocator_ref_t(allocator_t& allocator) noexcept : _allocator{ &allocator } {}
+        template<typename U>
+        allocator_ref_t(const allocator_ref_t<U>& other) noexcept : _allocator{ other.allocator() } {}
+
+        [[nodiscard]] T* allocate(const size_t count)
+        {
+            void* memory{ _allocator->allocate(count * sizeof(T), alignof(T)) };
+            // Containers have no way to handle a null allocation; size the allocator for their peak
+            if (memory == nullptr) std::abort();
+            return static_cast<T*>(memory);
+        }
+
+        void deallocate(T* pointer, const size_t count) noexcept { _allocator->deallocate(pointer, count * sizeof(T)); }
+
+        [[nodiscard]] allocator_t* allocator() const noexcept { return _allocator; }
+
+        template<typename U>
+        [[nodiscard]] bool operator==(const allocator_ref_t<U>& other) const noexcept
+        {
+            return _allocator == other.allocator();
+        }
+
+    private:
+        allocator_t*    _allocator;
+    };
+} // namespace carrot::memory
@@ -0,0 +1,112 @@
+//
+// Created by zshrout on 10/18/26.
+// Copyright (c) 2026 BunnySofty. All rights reserved.
+//
+
+#include "FrameArena.h"
+#include "HeapAllocator.h"
+
+#include <algorithm>
+#include <atomic>
+
+namespace carrot::memory {
+    namespace {
+        std::atomic<uint64_t> g_frame_epoch{ 0 };
+        thread_local frame_arena_t t_arena;
+
+        [[nodiscard]] std::byte* align_up(std::byte* pointer, const size_t alignment) noexcept
+        {
+            const auto address{ reinterpret_cast<uintptr_t>(pointer) };
+            return pointer + ((alignment - address % alignment) % alignment);
+        }
+    } // anonymous namespace
+
+    // PUBLIC
+    frame_arena_t::~frame_arena_t()
+    {
+        release();
+    }
+
+    void* frame_arena_t::allocate(const size_t size, const size_t alignment) noexcept
+    {
+        std::byte* start{ align_up(_cursor, alignment) };
+        if (_cursor == nullptr || start + size > _end)
+        {
+            // Later blocks left over from before a reset come first, then a new one big enough for this request
+            do
+            {
+                if (_current + 1 < _blocks.size() || add_block(size + alignment))
+                {
+                    if (_cursor != nullptr) ++_current;
+                    _cursor = _blocks[_current].data;
+                    _end = _cursor + _blocks[_current].size;
+                }
+                else
+                    return nullptr;
+
+                start = align_up(_cursor, alignment);
+            } while (start + size > _end);
+        }
+
+        _used += static_cast<size_t>(start + size - _cursor);
+        _high_water = std::max(_high_water, _used);
+        _cursor = start + size;
+        return start;
+    }
+
+    void frame_arena_t::reset() noexcept
+    {
+        // A frame that spilled into several blocks gets one that holds all of it from now on
+        if (_blocks.size() > 1)
+        {
+            const size_t size{ _high_water };
+            release();
+            _high_water = size;
+            if (!add_block(size)) return;
+        }
+
+        _current = 0;
+        _cursor = _blocks.empty() ? nullptr : _blocks.front().data;
+        _end = _blocks.empty() ? nullptr : _cursor + _blocks.front().size;
+        _used = 0;
+    }
+
+    // PRIVATE
+    bool frame_arena_t::add_block(const size_t min_size) noexcept
+    {
+        const size_t size{ std::max(min_size, k_min_block_size) };
+        auto* data{ static_cast<std::byte*>(heap_allocate(size, alignof(std::max_align_t), memory_tag::core)) };
+        if (data == nullptr) return false;
+
+        _blocks.push_back({ data, size });
+        _capacity += size;
+        return true;
+    }
+
+    void frame_arena_t::release() noexcept
+    {
+        for (const block_t& block: _blocks)
+            heap_free(block.data, block.size, memory_tag::core);
+        _blocks.clear();
+
+        _current = 0;
+        _cursor = _end = nullptr;
+        _used = _capacity = _high_water = 0;
+    }
+
+    frame_arena_t& frame_arena() noexcept
+    {
+        const uint64_t epoch{ g_frame_epoch.load(std::memory_order_acquire) };
+        if (t_arena._epoch != epoch)
+        {
+            t_arena.reset();
+            t_arena._epoch = epoch;
+        }
+        return t_arena;
+    }
+
+    void end_frame() noexcept
+    {
+        g_frame_epoch.fetch_add(1, std::memory_order_release);
+    }
+} // namespace carrot::memory
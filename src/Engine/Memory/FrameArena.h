@@ -0,0 +1,107 @@
+//
+// Created by zshrout on 10/18/26.
+// Copyright (c) 2026 BunnySofty. All rights reserved.
+//
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <string>
+#include <vector>
+
+// Included by Core/Logger.h, so nothing from the engine can be pulled in here
+
+namespace carrot::memory {
+    // Linear allocator for data that dies with the frame. Allocation bumps a pointer, nothing is freed on its own;
+    // reset() rewinds everything at once and keeps the memory. Blocks are added when a frame outgrows the arena,
+    // and folded into a single block of the high-water size on the next reset, so after a few frames every
+    // allocation comes out of one block and the arena stops touching the heap.
+    class frame_arena_t
+    {
+    public:
+        static constexpr size_t k_min_block_size{ 256 * 1024 };
+
+        frame_arena_t() noexcept = default;
+        ~frame_arena_t();
+
+        frame_arena_t(const frame_arena_t&) = delete;
+        frame_arena_t& operator=(const frame_arena_t&) = delete;
+
+        // `alignment` must be a power of two. Null only when the heap is exhausted
+        [[nodiscard]] void* allocate(size_t size, size_t alignment = alignof(std::max_align_t)) noexcept;
+        void reset() noexcept;
+
+        [[nodiscard]] size_t used() const noexcept { return _used; }
+        [[nodiscard]] size_t capacity() const noexcept { return _capacity; }
+        [[nodiscard]] size_t high_water() const noexcept { return _high_water; }
+
+    private:
+        struct block_t
+        {
+            std::byte*  data{ nullptr };
+            size_t      size{ 0 };
+        };
+
+        [[nodiscard]] bool add_block(size_t min_size) noexcept;
+        void release() noexcept;
+
+        std::vector<block_t>    _blocks;
+        size_t                  _current{ 0 };      // block the cursor is in
+        std::byte*              _cursor{ nullptr };
+        std::byte*              _end{ nullptr };
+
+        size_t                  _used{ 0 };         // bytes handed out since the last reset, padding included
+        size_t                  _capacity{ 0 };
+        size_t                  _high_water{ 0 };
+        uint64_t                _epoch{ 0 };        // frame the arena was last reset for, see frame_arena()
+
+        friend frame_arena_t& frame_arena() noexcept;
+    };
+
+    // The calling thread's arena. It is reset lazily, on the first call in a frame after end_frame(), so worker
+    // threads never race the main thread over their arena. Anything taken from it is invalid after end_frame().
+    [[nodiscard]] frame_arena_t& frame_arena() noexcept;
+    // Ends the frame for every thread's arena; the engine calls it at the end of each loop iteration
+    void end_frame() noexcept;
+
+    // Standard allocator over a frame arena, the calling thread's unless given one. deallocate() is a no-op, so a
+    // container that grows leaves its old storage behind until the reset; reserve() up front where it matters.
+    template<typename T>
+    class frame_allocator_t
+    {
+    public:
+        using value_type = T;
+
+        frame_allocator_t() noexcept : _arena{ &frame_arena() } {}
+        explicit frame_allocator_t(frame_arena_t& arena) noexcept : _arena{ &arena } {}
+        template<typename U>
+        frame_allocator_t(const frame_allocator_t<U>& other) noexcept : _arena{ other.arena() } {}
+
+        [[nodiscard]] T* allocate(const size_t count)
+        {
+            void* memory{ _arena->allocate(count * sizeof(T), alignof(T)) };
+            // Containers have no way to handle a null allocation, and the engine does not use exceptions
+            if (memory == nullptr) std::abort();
+            return static_cast<T*>(memory);
+        }
+
+        void deallocate(T*, size_t) noexcept {}
+
+        [[nodiscard]] frame_arena_t* arena() const noexcept { return _arena; }
+
+        template<typename U>
+        [[nodiscard]] bool operator==(const frame_allocator_t<U>& other) const noexcept
+        {
+            return _arena == other.arena();
+        }
+
+    private:
+        frame_arena_t*  _arena;
+    };
+
+    template<typename T>
+    using frame_vector_t = std::vector<T, frame_allocator_t<T>>;
+    using frame_string_t = std::basic_string<char, std::char_traits<char>, frame_allocator_t<char>>;
+} // namespace carrot::memory
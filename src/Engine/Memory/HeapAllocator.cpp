@@ -0,0 +1,55 @@
+//
+// Created by zshrout on 10/18/26.
+// Copyright (c) 2026 BunnySofty. All rights reserved.
+//
+
+#include "HeapAllocator.h"
+
+#include <algorithm>
+
+#ifdef _WIN32
+#include <malloc.h>
+#endif
+
+namespace carrot::memory {
+    void* heap_allocate(const size_t size, const size_t alignment, const memory_tag tag) noexcept
+    {
+        CE_ASSERT((alignment & (alignment - 1)) == 0, "Alignment must be a power of two");
+
+        const size_t heap_alignment{ std::max(alignment, alignof(std::max_align_t)) };
+#ifdef _WIN32
+        void* pointer{ _aligned_malloc(std::max<size_t>(size, 1), heap_alignment) };
+#else
+        // aligned_alloc wants the size to be a multiple of the alignment
+        void* pointer{ std::aligned_alloc(heap_alignment, align_up(std::max<size_t>(size, 1), heap_alignment)) };
+#endif
+        // Not logged: the logger formats into the frame arena, which allocates from here
+        if (pointer == nullptr) return nullptr;
+
+        track_allocation(tag, size);
+        return pointer;
+    }
+
+    void heap_free(void* pointer, const size_t size, const memory_tag tag) noexcept
+    {
+        if (pointer == nullptr) return;
+
+        track_free(tag, size);
+#ifdef _WIN32
+        _aligned_free(pointer);
+#else
+        std::free(pointer);
+#endif
+    }
+
+    // ── heap_allocator_t ────────────────────────────────────────
+    void* heap_allocator_t::allocate(const size_t size, const size_t alignment) noexcept
+    {
+        return heap_allocate(size, alignment, _tag);
+    }
+
+    void heap_allocator_t::deallocate(void* pointer, const size_t size) noexcept
+    {
+        heap_free(pointer, size, _tag);
+    }
+} // namespace carrot::memory
@@ -0,0 +1,63 @@
+//
+// Created by zshrout on 10/18/26.
+// Copyright (c) 2026 BunnySofty. All rights reserved.
+//
+
+#pragma once
+
+#include "Allocator.h"
+
+#include <cstdlib>
+#include <vector>
+
+namespace carrot::memory {
+    // The system heap, charged to `tag`. The engine's allocators and tagged containers take their memory from here;
+    // anything allocated with plain new or malloc bypasses it and is not tracked. Thread-safe
+    [[nodiscard]] void* heap_allocate(size_t size, size_t alignment, memory_tag tag) noexcept;
+    // `size` and `tag` are what was passed to heap_allocate()
+    void heap_free(void* pointer, size_t size, memory_tag tag) noexcept;
+
+    // General-purpose allocations, one heap allocation each. Thread-safe, unlike the other allocators
+    class heap_allocator_t final : public allocator_t
+    {
+    public:
+        using allocator_t::allocator_t;
+
+        [[nodiscard]] void* allocate(size_t size, size_t alignment = alignof(std::max_align_t)) noexcept override;
+        void deallocate(void* pointer, size_t size) noexcept override;
+    };
+
+    // Standard allocator over the heap for containers owned by one subsystem, e.g.
+    // std::vector<T, tagged_allocator_t<T, memory_tag::asset>>
+    template<typename T, memory_tag Tag>
+    struct tagged_allocator_t
+    {
+        using value_type = T;
+
+        template<typename U>
+        struct rebind
+        {
+            using other = tagged_allocator_t<U, Tag>;
+        };
+
+        tagged_allocator_t() noexcept = default;
+        template<typename U>
+        tagged_allocator_t(const tagged_allocator_t<U, Tag>&) noexcept {}
+
+        [[nodiscard]] T* allocate(const size_t count)
+        {
+            void* memory{ heap_allocate(count * sizeof(T), alignof(T), Tag) };
+            // Containers have no way to handle a null allocation, and the engine does not use exceptions
+            if (memory == nullptr) std::abort();
+            return static_cast<T*>(memory);
+        }
+
+        void deallocate(T* pointer, const size_t count) noexcept { heap_free(pointer, count * sizeof(T), Tag); }
+
+        template<typename U>
+        [[nodiscard]] bool operator==(const tagged_allocator_t<U, Tag>&) const noexcept { return true; }
+    };
+
+    template<typename T, memory_tag Tag>
+    using tagged_vector_t = std::vector<T, tagged_allocator_t<T, Tag>>;
+} // namespace carrot::memory
@@ -0,0 +1,42 @@
+//
+// Created by zshrout on 10/18/26.
+// Copyright (c) 2026 BunnySofty. All rights reserved.
+//
+
+#include "LinearAllocator.h"
+#include "HeapAllocator.h"
+
+namespace carrot::memory {
+    // PUBLIC
+    bool linear_allocator_t::init(const size_t capacity) noexcept
+    {
+        CE_ASSERT(_memory == nullptr, "Linear allocator initialized twice");
+
+        _memory = static_cast<std::byte*>(heap_allocate(capacity, alignof(std::max_align_t), _tag));
+        if (_memory == nullptr) return false;
+
+        _capacity = capacity;
+        _offset = 0;
+        return true;
+    }
+
+    void linear_allocator_t::shutdown() noexcept
+    {
+        if (_memory == nullptr) return;
+
+        heap_free(_memory, _capacity, _tag);
+        _memory = nullptr;
+        _capacity = _offset = 0;
+    }
+
+    void* linear_allocator_t::allocate(const size_t size, const size_t alignment) noexcept
+    {
+        // Aligned by address, so alignments above the buffer's own still hold
+        const auto base{ reinterpret_cast<uintptr_t>(_memory) };
+        const size_t start{ align_up(base + _offset, alignment) - base };
+        if (_memory == nullptr || start + size > _capacity) return nullptr;
+
+        _offset = start + size;
+        return _memory + start;
+    }
+} // namespace carrot::memory
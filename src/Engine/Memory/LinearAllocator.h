@@ -0,0 +1,34 @@
+//
+// Created by zshrout on 10/18/26.
+// Copyright (c) 2026 BunnySofty. All rights reserved.
+//
+
+#pragma once
+
+#include "Allocator.h"
+
+namespace carrot::memory {
+    // Bump allocator over one fixed heap allocation. Individual frees do nothing; reset() releases everything at
+    // once. Unlike frame_arena_t it never grows, so it suits lifetimes with a known upper bound (loading a level).
+    class linear_allocator_t final : public allocator_t
+    {
+    public:
+        using allocator_t::allocator_t;
+        ~linear_allocator_t() override { shutdown(); }
+
+        [[nodiscard]] bool init(size_t capacity) noexcept;
+        void shutdown() noexcept;
+
+        [[nodiscard]] void* allocate(size_t size, size_t alignment = alignof(std::max_align_t)) noexcept override;
+        void deallocate(void*, size_t) noexcept override {}
+        void reset() noexcept { _offset = 0; }
+
+        [[nodiscard]] size_t used() const noexcept { return _offset; }
+        [[nodiscard]] size_t capacity() const noexcept { return _capacity; }
+
+    private:
+        std::byte*  _memory{ nullptr };
+        size_t      _capacity{ 0 };
+        size_t      _offset{ 0 };
+    };
+} // namespace carrot::memory
@@ -0,0 +1,117 @@
+//
+// Created by zshrout on 10/18/26.
+// Copyright (c) 2026 BunnySofty. All rights reserved.
+//
+
+#include "MemoryTracker.h"
+
+#include "Core/Logger.h"
+
+#include <array>
+#include <atomic>
+
+namespace carrot::memory {
+    namespace {
+        struct tag_counters_t
+        {
+            std::atomic<uint64_t>   live_bytes{ 0 };
+            std::atomic<uint64_t>   peak_bytes{ 0 };
+            std::atomic<uint64_t>   allocation_count{ 0 };
+            std::atomic<uint64_t>   budget_bytes{ 0 };
+        };
+
+        constexpr std::array<const char*, k_tag_count> k_tag_names{
+            "CORE", "GRAPHICS", "AUDIO", "PHYSICS", "INPUT", "NETWORK", "UI", "ASSET", "SCRIPT"
+        };
+
+        std::array<tag_counters_t, k_tag_count> g_counters;
+
+        [[nodiscard]] tag_counters_t& counters(const memory_tag tag) noexcept
+        {
+            return g_counters[static_cast<size_t>(tag)];
+        }
+
+        [[nodiscard]] double to_mib(const uint64_t bytes) noexcept
+        {
+            return static_cast<double>(bytes) / (1024.0 * 1024.0);
+        }
+    } // anonymous namespace
+
+    const char* tag_to_string(const memory_tag tag) noexcept
+    {
+        return tag < memory_tag::count ? k_tag_names[static_cast<size_t>(tag)] : "???";
+    }
+
+    bool tag_from_string(const std::string_view name, memory_tag& tag) noexcept
+    {
+        for (size_t i{ 0 }; i < k_tag_count; ++i)
+        {
+            const std::string_view candidate{ k_tag_names[i] };
+            if (candidate.size() != name.size()) continue;
+
+            bool equal{ true };
+            for (size_t c{ 0 }; c < name.size() && equal; ++c)
+                equal = (name[c] & ~0x20) == candidate[c]; // names are upper-case letters only
+
+            if (equal)
+            {
+                tag = static_cast<memory_tag>(i);
+                return true;
+            }
+        }
+        return false;
+    }
+
+    void track_allocation(const memory_tag tag, const size_t size) noexcept
+    {
+        tag_counters_t& tag_counters{ counters(tag) };
+        const uint64_t before{ tag_counters.live_bytes.fetch_add(size, std::memory_order_relaxed) };
+        const uint64_t live{ before + size };
+        tag_counters.allocation_count.fetch_add(1, std::memory_order_relaxed);
+
+        uint64_t peak{ tag_counters.peak_bytes.load(std::memory_order_relaxed) };
+        while (live > peak && !tag_counters.peak_bytes.compare_exchange_weak(peak, live, std::memory_order_relaxed)) {}
+
+        // Only the allocation that crosses the line reports it, so a subsystem living above budget does not spam
+        const uint64_t budget{ tag_counters.budget_bytes.load(std::memory_order_relaxed) };
+        if (budget != 0 && before <= budget && live > budget)
+            LOG_CORE_WARN("[Memory] {} is over budget: {:.1f} of {:.1f} MiB", tag_to_string(tag), to_mib(live),
+                          to_mib(budget));
+    }
+
+    void track_free(const memory_tag tag, const size_t size) noexcept
+    {
+        tag_counters_t& tag_counters{ counters(tag) };
+        tag_counters.live_bytes.fetch_sub(size, std::memory_order_relaxed);
+        tag_counters.allocation_count.fetch_sub(1, std::memory_order_relaxed);
+    }
+
+    void set_budget(const memory_tag tag, const uint64_t bytes) noexcept
+    {
+        counters(tag).budget_bytes.store(bytes, std::memory_order_relaxed);
+
+        const uint64_t live{ counters(tag).live_bytes.load(std::memory_order_relaxed) };
+        if (bytes != 0 && live > bytes)
+            LOG_CORE_WARN("[Memory] {} is over budget: {:.1f} of {:.1f} MiB", tag_to_string(tag), to_mib(live),
+                          to_mib(bytes));
+    }
+
+    tag_stats_t tag_stats(const memory_tag tag) noexcept
+    {
+        const tag_counters_t& tag_counters{ counters(tag) };
+        return {
+            tag_counters.live_bytes.load(std::memory_order_relaxed),
+            tag_counters.peak_bytes.load(std::memory_order_relaxed),
+            tag_counters.allocation_count.load(std::memory_order_relaxed),
+            tag_counters.budget_bytes.load(std::memory_order_relaxed),
+        };
+    }
+
+    uint64_t total_live_bytes() noexcept
+    {
+        uint64_t total{ 0 };
+        for (const tag_counters_t& tag_counters: g_counters)
+            total += tag_counters.live_bytes.load(std::memory_order_relaxed);
+        return total;
+    }
+} // namespace carrot::memory
@@ -0,0 +1,59 @@
+//
+// Created by zshrout on 10/18/26.
+// Copyright (c) 2026 BunnySofty. All rights reserved.
+//
+
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+
+namespace carrot::memory {
+    // Subsystem that owns a block of memory, mirroring core::log_category. Unlike a category an allocation has
+    // exactly one owner, so these are indices rather than bits.
+    enum class memory_tag : uint8_t
+    {
+        core,
+        graphics,
+        audio,
+        physics,
+        input,
+        network,
+        ui,
+        asset,
+        script,
+
+        count
+    };
+
+    inline constexpr size_t k_tag_count{ static_cast<size_t>(memory_tag::count) };
+    // Bytes per tag, indexed by memory_tag; 0 for none
+    using tag_budgets_t = std::array<uint64_t, k_tag_count>;
+
+    struct tag_stats_t
+    {
+        uint64_t    live_bytes{ 0 };
+        uint64_t    peak_bytes{ 0 };
+        uint64_t    allocation_count{ 0 };  // live allocations
+        uint64_t    budget_bytes{ 0 };      // 0 when unbudgeted
+
+        [[nodiscard]] bool over_budget() const noexcept { return budget_bytes != 0 && live_bytes > budget_bytes; }
+    };
+
+    [[nodiscard]] const char* tag_to_string(memory_tag tag) noexcept;
+    // Case-insensitive; false when no tag has that name
+    [[nodiscard]] bool tag_from_string(std::string_view name, memory_tag& tag) noexcept;
+
+    // Fed by heap_allocate() and heap_free(). Only memory routed through carrot::memory is seen: the allocators'
+    // reservations, frame arena blocks and tagged containers. Plain new, malloc and driver allocations are not,
+    // so a tag reads what its subsystem has moved onto tagged storage. Thread-safe and lock-free.
+    void track_allocation(memory_tag tag, size_t size) noexcept;
+    void track_free(memory_tag tag, size_t size) noexcept;
+
+    // Crossing the budget is logged once per crossing; allocations still succeed. 0 removes the budget
+    void set_budget(memory_tag tag, uint64_t bytes) noexcept;
+    [[nodiscard]] tag_stats_t tag_stats(memory_tag tag) noexcept;
+    [[nodiscard]] uint64_t total_live_bytes() noexcept;
+} // namespace carrot::memory
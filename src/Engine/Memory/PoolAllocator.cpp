@@ -0,0 +1,67 @@
+//
+// Created by zshrout on 10/18/26.
+// Copyright (c) 2026 BunnySofty. All rights reserved.
+//
+
+#include "PoolAllocator.h"
+#include "HeapAllocator.h"
+
+#include <algorithm>
+#include <new>
+
+namespace carrot::memory {
+    // PUBLIC
+    bool pool_allocator_t::init(const size_t block_size, const size_t block_count, const size_t alignment) noexcept
+    {
+        CE_ASSERT(_memory == nullptr, "Pool allocator initialized twice");
+
+        // Every block has to hold a free-list link and keep the next one aligned
+        const size_t block_alignment{ std::max(alignment, alignof(free_block_t)) };
+        const size_t stride{ align_up(std::max(block_size, sizeof(free_block_t)), block_alignment) };
+
+        _memory = static_cast<std::byte*>(heap_allocate(stride * block_count, block_alignment, _tag));
+        if (_memory == nullptr) return false;
+
+        _block_size = stride;
+        _block_count = block_count;
+        _alignment = block_alignment;
+        _used_blocks = 0;
+
+        // Linked front to back, so a fresh pool hands out blocks in address order
+        _free = nullptr;
+        for (size_t i{ block_count }; i-- > 0;)
+            _free = new(_memory + i * stride) free_block_t{ _free };
+        return true;
+    }
+
+    void pool_allocator_t::shutdown() noexcept
+    {
+        if (_memory == nullptr) return;
+
+        CE_ENSURE(_used_blocks == 0, "Pool allocator shut down with blocks still allocated");
+        heap_free(_memory, _block_size * _block_count, _tag);
+        _memory = nullptr;
+        _free = nullptr;
+        _block_size = _block_count = _alignment = _used_blocks = 0;
+    }
+
+    void* pool_allocator_t::allocate(const size_t size, const size_t alignment) noexcept
+    {
+        CE_ASSERT(size <= _block_size && alignment <= _alignment, "Request does not fit a pool block");
+        if (_free == nullptr) return nullptr;
+
+        free_block_t* block{ _free };
+        _free = block->next;
+        ++_used_blocks;
+        return block;
+    }
+
+    void pool_allocator_t::deallocate(void* pointer, size_t) noexcept
+    {
+        if (pointer == nullptr) return;
+
+        CE_ASSERT(pointer >= _memory && pointer < _memory + _block_size * _block_count, "Block is not from this pool");
+        _free = new(pointer) free_block_t{ _free };
+        --_used_blocks;
+    }
+} // namespace carrot::memory
@@ -0,0 +1,43 @@
+//
+// Created by zshrout on 10/18/26.
+// Copyright (c) 2026 BunnySofty. All rights reserved.
+//
+
+#pragma once
+
+#include "Allocator.h"
+
+namespace carrot::memory {
+    // Fixed-size blocks carved from one heap allocation, with the free ones linked through their own storage.
+    // Allocation and free are O(1) and never fragment; any request up to the block size takes a whole block.
+    class pool_allocator_t final : public allocator_t
+    {
+    public:
+        using allocator_t::allocator_t;
+        ~pool_allocator_t() override { shutdown(); }
+
+        [[nodiscard]] bool init(size_t block_size, size_t block_count,
+                                size_t alignment = alignof(std::max_align_t)) noexcept;
+        void shutdown() noexcept;
+
+        [[nodiscard]] void* allocate(size_t size, size_t alignment = alignof(std::max_align_t)) noexcept override;
+        void deallocate(void* pointer, size_t size) noexcept override;
+
+        [[nodiscard]] size_t block_size() const noexcept { return _block_size; }
+        [[nodiscard]] size_t block_count() const noexcept { return _block_count; }
+        [[nodiscard]] size_t used_blocks() const noexcept { return _used_blocks; }
+
+    private:
+        struct free_block_t
+        {
+            free_block_t*   next;
+        };
+
+        std::byte*      _memory{ nullptr };
+        free_block_t*   _free{ nullptr };
+        size_t          _block_size{ 0 };
+        size_t          _block_count{ 0 };
+        size_t          _alignment{ 0 };
+        size_t          _used_blocks{ 0 };
+    };
+} // namespace carrot::memory
@@ -0,0 +1,63 @@
+//
+// Created by zshrout on 10/18/26.
+// Copyright (c) 2026 BunnySofty. All rights reserved.
+//
+
+#include "StackAllocator.h"
+#include "HeapAllocator.h"
+
+#include <algorithm>
+#include <new>
+
+namespace carrot::memory {
+    // PUBLIC
+    bool stack_allocator_t::init(const size_t capacity) noexcept
+    {
+        CE_ASSERT(_memory == nullptr, "Stack allocator initialized twice");
+
+        _memory = static_cast<std::byte*>(heap_allocate(capacity, alignof(std::max_align_t), _tag));
+        if (_memory == nullptr) return false;
+
+        _capacity = capacity;
+        _offset = 0;
+        return true;
+    }
+
+    void stack_allocator_t::shutdown() noexcept
+    {
+        if (_memory == nullptr) return;
+
+        CE_ENSURE(_offset == 0, "Stack allocator shut down with allocations still on it");
+        heap_free(_memory, _capacity, _tag);
+        _memory = nullptr;
+        _capacity = _offset = 0;
+    }
+
+    void* stack_allocator_t::allocate(const size_t size, const size_t alignment) noexcept
+    {
+        // The header sits right below the allocation and stays aligned with it
+        const auto base{ reinterpret_cast<uintptr_t>(_memory) };
+        const size_t header_end{ base + _offset + sizeof(header_t) };
+        const size_t start{ align_up(header_end, std::max(alignment, alignof(header_t))) - base };
+        if (_memory == nullptr || start + size > _capacity) return nullptr;
+
+        new(_memory + start - sizeof(header_t)) header_t{ _offset };
+        _offset = start + size;
+        return _memory + start;
+    }
+
+    void stack_allocator_t::deallocate(void* pointer, const size_t size) noexcept
+    {
+        if (pointer == nullptr) return;
+
+        std::byte* top{ static_cast<std::byte*>(pointer) };
+        CE_ASSERT(top + size == _memory + _offset, "Stack allocations must be freed in reverse order");
+        _offset = reinterpret_cast<const header_t*>(top - sizeof(header_t))->previous_offset;
+    }
+
+    void stack_allocator_t::rewind(const marker_t marker) noexcept
+    {
+        CE_ASSERT(marker <= _offset, "Marker is above the top of the stack");
+        _offset = marker;
+    }
+} // namespace carrot::memory
@@ -0,0 +1,46 @@
+//
+// Created by zshrout on 10/18/26.
+// Copyright (c) 2026 BunnySofty. All rights reserved.
+//
+
+#pragma once
+
+#include "Allocator.h"
+
+namespace carrot::memory {
+    // LIFO allocator over one fixed heap allocation: only the most recent allocation can be freed, or everything
+    // since a marker at once. Suits nested scopes of temporary data that the frame arena would keep too long.
+    class stack_allocator_t final : public allocator_t
+    {
+    public:
+        using marker_t = size_t;
+
+        using allocator_t::allocator_t;
+        ~stack_allocator_t() override { shutdown(); }
+
+        [[nodiscard]] bool init(size_t capacity) noexcept;
+        void shutdown() noexcept;
+
+        [[nodiscard]] void* allocate(size_t size, size_t alignment = alignof(std::max_align_t)) noexcept override;
+        // `pointer` must be the top of the stack
+        void deallocate(void* pointer, size_t size) noexcept override;
+
+        [[nodiscard]] marker_t mark() const noexcept { return _offset; }
+        // Frees everything allocated since mark() returned `marker`
+        void rewind(marker_t marker) noexcept;
+
+        [[nodiscard]] size_t used() const noexcept { return _offset; }
+        [[nodiscard]] size_t capacity() const noexcept { return _capacity; }
+
+    private:
+        // Stored right below every allocation, so deallocate() can restore the top of the stack
+        struct header_t
+        {
+            size_t  previous_offset;
+        };
+
+        std::byte*  _memory{ nullptr };
+        size_t      _capacity{ 0 };
+        size_t      _offset{ 0 };
+    };
+} // namespace carrot::memory
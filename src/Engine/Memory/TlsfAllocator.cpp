@@ -0,0 +1,70 @@
+//
+// Created by zshrout on 10/18/26.
+// Copyright (c) 2026 BunnySofty. All rights reserved.
+//
+
+#include "TlsfAllocator.h"
+#include "HeapAllocator.h"
+
+#include <algorithm>
+#include <cstring>
+
+namespace carrot::memory {
+    namespace {
+        // tlsf_t frees by node rather than by address, so the node is stored in front of every allocation
+        using node_header_t = uint32_t;
+
+        [[nodiscard]] size_t header_size(const size_t alignment) noexcept
+        {
+            return align_up(sizeof(node_header_t), alignment);
+        }
+    } // anonymous namespace
+
+    // PUBLIC
+    bool tlsf_allocator_t::init(const size_t capacity) noexcept
+    {
+        CE_ASSERT(_memory == nullptr, "TLSF allocator initialized twice");
+
+        _memory = static_cast<std::byte*>(heap_allocate(capacity, alignof(std::max_align_t), _tag));
+        if (_memory == nullptr) return false;
+
+        _tlsf.init(capacity);
+        return true;
+    }
+
+    void tlsf_allocator_t::shutdown() noexcept
+    {
+        if (_memory == nullptr) return;
+
+        CE_ENSURE(_tlsf.empty(), "TLSF allocator shut down with allocations still live");
+        heap_free(_memory, _tlsf.capacity(), _tag);
+        _memory = nullptr;
+        _tlsf = { };
+    }
+
+    void* tlsf_allocator_t::allocate(const size_t size, const size_t alignment) noexcept
+    {
+        if (_memory == nullptr) return nullptr;
+
+        // Offsets are aligned relative to the buffer, which is only max_align_t aligned itself
+        CE_ASSERT(alignment <= alignof(std::max_align_t), "Alignment above the TLSF buffer's own");
+
+        const size_t block_alignment{ std::max(alignment, alignof(node_header_t)) };
+        const size_t header{ header_size(block_alignment) };
+        const utils::tlsf_t::allocation_t allocation{ _tlsf.allocate(header + size, block_alignment) };
+        if (!allocation.is_valid()) return nullptr;
+
+        std::byte* pointer{ _memory + allocation.offset + header };
+        std::memcpy(pointer - sizeof(node_header_t), &allocation.node, sizeof(node_header_t));
+        return pointer;
+    }
+
+    void tlsf_allocator_t::deallocate(void* pointer, size_t) noexcept
+    {
+        if (pointer == nullptr) return;
+
+        node_header_t node{ 0 };
+        std::memcpy(&node, static_cast<const std::byte*>(pointer) - sizeof(node_header_t), sizeof(node_header_t));
+        _tlsf.free(node);
+    }
+} // namespace carrot::memory
@@ -0,0 +1,35 @@
+//
+// Created by zshrout on 10/18/26.
+// Copyright (c) 2026 BunnySofty. All rights reserved.
+//
+
+#pragma once
+
+#include "Allocator.h"
+#include "Utils/Tlsf.h"
+
+namespace carrot::memory {
+    // General-purpose allocator over one fixed heap allocation, with utils::tlsf_t doing the bookkeeping. O(1)
+    // allocation and free with low fragmentation, for long-lived allocations of mixed sizes that a subsystem
+    // wants kept inside its own reservation.
+    class tlsf_allocator_t final : public allocator_t
+    {
+    public:
+        using allocator_t::allocator_t;
+        ~tlsf_allocator_t() override { shutdown(); }
+
+        [[nodiscard]] bool init(size_t capacity) noexcept;
+        void shutdown() noexcept;
+
+        [[nodiscard]] void* allocate(size_t size, size_t alignment = alignof(std::max_align_t)) noexcept override;
+        void deallocate(void* pointer, size_t size) noexcept override;
+
+        [[nodiscard]] size_t used() const noexcept { return _tlsf.used(); }
+        [[nodiscard]] size_t capacity() const noexcept { return _tlsf.capacity(); }
+        [[nodiscard]] size_t largest_free_region() const noexcept { return _tlsf.largest_free_region(); }
+
+    private:
+        std::byte*      _memory{ nullptr };
+        utils::tlsf_t   _tlsf;
+    };
+} // namespace carrot::memory
@@ -0,0 +1,391 @@
+//
+// Created by zshrout on 10/18/26.
+// Copyright (c) 2026 BunnySofty. All rights reserved.
+//
+
+#include "VulkanAllocator.h"
+
+#include "Common/CommonHeaders.h"
+
+#include <algorithm>
+#include <new>
+
+namespace carrot::rhi::vulkan {
+    namespace {
+        constexpr VkDeviceSize k_default_block_size{ 64ull * 1024 * 1024 };
+        constexpr VkDeviceSize k_small_heap_size{ 1024ull * 1024 * 1024 };
+        constexpr uint32_t k_no_block{ ~0u };
+        // Block records are pooled: blocks come and go as resources are recreated. 256 default blocks are 16 GiB
+        constexpr size_t k_max_blocks{ 256 };
+
+        VkDeviceSize align_up(const VkDeviceSize value, const VkDeviceSize alignment) noexcept
+        {
+            return (value + alignment - 1) & ~(alignment - 1);
+        }
+    } // anonymous namespace
+
+    // PUBLIC
+    void gpu_allocator_t::init(VkPhysicalDevice physical_device, VkDevice device)
+    {
+        _device = device;
+        vkGetPhysicalDeviceMemoryProperties(physical_device, &_memory_properties);
+
+        VkPhysicalDeviceProperties props{ };
+        vkGetPhysicalDeviceProperties(physical_device, &props);
+        _buffer_image_granularity = std::max<VkDeviceSize>(props.limits.bufferImageGranularity, 1);
+        _non_coherent_atom_size = std::max<VkDeviceSize>(props.limits.nonCoherentAtomSize, 1);
+
+        CE_ENSURE(_block_records.init(sizeof(block_t), k_max_blocks, alignof(block_t)),
+                  "Out of memory for the GPU allocator's block records");
+    }
+
+    void gpu_allocator_t::shutdown()
+    {
+        const gpu_memory_stats_t final_stats{ stats() };
+        if (final_stats.allocation_count != 0)
+        {
+            LOG_GRAPHICS_WARN("[Vulkan] {} GPU allocation(s) ({} bytes) still alive at shutdown",
+                              final_stats.allocation_count, final_stats.used_bytes);
+        }
+
+        std::lock_guard<std::mutex> lock{ _mutex };
+        for (uint32_t i{ 0 }; i < _blocks.size(); ++i)
+            destroy_block(i);
+        _blocks.clear();
+        _block_records.shutdown();
+    }
+
+    gpu_allocation_t gpu_allocator_t::allocate(const VkMemoryRequirements& requirements,
+                                               const VkMemoryPropertyFlags properties, const resource_tiling tiling)
+    {
+        std::lock_guard<std::mutex> lock{ _mutex };
+        return allocate_locked(requirements, properties, tiling, false, nullptr);
+    }
+
+    void gpu_allocator_t::free(gpu_allocation_t& allocation) noexcept
+    {
+        if (!allocation.is_valid()) return;
+
+        std::lock_guard<std::mutex> lock{ _mutex };
+
+        if (allocation.is_dedicated())
+        {
+            vkFreeMemory(_device, allocation.memory, nullptr); // implicitly unmaps
+            --_dedicated_count;
+            _dedicated_bytes -= allocation.size;
+        }
+        else
+        {
+            block_t& block{ *_blocks[allocation.block] };
+            block.tlsf.free(allocation.node);
+
+            // Keep one block per memory type and tiling around so a single resource being recreated does not
+            // bounce a whole block in and out of the driver
+            if (block.tlsf.empty())
+            {
+                const bool has_sibling{
+                    std::ranges::any_of(_blocks, [&](const block_t* other) {
+                        return other && other != &block &&
+                               other->memory_type == block.memory_type && other->tiling == block.tiling;
+                    })
+                };
+                if (has_sibling) destroy_block(allocation.block);
+            }
+        }
+
+        allocation = { };
+    }
+
+    bool gpu_allocator_t::create_buffer(const VkBufferCreateInfo& info, const VkMemoryPropertyFlags properties,
+                                        VkBuffer& buffer, gpu_allocation_t& allocation)
+    {
+        if (vkCreateBuffer(_device, &info, nullptr, &buffer) != VK_SUCCESS)
+        {
+            buffer = VK_NULL_HANDLE;
+            return false;
+        }
+
+        VkMemoryDedicatedRequirements dedicated{ };
+        dedicated.sType = VK_STRUCTURE_TYPE_MEMORY_DEDICATED_REQUIREMENTS;
+
+        VkMemoryRequirements2 requirements{ };
+        requirements.sType = VK_STRUCTURE_TYPE_MEMORY_REQUIREMENTS_2;
+        requirements.pNext = &dedicated;
+
+        VkBufferMemoryRequirementsInfo2 requirements_info{ };
+        requirements_info.sType = VK_STRUCTURE_TYPE_BUFFER_MEMORY_REQUIREMENTS_INFO_2;
+        requirements_info.buffer = buffer;
+        vkGetBufferMemoryRequirements2(_device, &requirements_info, &requirements);
+
+        VkMemoryDedicatedAllocateInfo dedicated_info{ };
+        dedicated_info.sType = VK_STRUCTURE_TYPE_MEMORY_DEDICATED_ALLOCATE_INFO;
+        dedicated_info.buffer = buffer;
+
+        {
+            std::lock_guard<std::mutex> lock{ _mutex };
+            allocation = allocate_locked(requirements.memoryRequirements, properties, resource_tiling::linear,
+                                         dedicated.prefersDedicatedAllocation || dedicated.requiresDedicatedAllocation,
+                                         &dedicated_info);
+        }
+
+        if (!allocation.is_valid() || vkBindBufferMemory(_device, buffer, allocation.memory, allocation.offset) != VK_SUCCESS)
+        {
+            destroy_buffer(buffer, allocation);
+            return false;
+        }
+        return true;
+    }
+
+    bool gpu_allocator_t::create_image(const VkImageCreateInfo& info, const VkMemoryPropertyFlags properties,
+                                       VkImage& image, gpu_allocation_t& allocation)
+    {
+        if (vkCreateImage(_device, &info, nullptr, &image) != VK_SUCCESS)
+        {
+            image = VK_NULL_HANDLE;
+            return false;
+        }
+
+        VkMemoryDedicatedRequirements dedicated{ };
+        dedicated.sType = VK_STRUCTURE_TYPE_MEMORY_DEDICATED_REQUIREMENTS;
+
+        VkMemoryRequirements2 requirements{ };
+        requirements.sType = VK_STRUCTURE_TYPE_MEMORY_REQUIREMENTS_2;
+        requirements.pNext = &dedicated;
+
+        VkImageMemoryRequirementsInfo2 requirements_info{ };
+        requirements_info.sType = VK_STRUCTURE_TYPE_IMAGE_MEMORY_REQUIREMENTS_INFO_2;
+        requirements_info.image = image;
+        vkGetImageMemoryRequirements2(_device, &requirements_info, &requirements);
+
+        VkMemoryDedicatedAllocateInfo dedicated_info{ };
+        dedicated_info.sType = VK_STRUCTURE_TYPE_MEMORY_DEDICATED_ALLOCATE_INFO;
+        dedicated_info.image = image;
+
+        const resource_tiling tiling{
+            info.tiling == VK_IMAGE_TILING_OPTIMAL ? resource_tiling::optimal : resource_tiling::linear
+        };
+
+        {
+            std::lock_guard<std::mutex> lock{ _mutex };
+            allocation = allocate_locked(requirements.memoryRequirements, properties, tiling,
+                                         dedicated.prefersDedicatedAllocation || dedicated.requiresDedicatedAllocation,
+                                         &dedicated_info);
+        }
+
+        if (!allocation.is_valid() || vkBindImageMemory(_device, image, allocation.memory, allocation.offset) != VK_SUCCESS)
+        {
+            destroy_image(image, allocation);
+            return false;
+        }
+        return true;
+    }
+
+    void gpu_allocator_t::destroy_buffer(VkBuffer& buffer, gpu_allocation_t& allocation) noexcept
+    {
+        if (buffer) vkDestroyBuffer(_device, buffer, nullptr);
+        buffer = VK_NULL_HANDLE;
+        free(allocation);
+    }
+
+    void gpu_allocator_t::destroy_image(VkImage& image, gpu_allocation_t& allocation) noexcept
+    {
+        if (image) vkDestroyImage(_device, image, nullptr);
+        image = VK_NULL_HANDLE;
+        free(allocation);
+    }
+
+    gpu_memory_stats_t gpu_allocator_t::stats() const
+    {
+        std::lock_guard<std::mutex> lock{ _mutex };
+
+        gpu_memory_stats_t result{ };
+        result.dedicated_count = _dedicated_count;
+        result.allocation_count = _dedicated_count;
+        result.reserved_bytes = _dedicated_bytes;
+        result.used_bytes = _dedicated_bytes;
+
+        for (const block_t* block: _blocks)
+        {
+            if (!block) continue;
+
+            ++result.block_count;
+            result.allocation_count += block->tlsf.allocation_count();
+            result.free_region_count += block->tlsf.free_region_count();
+            result.reserved_bytes += block->tlsf.capacity();
+            result.used_bytes += block->tlsf.used();
+            result.largest_free_region = std::max(result.largest_free_region, block->tlsf.largest_free_region());
+        }
+
+        return result;
+    }
+
+    // PRIVATE
+    gpu_allocation_t gpu_allocator_t::allocate_locked(const VkMemoryRequirements& requirements,
+                                                      const VkMemoryPropertyFlags properties, resource_tiling tiling,
+                                                      const bool dedicated,
+                                                      const VkMemoryDedicatedAllocateInfo* dedicated_info)
+    {
+        if (_buffer_image_granularity <= 1) tiling = resource_tiling::linear;
+
+        // Fall through to the next compatible memory type when one is exhausted
+        for (uint32_t type{ 0 }; type < _memory_properties.memoryTypeCount; ++type)
+        {
+            if (!(requirements.memoryTypeBits & 1u << type)) continue;
+            if ((_memory_properties.memoryTypes[type].propertyFlags & properties) != properties) continue;
+
+            const bool use_dedicated{ dedicated || requirements.size > block_size(type) / 2 };
+            const gpu_allocation_t allocation{
+                use_dedicated
+                    ? allocate_dedicated(requirements.size, type, dedicated_info)
+                    : allocate_from_blocks(requirements, type, tiling)
+            };
+            if (allocation.is_valid()) return allocation;
+        }
+
+        LOG_GRAPHICS_ERROR("[Vulkan] Out of device memory for a {} byte allocation", requirements.size);
+        return { };
+    }
+
+    gpu_allocation_t gpu_allocator_t::allocate_dedicated(const VkDeviceSize size, const uint32_t memory_type,
+                                                         const VkMemoryDedicatedAllocateInfo* dedicated_info)
+    {
+        VkMemoryAllocateInfo alloc_info{ };
+        alloc_info.sType = VK_STRUCTURE_TYPE_MEMORY_ALLOCATE_INFO;
+        alloc_info.pNext = dedicated_info;
+        alloc_info.allocationSize = size;
+        alloc_info.memoryTypeIndex = memory_type;
+
+        gpu_allocation_t allocation{ };
+        if (vkAllocateMemory(_device, &alloc_info, nullptr, &allocation.memory) != VK_SUCCESS) return { };
+
+        if (is_host_visible(memory_type))
+            vkMapMemory(_device, allocation.memory, 0, VK_WHOLE_SIZE, 0, &allocation.mapped);
+
+        allocation.size = size;
+        allocation.memory_type = memory_type;
+
+        ++_dedicated_count;
+        _dedicated_bytes += size;
+        return allocation;
+    }
+
+    gpu_allocation_t gpu_allocator_t::allocate_from_blocks(const VkMemoryRequirements& requirements,
+                                                           const uint32_t memory_type, const resource_tiling tiling)
+    {
+        // Non-coherent memory is flushed in whole atoms, keep neighbouring allocations out of each other's atoms
+        VkDeviceSize alignment{ std::max<VkDeviceSize>(requirements.alignment, 1) };
+        VkDeviceSize size{ requirements.size };
+        const VkMemoryPropertyFlags flags{ _memory_properties.memoryTypes[memory_type].propertyFlags };
+        if ((flags & VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT) && !(flags & VK_MEMORY_PROPERTY_HOST_COHERENT_BIT))
+        {
+            alignment = std::max(alignment, _non_coherent_atom_size);
+            size = align_up(size, _non_coherent_atom_size);
+        }
+
+        const auto make_allocation{
+            [&](const uint32_t index, const utils::tlsf_t::allocation_t& range) {
+                const block_t& block{ *_blocks[index] };
+
+                gpu_allocation_t allocation{ };
+                allocation.memory = block.memory;
+                allocation.offset = range.offset;
+                allocation.size = size;
+                allocation.mapped = block.mapped ? static_cast<std::byte*>(block.mapped) + range.offset : nullptr;
+                allocation.memory_type = memory_type;
+                allocation.block = index;
+                allocation.node = range.node;
+                return allocation;
+            }
+        };
+
+        for (uint32_t i{ 0 }; i < _blocks.size(); ++i)
+        {
+            block_t* block{ _blocks[i] };
+            if (!block || block->memory_type != memory_type || block->tiling != tiling) continue;
+
+            const utils::tlsf_t::allocation_t range{ block->tlsf.allocate(size, alignment) };
+            if (range.is_valid()) return make_allocation(i, range);
+        }
+
+        const uint32_t index{ create_block(memory_type, tiling) };
+        if (index == k_no_block) return { };
+
+        const utils::tlsf_t::allocation_t range{ _blocks[index]->tlsf.allocate(size, alignment) };
+        if (!range.is_valid()) return { };
+
+        return make_allocation(index, range);
+    }
+
+    uint32_t gpu_allocator_t::create_block(const uint32_t memory_type, const resource_tiling tiling)
+    {
+        const VkDeviceSize size{ block_size(memory_type) };
+
+        VkMemoryAllocateInfo alloc_info{ };
+        alloc_info.sType = VK_STRUCTURE_TYPE_MEMORY_ALLOCATE_INFO;
+        alloc_info.allocationSize = size;
+        alloc_info.memoryTypeIndex = memory_type;
+
+        void* record{ _block_records.allocate(sizeof(block_t), alignof(block_t)) };
+        if (record == nullptr)
+        {
+            LOG_GRAPHICS_ERROR("[Vulkan] All {} memory blocks are in use", k_max_blocks);
+            return k_no_block;
+        }
+
+        block_t* block{ new(record) block_t{ } };
+        if (vkAllocateMemory(_device, &alloc_info, nullptr, &block->memory) != VK_SUCCESS)
+        {
+            free_record(block);
+            return k_no_block;
+        }
+
+        if (is_host_visible(memory_type))
+            vkMapMemory(_device, block->memory, 0, VK_WHOLE_SIZE, 0, &block->mapped);
+
+        block->memory_type = memory_type;
+        block->tiling = tiling;
+        block->tlsf.init(size);
+
+        LOG_GRAPHICS_INFO("[Vulkan] New {} MiB memory block (type {}, {})", size / (1024 * 1024), memory_type,
+                          tiling == resource_tiling::optimal ? "optimal" : "linear");
+
+        const auto slot{ std::ranges::find_if(_blocks, [](const auto& entry) { return !entry; }) };
+        if (slot != _blocks.end())
+        {
+            *slot = block;
+            return static_cast<uint32_t>(slot - _blocks.begin());
+        }
+
+        _blocks.push_back(block);
+        return static_cast<uint32_t>(_blocks.size() - 1);
+    }
+
+    void gpu_allocator_t::destroy_block(const uint32_t index) noexcept
+    {
+        if (!_blocks[index]) return;
+
+        vkFreeMemory(_device, _blocks[index]->memory, nullptr);
+        free_record(_blocks[index]);
+        _blocks[index] = nullptr;
+    }
+
+    void gpu_allocator_t::free_record(block_t* block) noexcept
+    {
+        block->~block_t();
+        _block_records.deallocate(block, sizeof(block_t));
+    }
+
+    VkDeviceSize gpu_allocator_t::block_size(const uint32_t memory_type) const noexcept
+    {
+        const uint32_t heap{ _memory_properties.memoryTypes[memory_type].heapIndex };
+        const VkDeviceSize heap_size{ _memory_properties.memoryHeaps[heap].size };
+
+        // Small heaps (e.g. the 256 MiB host-visible device-local window) would be eaten by a few default blocks
+        return heap_size <= k_small_heap_size ? heap_size / 8 : k_default_block_size;
+    }
+
+    bool gpu_allocator_t::is_host_visible(const uint32_t memory_type) const noexcept
+    {
+        return _memory_properties.memoryTypes[memory_type].propertyFlags & VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT;
+    }
+} // namespace carrot::rhi::vulkan
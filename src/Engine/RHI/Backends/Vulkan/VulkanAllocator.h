@@ -0,0 +1,116 @@
+//
+// Created by zshrout on 10/18/26.
+// Copyright (c) 2026 BunnySofty. All rights reserved.
+//
+
+#pragma once
+
+#include "VulkanCommon.h"
+#include "Memory/PoolAllocator.h"
+#include "Utils/Tlsf.h"
+
+#include <mutex>
+#include <vector>
+
+namespace carrot::rhi::vulkan {
+    // Buffers and linear images may not share a bufferImageGranularity page with optimal-tiling images, so the
+    // two kinds are sub-allocated from separate blocks (unless the device has no such restriction)
+    enum class resource_tiling : uint8_t
+    {
+        linear,
+        optimal,
+    };
+
+    struct gpu_allocation_t
+    {
+        static constexpr uint32_t k_dedicated{ ~0u };
+
+        VkDeviceMemory  memory{ VK_NULL_HANDLE };
+        VkDeviceSize    offset{ 0 };
+        VkDeviceSize    size{ 0 };
+        void*           mapped{ nullptr }; // persistently mapped when the memory type is host-visible
+        uint32_t        memory_type{ 0 };
+        uint32_t        block{ k_dedicated };
+        uint32_t        node{ utils::tlsf_t::k_invalid_node };
+
+        [[nodiscard]] bool is_valid() const noexcept { return memory != VK_NULL_HANDLE; }
+        [[nodiscard]] bool is_dedicated() const noexcept { return block == k_dedicated; }
+    };
+
+    struct gpu_memory_stats_t
+    {
+        uint32_t        block_count{ 0 };
+        uint32_t        dedicated_count{ 0 };
+        uint32_t        allocation_count{ 0 };      // sub-allocations + dedicated
+        uint32_t        free_region_count{ 0 };
+        VkDeviceSize    reserved_bytes{ 0 };        // all device memory owned by the allocator
+        VkDeviceSize    used_bytes{ 0 };
+        VkDeviceSize    largest_free_region{ 0 };
+
+        // 0 when all free block memory is one region, towards 1 the more it is scattered
+        [[nodiscard]] float fragmentation() const noexcept
+        {
+            const VkDeviceSize free_bytes{ reserved_bytes - used_bytes };
+            return free_bytes == 0 ? 0.f : 1.f - static_cast<float>(largest_free_region) / static_cast<float>(free_bytes);
+        }
+    };
+
+    // Device memory allocator: one vkAllocateMemory per large block, resources are TLSF sub-allocated from the
+    // blocks of their memory type. Resources that are big, or that the driver wants dedicated, get their own
+    // allocation. Host-visible memory is mapped once for its whole lifetime. Thread-safe.
+    class gpu_allocator_t
+    {
+    public:
+        void init(VkPhysicalDevice physical_device, VkDevice device);
+        void shutdown();
+
+        [[nodiscard]] gpu_allocation_t allocate(const VkMemoryRequirements& requirements, VkMemoryPropertyFlags properties,
+                                                resource_tiling tiling);
+        void free(gpu_allocation_t& allocation) noexcept;
+
+        // Create the resource, allocate and bind its memory; on failure nothing is left behind and false is returned
+        bool create_buffer(const VkBufferCreateInfo& info, VkMemoryPropertyFlags properties,
+                           VkBuffer& buffer, gpu_allocation_t& allocation);
+        bool create_image(const VkImageCreateInfo& info, VkMemoryPropertyFlags properties,
+                          VkImage& image, gpu_allocation_t& allocation);
+        void destroy_buffer(VkBuffer& buffer, gpu_allocation_t& allocation) noexcept;
+        void destroy_image(VkImage& image, gpu_allocation_t& allocation) noexcept;
+
+        [[nodiscard]] gpu_memory_stats_t stats() const;
+
+    private:
+        struct block_t
+        {
+            VkDeviceMemory      memory{ VK_NULL_HANDLE };
+            void*               mapped{ nullptr };
+            uint32_t            memory_type{ 0 };
+            resource_tiling     tiling{ resource_tiling::linear };
+            utils::tlsf_t       tlsf;
+        };
+
+        [[nodiscard]] gpu_allocation_t allocate_locked(const VkMemoryRequirements& requirements, VkMemoryPropertyFlags properties,
+                                                       resource_tiling tiling, bool dedicated,
+                                                       const VkMemoryDedicatedAllocateInfo* dedicated_info);
+        [[nodiscard]] gpu_allocation_t allocate_dedicated(VkDeviceSize size, uint32_t memory_type,
+                                                          const VkMemoryDedicatedAllocateInfo* dedicated_info);
+        [[nodiscard]] gpu_allocation_t allocate_from_blocks(const VkMemoryRequirements& requirements, uint32_t memory_type,
+                                                            resource_tiling tiling);
+        [[nodiscard]] uint32_t create_block(uint32_t memory_type, resource_tiling tiling);
+        void destroy_block(uint32_t index) noexcept;
+        void free_record(block_t* block) noexcept;
+
+        [[nodiscard]] VkDeviceSize block_size(uint32_t memory_type) const noexcept;
+        [[nodiscard]] bool is_host_visible(uint32_t memory_type) const noexcept;
+
+        VkDevice                                _device{ VK_NULL_HANDLE };
+        VkPhysicalDeviceMemoryProperties        _memory_properties{ };
+        VkDeviceSize                            _buffer_image_granularity{ 1 };
+        VkDeviceSize                            _non_coherent_atom_size{ 1 };
+
+        graphics_vector_t<block_t*>             _blocks; // null entries are free slots, indices stay stable
+        memory::pool_allocator_t                _block_records{ memory::memory_tag::graphics }; // behind _blocks
+        uint32_t                                _dedicated_count{ 0 };
+        VkDeviceSize                            _dedicated_bytes{ 0 };
+        mutable std::mutex                      _mutex;
+    };
+} // namespace carrot::rhi::vulkan
@@ -0,0 +1,227 @@
+//
+// Created by zshrout on 10/18/26.
+// Copyright (c) 2026 BunnySofty. All rights reserved.
+//
+
+#include "VulkanBindless.h"
+
+#include "Common/CommonHeaders.h"
+
+namespace carrot::rhi::vulkan {
+    namespace {
+        constexpr size_t k_kind_count{ static_cast<size_t>(bindless_kind::count) };
+
+        constexpr const char* kind_name(const bindless_kind kind) noexcept
+        {
+            switch (kind)
+            {
+                case bindless_kind::texture: return "texture";
+                case bindless_kind::sampler: return "sampler";
+                case bindless_kind::storage_buffer: return "storage buffer";
+                default: return "unknown";
+            }
+        }
+    } // anonymous namespace
+
+    // PUBLIC
+    void bindless_heap_t::init(VkDevice device, timeline_semaphore_t& frame_timeline)
+    {
+        _device = device;
+        _frame_timeline = &frame_timeline;
+
+        std::array<VkDescriptorSetLayoutBinding, k_kind_count> bindings{ };
+        std::array<VkDescriptorBindingFlags, k_kind_count> binding_flags{ };
+        std::array<VkDescriptorPoolSize, k_kind_count> pool_sizes{ };
+        for (uint32_t kind{ 0 }; kind < k_kind_count; ++kind)
+        {
+            bindings[kind].binding = kind;
+            bindings[kind].descriptorType = k_bindless_types[kind];
+            bindings[kind].descriptorCount = k_bindless_capacity[kind];
+            bindings[kind].stageFlags = VK_SHADER_STAGE_ALL;
+
+            // Shaders only touch the slots they are handed, the rest may be empty or rewritten while frames run
+            binding_flags[kind] = VK_DESCRIPTOR_BINDING_UPDATE_AFTER_BIND_BIT |
+                                  VK_DESCRIPTOR_BINDING_UPDATE_UNUSED_WHILE_PENDING_BIT |
+                                  VK_DESCRIPTOR_BINDING_PARTIALLY_BOUND_BIT;
+
+            pool_sizes[kind] = { k_bindless_types[kind], k_bindless_capacity[kind] };
+        }
+
+        VkDescriptorSetLayoutBindingFlagsCreateInfo flags_info{ };
+        flags_info.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_LAYOUT_BINDING_FLAGS_CREATE_INFO;
+        flags_info.bindingCount = static_cast<uint32_t>(binding_flags.size());
+        flags_info.pBindingFlags = binding_flags.data();
+
+        VkDescriptorSetLayoutCreateInfo layout_info{ };
+        layout_info.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_LAYOUT_CREATE_INFO;
+        layout_info.pNext = &flags_info;
+        layout_info.flags = VK_DESCRIPTOR_SET_LAYOUT_CREATE_UPDATE_AFTER_BIND_POOL_BIT;
+        layout_info.bindingCount = static_cast<uint32_t>(bindings.size());
+        layout_info.pBindings = bindings.data();
+        vkCreateDescriptorSetLayout(_device, &layout_info, nullptr, &_layout);
+
+        VkDescriptorPoolCreateInfo pool_info{ };
+        pool_info.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_POOL_CREATE_INFO;
+        pool_info.flags = VK_DESCRIPTOR_POOL_CREATE_UPDATE_AFTER_BIND_BIT;
+        pool_info.maxSets = 1;
+        pool_info.poolSizeCount = static_cast<uint32_t>(pool_sizes.size());
+        pool_info.pPoolSizes = pool_sizes.data();
+        vkCreateDescriptorPool(_device, &pool_info, nullptr, &_pool);
+
+        VkDescriptorSetAllocateInfo alloc_info{ };
+        alloc_info.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_ALLOCATE_INFO;
+        alloc_info.descriptorPool = _pool;
+        alloc_info.descriptorSetCount = 1;
+        alloc_info.pSetLayouts = &_layout;
+        vkAllocateDescriptorSets(_device, &alloc_info, &_set);
+
+        LOG_GRAPHICS_INFO("[Vulkan] Bindless heap: {} textures, {} samplers, {} storage buffers",
+                          k_bindless_capacity[0], k_bindless_capacity[1], k_bindless_capacity[2]);
+    }
+
+    void bindless_heap_t::shutdown() noexcept
+    {
+        if (_device == VK_NULL_HANDLE) return;
+
+        for (uint32_t kind{ 0 }; kind < k_kind_count; ++kind)
+            if (_slots[kind].live != 0)
+                LOG_GRAPHICS_WARN("[Vulkan] Bindless heap destroyed with {} live {} handle(s)", _slots[kind].live,
+                                  kind_name(static_cast<bindless_kind>(kind)));
+
+        vkDestroyDescriptorPool(_device, _pool, nullptr);
+        vkDestroyDescriptorSetLayout(_device, _layout, nullptr);
+        _pool = VK_NULL_HANDLE;
+        _layout = VK_NULL_HANDLE;
+        _set = VK_NULL_HANDLE;
+
+        _slots = { };
+        _retired.clear();
+        _frame_timeline = nullptr;
+        _device = VK_NULL_HANDLE;
+    }
+
+    texture_handle_t bindless_heap_t::add_texture(VkImageView view, const VkImageLayout layout)
+    {
+        const uint32_t index{ allocate(bindless_kind::texture) };
+        if (index == ~0u) return { };
+
+        const VkDescriptorImageInfo image{ VK_NULL_HANDLE, view, layout };
+        write(bindless_kind::texture, index, &image, nullptr);
+        return { index };
+    }
+
+    sampler_handle_t bindless_heap_t::add_sampler(VkSampler sampler)
+    {
+        const uint32_t index{ allocate(bindless_kind::sampler) };
+        if (index == ~0u) return { };
+
+        const VkDescriptorImageInfo image{ sampler, VK_NULL_HANDLE, VK_IMAGE_LAYOUT_UNDEFINED };
+        write(bindless_kind::sampler, index, &image, nullptr);
+        return { index };
+    }
+
+    storage_buffer_handle_t bindless_heap_t::add_storage_buffer(VkBuffer buffer, const VkDeviceSize offset,
+                                                                const VkDeviceSize range)
+    {
+        const uint32_t index{ allocate(bindless_kind::storage_buffer) };
+        if (index == ~0u) return { };
+
+        const VkDescriptorBufferInfo info{ buffer, offset, range };
+        write(bindless_kind::storage_buffer, index, nullptr, &info);
+        return { index };
+    }
+
+    void bindless_heap_t::update_texture(const texture_handle_t handle, VkImageView view,
+                                         const VkImageLayout layout) const noexcept
+    {
+        if (!handle.is_valid()) return;
+
+        const VkDescriptorImageInfo image{ VK_NULL_HANDLE, view, layout };
+        write(bindless_kind::texture, handle.index, &image, nullptr);
+    }
+
+    void bindless_heap_t::update_storage_buffer(const storage_buffer_handle_t handle, VkBuffer buffer,
+                                                const VkDeviceSize offset, const VkDeviceSize range) const noexcept
+    {
+        if (!handle.is_valid()) return;
+
+        const VkDescriptorBufferInfo info{ buffer, offset, range };
+        write(bindless_kind::storage_buffer, handle.index, nullptr, &info);
+    }
+
+    void bindless_heap_t::bind(VkCommandBuffer cmd, const VkPipelineBindPoint bind_point,
+                               VkPipelineLayout layout) const noexcept
+    {
+        vkCmdBindDescriptorSets(cmd, bind_point, layout, k_bindless_set, 1, &_set, 0, nullptr);
+    }
+
+    uint32_t bindless_heap_t::live_count(const bindless_kind kind) const noexcept
+    {
+        std::lock_guard<std::mutex> lock{ _mutex };
+        return _slots[static_cast<size_t>(kind)].live;
+    }
+
+    // PRIVATE
+    uint32_t bindless_heap_t::allocate(const bindless_kind kind)
+    {
+        std::lock_guard<std::mutex> lock{ _mutex };
+        collect_retired();
+
+        slots_t& slots{ _slots[static_cast<size_t>(kind)] };
+        uint32_t index{ ~0u };
+        if (!slots.free.empty())
+        {
+            index = slots.free.back();
+            slots.free.pop_back();
+        }
+        else if (slots.next < k_bindless_capacity[static_cast<size_t>(kind)])
+        {
+            index = slots.next++;
+        }
+        else
+        {
+            LOG_GRAPHICS_ERROR("[Vulkan] Bindless heap is out of {} slots ({})", kind_name(kind),
+                               k_bindless_capacity[static_cast<size_t>(kind)]);
+            return ~0u;
+        }
+
+        ++slots.live;
+        return index;
+    }
+
+    void bindless_heap_t::release(const bindless_kind kind, const uint32_t index)
+    {
+        std::lock_guard<std::mutex> lock{ _mutex };
+
+        // The frame being recorded may still index the slot; it is submitted with the next timeline value
+        _retired.push_back({ _frame_timeline->pending + 1, kind, index });
+        --_slots[static_cast<size_t>(kind)].live;
+    }
+
+    void bindless_heap_t::collect_retired()
+    {
+        if (_retired.empty()) return;
+
+        std::erase_if(_retired, [this](const retired_t& retired) {
+            if (!_frame_timeline->has_reached(retired.frame_value)) return false;
+
+            _slots[static_cast<size_t>(retired.kind)].free.push_back(retired.index);
+            return true;
+        });
+    }
+
+    void bindless_heap_t::write(const bindless_kind kind, const uint32_t index, const VkDescriptorImageInfo* image,
+                                const VkDescriptorBufferInfo* buffer) const noexcept
+    {
+        VkWriteDescriptorSet write{ };
+        write.sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
+        write.dstSet = _set;
+        write.dstBinding = static_cast<uint32_t>(kind);
+        write.dstArrayElement = index;
+        write.descriptorCount = 1;
+        write.descriptorType = k_bindless_types[static_cast<size_t>(kind)];
+        write.pImageInfo = image;
+        write.pBufferInfo = buffer;
+        vkUpdateDescriptorSets(_device, 1, &write, 0, nullptr);
+    }
+} // namespace carrot::rhi::vulkan
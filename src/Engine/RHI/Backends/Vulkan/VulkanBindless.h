@@ -0,0 +1,112 @@
+//
+// Created by zshrout on 10/18/26.
+// Copyright (c) 2026 BunnySofty. All rights reserved.
+//
+
+#pragma once
+
+#include "VulkanCommon.h"
+#include "VulkanCore.h"
+
+#include <array>
+#include <mutex>
+#include <vector>
+
+namespace carrot::rhi::vulkan {
+    // One binding per kind in the bindless set, declared in GLSL as runtime-sized arrays (see shaders/bindless.glsl)
+    enum class bindless_kind : uint8_t
+    {
+        texture,            // binding 0, texture2D[]
+        sampler,            // binding 1, sampler[]
+        storage_buffer,     // binding 2, buffer[]
+
+        count
+    };
+
+    constexpr uint32_t k_bindless_set{ 0 };
+    constexpr std::array<uint32_t, static_cast<size_t>(bindless_kind::count)> k_bindless_capacity{ 16384, 128, 16384 };
+    constexpr std::array<VkDescriptorType, static_cast<size_t>(bindless_kind::count)> k_bindless_types{
+        VK_DESCRIPTOR_TYPE_SAMPLED_IMAGE, VK_DESCRIPTOR_TYPE_SAMPLER, VK_DESCRIPTOR_TYPE_STORAGE_BUFFER
+    };
+
+    // Index into one of the heap's arrays; stays the same for the resource's whole lifetime, so it can be baked
+    // into push constants, instance data or materials
+    template<bindless_kind Kind>
+    struct bindless_handle_t
+    {
+        uint32_t index{ ~0u };
+
+        [[nodiscard]] bool is_valid() const noexcept { return index != ~0u; }
+    };
+
+    using texture_handle_t = bindless_handle_t<bindless_kind::texture>;
+    using sampler_handle_t = bindless_handle_t<bindless_kind::sampler>;
+    using storage_buffer_handle_t = bindless_handle_t<bindless_kind::storage_buffer>;
+
+    // Global descriptor heap: a single update-after-bind, partially bound set holding every sampled image,
+    // sampler and storage buffer. It is bound once per command buffer and shaders index it with handles, so
+    // drawing with a new texture never allocates or binds a set. Slots are written as soon as a resource is
+    // added; a released slot is only reused once the frame that released it has completed on the GPU.
+    class bindless_heap_t
+    {
+    public:
+        void init(VkDevice device, timeline_semaphore_t& frame_timeline);
+        void shutdown() noexcept;
+
+        // Thread-safe. Return an invalid handle when the array is full
+        [[nodiscard]] texture_handle_t add_texture(VkImageView view,
+                                                   VkImageLayout layout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL);
+        [[nodiscard]] sampler_handle_t add_sampler(VkSampler sampler);
+        [[nodiscard]] storage_buffer_handle_t add_storage_buffer(VkBuffer buffer, VkDeviceSize offset = 0,
+                                                                 VkDeviceSize range = VK_WHOLE_SIZE);
+
+        // Point an existing handle at another resource; no frame in flight may still use the old one
+        void update_texture(texture_handle_t handle, VkImageView view,
+                            VkImageLayout layout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL) const noexcept;
+        void update_storage_buffer(storage_buffer_handle_t handle, VkBuffer buffer, VkDeviceSize offset = 0,
+                                   VkDeviceSize range = VK_WHOLE_SIZE) const noexcept;
+
+        template<bindless_kind Kind>
+        void release(const bindless_handle_t<Kind> handle)
+        {
+            if (handle.is_valid()) release(Kind, handle.index);
+        }
+
+        void bind(VkCommandBuffer cmd, VkPipelineBindPoint bind_point, VkPipelineLayout layout) const noexcept;
+
+        [[nodiscard]] VkDescriptorSetLayout layout() const noexcept { return _layout; }
+        [[nodiscard]] uint32_t live_count(bindless_kind kind) const noexcept;
+
+    private:
+        struct slots_t
+        {
+            graphics_vector_t<uint32_t> free;
+            uint32_t                    next{ 0 };  // slots past this one were never handed out
+            uint32_t                    live{ 0 };
+        };
+
+        struct retired_t
+        {
+            uint64_t                frame_value{ 0 };
+            bindless_kind           kind{ bindless_kind::texture };
+            uint32_t                index{ 0 };
+        };
+
+        [[nodiscard]] uint32_t allocate(bindless_kind kind);
+        void release(bindless_kind kind, uint32_t index);
+        void collect_retired();
+        void write(bindless_kind kind, uint32_t index, const VkDescriptorImageInfo* image,
+                   const VkDescriptorBufferInfo* buffer) const noexcept;
+
+        VkDevice                    _device{ VK_NULL_HANDLE };
+        timeline_semaphore_t*       _frame_timeline{ nullptr };
+        VkDescriptorSetLayout       _layout{ VK_NULL_HANDLE };
+        VkDescriptorPool            _pool{ VK_NULL_HANDLE };
+        VkDescriptorSet             _set{ VK_NULL_HANDLE };
+
+        // Only the slot bookkeeping is locked; update-after-bind allows writing distinct descriptors concurrently
+        mutable std::mutex          _mutex;
+        std::array<slots_t, static_cast<size_t>(bindless_kind::count)> _slots;
+        graphics_vector_t<retired_t> _retired;
+    };
+} // namespace carrot::rhi::vulkan
@@ -0,0 +1,192 @@
+//
+// Created by zshrout on 10/18/26.
+// Copyright (c) 2026 BunnySofty. All rights reserved.
+//
+
+#include "VulkanCommandRecorder.h"
+
+#include "VulkanCore.h"
+#include "Utils/Assert.h"
+
+namespace carrot::rhi::vulkan {
+    // PUBLIC
+    void command_recorder_t::init(VkDevice device, const uint32_t queue_family, const uint32_t worker_count)
+    {
+        _device = device;
+
+        const uint32_t threads{ worker_count + 1 };
+        _pools.resize(static_cast<size_t>(threads) * k_max_frames_in_flight);
+
+        // Transient pools, buffers are never reset individually, only the whole pool at begin_frame()
+        VkCommandPoolCreateInfo pool_info{ };
+        pool_info.sType = VK_STRUCTURE_TYPE_COMMAND_POOL_CREATE_INFO;
+        pool_info.flags = VK_COMMAND_POOL_CREATE_TRANSIENT_BIT;
+        pool_info.queueFamilyIndex = queue_family;
+
+        for (thread_pool_t& pool: _pools)
+            vkCreateCommandPool(_device, &pool_info, nullptr, &pool.pool);
+
+        _quit = false;
+        _workers.reserve(worker_count);
+        for (uint32_t i{ 0 }; i < worker_count; ++i)
+            _workers.emplace_back(&command_recorder_t::worker_main, this, i + 1);
+
+        LOG_GRAPHICS_INFO("[Vulkan] Command recording on {} thread(s)", threads);
+    }
+
+    void command_recorder_t::shutdown()
+    {
+        {
+            std::lock_guard<std::mutex> lock(_mutex);
+            _quit = true;
+            _wake.notify_all();
+        }
+        for (std::thread& worker: _workers)
+            if (worker.joinable()) worker.join();
+        _workers.clear();
+
+        for (thread_pool_t& pool: _pools)
+            if (pool.pool != VK_NULL_HANDLE) vkDestroyCommandPool(_device, pool.pool, nullptr);
+        _pools.clear();
+
+        _jobs.clear();
+        _recorded.clear();
+        _device = VK_NULL_HANDLE;
+    }
+
+    void command_recorder_t::begin_frame(const uint32_t frame_index)
+    {
+        _frame_index = frame_index;
+
+        for (uint32_t thread{ 0 }; thread < thread_count(); ++thread)
+        {
+            thread_pool_t& pool{ _pools[frame_index * thread_count() + thread] };
+            vkResetCommandPool(_device, pool.pool, 0);
+            pool.used = 0;
+        }
+    }
+
+    void command_recorder_t::begin_rendering(const VkCommandBufferInheritanceRenderingInfo& rendering)
+    {
+        CE_ASSERT(_jobs.empty(), "Previous recording batch was never executed");
+
+        // Copied, the caller's format array does not have to outlive the batch
+        _color_formats.assign(rendering.pColorAttachmentFormats,
+                              rendering.pColorAttachmentFormats + rendering.colorAttachmentCount);
+        _rendering = rendering;
+        _rendering.pNext = nullptr;
+        _rendering.pColorAttachmentFormats = _color_formats.data();
+
+        _inheritance = { };
+        _inheritance.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_INHERITANCE_INFO;
+        _inheritance.pNext = &_rendering;
+    }
+
+    void command_recorder_t::add(const record_delegate_t& job)
+    {
+        _jobs.push_back(job);
+    }
+
+    void command_recorder_t::execute(VkCommandBuffer primary)
+    {
+        if (_jobs.empty()) return;
+
+        const uint32_t job_count{ static_cast<uint32_t>(_jobs.size()) };
+        _recorded.assign(job_count, VK_NULL_HANDLE);
+
+        {
+            std::unique_lock<std::mutex> lock(_mutex);
+
+            // A worker that woke late for the previous batch may still be leaving drain()
+            _idle.wait(lock, [this] { return _active_workers == 0; });
+
+            _next_job.store(0, std::memory_order_relaxed);
+            _finished_jobs.store(0, std::memory_order_relaxed);
+            _job_count = job_count;
+            ++_generation;
+            _wake.notify_all();
+        }
+
+        // The calling thread records too instead of sleeping
+        drain(0, job_count);
+
+        {
+            std::unique_lock<std::mutex> lock(_mutex);
+            _idle.wait(lock, [this, job_count] {
+                return _active_workers == 0 && _finished_jobs.load(std::memory_order_acquire) == job_count;
+            });
+        }
+
+        vkCmdExecuteCommands(primary, job_count, _recorded.data());
+        _jobs.clear();
+    }
+
+    // PRIVATE
+    void command_recorder_t::worker_main(const uint32_t thread_index)
+    {
+        uint64_t seen_generation{ 0 };
+
+        while (true)
+        {
+            uint32_t job_count{ 0 };
+            {
+                std::unique_lock<std::mutex> lock(_mutex);
+                _wake.wait(lock, [this, seen_generation] { return _quit || _generation != seen_generation; });
+                if (_quit) break;
+
+                seen_generation = _generation;
+                job_count = _job_count;
+                ++_active_workers;
+            }
+
+            drain(thread_index, job_count);
+
+            {
+                std::lock_guard<std::mutex> lock(_mutex);
+                --_active_workers;
+                _idle.notify_all();
+            }
+        }
+    }
+
+    void command_recorder_t::drain(const uint32_t thread_index, const uint32_t job_count)
+    {
+        VkCommandBufferBeginInfo begin_info{ };
+        begin_info.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO;
+        begin_info.flags = VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT | VK_COMMAND_BUFFER_USAGE_RENDER_PASS_CONTINUE_BIT;
+        begin_info.pInheritanceInfo = &_inheritance;
+
+        for (uint32_t job{ _next_job.fetch_add(1, std::memory_order_relaxed) }; job < job_count;
+             job = _next_job.fetch_add(1, std::memory_order_relaxed))
+        {
+            VkCommandBuffer cmd{ acquire(thread_index) };
+
+            vkBeginCommandBuffer(cmd, &begin_info);
+            _jobs[job].invoke(cmd);
+            vkEndCommandBuffer(cmd);
+
+            _recorded[job] = cmd;
+            _finished_jobs.fetch_add(1, std::memory_order_release);
+        }
+    }
+
+    VkCommandBuffer command_recorder_t::acquire(const uint32_t thread_index)
+    {
+        thread_pool_t& pool{ _pools[_frame_index * thread_count() + thread_index] };
+
+        if (pool.used == pool.buffers.size())
+        {
+            VkCommandBufferAllocateInfo alloc_info{ };
+            alloc_info.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_ALLOCATE_INFO;
+            alloc_info.commandPool = pool.pool;
+            alloc_info.level = VK_COMMAND_BUFFER_LEVEL_SECONDARY;
+            alloc_info.commandBufferCount = 1;
+
+            VkCommandBuffer cmd{ VK_NULL_HANDLE };
+            vkAllocateCommandBuffers(_device, &alloc_info, &cmd);
+            pool.buffers.push_back(cmd);
+        }
+
+        return pool.buffers[pool.used++];
+    }
+} // namespace carrot::rhi::vulkan
@@ -0,0 +1,80 @@
+//
+// Created by zshrout on 10/18/26.
+// Copyright (c) 2026 BunnySofty. All rights reserved.
+//
+
+#pragma once
+
+#include "VulkanCommon.h"
+#include "Utils/MulticastDelegate.h"
+
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace carrot::rhi::vulkan {
+    // Records into a secondary command buffer that already inherits the pass; pipeline, viewport and scissor are
+    // not inherited and must be set by the job itself
+    using record_delegate_t = utils::single_delegate_t<void(VkCommandBuffer)>;
+
+    // Records secondary command buffers in parallel. Every thread owns one command pool per frame in flight, so
+    // recording never contends on a pool, and a frame slot's pools are reset wholesale once the GPU retired it.
+    // Jobs may finish in any order; execute() replays them in the order they were added, so the frame does not
+    // depend on scheduling.
+    class command_recorder_t
+    {
+    public:
+        void init(VkDevice device, uint32_t queue_family, uint32_t worker_count);
+        void shutdown();
+
+        // Recycles every buffer recorded for this slot; its previous submission must have completed
+        void begin_frame(uint32_t frame_index);
+
+        // Starts a batch continuing the rendering the primary is in; the primary must have begun it with
+        // VK_RENDERING_CONTENTS_SECONDARY_COMMAND_BUFFERS_BIT and the same attachment formats
+        void begin_rendering(const VkCommandBufferInheritanceRenderingInfo& rendering);
+        void add(const record_delegate_t& job);
+        // Records the batch on the workers and the calling thread, then executes it into the primary in add() order
+        void execute(VkCommandBuffer primary);
+
+        // Worker threads plus the thread calling execute()
+        [[nodiscard]] uint32_t thread_count() const noexcept { return static_cast<uint32_t>(_workers.size()) + 1; }
+
+    private:
+        struct thread_pool_t
+        {
+            VkCommandPool                       pool{ VK_NULL_HANDLE };
+            graphics_vector_t<VkCommandBuffer>  buffers;
+            uint32_t                            used{ 0 };
+        };
+
+        void worker_main(uint32_t thread_index);
+        void drain(uint32_t thread_index, uint32_t job_count);
+        [[nodiscard]] VkCommandBuffer acquire(uint32_t thread_index);
+
+        VkDevice                                    _device{ VK_NULL_HANDLE };
+        uint32_t                                    _frame_index{ 0 };
+        graphics_vector_t<thread_pool_t>            _pools; // [frame * thread_count + thread]
+        graphics_vector_t<std::thread>              _workers;
+
+        // Only touched by the owning thread while no worker is active
+        VkCommandBufferInheritanceInfo              _inheritance{ };
+        VkCommandBufferInheritanceRenderingInfo     _rendering{ };
+        graphics_vector_t<VkFormat>                 _color_formats;
+        graphics_vector_t<record_delegate_t>        _jobs;
+        graphics_vector_t<VkCommandBuffer>          _recorded; // parallel to _jobs
+
+        std::atomic<uint32_t>                       _next_job{ 0 };
+        std::atomic<uint32_t>                       _finished_jobs{ 0 };
+
+        std::mutex                                  _mutex;
+        std::condition_variable                     _wake;
+        std::condition_variable                     _idle;
+        uint64_t                                    _generation{ 0 };
+        uint32_t                                    _job_count{ 0 };
+        uint32_t                                    _active_workers{ 0 };
+        bool                                        _quit{ false };
+    };
+} // namespace carrot::rhi::vulkan
@@ -6,5 +6,40 @@
 #pragma once
 
 #include "Common/CommonHeaders.h"
+#include "Memory/HeapAllocator.h"
 
-#include <vulkan/vulkan.h>
\ No newline at end of file
+#include <vulkan/vulkan.h>
+
+#include <deque>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+
+namespace carrot::rhi::vulkan {
+    // The backend's host-side containers, charged to memory_tag::graphics
+    template<typename T>
+    using graphics_allocator_t = memory::tagged_allocator_t<T, memory::memory_tag::graphics>;
+
+    template<typename T>
+    using graphics_vector_t = memory::tagged_vector_t<T, memory::memory_tag::graphics>;
+
+    template<typename T>
+    using graphics_deque_t = std::deque<T, graphics_allocator_t<T>>;
+
+    using graphics_string_t = std::basic_string<char, std::char_traits<char>, graphics_allocator_t<char>>;
+
+    // Looked up by string_view, so a find never builds a key
+    struct graphics_string_hash_t
+    {
+        using is_transparent = void;
+
+        [[nodiscard]] size_t operator()(const std::string_view key) const noexcept
+        {
+            return std::hash<std::string_view>{ }(key);
+        }
+    };
+
+    template<typename T>
+    using graphics_string_map_t = std::unordered_map<graphics_string_t, T, graphics_string_hash_t, std::equal_to<>,
+                                                     graphics_allocator_t<std::pair<const graphics_string_t, T>>>;
+} // namespace carrot::rhi::vulkan
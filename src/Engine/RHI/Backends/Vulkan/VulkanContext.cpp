@@ -9,8 +9,16 @@
 
 #include <vector>
 #include <algorithm>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
 
 namespace carrot::rhi::vulkan {
+    namespace {
+        constexpr const char* k_pipeline_cache_path{ "cache/pipeline_cache.bin" };
+        constexpr VkDeviceSize k_transient_bytes_per_frame{ 4 * 1024 * 1024 }; // 4 MiB
+    } // anonymous namespace
+
     static uint32_t find_queue_family(VkPhysicalDevice phys, VkSurfaceKHR surface, VkQueueFlags flags)
     {
         uint32_t count{ 0 };
@@ -37,6 +45,27 @@ namespace carrot::rhi::vulkan {
         return ~0u;
     }
 
+    // Prefers a transfer-only family (the DMA engines on discrete GPUs), then any non-graphics family that can
+    // transfer; falls back to the graphics family
+    static uint32_t find_transfer_family(VkPhysicalDevice phys, const uint32_t graphics_family)
+    {
+        uint32_t count{ 0 };
+        vkGetPhysicalDeviceQueueFamilyProperties(phys, &count, nullptr);
+        std::vector<VkQueueFamilyProperties> families(count);
+        vkGetPhysicalDeviceQueueFamilyProperties(phys, &count, families.data());
+
+        uint32_t fallback{ graphics_family };
+        for (uint32_t i = 0; i < count; ++i)
+        {
+            const VkQueueFlags flags{ families[i].queueFlags };
+            if (!(flags & VK_QUEUE_TRANSFER_BIT) || flags & VK_QUEUE_GRAPHICS_BIT) continue;
+
+            if (!(flags & VK_QUEUE_COMPUTE_BIT)) return i;
+            if (fallback == graphics_family) fallback = i;
+        }
+        return fallback;
+    }
+
     void vulkan_context_t::init(VkInstance inst, VkSurfaceKHR surf)
     {
         _instance = inst;
@@ -50,24 +79,61 @@ namespace carrot::rhi::vulkan {
 
         _graphics_family = find_queue_family(_physical_device, _surface, VK_QUEUE_GRAPHICS_BIT);
         _present_family = _graphics_family;
+        _transfer_family = find_transfer_family(_physical_device, _graphics_family);
 
         constexpr float priority{ 1.0f };
-        VkDeviceQueueCreateInfo queue_info{ };
-        queue_info.sType = VK_STRUCTURE_TYPE_DEVICE_QUEUE_CREATE_INFO;
-        queue_info.queueFamilyIndex = _graphics_family;
-        queue_info.queueCount = 1;
-        queue_info.pQueuePriorities = &priority;
-
+        VkDeviceQueueCreateInfo queue_infos[2]{ };
+        for (VkDeviceQueueCreateInfo& queue_info: queue_infos)
+        {
+            queue_info.sType = VK_STRUCTURE_TYPE_DEVICE_QUEUE_CREATE_INFO;
+            queue_info.queueCount = 1;
+            queue_info.pQueuePriorities = &priority;
+        }
+        queue_infos[0].queueFamilyIndex = _graphics_family;
+        queue_infos[1].queueFamilyIndex = _transfer_family;
+
+        // Timeline semaphores are core in 1.2 and mandatory there, frame pacing and uploads rely on them
+        VkPhysicalDeviceVulkan12Features features_12{ };
+        features_12.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_VULKAN_1_2_FEATURES;
+        features_12.timelineSemaphore = VK_TRUE;
+
+        // Bindless heap: runtime-sized, partially bound arrays that are written while frames are in flight
+        features_12.descriptorIndexing = VK_TRUE;
+        features_12.runtimeDescriptorArray = VK_TRUE;
+        features_12.descriptorBindingPartiallyBound = VK_TRUE;
+        features_12.descriptorBindingUpdateUnusedWhilePending = VK_TRUE;
+        features_12.descriptorBindingSampledImageUpdateAfterBind = VK_TRUE;
+        features_12.descriptorBindingStorageBufferUpdateAfterBind = VK_TRUE;
+        features_12.shaderSampledImageArrayNonUniformIndexing = VK_TRUE;
+        features_12.shaderStorageBufferArrayNonUniformIndexing = VK_TRUE;
+
+        // GPU-driven scene: the cull pass writes the draw count and one command per visible instance
+        features_12.drawIndirectCount = VK_TRUE;
+
+        VkPhysicalDeviceFeatures features{ };
+        features.multiDrawIndirect = VK_TRUE;
+        features.drawIndirectFirstInstance = VK_TRUE;
+
+        // Passes render through vkCmdBeginRendering; pipelines only name their attachment formats
+        VkPhysicalDeviceVulkan13Features features_13{ };
+        features_13.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_VULKAN_1_3_FEATURES;
+        features_13.dynamicRendering = VK_TRUE;
+        features_12.pNext = &features_13;
+
+        // Headless devices never present, so they do not need (or on CPU drivers in CI, have) a swapchain
         const char* device_ext[]{ VK_KHR_SWAPCHAIN_EXTENSION_NAME };
         VkDeviceCreateInfo device_info{ };
         device_info.sType = VK_STRUCTURE_TYPE_DEVICE_CREATE_INFO;
-        device_info.queueCreateInfoCount = 1;
-        device_info.pQueueCreateInfos = &queue_info;
-        device_info.enabledExtensionCount = 1;
+        device_info.pNext = &features_12;
+        device_info.queueCreateInfoCount = _transfer_family != _graphics_family ? 2 : 1;
+        device_info.pQueueCreateInfos = queue_infos;
+        device_info.pEnabledFeatures = &features;
+        device_info.enabledExtensionCount = is_headless() ? 0 : 1;
         device_info.ppEnabledExtensionNames = device_ext;
 
         vkCreateDevice(_physical_device, &device_info, nullptr, &_device.device);
         vkGetDeviceQueue(_device, _graphics_family, 0, &_graphics_queue);
+        vkGetDeviceQueue(_device, _transfer_family, 0, &_transfer_queue);
         _present_queue = _graphics_queue;
 
         VkCommandPoolCreateInfo transient_pool_info{ };
@@ -78,6 +144,16 @@ namespace carrot::rhi::vulkan {
 
         vkCreateCommandPool(_device, &transient_pool_info, nullptr, &_transient_command_pool.pool);
 
+        _frame_timeline = timeline_semaphore_t{ _device };
+        _allocator.init(_physical_device, _device);
+        _transient_ring.init(_physical_device, _allocator, k_transient_bytes_per_frame);
+        _uploads.init(_physical_device, _device, _allocator, _transfer_family, _transfer_queue,
+                      _graphics_family, _graphics_queue);
+        create_pipeline_cache();
+        _layout_cache.init(_device);
+        _bindless.init(_device, _frame_timeline);
+        _layout_cache.set_bindless_layout(_bindless.layout());
+
         _context = this;
     }
 
@@ -137,9 +213,58 @@ namespace carrot::rhi::vulkan {
         _swapchain_format = VK_FORMAT_B8G8R8A8_SRGB;
     }
 
-    void vulkan_context_t::create_buffer(VkDeviceSize size, VkBufferUsageFlags usage,
+    void vulkan_context_t::create_offscreen_targets(const uint32_t width, const uint32_t height)
+    {
+        destroy_offscreen_targets();
+
+        // Rendered like swapchain images; TRANSFER_SRC lets frame captures read them back
+        VkImageCreateInfo img_info{ };
+        img_info.sType = VK_STRUCTURE_TYPE_IMAGE_CREATE_INFO;
+        img_info.imageType = VK_IMAGE_TYPE_2D;
+        img_info.format = VK_FORMAT_B8G8R8A8_SRGB;
+        img_info.extent = { width, height, 1 };
+        img_info.mipLevels = 1;
+        img_info.arrayLayers = 1;
+        img_info.samples = VK_SAMPLE_COUNT_1_BIT;
+        img_info.tiling = VK_IMAGE_TILING_OPTIMAL;
+        img_info.usage = VK_IMAGE_USAGE_COLOR_ATTACHMENT_BIT | VK_IMAGE_USAGE_TRANSFER_SRC_BIT;
+        img_info.initialLayout = VK_IMAGE_LAYOUT_UNDEFINED;
+
+        // A frame slot's target is free once the slot's last submission retired, no acquire is needed
+        constexpr uint32_t img_count{ k_max_frames_in_flight };
+        _swapchain_images.assign(img_count, VK_NULL_HANDLE);
+        _offscreen_allocations.assign(img_count, { });
+        _swapchain_views = image_view_array_t{ _device };
+        _swapchain_views.resize(img_count);
+
+        for (uint32_t i = 0; i < img_count; ++i)
+        {
+            if (!_allocator.create_image(img_info, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT, _swapchain_images[i],
+                                         _offscreen_allocations[i]))
+            {
+                LOG_GRAPHICS_ERROR("[Vulkan] Failed to create a {}x{} offscreen target", width, height);
+                return;
+            }
+
+            VkImageViewCreateInfo view_info{ };
+            view_info.sType = VK_STRUCTURE_TYPE_IMAGE_VIEW_CREATE_INFO;
+            view_info.image = _swapchain_images[i];
+            view_info.viewType = VK_IMAGE_VIEW_TYPE_2D;
+            view_info.format = img_info.format;
+            view_info.subresourceRange.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
+            view_info.subresourceRange.levelCount = 1;
+            view_info.subresourceRange.layerCount = 1;
+            vkCreateImageView(_device, &view_info, nullptr, &_swapchain_views[i]);
+        }
+
+        _swapchain_extent = { width, height };
+        _image_count = img_count;
+        _swapchain_format = img_info.format;
+    }
+
+    bool vulkan_context_t::create_buffer(VkDeviceSize size, VkBufferUsageFlags usage,
                                          VkMemoryPropertyFlags properties,
-                                         VkBuffer& buffer, VkDeviceMemory& memory) const noexcept
+                                         VkBuffer& buffer, gpu_allocation_t& allocation) noexcept
     {
         VkBufferCreateInfo buffer_info{ };
         buffer_info.sType = VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO;
@@ -147,22 +272,29 @@ namespace carrot::rhi::vulkan {
         buffer_info.usage = usage;
         buffer_info.sharingMode = VK_SHARING_MODE_EXCLUSIVE;
 
-        vkCreateBuffer(_device, &buffer_info, nullptr, &buffer);
-
-        VkMemoryRequirements mem_req;
-        vkGetBufferMemoryRequirements(_device, buffer, &mem_req);
-
-        VkMemoryAllocateInfo alloc_info{ };
-        alloc_info.sType = VK_STRUCTURE_TYPE_MEMORY_ALLOCATE_INFO;
-        alloc_info.allocationSize = mem_req.size;
-        alloc_info.memoryTypeIndex = find_memory_type(mem_req.memoryTypeBits, properties);
+        return _allocator.create_buffer(buffer_info, properties, buffer, allocation);
+    }
 
-        vkAllocateMemory(_device, &alloc_info, nullptr, &memory);
-        vkBindBufferMemory(_device, buffer, memory, 0);
+    void vulkan_context_t::destroy_buffer(VkBuffer& buffer, gpu_allocation_t& allocation) noexcept
+    {
+        _allocator.destroy_buffer(buffer, allocation);
     }
 
     void vulkan_context_t::cleanup()
     {
+        _layout_cache.shutdown();
+        _bindless.shutdown();
+        destroy_offscreen_targets();
+
+        _uploads.shutdown();
+        _transient_ring.shutdown();
+        _allocator.shutdown();
+
+        save_pipeline_cache();
+        vkDestroyPipelineCache(_device, _pipeline_cache, nullptr);
+        _pipeline_cache = VK_NULL_HANDLE;
+
+        _frame_timeline = { };
         _swapchain_views.reset();
         _swapchain_images.clear();
         _swapchain = { };
@@ -223,5 +355,71 @@ namespace carrot::rhi::vulkan {
         vkFreeCommandBuffers(_device, _transient_command_pool.pool, 1, &cmd);
     }
 
+    // PRIVATE
+    void vulkan_context_t::destroy_offscreen_targets() noexcept
+    {
+        if (_offscreen_allocations.empty()) return;
+
+        _swapchain_views.reset();
+        for (size_t i = 0; i < _offscreen_allocations.size(); ++i)
+        {
+            if (_swapchain_images[i] != VK_NULL_HANDLE)
+                _allocator.destroy_image(_swapchain_images[i], _offscreen_allocations[i]);
+        }
+
+        _swapchain_images.clear();
+        _offscreen_allocations.clear();
+    }
+
+    void vulkan_context_t::create_pipeline_cache()
+    {
+        std::vector<char> initial_data;
+
+        if (std::ifstream file{ k_pipeline_cache_path, std::ios::ate | std::ios::binary }; file.is_open())
+        {
+            initial_data.resize(static_cast<size_t>(file.tellg()));
+            file.seekg(0);
+            file.read(initial_data.data(), static_cast<std::streamsize>(initial_data.size()));
+        }
+
+        // Drivers must reject foreign data, but a stale cache from another GPU/driver is cheaper to drop here
+        VkPhysicalDeviceProperties props{ };
+        vkGetPhysicalDeviceProperties(_physical_device, &props);
+
+        const bool compatible{
+            initial_data.size() >= 16 + VK_UUID_SIZE &&
+            std::memcmp(initial_data.data() + 16, props.pipelineCacheUUID, VK_UUID_SIZE) == 0
+        };
+        if (!compatible) initial_data.clear();
+
+        VkPipelineCacheCreateInfo cache_info{ };
+        cache_info.sType = VK_STRUCTURE_TYPE_PIPELINE_CACHE_CREATE_INFO;
+        cache_info.initialDataSize = initial_data.size();
+        cache_info.pInitialData = initial_data.empty() ? nullptr : initial_data.data();
+
+        vkCreatePipelineCache(_device, &cache_info, nullptr, &_pipeline_cache);
+    }
+
+    void vulkan_context_t::save_pipeline_cache() const
+    {
+        if (!_pipeline_cache) return;
+
+        size_t size{ 0 };
+        vkGetPipelineCacheData(_device, _pipeline_cache, &size, nullptr);
+        std::vector<char> data(size);
+        vkGetPipelineCacheData(_device, _pipeline_cache, &size, data.data());
+
+        std::error_code ec;
+        std::filesystem::create_directories(std::filesystem::path{ k_pipeline_cache_path }.parent_path(), ec);
+
+        std::ofstream file{ k_pipeline_cache_path, std::ios::binary | std::ios::trunc };
+        if (!file.is_open())
+        {
+            LOG_GRAPHICS_WARN("[Vulkan] Failed to write pipeline cache to {}", k_pipeline_cache_path);
+            return;
+        }
+        file.write(data.data(), static_cast<std::streamsize>(size));
+    }
+
     vulkan_context_t* vulkan_context_t::_context{ nullptr };
 } // namespace carrot::rhi::vulkan
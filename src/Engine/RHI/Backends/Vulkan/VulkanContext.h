@@ -5,18 +5,27 @@
 
 #pragma once
 
+#include "VulkanAllocator.h"
+#include "VulkanBindless.h"
 #include "VulkanCommon.h"
 #include "VulkanCore.h"
+#include "VulkanLayoutCache.h"
+#include "VulkanTransientRing.h"
+#include "VulkanUploadService.h"
 
 namespace carrot::rhi::vulkan {
     class vulkan_context_t
     {
     public:
+        // A null surface selects headless mode: no presentation, create_offscreen_targets() replaces the swapchain
         void init(VkInstance inst, VkSurfaceKHR surf);
         void create_swapchain(uint32_t width, uint32_t height);
-        void create_buffer(VkDeviceSize size, VkBufferUsageFlags usage,
+        // One color target per frame in flight, exposed through the swapchain accessors
+        void create_offscreen_targets(uint32_t width, uint32_t height);
+        bool create_buffer(VkDeviceSize size, VkBufferUsageFlags usage,
                            VkMemoryPropertyFlags properties,
-                           VkBuffer& buffer, VkDeviceMemory& memory) const noexcept;
+                           VkBuffer& buffer, gpu_allocation_t& allocation) noexcept;
+        void destroy_buffer(VkBuffer& buffer, gpu_allocation_t& allocation) noexcept;
         void cleanup();
 
         [[nodiscard]] static vulkan_context_t* get() noexcept { return _context; }
@@ -25,14 +34,21 @@ namespace carrot::rhi::vulkan {
         [[nodiscard]] VkCommandBuffer begin_one_time_commands() const noexcept;
         void end_one_time_commands(VkCommandBuffer cmd) const noexcept;
 
-        void set_render_pass(VkRenderPass render_pass) noexcept { _render_pass = render_pass; }
-
         [[nodiscard]] VkInstance instance() const noexcept { return _instance; }
+        [[nodiscard]] VkPhysicalDevice physical_device() const noexcept { return _physical_device; }
         [[nodiscard]] VkDevice device() const noexcept { return _device; }
         [[nodiscard]] VkSurfaceKHR surface() const noexcept { return _surface; }
+        [[nodiscard]] bool is_headless() const noexcept { return _surface == VK_NULL_HANDLE; }
         [[nodiscard]] uint32_t graphics_family() const noexcept { return _graphics_family; }
         [[nodiscard]] VkCommandPool transient_command_pool() const noexcept { return _transient_command_pool.pool; }
-        [[nodiscard]] VkRenderPass render_pass() const noexcept { return _render_pass; }
+        [[nodiscard]] VkPipelineCache pipeline_cache() const noexcept { return _pipeline_cache; }
+        [[nodiscard]] layout_cache_t& layout_cache() noexcept { return _layout_cache; }
+        [[nodiscard]] bindless_heap_t& bindless() noexcept { return _bindless; }
+        [[nodiscard]] gpu_allocator_t& allocator() noexcept { return _allocator; }
+        [[nodiscard]] transient_ring_t& transient_ring() noexcept { return _transient_ring; }
+        [[nodiscard]] upload_service_t& uploads() noexcept { return _uploads; }
+        // Signalled with an increasing value by every frame submission; query it instead of per-frame fences
+        [[nodiscard]] timeline_semaphore_t& frame_timeline() noexcept { return _frame_timeline; }
         [[nodiscard]] VkQueue graphics_queue() const noexcept { return _graphics_queue; }
         [[nodiscard]] VkQueue present_queue() const noexcept { return _present_queue; }
         [[nodiscard]] VkSwapchainKHR* swapchain() noexcept { return &_swapchain.swapchain; }
@@ -40,8 +56,13 @@ namespace carrot::rhi::vulkan {
         [[nodiscard]] VkExtent2D swapchain_extent() const noexcept { return _swapchain_extent; }
         [[nodiscard]] uint32_t image_count() const noexcept { return _image_count; }
         [[nodiscard]] VkImageView* swapchain_views() noexcept { return _swapchain_views.data(); }
+        [[nodiscard]] VkImage swapchain_image(const uint32_t index) const noexcept { return _swapchain_images[index]; }
 
     private:
+        void destroy_offscreen_targets() noexcept;
+        void create_pipeline_cache();
+        void save_pipeline_cache() const;
+
         VkInstance              _instance{ VK_NULL_HANDLE };
         VkPhysicalDevice        _physical_device{ VK_NULL_HANDLE };
         VkSurfaceKHR            _surface{ VK_NULL_HANDLE };
@@ -50,8 +71,9 @@ namespace carrot::rhi::vulkan {
         command_pool_t          _transient_command_pool;
         swapchain_t             _swapchain;
 
-        std::vector<VkImage>    _swapchain_images;
+        graphics_vector_t<VkImage> _swapchain_images;
         image_view_array_t      _swapchain_views;
+        graphics_vector_t<gpu_allocation_t> _offscreen_allocations; // backing _swapchain_images in headless mode
 
         VkFormat                _swapchain_format{ };
         VkExtent2D              _swapchain_extent{ };
@@ -59,10 +81,18 @@ namespace carrot::rhi::vulkan {
 
         uint32_t                _graphics_family{ ~0u };
         uint32_t                _present_family{ ~0u };
+        uint32_t                _transfer_family{ ~0u };
         VkQueue                 _graphics_queue{ VK_NULL_HANDLE };
         VkQueue                 _present_queue{ VK_NULL_HANDLE };
+        VkQueue                 _transfer_queue{ VK_NULL_HANDLE };
 
-        VkRenderPass            _render_pass{ VK_NULL_HANDLE };
+        VkPipelineCache         _pipeline_cache{ VK_NULL_HANDLE };
+        layout_cache_t          _layout_cache;
+        bindless_heap_t         _bindless;
+        gpu_allocator_t         _allocator;
+        transient_ring_t        _transient_ring;
+        upload_service_t        _uploads;
+        timeline_semaphore_t    _frame_timeline;
 
         static vulkan_context_t* _context;
     };
@@ -8,6 +8,7 @@
 #include "VulkanCommon.h"
 
 #include <array>
+#include <vector>
 
 namespace carrot::rhi::vulkan {
     constexpr uint32_t k_max_frames_in_flight{ 2 };
@@ -15,9 +16,9 @@ namespace carrot::rhi::vulkan {
     struct frame_resources_t
     {
         VkCommandBuffer command_buffer{ VK_NULL_HANDLE };
-        VkSemaphore image_available{ VK_NULL_HANDLE };
+        VkSemaphore image_available{ VK_NULL_HANDLE }; // binary, acquire and present cannot use timelines
         VkSemaphore render_finished{ VK_NULL_HANDLE };
-        VkFence in_flight{ VK_NULL_HANDLE };
+        uint64_t timeline_value{ 0 }; // frame timeline value reached once this slot's last submission retired
 
         // Note: potential future per-frame additions...
         // VkDescriptorSet descriptor_set{ VK_NULL_HANDLE };
@@ -87,64 +88,103 @@ namespace carrot::rhi::vulkan {
         explicit operator VkPipelineLayout() const { return layout; }
     };
 
-    struct render_pass_t
+    struct command_pool_t
     {
         VkDevice device = VK_NULL_HANDLE;
-        VkRenderPass pass = VK_NULL_HANDLE;
+        VkCommandPool pool = VK_NULL_HANDLE;
 
-        render_pass_t() = default;
-        render_pass_t(VkDevice dev, VkRenderPass render_pass) : device{ dev }, pass{ render_pass } {}
+        command_pool_t() = default;
+        command_pool_t(VkDevice dev, VkCommandPool cmd_pool) : device{ dev }, pool{ cmd_pool } {}
 
-        ~render_pass_t() { if (pass) vkDestroyRenderPass(device, pass, nullptr); }
+        ~command_pool_t() { if (pool) vkDestroyCommandPool(device, pool, nullptr); }
 
         // Move allowed, copy disallowed
-        DISABLE_COPY(render_pass_t)
-        render_pass_t(render_pass_t&& other) noexcept { *this = std::move(other); }
+        DISABLE_COPY(command_pool_t)
+        command_pool_t(command_pool_t&& other) noexcept { *this = std::move(other); }
 
-        render_pass_t& operator=(render_pass_t&& other) noexcept
+        command_pool_t& operator=(command_pool_t&& other) noexcept
         {
             if (this != &other)
             {
-                if (pass) vkDestroyRenderPass(device, pass, nullptr);
+                if (pool) vkDestroyCommandPool(device, pool, nullptr);
                 device = other.device;
-                pass = other.pass;
+                pool = other.pool;
                 other.device = VK_NULL_HANDLE;
-                other.pass = VK_NULL_HANDLE;
+                other.pool = VK_NULL_HANDLE;
             }
             return *this;
         }
 
-        explicit operator VkRenderPass() const { return pass; }
+        explicit operator VkCommandPool() const { return pool; }
     };
 
-    struct command_pool_t
+    // Monotonic GPU progress counter. A submission signals the value handed out by advance(); anything tied to
+    // that value (a frame, a readback, a resource waiting for deletion) is done once has_reached() says so.
+    struct timeline_semaphore_t
     {
-        VkDevice device = VK_NULL_HANDLE;
-        VkCommandPool pool = VK_NULL_HANDLE;
+        VkDevice device{ VK_NULL_HANDLE };
+        VkSemaphore semaphore{ VK_NULL_HANDLE };
+        uint64_t pending{ 0 }; // last value handed out to a submission
 
-        command_pool_t() = default;
-        command_pool_t(VkDevice dev, VkCommandPool cmd_pool) : device{ dev }, pool{ cmd_pool } {}
+        timeline_semaphore_t() = default;
+        explicit timeline_semaphore_t(VkDevice dev) : device{ dev }
+        {
+            VkSemaphoreTypeCreateInfo type_info{ };
+            type_info.sType = VK_STRUCTURE_TYPE_SEMAPHORE_TYPE_CREATE_INFO;
+            type_info.semaphoreType = VK_SEMAPHORE_TYPE_TIMELINE;
+            type_info.initialValue = 0;
+
+            VkSemaphoreCreateInfo info{ };
+            info.sType = VK_STRUCTURE_TYPE_SEMAPHORE_CREATE_INFO;
+            info.pNext = &type_info;
+            vkCreateSemaphore(device, &info, nullptr, &semaphore);
+        }
 
-        ~command_pool_t() { if (pool) vkDestroyCommandPool(device, pool, nullptr); }
+        ~timeline_semaphore_t() { if (semaphore) vkDestroySemaphore(device, semaphore, nullptr); }
 
         // Move allowed, copy disallowed
-        DISABLE_COPY(command_pool_t)
-        command_pool_t(command_pool_t&& other) noexcept { *this = std::move(other); }
+        DISABLE_COPY(timeline_semaphore_t)
+        timeline_semaphore_t(timeline_semaphore_t&& other) noexcept { *this = std::move(other); }
 
-        command_pool_t& operator=(command_pool_t&& other) noexcept
+        timeline_semaphore_t& operator=(timeline_semaphore_t&& other) noexcept
         {
             if (this != &other)
             {
-                if (pool) vkDestroyCommandPool(device, pool, nullptr);
+                if (semaphore) vkDestroySemaphore(device, semaphore, nullptr);
                 device = other.device;
-                pool = other.pool;
+                semaphore = other.semaphore;
+                pending = other.pending;
                 other.device = VK_NULL_HANDLE;
-                other.pool = VK_NULL_HANDLE;
+                other.semaphore = VK_NULL_HANDLE;
+                other.pending = 0;
             }
             return *this;
         }
 
-        explicit operator VkCommandPool() const { return pool; }
+        [[nodiscard]] uint64_t advance() noexcept { return ++pending; }
+
+        [[nodiscard]] uint64_t completed() const noexcept
+        {
+            uint64_t value{ 0 };
+            vkGetSemaphoreCounterValue(device, semaphore, &value);
+            return value;
+        }
+
+        [[nodiscard]] bool has_reached(const uint64_t value) const noexcept { return value == 0 || completed() >= value; }
+
+        void wait(const uint64_t value) const noexcept
+        {
+            if (value == 0) return;
+
+            VkSemaphoreWaitInfo wait_info{ };
+            wait_info.sType = VK_STRUCTURE_TYPE_SEMAPHORE_WAIT_INFO;
+            wait_info.semaphoreCount = 1;
+            wait_info.pSemaphores = &semaphore;
+            wait_info.pValues = &value;
+            vkWaitSemaphores(device, &wait_info, ~0ull);
+        }
+
+        operator VkSemaphore() const { return semaphore; }
     };
 
     struct device_t
@@ -202,55 +242,6 @@ namespace carrot::rhi::vulkan {
         operator VkSwapchainKHR() const { return swapchain; }
     };
 
-    // Custom framebuffer container with auto-cleanup
-    struct framebuffer_array_t : std::vector<VkFramebuffer>
-    {
-        VkDevice device{ VK_NULL_HANDLE };
-
-        framebuffer_array_t() = default;
-        explicit framebuffer_array_t(VkDevice dev) : device{ dev } {}
-
-        ~framebuffer_array_t()
-        {
-            for (auto fb: *this)
-                if (fb) vkDestroyFramebuffer(device, fb, nullptr);
-            clear();
-        }
-
-        // Move allowed, copy disallowed
-        DISABLE_COPY(framebuffer_array_t)
-
-        framebuffer_array_t(framebuffer_array_t&& other) noexcept
-            : std::vector<VkFramebuffer>(std::move(static_cast<std::vector<VkFramebuffer> &>(other))),
-              device(other.device)
-        {
-            other.device = VK_NULL_HANDLE;
-            other.clear(); // optional: prevent double destroy
-        }
-
-        framebuffer_array_t& operator=(framebuffer_array_t&& other) noexcept
-        {
-            if (this != &other)
-            {
-                // Destroy current contents
-                if (device != VK_NULL_HANDLE)
-                {
-                    for (auto fb: *this)
-                        if (fb) vkDestroyFramebuffer(device, fb, nullptr);
-                }
-                clear();
-
-                // Move from other
-                static_cast<std::vector<VkFramebuffer> &>(*this) = std::move(
-                    static_cast<std::vector<VkFramebuffer> &>(other));
-                device = other.device;
-                other.device = VK_NULL_HANDLE;
-                other.clear();
-            }
-            return *this;
-        }
-    };
-
     // Reusable pattern for an array of destroyable objects
     template<typename T, void(*DestroyFunc)(VkDevice, T, const VkAllocationCallbacks*)>
     struct vk_array_t : std::vector<T>
@@ -0,0 +1,168 @@
+//
+// Created by zshrout on 10/18/26.
+// Copyright (c) 2026 BunnySofty. All rights reserved.
+//
+
+#include "VulkanFrameCapture.h"
+
+#include "VulkanContext.h"
+#include "Common/CommonHeaders.h"
+
+#define STB_IMAGE_WRITE_IMPLEMENTATION
+#include <stb_image_write.h>
+
+#include <format>
+#include <fstream>
+#include <vector>
+
+namespace carrot::rhi::vulkan {
+    namespace {
+        constexpr uint32_t k_bytes_per_texel{ 4 }; // the color target is B8G8R8A8
+
+        [[nodiscard]] const char* extension(const renderer::image_file_format format) noexcept
+        {
+            return format == renderer::image_file_format::png ? "png" : "ppm";
+        }
+    } // anonymous namespace
+
+    // PUBLIC
+    void frame_capture_t::init(vulkan_context_t& ctx, const std::filesystem::path& directory,
+                               const renderer::image_file_format format)
+    {
+        std::error_code ec;
+        std::filesystem::create_directories(directory, ec);
+        if (ec)
+        {
+            LOG_GRAPHICS_ERROR("[Vulkan] Frame capture disabled, cannot create {}: {}", directory.string(),
+                               ec.message());
+            return;
+        }
+
+        _ctx = &ctx;
+        _directory = directory;
+        _format = format;
+        LOG_GRAPHICS_INFO("[Vulkan] Capturing frames to {} as {}", _directory.string(), extension(_format));
+    }
+
+    void frame_capture_t::shutdown()
+    {
+        if (_ctx == nullptr) return;
+
+        for (readback_t& readback: _readbacks)
+        {
+            if (readback.pending) write(readback);
+            if (readback.buffer != VK_NULL_HANDLE) _ctx->destroy_buffer(readback.buffer, readback.allocation);
+            readback = { };
+        }
+
+        _graph = nullptr;
+        _ctx = nullptr;
+    }
+
+    void frame_capture_t::add_pass(render_graph_t& graph, const rg_resource_t target, const uint32_t frame_index,
+                                   const uint64_t frame_number)
+    {
+        readback_t& readback{ _readbacks[frame_index] };
+        CE_ASSERT(!readback.pending, "Frame slot reused before its capture was collected");
+
+        if (!reserve(readback, _ctx->swapchain_extent())) return;
+        readback.frame_number = frame_number;
+        readback.pending = true;
+
+        _graph = &graph;
+        _target = target;
+        _frame_index = frame_index;
+
+        // Nothing in the graph consumes the copy, it has to be kept explicitly
+        graph.add_pass("frame_capture", record_delegate_t::bind<&frame_capture_t::record_copy>(this))
+             .use(target, rg_access::transfer_read)
+             .side_effect();
+    }
+
+    void frame_capture_t::collect(const uint32_t frame_index)
+    {
+        readback_t& readback{ _readbacks[frame_index] };
+        if (!readback.pending) return;
+
+        write(readback);
+        readback.pending = false;
+    }
+
+    // PRIVATE
+    bool frame_capture_t::reserve(readback_t& readback, const VkExtent2D extent)
+    {
+        if (readback.buffer != VK_NULL_HANDLE && readback.extent.width == extent.width &&
+            readback.extent.height == extent.height)
+            return true;
+
+        // Not pending, so no submission still writes the old buffer
+        if (readback.buffer != VK_NULL_HANDLE) _ctx->destroy_buffer(readback.buffer, readback.allocation);
+        readback.extent = { };
+
+        const VkDeviceSize size{ VkDeviceSize{ extent.width } * extent.height * k_bytes_per_texel };
+        if (!_ctx->create_buffer(size, VK_BUFFER_USAGE_TRANSFER_DST_BIT,
+                                 VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT,
+                                 readback.buffer, readback.allocation))
+        {
+            LOG_GRAPHICS_ERROR("[Vulkan] Failed to create a {}x{} capture buffer", extent.width, extent.height);
+            return false;
+        }
+
+        readback.extent = extent;
+        return true;
+    }
+
+    void frame_capture_t::record_copy(VkCommandBuffer cmd)
+    {
+        const readback_t& readback{ _readbacks[_frame_index] };
+
+        VkBufferImageCopy region{ };
+        region.imageSubresource = { VK_IMAGE_ASPECT_COLOR_BIT, 0, 0, 1 };
+        region.imageExtent = { readback.extent.width, readback.extent.height, 1 };
+        vkCmdCopyImageToBuffer(cmd, _graph->image(_target), VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL, readback.buffer, 1,
+                               &region);
+
+        // The graph only tracks device accesses; make the copy available to the host read in collect()
+        VkMemoryBarrier barrier{ };
+        barrier.sType = VK_STRUCTURE_TYPE_MEMORY_BARRIER;
+        barrier.srcAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
+        barrier.dstAccessMask = VK_ACCESS_HOST_READ_BIT;
+        vkCmdPipelineBarrier(cmd, VK_PIPELINE_STAGE_TRANSFER_BIT, VK_PIPELINE_STAGE_HOST_BIT, 0, 1, &barrier,
+                             0, nullptr, 0, nullptr);
+    }
+
+    void frame_capture_t::write(const readback_t& readback) const
+    {
+        const uint32_t width{ readback.extent.width };
+        const uint32_t height{ readback.extent.height };
+        const auto* texels{ static_cast<const uint8_t*>(readback.allocation.mapped) };
+
+        // BGRA → RGB; the target is sRGB-encoded already, so the bytes go out as they are
+        std::vector<uint8_t> rgb(size_t{ width } * height * 3);
+        for (size_t i{ 0 }, count{ size_t{ width } * height }; i < count; ++i)
+        {
+            rgb[i * 3 + 0] = texels[i * k_bytes_per_texel + 2];
+            rgb[i * 3 + 1] = texels[i * k_bytes_per_texel + 1];
+            rgb[i * 3 + 2] = texels[i * k_bytes_per_texel + 0];
+        }
+
+        const std::filesystem::path path{
+            _directory / std::format("frame_{:05}.{}", readback.frame_number, extension(_format))
+        };
+
+        bool written{ false };
+        if (_format == renderer::image_file_format::png)
+        {
+            written = stbi_write_png(path.string().c_str(), static_cast<int>(width), static_cast<int>(height), 3,
+                                     rgb.data(), static_cast<int>(width * 3)) != 0;
+        }
+        else if (std::ofstream file{ path, std::ios::binary | std::ios::trunc }; file.is_open())
+        {
+            file << std::format("P6\n{} {}\n255\n", width, height);
+            file.write(reinterpret_cast<const char*>(rgb.data()), static_cast<std::streamsize>(rgb.size()));
+            written = file.good();
+        }
+
+        if (!written) LOG_GRAPHICS_WARN("[Vulkan] Failed to write frame capture {}", path.string());
+    }
+} // namespace carrot::rhi::vulkan
@@ -0,0 +1,62 @@
+//
+// Created by zshrout on 10/18/26.
+// Copyright (c) 2026 BunnySofty. All rights reserved.
+//
+
+#pragma once
+
+#include "VulkanAllocator.h"
+#include "VulkanCommon.h"
+#include "VulkanCore.h"
+#include "VulkanRenderGraph.h"
+#include "Renderer/RendererConfig.h"
+
+#include <array>
+#include <filesystem>
+
+namespace carrot::rhi::vulkan {
+    class vulkan_context_t;
+
+    // Reads rendered frames back to the host and writes them to disk. Each frame slot owns a host-visible
+    // buffer the frame's color target is copied into at the end of the graph; the file is written once that
+    // slot comes around again and its submission has retired, so capturing never stalls the GPU.
+    class frame_capture_t
+    {
+    public:
+        void init(vulkan_context_t& ctx, const std::filesystem::path& directory, renderer::image_file_format format);
+        // Writes frames still in flight; the device has to be idle
+        void shutdown();
+
+        [[nodiscard]] bool is_enabled() const noexcept { return _ctx != nullptr; }
+
+        // Declares the copy of `target`, which holds frame `frame_number` at the end of the graph
+        void add_pass(render_graph_t& graph, rg_resource_t target, uint32_t frame_index, uint64_t frame_number);
+        // Call once the frame slot's previous submission has retired
+        void collect(uint32_t frame_index);
+
+    private:
+        struct readback_t
+        {
+            VkBuffer                buffer{ VK_NULL_HANDLE };
+            gpu_allocation_t        allocation;
+            VkExtent2D              extent{ 0, 0 };
+            uint64_t                frame_number{ 0 };
+            bool                    pending{ false };
+        };
+
+        [[nodiscard]] bool reserve(readback_t& readback, VkExtent2D extent);
+        void record_copy(VkCommandBuffer cmd);
+        void write(const readback_t& readback) const;
+
+        vulkan_context_t*           _ctx{ nullptr };
+        std::filesystem::path       _directory;
+        renderer::image_file_format _format{ renderer::image_file_format::ppm };
+
+        std::array<readback_t, k_max_frames_in_flight> _readbacks;
+
+        // Declared this frame
+        const render_graph_t*       _graph{ nullptr };
+        rg_resource_t               _target;
+        uint32_t                    _frame_index{ 0 };
+    };
+} // namespace carrot::rhi::vulkan
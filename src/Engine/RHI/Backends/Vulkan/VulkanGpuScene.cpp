@@ -0,0 +1,362 @@
+//
+// Created by zshrout on 10/18/26.
+// Copyright (c) 2026 BunnySofty. All rights reserved.
+//
+
+#include "VulkanGpuScene.h"
+
+#include "VulkanContext.h"
+#include "Renderer/ShaderReflection.h"
+#include "Utils/ShaderUtils.h"
+#include "Common/CommonHeaders.h"
+
+#include <cmath>
+
+namespace carrot::rhi::vulkan {
+    namespace {
+        constexpr uint32_t k_cull_group_size{ 64 }; // local_size_x in cull.comp
+
+        // Matches the Push block in cull.comp
+        struct cull_push_t
+        {
+            float       frustum[6][4];
+            uint32_t    instances;
+            uint32_t    meshes;
+            uint32_t    draws;
+            uint32_t    count;
+            uint32_t    instance_count;
+        };
+        static_assert(sizeof(cull_push_t) <= 128, "Push constants beyond the guaranteed minimum");
+
+        // Last frame's consumers of each buffer; this frame's first writer has to wait for them
+        constexpr rg_state_t k_read_by_shaders{
+            VK_IMAGE_LAYOUT_UNDEFINED, VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT | VK_PIPELINE_STAGE_VERTEX_SHADER_BIT, 0
+        };
+        constexpr rg_state_t k_read_by_compute{ VK_IMAGE_LAYOUT_UNDEFINED, VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, 0 };
+        constexpr rg_state_t k_read_as_indirect{ VK_IMAGE_LAYOUT_UNDEFINED, VK_PIPELINE_STAGE_DRAW_INDIRECT_BIT, 0 };
+
+        template<typename T>
+        bool patch(VkCommandBuffer cmd, transient_ring_t& ring, const graphics_vector_t<T>& source, uint32_t& begin,
+                   uint32_t& end, VkBuffer destination)
+        {
+            if (begin >= end) return true;
+
+            const transient_slice_t slice{ ring.push(std::span<const T>{ source.data() + begin, end - begin }) };
+            if (!slice.is_valid()) return false; // ring exhausted, stays dirty for the next frame
+
+            const VkBufferCopy copy{ slice.offset, begin * sizeof(T), (end - begin) * sizeof(T) };
+            vkCmdCopyBuffer(cmd, slice.buffer, destination, 1, &copy);
+
+            begin = ~0u;
+            end = 0;
+            return true;
+        }
+    } // anonymous namespace
+
+    // PUBLIC
+    void gpu_scene_t::init(vulkan_context_t& ctx)
+    {
+        _ctx = &ctx;
+
+        constexpr VkBufferUsageFlags k_patched{ VK_BUFFER_USAGE_STORAGE_BUFFER_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT };
+        constexpr VkBufferUsageFlags k_indirect{
+            VK_BUFFER_USAGE_STORAGE_BUFFER_BIT | VK_BUFFER_USAGE_INDIRECT_BUFFER_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT
+        };
+
+        create_buffer(_vertices, k_max_scene_vertices * sizeof(scene_vertex_t),
+                      VK_BUFFER_USAGE_VERTEX_BUFFER_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT);
+        create_buffer(_indices, k_max_scene_indices * sizeof(uint32_t),
+                      VK_BUFFER_USAGE_INDEX_BUFFER_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT);
+        create_buffer(_instance_buffer, k_max_scene_instances * sizeof(gpu_instance_t), k_patched);
+        create_buffer(_mesh_buffer, k_max_scene_meshes * sizeof(gpu_mesh_t), k_patched);
+        create_buffer(_draw_buffer, k_max_scene_instances * sizeof(VkDrawIndexedIndirectCommand), k_indirect);
+        create_buffer(_count_buffer, sizeof(uint32_t), k_indirect);
+
+        bindless_heap_t& heap{ _ctx->bindless() };
+        _instance_handle = heap.add_storage_buffer(_instance_buffer.buffer);
+        _mesh_handle = heap.add_storage_buffer(_mesh_buffer.buffer);
+        _draw_handle = heap.add_storage_buffer(_draw_buffer.buffer);
+        _count_handle = heap.add_storage_buffer(_count_buffer.buffer);
+
+        set_view_projection(_view_projection);
+        create_pipeline();
+    }
+
+    void gpu_scene_t::shutdown()
+    {
+        if (_ctx == nullptr) return;
+
+        vkDestroyPipeline(_ctx->device(), _cull_pipeline, nullptr);
+        _cull_pipeline = VK_NULL_HANDLE;
+        _cull_layout = { }; // owned by the layout cache
+
+        bindless_heap_t& heap{ _ctx->bindless() };
+        heap.release(_instance_handle);
+        heap.release(_mesh_handle);
+        heap.release(_draw_handle);
+        heap.release(_count_handle);
+
+        destroy_buffer(_vertices);
+        destroy_buffer(_indices);
+        destroy_buffer(_instance_buffer);
+        destroy_buffer(_mesh_buffer);
+        destroy_buffer(_draw_buffer);
+        destroy_buffer(_count_buffer);
+
+        _instances.clear();
+        _meshes.clear();
+        _pending_meshes.clear();
+        _dirty_instances = { };
+        _dirty_meshes = { };
+        _gpu_instance_count = 0;
+        _vertex_count = 0;
+        _index_count = 0;
+        _ctx = nullptr;
+    }
+
+    void gpu_scene_t::rebuild_pipeline()
+    {
+        vkDestroyPipeline(_ctx->device(), _cull_pipeline, nullptr);
+        _cull_pipeline = VK_NULL_HANDLE;
+
+        create_pipeline();
+    }
+
+    scene_mesh_t gpu_scene_t::add_mesh(const std::span<const scene_vertex_t> vertices,
+                                       const std::span<const uint32_t> indices)
+    {
+        if (_meshes.size() >= k_max_scene_meshes || _vertex_count + vertices.size() > k_max_scene_vertices ||
+            _index_count + indices.size() > k_max_scene_indices)
+        {
+            LOG_GRAPHICS_ERROR("[Vulkan] Scene geometry buffers are full, mesh with {} vertices dropped",
+                               vertices.size());
+            return { };
+        }
+
+        pending_mesh_t pending{ };
+        pending.mesh = static_cast<uint32_t>(_meshes.size());
+        pending.gpu.index_count = static_cast<uint32_t>(indices.size());
+        pending.gpu.first_index = _index_count;
+        pending.gpu.vertex_offset = static_cast<int32_t>(_vertex_count);
+        for (const scene_vertex_t& vertex: vertices)
+        {
+            const float* p{ vertex.position };
+            pending.gpu.radius = std::max(pending.gpu.radius, std::sqrt(p[0] * p[0] + p[1] * p[1] + p[2] * p[2]));
+        }
+
+        // Append-only, so no frame in flight reads the ranges being written
+        upload_service_t& uploads{ _ctx->uploads() };
+        buffer_upload_t upload{ };
+        upload.buffer = _vertices.buffer;
+        upload.offset = _vertex_count * sizeof(scene_vertex_t);
+        upload.dst_access = VK_ACCESS_VERTEX_ATTRIBUTE_READ_BIT;
+        // Both land in the same batch, the index upload's ticket covers the vertices too
+        const upload_ticket_t vertex_ticket{ uploads.upload_buffer(upload, vertices.data(), vertices.size_bytes()) };
+        if (vertex_ticket.is_valid())
+        {
+            upload.buffer = _indices.buffer;
+            upload.offset = _index_count * sizeof(uint32_t);
+            upload.dst_access = VK_ACCESS_INDEX_READ_BIT;
+            pending.ticket = uploads.upload_buffer(upload, indices.data(), indices.size_bytes());
+        }
+
+        // Reserved even on failure: a copy that did get queued may still land in these ranges
+        _vertex_count += static_cast<uint32_t>(vertices.size());
+        _index_count += static_cast<uint32_t>(indices.size());
+
+        if (!pending.ticket.is_valid())
+        {
+            LOG_GRAPHICS_ERROR("[Vulkan] Failed to queue the upload of a mesh with {} vertices, mesh dropped",
+                               vertices.size());
+            return { };
+        }
+
+        // Published with index_count 0 so instances may reference it right away; they are culled until it lands
+        _meshes.push_back({ });
+        _dirty_meshes.add(pending.mesh);
+        _pending_meshes.push_back(pending);
+
+        return { pending.mesh };
+    }
+
+    scene_instance_t gpu_scene_t::add_instance(const gpu_instance_t& instance)
+    {
+        CE_ASSERT(instance.mesh < _meshes.size(), "Scene instance references an unknown mesh");
+
+        if (_instances.size() >= k_max_scene_instances)
+        {
+            LOG_GRAPHICS_ERROR("[Vulkan] Scene is full ({} instances)", k_max_scene_instances);
+            return { };
+        }
+
+        const uint32_t index{ static_cast<uint32_t>(_instances.size()) };
+        _instances.push_back(instance);
+        _dirty_instances.add(index);
+        return { index };
+    }
+
+    void gpu_scene_t::set_instance(const scene_instance_t handle, const gpu_instance_t& instance)
+    {
+        if (!handle.is_valid()) return;
+
+        _instances[handle.index] = instance;
+        _dirty_instances.add(handle.index);
+    }
+
+    void gpu_scene_t::set_view_projection(const float (&matrix)[16]) noexcept
+    {
+        std::copy(std::begin(matrix), std::end(matrix), _view_projection);
+
+        // Gribb-Hartmann: planes are sums of the matrix rows; with depth 0..1 the near plane is row 2 alone
+        const auto row = [this](const uint32_t r, const uint32_t c) { return _view_projection[c * 4 + r]; };
+        for (uint32_t c{ 0 }; c < 4; ++c)
+        {
+            _frustum[0][c] = row(3, c) + row(0, c); // left
+            _frustum[1][c] = row(3, c) - row(0, c); // right
+            _frustum[2][c] = row(3, c) + row(1, c); // bottom
+            _frustum[3][c] = row(3, c) - row(1, c); // top
+            _frustum[4][c] = row(2, c);             // near
+            _frustum[5][c] = row(3, c) - row(2, c); // far
+        }
+
+        // Normalized, so the distance test can use the bounding sphere radius directly
+        for (float (&plane)[4]: _frustum)
+        {
+            const float length{ std::sqrt(plane[0] * plane[0] + plane[1] * plane[1] + plane[2] * plane[2]) };
+            if (length <= 0.0f) continue;
+            for (float& value: plane) value /= length;
+        }
+    }
+
+    void gpu_scene_t::add_passes(render_graph_t& graph)
+    {
+        collect_uploaded_meshes();
+
+        _rg_instances = graph.import_buffer("scene_instances", { _instance_buffer.buffer, 0, VK_WHOLE_SIZE,
+                                                                 k_read_by_shaders });
+        _rg_meshes = graph.import_buffer("scene_meshes", { _mesh_buffer.buffer, 0, VK_WHOLE_SIZE, k_read_by_compute });
+        _rg_draws = graph.import_buffer("scene_draws", { _draw_buffer.buffer, 0, VK_WHOLE_SIZE, k_read_as_indirect });
+        _rg_count = graph.import_buffer("scene_draw_count", { _count_buffer.buffer, 0, VK_WHOLE_SIZE,
+                                                              k_read_as_indirect });
+
+        // Always declared, even when nothing changed, so the graph topology stays stable
+        graph.add_pass("scene_upload", record_delegate_t::bind<&gpu_scene_t::record_upload>(this))
+             .use(_rg_instances, rg_access::transfer_write)
+             .use(_rg_meshes, rg_access::transfer_write)
+             .use(_rg_count, rg_access::transfer_write);
+
+        graph.add_pass("scene_cull", record_delegate_t::bind<&gpu_scene_t::record_cull>(this))
+             .use(_rg_instances, rg_access::storage_read_compute)
+             .use(_rg_meshes, rg_access::storage_read_compute)
+             .use(_rg_draws, rg_access::storage_write_compute)
+             .use(_rg_count, rg_access::storage_write_compute);
+    }
+
+    render_graph_t::pass_builder_t& gpu_scene_t::use_draw_resources(render_graph_t::pass_builder_t& pass) const
+    {
+        return pass.use(_rg_draws, rg_access::indirect)
+                   .use(_rg_count, rg_access::indirect)
+                   .use(_rg_instances, rg_access::storage_read_graphics);
+    }
+
+    void gpu_scene_t::draw(VkCommandBuffer cmd, VkPipelineLayout layout) const
+    {
+        _ctx->bindless().bind(cmd, VK_PIPELINE_BIND_POINT_GRAPHICS, layout);
+
+        constexpr VkDeviceSize offset{ 0 };
+        vkCmdBindVertexBuffers(cmd, 0, 1, &_vertices.buffer, &offset);
+        vkCmdBindIndexBuffer(cmd, _indices.buffer, 0, VK_INDEX_TYPE_UINT32);
+
+        // The count written by the cull pass picks how many of the commands run
+        vkCmdDrawIndexedIndirectCount(cmd, _draw_buffer.buffer, 0, _count_buffer.buffer, 0, _gpu_instance_count,
+                                      sizeof(VkDrawIndexedIndirectCommand));
+    }
+
+    // PRIVATE
+    void gpu_scene_t::create_buffer(device_buffer_t& buffer, const VkDeviceSize size,
+                                    const VkBufferUsageFlags usage) const
+    {
+        if (!_ctx->create_buffer(size, usage, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT, buffer.buffer, buffer.allocation))
+            LOG_GRAPHICS_ERROR("[Vulkan] Failed to create a {} KiB scene buffer", size / 1024);
+    }
+
+    void gpu_scene_t::destroy_buffer(device_buffer_t& buffer) const noexcept
+    {
+        if (buffer.buffer != VK_NULL_HANDLE) _ctx->destroy_buffer(buffer.buffer, buffer.allocation);
+    }
+
+    void gpu_scene_t::create_pipeline()
+    {
+        const spv_blob_t comp_spv{ load_spv("shaders/cull.comp.spv") };
+
+        renderer::shader_reflection_t reflection{ };
+        if (!reflect_stages({ comp_spv }, reflection)) return;
+
+        _cull_layout = _ctx->layout_cache().pipeline_layout(reflection);
+        CE_ASSERT(_cull_layout.push_range.size == sizeof(cull_push_t), "cull_push_t does not match cull.comp");
+
+        VkShaderModuleCreateInfo mod_info{ };
+        mod_info.sType = VK_STRUCTURE_TYPE_SHADER_MODULE_CREATE_INFO;
+        mod_info.codeSize = comp_spv.size_bytes();
+        mod_info.pCode = comp_spv.data();
+
+        VkShaderModule comp_mod{ VK_NULL_HANDLE };
+        vkCreateShaderModule(_ctx->device(), &mod_info, nullptr, &comp_mod);
+
+        VkComputePipelineCreateInfo pipe_info{ };
+        pipe_info.sType = VK_STRUCTURE_TYPE_COMPUTE_PIPELINE_CREATE_INFO;
+        pipe_info.stage = {
+            VK_STRUCTURE_TYPE_PIPELINE_SHADER_STAGE_CREATE_INFO, nullptr, 0, VK_SHADER_STAGE_COMPUTE_BIT,
+            comp_mod, "main", nullptr
+        };
+        pipe_info.layout = _cull_layout.pipeline_layout;
+
+        vkCreateComputePipelines(_ctx->device(), _ctx->pipeline_cache(), 1, &pipe_info, nullptr, &_cull_pipeline);
+        vkDestroyShaderModule(_ctx->device(), comp_mod, nullptr);
+    }
+
+    void gpu_scene_t::collect_uploaded_meshes()
+    {
+        const upload_service_t& uploads{ _ctx->uploads() };
+
+        std::erase_if(_pending_meshes, [this, &uploads](const pending_mesh_t& pending) {
+            if (!uploads.is_complete(pending.ticket)) return false;
+
+            _meshes[pending.mesh] = pending.gpu;
+            _dirty_meshes.add(pending.mesh);
+            return true;
+        });
+    }
+
+    void gpu_scene_t::record_upload(VkCommandBuffer cmd)
+    {
+        transient_ring_t& ring{ _ctx->transient_ring() };
+
+        // Meshes first: an instance only becomes visible to the cull pass once everything it references is there
+        if (patch(cmd, ring, _meshes, _dirty_meshes.begin, _dirty_meshes.end, _mesh_buffer.buffer) &&
+            patch(cmd, ring, _instances, _dirty_instances.begin, _dirty_instances.end, _instance_buffer.buffer))
+            _gpu_instance_count = instance_count();
+        else
+            LOG_GRAPHICS_WARN("[Vulkan] Transient ring exhausted, scene changes are deferred to the next frame");
+
+        vkCmdFillBuffer(cmd, _count_buffer.buffer, 0, sizeof(uint32_t), 0);
+    }
+
+    void gpu_scene_t::record_cull(VkCommandBuffer cmd)
+    {
+        if (_gpu_instance_count == 0 || _cull_pipeline == VK_NULL_HANDLE) return;
+
+        cull_push_t push{ };
+        std::copy(&_frustum[0][0], &_frustum[0][0] + 24, &push.frustum[0][0]);
+        push.instances = _instance_handle.index;
+        push.meshes = _mesh_handle.index;
+        push.draws = _draw_handle.index;
+        push.count = _count_handle.index;
+        push.instance_count = _gpu_instance_count;
+
+        vkCmdBindPipeline(cmd, VK_PIPELINE_BIND_POINT_COMPUTE, _cull_pipeline);
+        _ctx->bindless().bind(cmd, VK_PIPELINE_BIND_POINT_COMPUTE, _cull_layout.pipeline_layout);
+        vkCmdPushConstants(cmd, _cull_layout.pipeline_layout, _cull_layout.push_range.stageFlags, 0, sizeof(push), &push);
+        vkCmdDispatch(cmd, (_gpu_instance_count + k_cull_group_size - 1) / k_cull_group_size, 1, 1);
+    }
+} // namespace carrot::rhi::vulkan
@@ -0,0 +1,170 @@
+//
+// Created by zshrout on 10/18/26.
+// Copyright (c) 2026 BunnySofty. All rights reserved.
+//
+
+#pragma once
+
+#include "VulkanAllocator.h"
+#include "VulkanBindless.h"
+#include "VulkanCommon.h"
+#include "VulkanLayoutCache.h"
+#include "VulkanRenderGraph.h"
+#include "VulkanUploadService.h"
+
+#include <algorithm>
+#include <span>
+#include <vector>
+
+namespace carrot::rhi::vulkan {
+    class vulkan_context_t;
+
+    constexpr uint32_t k_max_scene_instances{ 65536 };
+    constexpr uint32_t k_max_scene_meshes{ 1024 };
+    constexpr uint32_t k_max_scene_vertices{ 256 * 1024 };
+    constexpr uint32_t k_max_scene_indices{ 1024 * 1024 };
+
+    // Layouts below are shared with shaders/scene.glsl (std430)
+    struct scene_vertex_t
+    {
+        float                   position[3];
+        float                   color[3];
+    };
+
+    struct gpu_instance_t
+    {
+        float                   position[3]{ 0.0f, 0.0f, 0.0f };
+        float                   scale{ 1.0f };
+        float                   rotation{ 0.0f };   // radians, around z
+        uint32_t                mesh{ 0 };
+        uint32_t                pad[2]{ };
+    };
+    static_assert(sizeof(gpu_instance_t) == 32);
+
+    struct gpu_mesh_t
+    {
+        uint32_t                index_count{ 0 };   // stays 0, so the mesh is culled, until its upload completed
+        uint32_t                first_index{ 0 };
+        int32_t                 vertex_offset{ 0 };
+        float                   radius{ 0.0f };     // bounding sphere around the mesh origin
+    };
+    static_assert(sizeof(gpu_mesh_t) == 16);
+
+    struct scene_mesh_t
+    {
+        uint32_t index{ ~0u };
+
+        [[nodiscard]] bool is_valid() const noexcept { return index != ~0u; }
+    };
+
+    struct scene_instance_t
+    {
+        uint32_t index{ ~0u };
+
+        [[nodiscard]] bool is_valid() const noexcept { return index != ~0u; }
+    };
+
+    // GPU-driven scene. Geometry of every mesh lives in one shared vertex and index buffer; instances and the mesh
+    // table live in storage buffers that are only patched where the CPU changed them. Each frame a compute pass
+    // frustum-culls all instances and appends one VkDrawIndexedIndirectCommand per visible instance, and the
+    // scene is drawn with a single vkCmdDrawIndexedIndirectCount, so CPU cost does not grow with the scene.
+    class gpu_scene_t
+    {
+    public:
+        void init(vulkan_context_t& ctx);
+        void shutdown();
+        void rebuild_pipeline();
+
+        // Geometry is uploaded asynchronously; instances of the mesh start drawing once it has landed
+        [[nodiscard]] scene_mesh_t add_mesh(std::span<const scene_vertex_t> vertices, std::span<const uint32_t> indices);
+        [[nodiscard]] scene_instance_t add_instance(const gpu_instance_t& instance);
+        void set_instance(scene_instance_t handle, const gpu_instance_t& instance);
+
+        // Column-major clip-from-world matrix, Vulkan clip space (depth 0..1)
+        void set_view_projection(const float (&matrix)[16]) noexcept;
+
+        // Declares the upload and culling passes; the result is consumed by draw() in a pass declared with
+        // use_draw_resources()
+        void add_passes(render_graph_t& graph);
+        render_graph_t::pass_builder_t& use_draw_resources(render_graph_t::pass_builder_t& pass) const;
+
+        // Binds geometry and the bindless heap; the caller binds a pipeline with a compatible layout and push
+        // constants first
+        void draw(VkCommandBuffer cmd, VkPipelineLayout layout) const;
+
+        [[nodiscard]] const float* view_projection() const noexcept { return _view_projection; }
+        [[nodiscard]] uint32_t instance_buffer_index() const noexcept { return _instance_handle.index; }
+        [[nodiscard]] uint32_t instance_count() const noexcept { return static_cast<uint32_t>(_instances.size()); }
+
+    private:
+        struct device_buffer_t
+        {
+            VkBuffer                buffer{ VK_NULL_HANDLE };
+            gpu_allocation_t        allocation;
+        };
+
+        struct pending_mesh_t
+        {
+            uint32_t                mesh{ 0 };
+            gpu_mesh_t              gpu;
+            upload_ticket_t         ticket;
+        };
+
+        // Elements [begin, end) differ between the CPU copy and the storage buffer
+        struct dirty_range_t
+        {
+            uint32_t                begin{ ~0u };
+            uint32_t                end{ 0 };
+
+            void add(const uint32_t index) noexcept
+            {
+                begin = std::min(begin, index);
+                end = std::max(end, index + 1);
+            }
+            [[nodiscard]] bool empty() const noexcept { return begin >= end; }
+        };
+
+        void create_buffer(device_buffer_t& buffer, VkDeviceSize size, VkBufferUsageFlags usage) const;
+        void destroy_buffer(device_buffer_t& buffer) const noexcept;
+        void create_pipeline();
+        void collect_uploaded_meshes();
+        void record_upload(VkCommandBuffer cmd);
+        void record_cull(VkCommandBuffer cmd);
+
+        vulkan_context_t*           _ctx{ nullptr };
+
+        device_buffer_t             _vertices;
+        device_buffer_t             _indices;
+        device_buffer_t             _instance_buffer;
+        device_buffer_t             _mesh_buffer;
+        device_buffer_t             _draw_buffer;   // VkDrawIndexedIndirectCommand per visible instance
+        device_buffer_t             _count_buffer;  // visible instance count
+
+        storage_buffer_handle_t     _instance_handle;
+        storage_buffer_handle_t     _mesh_handle;
+        storage_buffer_handle_t     _draw_handle;
+        storage_buffer_handle_t     _count_handle;
+
+        VkPipeline                  _cull_pipeline{ VK_NULL_HANDLE };
+        reflected_layout_t          _cull_layout;
+
+        // CPU copies, the storage buffers are patched from them
+        graphics_vector_t<gpu_instance_t>   _instances;
+        graphics_vector_t<gpu_mesh_t>       _meshes;
+        graphics_vector_t<pending_mesh_t>   _pending_meshes;
+        dirty_range_t               _dirty_instances;
+        dirty_range_t               _dirty_meshes;
+        uint32_t                    _gpu_instance_count{ 0 }; // instances whose data reached the storage buffer
+        uint32_t                    _vertex_count{ 0 };
+        uint32_t                    _index_count{ 0 };
+
+        float                       _view_projection[16]{ 1, 0, 0, 0, 0, 1, 0, 0, 0, 0, 1, 0, 0, 0, 0, 1 };
+        float                       _frustum[6][4]{ };
+
+        // Declared this frame
+        rg_resource_t               _rg_instances;
+        rg_resource_t               _rg_meshes;
+        rg_resource_t               _rg_draws;
+        rg_resource_t               _rg_count;
+    };
+} // namespace carrot::rhi::vulkan
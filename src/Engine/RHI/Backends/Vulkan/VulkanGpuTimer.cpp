@@ -0,0 +1,146 @@
+//
+// Created by zshrout on 10/18/26.
+// Copyright (c) 2026 BunnySofty. All rights reserved.
+//
+
+#include "VulkanGpuTimer.h"
+
+#include "VulkanContext.h"
+#include "Common/CommonHeaders.h"
+
+#include <algorithm>
+
+namespace carrot::rhi::vulkan {
+    namespace {
+        constexpr uint32_t k_queries_per_frame{ gpu_timer_t::k_max_scopes * 2 };
+    } // anonymous namespace
+
+    // PUBLIC
+    void gpu_timer_t::init(vulkan_context_t& ctx)
+    {
+        VkPhysicalDeviceProperties properties{ };
+        vkGetPhysicalDeviceProperties(ctx.physical_device(), &properties);
+
+        uint32_t family_count{ 0 };
+        vkGetPhysicalDeviceQueueFamilyProperties(ctx.physical_device(), &family_count, nullptr);
+        std::vector<VkQueueFamilyProperties> families(family_count);
+        vkGetPhysicalDeviceQueueFamilyProperties(ctx.physical_device(), &family_count, families.data());
+
+        const uint32_t valid_bits{ families[ctx.graphics_family()].timestampValidBits };
+        if (valid_bits == 0 || properties.limits.timestampPeriod <= 0.f)
+        {
+            LOG_GRAPHICS_WARN("[Vulkan] Graphics queue has no timestamps, GPU scopes are not timed");
+            return;
+        }
+
+        VkQueryPoolCreateInfo pool_info{ };
+        pool_info.sType = VK_STRUCTURE_TYPE_QUERY_POOL_CREATE_INFO;
+        pool_info.queryType = VK_QUERY_TYPE_TIMESTAMP;
+        pool_info.queryCount = k_queries_per_frame * k_max_frames_in_flight;
+        if (vkCreateQueryPool(ctx.device(), &pool_info, nullptr, &_pool) != VK_SUCCESS)
+        {
+            LOG_GRAPHICS_ERROR("[Vulkan] Failed to create the GPU timer query pool");
+            _pool = VK_NULL_HANDLE;
+            return;
+        }
+
+        _ctx = &ctx;
+        _ns_per_tick = properties.limits.timestampPeriod;
+        _valid_mask = valid_bits >= 64 ? ~0ull : (1ull << valid_bits) - 1;
+        _results.resize(k_queries_per_frame);
+        for (frame_t& frame: _frames)
+            frame.scopes.reserve(k_max_scopes);
+    }
+
+    void gpu_timer_t::shutdown()
+    {
+        if (_pool != VK_NULL_HANDLE) vkDestroyQueryPool(_ctx->device(), _pool, nullptr);
+        _pool = VK_NULL_HANDLE;
+        _ctx = nullptr;
+    }
+
+    void gpu_timer_t::collect(const uint32_t frame_index)
+    {
+        frame_t& frame{ _frames[frame_index] };
+        if (!is_enabled() || !frame.pending) return;
+        frame.pending = false;
+        if (frame.scopes.empty()) return;
+
+        // The slot has retired, every query it wrote is available without waiting
+        const uint32_t first{ frame_index * k_queries_per_frame };
+        const uint32_t count{ static_cast<uint32_t>(frame.scopes.size()) * 2 };
+        if (vkGetQueryPoolResults(_ctx->device(), _pool, first, count, count * sizeof(uint64_t), _results.data(),
+                                  sizeof(uint64_t), VK_QUERY_RESULT_64_BIT) != VK_SUCCESS)
+            return;
+
+        uint64_t origin{ ~0ull };
+        for (uint32_t i{ 0 }; i < count; ++i)
+            origin = std::min(origin, _results[i] & _valid_mask);
+
+        const auto to_ns = [&](const uint32_t query) {
+            return static_cast<uint64_t>(static_cast<double>((_results[query] & _valid_mask) - origin) * _ns_per_tick);
+        };
+
+        _collected.clear();
+        for (const scope_t& scope: frame.scopes)
+        {
+            const uint32_t query{ scope.query - first };
+            _collected.push_back({ scope.zone, to_ns(query), std::max(to_ns(query), to_ns(query + 1)) });
+        }
+        core::profiler::submit_gpu_frame(_collected);
+    }
+
+    void gpu_timer_t::begin_frame(VkCommandBuffer cmd, const uint32_t frame_index)
+    {
+        if (!is_enabled()) return;
+
+        _frame_index = frame_index;
+        _next_query = frame_index * k_queries_per_frame;
+        _open.clear();
+        _frames[frame_index].scopes.clear();
+        _frames[frame_index].pending = true;
+
+        vkCmdResetQueryPool(cmd, _pool, _next_query, k_queries_per_frame);
+    }
+
+    void gpu_timer_t::begin_scope(VkCommandBuffer cmd, const std::string_view name)
+    {
+        if (!is_enabled()) return;
+
+        frame_t& frame{ _frames[_frame_index] };
+        if (frame.scopes.size() == k_max_scopes)
+        {
+            _open.push_back(~0u); // keeps end_scope() balanced
+            return;
+        }
+
+        _open.push_back(static_cast<uint32_t>(frame.scopes.size()));
+        frame.scopes.push_back({ zone(name), _next_query });
+        vkCmdWriteTimestamp(cmd, VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT, _pool, _next_query);
+        _next_query += 2;
+    }
+
+    void gpu_timer_t::end_scope(VkCommandBuffer cmd)
+    {
+        if (!is_enabled() || _open.empty()) return;
+
+        const uint32_t scope{ _open.back() };
+        _open.pop_back();
+        if (scope == ~0u) return;
+
+        vkCmdWriteTimestamp(cmd, VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT, _pool,
+                            _frames[_frame_index].scopes[scope].query + 1);
+    }
+
+    // PRIVATE
+    uint32_t gpu_timer_t::zone(const std::string_view name)
+    {
+        auto it{ _zones.find(name) };
+        if (it == _zones.end())
+        {
+            it = _zones.emplace(graphics_string_t{ name }, core::profiler::k_invalid_zone).first;
+            it->second = core::profiler::register_zone(it->first.c_str());
+        }
+        return it->second;
+    }
+} // namespace carrot::rhi::vulkan
@@ -0,0 +1,71 @@
+//
+// Created by zshrout on 10/18/26.
+// Copyright (c) 2026 BunnySofty. All rights reserved.
+//
+
+#pragma once
+
+#include "VulkanCommon.h"
+#include "VulkanCore.h"
+#include "Core/Profiler.h"
+
+#include <array>
+#include <string_view>
+#include <vector>
+
+namespace carrot::rhi::vulkan {
+    class vulkan_context_t;
+
+    // Timestamp queries around GPU scopes, handed to the CPU profiler as gpu_scope_t. Each frame slot owns a
+    // range of one query pool; its results are read once that slot comes around again and its submission has
+    // retired, so timing never stalls the GPU. Disabled on queues without timestamp support.
+    class gpu_timer_t
+    {
+    public:
+        static constexpr uint32_t k_max_scopes{ 64 };  // per frame, further scopes are not timed
+
+        void init(vulkan_context_t& ctx);
+        void shutdown();
+
+        [[nodiscard]] bool is_enabled() const noexcept { return _pool != VK_NULL_HANDLE; }
+
+        // Call once the frame slot's previous submission has retired; hands its scopes to the profiler
+        void collect(uint32_t frame_index);
+        // Resets the slot's queries, outside any render pass
+        void begin_frame(VkCommandBuffer cmd, uint32_t frame_index);
+
+        // Scopes may nest; they are matched in LIFO order
+        void begin_scope(VkCommandBuffer cmd, std::string_view name);
+        void end_scope(VkCommandBuffer cmd);
+
+    private:
+        struct scope_t
+        {
+            uint32_t                zone{ core::profiler::k_invalid_zone };
+            uint32_t                query{ 0 };     // begin; end is the next one
+        };
+
+        struct frame_t
+        {
+            graphics_vector_t<scope_t>  scopes;
+            bool                        pending{ false };
+        };
+
+        [[nodiscard]] uint32_t zone(std::string_view name);
+
+        vulkan_context_t*           _ctx{ nullptr };
+        VkQueryPool                 _pool{ VK_NULL_HANDLE };
+        float                       _ns_per_tick{ 1.f };
+        uint64_t                    _valid_mask{ ~0ull };
+
+        std::array<frame_t, k_max_frames_in_flight> _frames;
+        uint32_t                    _frame_index{ 0 };
+        uint32_t                    _next_query{ 0 };
+        graphics_vector_t<uint32_t> _open;          // indices into this frame's scopes
+
+        // Profiler zones keep the name pointer, the strings live as long as the timer
+        graphics_string_map_t<uint32_t> _zones;
+        graphics_vector_t<uint64_t> _results;
+        graphics_vector_t<core::profiler::gpu_scope_t> _collected;
+    };
+} // namespace carrot::rhi::vulkan
@@ -0,0 +1,242 @@
+//
+// Created by zshrout on 10/18/26.
+// Copyright (c) 2026 BunnySofty. All rights reserved.
+//
+
+#include "VulkanLayoutCache.h"
+
+#include "VulkanBindless.h"
+#include "Common/CommonHeaders.h"
+
+#include <algorithm>
+#include <type_traits>
+
+namespace carrot::rhi::vulkan {
+    namespace {
+        template<typename T>
+        uint64_t handle_bits(const T handle) noexcept
+        {
+            if constexpr (std::is_pointer_v<T>) return reinterpret_cast<uintptr_t>(handle);
+            else return static_cast<uint64_t>(handle);
+        }
+
+        VkDescriptorType to_vk_descriptor_type(const renderer::descriptor_kind kind) noexcept
+        {
+            switch (kind)
+            {
+                case renderer::descriptor_kind::sampler: return VK_DESCRIPTOR_TYPE_SAMPLER;
+                case renderer::descriptor_kind::combined_image_sampler: return VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER;
+                case renderer::descriptor_kind::sampled_image: return VK_DESCRIPTOR_TYPE_SAMPLED_IMAGE;
+                case renderer::descriptor_kind::storage_image: return VK_DESCRIPTOR_TYPE_STORAGE_IMAGE;
+                case renderer::descriptor_kind::uniform_texel_buffer: return VK_DESCRIPTOR_TYPE_UNIFORM_TEXEL_BUFFER;
+                case renderer::descriptor_kind::storage_texel_buffer: return VK_DESCRIPTOR_TYPE_STORAGE_TEXEL_BUFFER;
+                case renderer::descriptor_kind::uniform_buffer: return VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER;
+                case renderer::descriptor_kind::storage_buffer: return VK_DESCRIPTOR_TYPE_STORAGE_BUFFER;
+            }
+            return VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER;
+        }
+
+        VkFormat to_vk_format(const renderer::vertex_format format) noexcept
+        {
+            switch (format)
+            {
+                case renderer::vertex_format::float1: return VK_FORMAT_R32_SFLOAT;
+                case renderer::vertex_format::float2: return VK_FORMAT_R32G32_SFLOAT;
+                case renderer::vertex_format::float3: return VK_FORMAT_R32G32B32_SFLOAT;
+                case renderer::vertex_format::float4: return VK_FORMAT_R32G32B32A32_SFLOAT;
+                case renderer::vertex_format::int1: return VK_FORMAT_R32_SINT;
+                case renderer::vertex_format::int2: return VK_FORMAT_R32G32_SINT;
+                case renderer::vertex_format::int3: return VK_FORMAT_R32G32B32_SINT;
+                case renderer::vertex_format::int4: return VK_FORMAT_R32G32B32A32_SINT;
+                case renderer::vertex_format::uint1: return VK_FORMAT_R32_UINT;
+                case renderer::vertex_format::uint2: return VK_FORMAT_R32G32_UINT;
+                case renderer::vertex_format::uint3: return VK_FORMAT_R32G32B32_UINT;
+                case renderer::vertex_format::uint4: return VK_FORMAT_R32G32B32A32_UINT;
+                default: return VK_FORMAT_UNDEFINED;
+            }
+        }
+    } // anonymous namespace
+
+    VkPipelineVertexInputStateCreateInfo vertex_input_layout_t::create_info() const noexcept
+    {
+        VkPipelineVertexInputStateCreateInfo info{ };
+        info.sType = VK_STRUCTURE_TYPE_PIPELINE_VERTEX_INPUT_STATE_CREATE_INFO;
+        if (attributes.empty()) return info;
+
+        info.vertexBindingDescriptionCount = 1;
+        info.pVertexBindingDescriptions = &binding;
+        info.vertexAttributeDescriptionCount = static_cast<uint32_t>(attributes.size());
+        info.pVertexAttributeDescriptions = attributes.data();
+        return info;
+    }
+
+    VkShaderStageFlags to_vk_stages(const renderer::shader_stage_flags_t stages) noexcept
+    {
+        VkShaderStageFlags flags{ 0 };
+        if (stages & renderer::k_stage_vertex) flags |= VK_SHADER_STAGE_VERTEX_BIT;
+        if (stages & renderer::k_stage_fragment) flags |= VK_SHADER_STAGE_FRAGMENT_BIT;
+        if (stages & renderer::k_stage_compute) flags |= VK_SHADER_STAGE_COMPUTE_BIT;
+        return flags;
+    }
+
+    vertex_input_layout_t build_vertex_input(const renderer::shader_reflection_t& reflection)
+    {
+        vertex_input_layout_t layout{ };
+        layout.binding = { 0, 0, VK_VERTEX_INPUT_RATE_VERTEX };
+
+        for (const auto& input: reflection.vertex_inputs)
+        {
+            layout.attributes.push_back({ input.location, 0, to_vk_format(input.format), layout.binding.stride });
+            layout.binding.stride += renderer::vertex_format_size(input.format);
+        }
+
+        return layout;
+    }
+
+    bool reflect_stages(const std::initializer_list<std::reference_wrapper<const spv_blob_t>> stages,
+                        renderer::shader_reflection_t& out)
+    {
+        renderer::shader_reflection_t merged{ };
+        for (const spv_blob_t& spv: stages)
+        {
+            renderer::shader_reflection_t stage{ };
+            if (renderer::deserialize_reflection(spv.reflection(), stage))
+            {
+                renderer::merge_reflection(merged, stage);
+                continue;
+            }
+
+            if (!renderer::reflect_spirv(spv.words(), stage))
+            {
+                LOG_GRAPHICS_ERROR("[Vulkan] Shader reflection failed, module is not valid SPIR-V");
+                return false;
+            }
+            renderer::merge_reflection(merged, stage);
+        }
+
+        out = std::move(merged);
+        return true;
+    }
+
+    // ── layout_cache_t ──────────────────────────────────────────
+    // PUBLIC
+    void layout_cache_t::init(VkDevice device) noexcept
+    {
+        _device = device;
+    }
+
+    void layout_cache_t::shutdown() noexcept
+    {
+        std::lock_guard<std::mutex> lock{ _mutex };
+
+        for (const auto& [key, layout]: _pipeline_layouts)
+            vkDestroyPipelineLayout(_device, layout, nullptr);
+        for (const auto& [key, layout]: _set_layouts)
+            vkDestroyDescriptorSetLayout(_device, layout, nullptr);
+
+        _pipeline_layouts.clear();
+        _set_layouts.clear();
+    }
+
+    VkDescriptorSetLayout layout_cache_t::set_layout(const std::span<const renderer::descriptor_binding_t> bindings)
+    {
+        std::lock_guard<std::mutex> lock{ _mutex };
+        return set_layout_locked(bindings);
+    }
+
+    reflected_layout_t layout_cache_t::pipeline_layout(const renderer::shader_reflection_t& reflection)
+    {
+        std::lock_guard<std::mutex> lock{ _mutex };
+
+        reflected_layout_t result{ };
+        for (const auto& binding: reflection.bindings)
+            result.set_count = std::max(result.set_count, binding.set + 1);
+
+        CE_ASSERT(result.set_count <= k_max_descriptor_sets, "Shader uses more descriptor sets than supported");
+        result.set_count = std::min(result.set_count, k_max_descriptor_sets);
+
+        // Gaps in the set numbering still need a (empty) layout
+        std::vector<uint64_t> key;
+        for (uint32_t set{ 0 }; set < result.set_count; ++set)
+        {
+            std::vector<renderer::descriptor_binding_t> set_bindings;
+            for (const auto& binding: reflection.bindings)
+                if (binding.set == set) set_bindings.push_back(binding);
+
+            result.set_layouts[set] = set_layout_locked(set_bindings);
+            key.push_back(handle_bits(result.set_layouts[set]));
+        }
+
+        const renderer::push_constant_range_t& push{ reflection.push_constants };
+        if (push.size != 0) result.push_range = { to_vk_stages(push.stages), push.offset, push.size };
+
+        key.push_back(static_cast<uint64_t>(result.push_range.offset) << 32 | result.push_range.size);
+        key.push_back(result.push_range.stageFlags);
+
+        if (const auto it{ _pipeline_layouts.find(key) }; it != _pipeline_layouts.end())
+        {
+            result.pipeline_layout = it->second;
+            return result;
+        }
+
+        VkPipelineLayoutCreateInfo layout_info{ };
+        layout_info.sType = VK_STRUCTURE_TYPE_PIPELINE_LAYOUT_CREATE_INFO;
+        layout_info.setLayoutCount = result.set_count;
+        layout_info.pSetLayouts = result.set_layouts.data();
+        layout_info.pushConstantRangeCount = push.size != 0 ? 1 : 0;
+        layout_info.pPushConstantRanges = &result.push_range;
+
+        vkCreatePipelineLayout(_device, &layout_info, nullptr, &result.pipeline_layout);
+        _pipeline_layouts.emplace(std::move(key), result.pipeline_layout);
+
+        return result;
+    }
+
+    // PRIVATE
+    VkDescriptorSetLayout layout_cache_t::set_layout_locked(const std::span<const renderer::descriptor_binding_t> bindings)
+    {
+        const bool bindless{ std::ranges::any_of(bindings, [](const auto& binding) { return binding.count == 0; }) };
+        if (bindless)
+        {
+            CE_ASSERT(_bindless_layout != VK_NULL_HANDLE, "Shader declares a bindless set but no heap was created");
+            for ([[maybe_unused]] const auto& binding: bindings)
+                CE_ASSERT(binding.set == k_bindless_set && binding.binding < k_bindless_types.size() &&
+                          to_vk_descriptor_type(binding.kind) == k_bindless_types[binding.binding],
+                          "Bindless set declaration does not match bindless_heap_t");
+            return _bindless_layout;
+        }
+
+        std::vector<uint64_t> key;
+        key.reserve(bindings.size() * 2);
+        for (const auto& binding: bindings)
+        {
+            key.push_back(static_cast<uint64_t>(binding.binding) << 32 | binding.count);
+            key.push_back(static_cast<uint64_t>(binding.kind) << 32 | binding.stages);
+        }
+
+        if (const auto it{ _set_layouts.find(key) }; it != _set_layouts.end()) return it->second;
+
+        std::vector<VkDescriptorSetLayoutBinding> vk_bindings;
+        vk_bindings.reserve(bindings.size());
+        for (const auto& binding: bindings)
+        {
+            VkDescriptorSetLayoutBinding vk_binding{ };
+            vk_binding.binding = binding.binding;
+            vk_binding.descriptorType = to_vk_descriptor_type(binding.kind);
+            vk_binding.descriptorCount = binding.count;
+            vk_binding.stageFlags = to_vk_stages(binding.stages);
+            vk_bindings.push_back(vk_binding);
+        }
+
+        VkDescriptorSetLayoutCreateInfo layout_info{ };
+        layout_info.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_LAYOUT_CREATE_INFO;
+        layout_info.bindingCount = static_cast<uint32_t>(vk_bindings.size());
+        layout_info.pBindings = vk_bindings.data();
+
+        VkDescriptorSetLayout layout{ VK_NULL_HANDLE };
+        vkCreateDescriptorSetLayout(_device, &layout_info, nullptr, &layout);
+        _set_layouts.emplace(std::move(key), layout);
+
+        return layout;
+    }
+} // namespace carrot::rhi::vulkan
@@ -0,0 +1,73 @@
+//
+// Created by zshrout on 10/18/26.
+// Copyright (c) 2026 BunnySofty. All rights reserved.
+//
+
+#pragma once
+
+#include "VulkanCommon.h"
+#include "Renderer/ShaderReflection.h"
+#include "Utils/ShaderUtils.h"
+
+#include <array>
+#include <functional>
+#include <initializer_list>
+#include <map>
+#include <mutex>
+#include <span>
+#include <vector>
+
+namespace carrot::rhi::vulkan {
+    constexpr uint32_t k_max_descriptor_sets{ 4 };
+
+    struct reflected_layout_t
+    {
+        VkPipelineLayout                                            pipeline_layout{ VK_NULL_HANDLE };
+        std::array<VkDescriptorSetLayout, k_max_descriptor_sets>    set_layouts{ };
+        uint32_t                                                    set_count{ 0 };
+        VkPushConstantRange                                         push_range{ };
+    };
+
+    // Single interleaved vertex buffer, attributes packed in location order
+    struct vertex_input_layout_t
+    {
+        VkVertexInputBindingDescription                 binding{ };
+        std::vector<VkVertexInputAttributeDescription>  attributes;
+
+        // Points into this object, keep it alive until the pipeline is created
+        [[nodiscard]] VkPipelineVertexInputStateCreateInfo create_info() const noexcept;
+    };
+
+    [[nodiscard]] VkShaderStageFlags to_vk_stages(renderer::shader_stage_flags_t stages) noexcept;
+    [[nodiscard]] vertex_input_layout_t build_vertex_input(const renderer::shader_reflection_t& reflection);
+
+    // Reflects and merges all stages of one pipeline; logs and returns false if any blob is not SPIR-V.
+    // Archived modules use their build-time reflection instead of parsing the SPIR-V again.
+    [[nodiscard]] bool reflect_stages(std::initializer_list<std::reference_wrapper<const spv_blob_t>> stages,
+                                      renderer::shader_reflection_t& out);
+
+    // Owns every descriptor set layout and pipeline layout built from reflection. Identical layouts are only
+    // created once, so pipelines with matching interfaces share them and stay compatible across hot-reloads.
+    // A set that declares a runtime-sized array is the bindless heap's set and resolves to its layout.
+    class layout_cache_t
+    {
+    public:
+        void init(VkDevice device) noexcept;
+        void shutdown() noexcept;
+
+        // Not owned; must outlive every pipeline layout built from it
+        void set_bindless_layout(VkDescriptorSetLayout layout) noexcept { _bindless_layout = layout; }
+
+        [[nodiscard]] VkDescriptorSetLayout set_layout(std::span<const renderer::descriptor_binding_t> bindings);
+        [[nodiscard]] reflected_layout_t pipeline_layout(const renderer::shader_reflection_t& reflection);
+
+    private:
+        [[nodiscard]] VkDescriptorSetLayout set_layout_locked(std::span<const renderer::descriptor_binding_t> bindings);
+
+        VkDevice                                                    _device{ VK_NULL_HANDLE };
+        VkDescriptorSetLayout                                       _bindless_layout{ VK_NULL_HANDLE };
+        std::map<std::vector<uint64_t>, VkDescriptorSetLayout>      _set_layouts;
+        std::map<std::vector<uint64_t>, VkPipelineLayout>           _pipeline_layouts;
+        std::mutex                                                  _mutex; // variants build on worker threads
+    };
+} // namespace carrot::rhi::vulkan
@@ -0,0 +1,722 @@
+//
+// Created by zshrout on 10/18/26.
+// Copyright (c) 2026 BunnySofty. All rights reserved.
+//
+
+#include "VulkanRenderGraph.h"
+
+#include "Utils/Assert.h"
+#include "Utils/ShaderArchiveFormat.h"
+
+#include <algorithm>
+#include <span>
+#include <type_traits>
+#include <utility>
+
+namespace carrot::rhi::vulkan {
+    namespace {
+        struct access_info_t
+        {
+            VkPipelineStageFlags    stages;
+            VkAccessFlags           access;
+            VkImageLayout           layout;     // UNDEFINED for buffer-only accesses
+            VkImageUsageFlags       usage;
+            bool                    write;
+        };
+
+        constexpr VkPipelineStageFlags k_graphics_shaders{
+            VK_PIPELINE_STAGE_VERTEX_SHADER_BIT | VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT
+        };
+        constexpr VkPipelineStageFlags k_depth_tests{
+            VK_PIPELINE_STAGE_EARLY_FRAGMENT_TESTS_BIT | VK_PIPELINE_STAGE_LATE_FRAGMENT_TESTS_BIT
+        };
+        // Source scope of barriers that only transition, nothing earlier has to finish
+        constexpr VkPipelineStageFlags k_no_stages{ VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT };
+        constexpr VkAccessFlags k_write_access{
+            VK_ACCESS_COLOR_ATTACHMENT_WRITE_BIT | VK_ACCESS_DEPTH_STENCIL_ATTACHMENT_WRITE_BIT |
+            VK_ACCESS_SHADER_WRITE_BIT | VK_ACCESS_TRANSFER_WRITE_BIT
+        };
+
+        // Indexed by rg_access
+        constexpr access_info_t k_access_info[]{
+            {
+                VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT,
+                VK_ACCESS_COLOR_ATTACHMENT_READ_BIT | VK_ACCESS_COLOR_ATTACHMENT_WRITE_BIT,
+                VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL, VK_IMAGE_USAGE_COLOR_ATTACHMENT_BIT, true
+            },
+            {
+                k_depth_tests,
+                VK_ACCESS_DEPTH_STENCIL_ATTACHMENT_READ_BIT | VK_ACCESS_DEPTH_STENCIL_ATTACHMENT_WRITE_BIT,
+                VK_IMAGE_LAYOUT_DEPTH_STENCIL_ATTACHMENT_OPTIMAL, VK_IMAGE_USAGE_DEPTH_STENCIL_ATTACHMENT_BIT, true
+            },
+            {
+                k_depth_tests, VK_ACCESS_DEPTH_STENCIL_ATTACHMENT_READ_BIT,
+                VK_IMAGE_LAYOUT_DEPTH_STENCIL_READ_ONLY_OPTIMAL, VK_IMAGE_USAGE_DEPTH_STENCIL_ATTACHMENT_BIT, false
+            },
+            {
+                k_graphics_shaders, VK_ACCESS_SHADER_READ_BIT,
+                VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL, VK_IMAGE_USAGE_SAMPLED_BIT, false
+            },
+            {
+                VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, VK_ACCESS_SHADER_READ_BIT,
+                VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL, VK_IMAGE_USAGE_SAMPLED_BIT, false
+            },
+            {
+                k_graphics_shaders, VK_ACCESS_SHADER_READ_BIT,
+                VK_IMAGE_LAYOUT_GENERAL, VK_IMAGE_USAGE_STORAGE_BIT, false
+            },
+            {
+                VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, VK_ACCESS_SHADER_READ_BIT,
+                VK_IMAGE_LAYOUT_GENERAL, VK_IMAGE_USAGE_STORAGE_BIT, false
+            },
+            {
+                VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, VK_ACCESS_SHADER_READ_BIT | VK_ACCESS_SHADER_WRITE_BIT,
+                VK_IMAGE_LAYOUT_GENERAL, VK_IMAGE_USAGE_STORAGE_BIT, true
+            },
+            {
+                VK_PIPELINE_STAGE_TRANSFER_BIT, VK_ACCESS_TRANSFER_READ_BIT,
+                VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL, VK_IMAGE_USAGE_TRANSFER_SRC_BIT, false
+            },
+            {
+                VK_PIPELINE_STAGE_TRANSFER_BIT, VK_ACCESS_TRANSFER_WRITE_BIT,
+                VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, VK_IMAGE_USAGE_TRANSFER_DST_BIT, true
+            },
+            {
+                VK_PIPELINE_STAGE_VERTEX_INPUT_BIT, VK_ACCESS_VERTEX_ATTRIBUTE_READ_BIT | VK_ACCESS_INDEX_READ_BIT,
+                VK_IMAGE_LAYOUT_UNDEFINED, 0, false
+            },
+            {
+                VK_PIPELINE_STAGE_DRAW_INDIRECT_BIT, VK_ACCESS_INDIRECT_COMMAND_READ_BIT,
+                VK_IMAGE_LAYOUT_UNDEFINED, 0, false
+            },
+            {
+                k_graphics_shaders, VK_ACCESS_UNIFORM_READ_BIT,
+                VK_IMAGE_LAYOUT_UNDEFINED, 0, false
+            },
+        };
+        static_assert(std::size(k_access_info) == static_cast<size_t>(rg_access::count));
+
+        [[nodiscard]] constexpr const access_info_t& info(const rg_access access) noexcept
+        {
+            return k_access_info[static_cast<size_t>(access)];
+        }
+
+        template<typename T>
+        [[nodiscard]] uint64_t hash_value(const uint64_t hash, const T value) noexcept
+        {
+            static_assert(std::is_trivially_copyable_v<T> && std::has_unique_object_representations_v<T>);
+            return utils::fnv1a_64(std::string_view{ reinterpret_cast<const char*>(&value), sizeof(T) }, hash);
+        }
+
+        [[nodiscard]] uint64_t hash_state(uint64_t hash, const rg_state_t& state) noexcept
+        {
+            hash = hash_value(hash, state.layout);
+            hash = hash_value(hash, state.stages);
+            return hash_value(hash, state.access);
+        }
+
+        [[nodiscard]] VkDeviceSize align_up(const VkDeviceSize value, const VkDeviceSize alignment) noexcept
+        {
+            return (value + alignment - 1) / alignment * alignment;
+        }
+    } // anonymous namespace
+
+    // ── pass_builder_t ──────────────────────────────────────────
+    render_graph_t::pass_builder_t& render_graph_t::pass_builder_t::use(const rg_resource_t resource,
+                                                                        const rg_access access)
+    {
+        CE_ASSERT(resource.index < _graph._resources.size(), "Render graph resource from another declaration");
+        CE_ASSERT(_pass + 1 == _graph._passes.size(), "Declare a pass's uses before adding the next pass");
+        CE_ASSERT(info(access).layout != VK_IMAGE_LAYOUT_UNDEFINED ||
+                  _graph._resources[resource.index].kind == resource_kind::imported_buffer,
+                  "Buffer-only access used on a texture");
+
+        _graph._uses.push_back({ resource.index, access });
+        ++_graph._passes[_pass].use_count;
+        return *this;
+    }
+
+    render_graph_t::pass_builder_t& render_graph_t::pass_builder_t::side_effect() noexcept
+    {
+        _graph._passes[_pass].side_effect = true;
+        return *this;
+    }
+
+    // ── render_graph_t ──────────────────────────────────────────
+    // PUBLIC
+    void render_graph_t::init(VkDevice device, gpu_allocator_t& allocator, timeline_semaphore_t& frame_timeline)
+    {
+        _device = device;
+        _allocator = &allocator;
+        _frame_timeline = &frame_timeline;
+    }
+
+    void render_graph_t::shutdown()
+    {
+        // The device is idle by now, nothing retired can still be in use
+        retire_transients();
+        collect_retired(true);
+
+        reset();
+        _steps.clear();
+        _barriers.clear();
+        _scratch.shutdown();
+        _compiled = false;
+        _device = VK_NULL_HANDLE;
+    }
+
+    void render_graph_t::reset()
+    {
+        _resources.clear();
+        _passes.clear();
+        _uses.clear();
+
+        if (!_retired.empty()) collect_retired(false);
+    }
+
+    rg_resource_t render_graph_t::create_texture(const std::string_view name, const rg_texture_desc_t& desc)
+    {
+        resource_t& resource{ _resources.emplace_back() };
+        resource.name = name;
+        resource.kind = resource_kind::transient_texture;
+        resource.desc = desc;
+        return { static_cast<uint32_t>(_resources.size() - 1) };
+    }
+
+    rg_resource_t render_graph_t::import_texture(const std::string_view name, const rg_imported_texture_t& texture)
+    {
+        resource_t& resource{ _resources.emplace_back() };
+        resource.name = name;
+        resource.kind = resource_kind::imported_texture;
+        resource.desc.format = texture.format;
+        resource.desc.extent = texture.extent;
+        resource.desc.aspect = texture.aspect;
+        resource.initial = texture.initial;
+        resource.final = texture.final;
+        resource.image = texture.image;
+        resource.view = texture.view;
+        return { static_cast<uint32_t>(_resources.size() - 1) };
+    }
+
+    rg_resource_t render_graph_t::import_buffer(const std::string_view name, const rg_imported_buffer_t& buffer)
+    {
+        resource_t& resource{ _resources.emplace_back() };
+        resource.name = name;
+        resource.kind = resource_kind::imported_buffer;
+        resource.initial = buffer.initial;
+        resource.buffer = buffer.buffer;
+        resource.offset = buffer.offset;
+        resource.size = buffer.size;
+        return { static_cast<uint32_t>(_resources.size() - 1) };
+    }
+
+    render_graph_t::pass_builder_t render_graph_t::add_pass(const std::string_view name, const record_delegate_t& record)
+    {
+        pass_t& pass{ _passes.emplace_back() };
+        pass.name = name;
+        pass.record = record;
+        pass.first_use = static_cast<uint32_t>(_uses.size());
+        return { *this, static_cast<uint32_t>(_passes.size() - 1) };
+    }
+
+    void render_graph_t::compile()
+    {
+        const uint64_t hash{ topology_hash() };
+        if (_compiled && hash == _compiled_hash) return;
+
+        // Rebuilds happen only on topology changes, so the stack is sized for this graph rather than for reuse
+        if (const size_t capacity{ scratch_capacity() }; _scratch.capacity() < capacity)
+        {
+            _scratch.shutdown();
+            CE_ENSURE(_scratch.init(capacity), "Out of memory for the render graph's compile scratch");
+        }
+
+        scratch_vector_t<bool> live{ scratch_vector<bool>(_passes.size()) };
+        cull_passes(live);
+        if (!build_transients(live))
+        {
+            // Passes touching a transient left without memory are dropped for as long as this plan stands
+            for (uint32_t p{ 0 }; p < _passes.size(); ++p)
+            {
+                const pass_t& pass{ _passes[p] };
+                for (uint32_t u{ pass.first_use }; u < pass.first_use + pass.use_count && live[p]; ++u)
+                {
+                    const uint32_t resource{ _uses[u].resource };
+                    if (_resources[resource].kind == resource_kind::transient_texture &&
+                        _transients[resource].image == VK_NULL_HANDLE)
+                        live[p] = false;
+                }
+            }
+        }
+        build_barriers(live);
+
+        _compiled_hash = hash;
+        _compiled = true;
+        ++_stats.rebuilds;
+
+        LOG_GRAPHICS_DEBUG("[RenderGraph] Rebuilt: {} pass(es), {} culled, {} barrier(s), {} transient(s) "
+                           "({} KiB aliased into {} KiB)", _stats.pass_count, _stats.culled_count,
+                           _stats.barrier_count, _stats.transient_count, _stats.transient_bytes / 1024,
+                           _stats.aliased_bytes / 1024);
+    }
+
+    void render_graph_t::execute(VkCommandBuffer cmd, gpu_timer_t* timer)
+    {
+        CE_ASSERT(_compiled, "Render graph executed before it was compiled");
+
+        for (const step_t& step: _steps)
+        {
+            if (step.barrier_count > 0)
+            {
+                _image_scratch.clear();
+                _buffer_scratch.clear();
+
+                for (uint32_t i{ step.first_barrier }; i < step.first_barrier + step.barrier_count; ++i)
+                {
+                    const barrier_t& barrier{ _barriers[i] };
+                    const resource_t& resource{ _resources[barrier.resource] };
+
+                    if (resource.kind == resource_kind::imported_buffer)
+                    {
+                        VkBufferMemoryBarrier& out{ _buffer_scratch.emplace_back() };
+                        out.sType = VK_STRUCTURE_TYPE_BUFFER_MEMORY_BARRIER;
+                        out.srcAccessMask = barrier.src_access;
+                        out.dstAccessMask = barrier.dst_access;
+                        out.srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+                        out.dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+                        out.buffer = resource.buffer;
+                        out.offset = resource.offset;
+                        out.size = resource.size;
+                        continue;
+                    }
+
+                    VkImageMemoryBarrier& out{ _image_scratch.emplace_back() };
+                    out.sType = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER;
+                    out.srcAccessMask = barrier.src_access;
+                    out.dstAccessMask = barrier.dst_access;
+                    out.oldLayout = barrier.old_layout;
+                    out.newLayout = barrier.new_layout;
+                    out.srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+                    out.dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+                    out.image = image({ barrier.resource });
+                    out.subresourceRange = {
+                        resource.desc.aspect, 0, VK_REMAINING_MIP_LEVELS, 0, VK_REMAINING_ARRAY_LAYERS
+                    };
+                }
+
+                vkCmdPipelineBarrier(cmd, step.src_stages, step.dst_stages, 0, 0, nullptr,
+                                     static_cast<uint32_t>(_buffer_scratch.size()), _buffer_scratch.data(),
+                                     static_cast<uint32_t>(_image_scratch.size()), _image_scratch.data());
+            }
+
+            if (step.pass == ~0u) continue;
+
+            if (timer != nullptr) timer->begin_scope(cmd, _passes[step.pass].name);
+            _passes[step.pass].record.invoke(cmd);
+            if (timer != nullptr) timer->end_scope(cmd);
+        }
+    }
+
+    VkImage render_graph_t::image(const rg_resource_t resource) const noexcept
+    {
+        if (_resources[resource.index].kind != resource_kind::transient_texture) return _resources[resource.index].image;
+        return resource.index < _transients.size() ? _transients[resource.index].image : VK_NULL_HANDLE;
+    }
+
+    VkImageView render_graph_t::view(const rg_resource_t resource) const noexcept
+    {
+        if (_resources[resource.index].kind != resource_kind::transient_texture) return _resources[resource.index].view;
+        return resource.index < _transients.size() ? _transients[resource.index].view : VK_NULL_HANDLE;
+    }
+
+    VkBuffer render_graph_t::buffer(const rg_resource_t resource) const noexcept
+    {
+        return _resources[resource.index].buffer;
+    }
+
+    // PRIVATE
+    uint64_t render_graph_t::topology_hash() const noexcept
+    {
+        // Handles of imported resources are deliberately left out, they change every frame (swapchain images)
+        uint64_t hash{ utils::fnv1a_64("render_graph") };
+
+        for (const resource_t& resource: _resources)
+        {
+            hash = hash_value(hash, resource.kind);
+            hash = hash_value(hash, resource.desc.format);
+            hash = hash_value(hash, resource.desc.extent.width);
+            hash = hash_value(hash, resource.desc.extent.height);
+            hash = hash_value(hash, resource.desc.aspect);
+            hash = hash_value(hash, resource.desc.mip_levels);
+            hash = hash_value(hash, resource.desc.layers);
+            hash = hash_state(hash, resource.initial);
+            hash = hash_state(hash, resource.final);
+        }
+
+        for (const pass_t& pass: _passes)
+        {
+            hash = utils::fnv1a_64(pass.name, hash);
+            hash = hash_value(hash, pass.use_count);
+            hash = hash_value(hash, pass.side_effect);
+        }
+
+        for (const use_t& use: _uses)
+        {
+            hash = hash_value(hash, use.resource);
+            hash = hash_value(hash, use.access);
+        }
+
+        return hash;
+    }
+
+    size_t render_graph_t::scratch_capacity() const noexcept
+    {
+        // Every scratch vector of compile() alive at once, each behind a stack header and alignment padding
+        constexpr size_t k_allocation_count{ 7 };
+        constexpr size_t k_overhead{ sizeof(size_t) + alignof(std::max_align_t) };
+        constexpr size_t k_per_resource{
+            sizeof(lifetime_t) + sizeof(const lifetime_t*) + sizeof(std::pair<VkDeviceSize, VkDeviceSize>) +
+            2 * sizeof(track_t)
+        };
+
+        const size_t flags{ (_passes.size() + _resources.size()) / 8 + 2 * sizeof(uint64_t) };
+        return flags + _resources.size() * k_per_resource + k_allocation_count * k_overhead;
+    }
+
+    void render_graph_t::cull_passes(scratch_vector_t<bool>& live)
+    {
+        // Walk backwards from what leaves the graph: imported resources are observed outside of it, so their
+        // writers stay; a transient only matters if a live pass reads it. Writes do not clear the flag, an
+        // attachment write may load what an earlier pass left behind.
+        scratch_vector_t<bool> needed{ scratch_vector<bool>(_resources.size()) };
+        for (size_t i{ 0 }; i < _resources.size(); ++i)
+            needed[i] = _resources[i].kind != resource_kind::transient_texture;
+
+        for (size_t p{ _passes.size() }; p-- > 0;)
+        {
+            const pass_t& pass{ _passes[p] };
+            const std::span<const use_t> uses{ _uses.data() + pass.first_use, pass.use_count };
+
+            bool keep{ pass.side_effect };
+            for (const use_t& use: uses)
+                keep = keep || (info(use.access).write && needed[use.resource]);
+            if (!keep) continue;
+
+            live[p] = true;
+            for (const use_t& use: uses)
+                if (!info(use.access).write) needed[use.resource] = true;
+        }
+    }
+
+    bool render_graph_t::build_transients(const scratch_vector_t<bool>& live)
+    {
+        // The previous images may still be read by frames in flight
+        retire_transients();
+        _transients.assign(_resources.size(), { });
+
+        scratch_vector_t<lifetime_t> lifetimes{ scratch_vector<lifetime_t>(_resources.size()) };
+        for (uint32_t p{ 0 }; p < _passes.size(); ++p)
+        {
+            if (!live[p]) continue;
+
+            for (uint32_t u{ _passes[p].first_use }; u < _passes[p].first_use + _passes[p].use_count; ++u)
+            {
+                lifetime_t& lifetime{ lifetimes[_uses[u].resource] };
+                lifetime.resource = _uses[u].resource;
+                lifetime.first = std::min(lifetime.first, p);
+                lifetime.last = std::max(lifetime.last, p);
+                lifetime.usage |= info(_uses[u].access).usage;
+            }
+        }
+
+        std::erase_if(lifetimes, [this](const lifetime_t& lifetime) {
+            return lifetime.first == ~0u || _resources[lifetime.resource].kind != resource_kind::transient_texture;
+        });
+
+        _stats.transient_count = static_cast<uint32_t>(lifetimes.size());
+        _stats.transient_bytes = 0;
+        _stats.aliased_bytes = 0;
+
+        for (lifetime_t& lifetime: lifetimes)
+        {
+            const rg_texture_desc_t& desc{ _resources[lifetime.resource].desc };
+
+            VkImageCreateInfo image_info{ };
+            image_info.sType = VK_STRUCTURE_TYPE_IMAGE_CREATE_INFO;
+            image_info.imageType = VK_IMAGE_TYPE_2D;
+            image_info.format = desc.format;
+            image_info.extent = { desc.extent.width, desc.extent.height, 1 };
+            image_info.mipLevels = desc.mip_levels;
+            image_info.arrayLayers = desc.layers;
+            image_info.samples = VK_SAMPLE_COUNT_1_BIT;
+            image_info.tiling = VK_IMAGE_TILING_OPTIMAL;
+            image_info.usage = lifetime.usage;
+            image_info.sharingMode = VK_SHARING_MODE_EXCLUSIVE;
+            image_info.initialLayout = VK_IMAGE_LAYOUT_UNDEFINED;
+
+            transient_t& transient{ _transients[lifetime.resource] };
+            vkCreateImage(_device, &image_info, nullptr, &transient.image);
+            vkGetImageMemoryRequirements(_device, transient.image, &lifetime.requirements);
+
+            transient.size = lifetime.requirements.size;
+            _stats.transient_bytes += lifetime.requirements.size;
+        }
+
+        // Largest first, each image goes to the lowest offset not overlapping any placed image that is alive at
+        // the same time. Images no other memory type fits get their own allocation.
+        std::ranges::sort(lifetimes, [](const lifetime_t& a, const lifetime_t& b) {
+            return a.requirements.size > b.requirements.size;
+        });
+
+        uint32_t heap_types{ ~0u };
+        VkDeviceSize heap_size{ 0 };
+        VkDeviceSize heap_alignment{ 1 };
+        scratch_vector_t<const lifetime_t*> placed{ scratch_vector<const lifetime_t*>(0) };
+        placed.reserve(lifetimes.size());
+        // [begin, end) of the placed images alive at the same time as the current one
+        scratch_vector_t<std::pair<VkDeviceSize, VkDeviceSize>> taken{
+            scratch_vector<std::pair<VkDeviceSize, VkDeviceSize>>(0)
+        };
+        taken.reserve(lifetimes.size());
+
+        for (const lifetime_t& lifetime: lifetimes)
+        {
+            transient_t& transient{ _transients[lifetime.resource] };
+            if ((heap_types & lifetime.requirements.memoryTypeBits) == 0) continue;
+
+            taken.clear();
+            for (const lifetime_t* other: placed)
+            {
+                if (other->first > lifetime.last || other->last < lifetime.first) continue;
+                const transient_t& other_transient{ _transients[other->resource] };
+                taken.emplace_back(other_transient.heap_offset, other_transient.heap_offset + other_transient.size);
+            }
+            std::ranges::sort(taken);
+
+            VkDeviceSize offset{ 0 };
+            for (const auto& [begin, end]: taken)
+            {
+                if (align_up(offset, lifetime.requirements.alignment) + lifetime.requirements.size <= begin) break;
+                offset = std::max(offset, end);
+            }
+
+            transient.heap_offset = align_up(offset, lifetime.requirements.alignment);
+            transient.in_heap = true;
+            heap_types &= lifetime.requirements.memoryTypeBits;
+            heap_size = std::max(heap_size, transient.heap_offset + transient.size);
+            heap_alignment = std::max(heap_alignment, lifetime.requirements.alignment);
+            placed.push_back(&lifetime);
+        }
+
+        if (heap_size > 0)
+        {
+            const VkMemoryRequirements heap_requirements{ heap_size, heap_alignment, heap_types };
+            _heap = _allocator->allocate(heap_requirements, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT, resource_tiling::optimal);
+            _stats.aliased_bytes += heap_size;
+        }
+
+        bool complete{ true };
+        for (const lifetime_t& lifetime: lifetimes)
+        {
+            const rg_texture_desc_t& desc{ _resources[lifetime.resource].desc };
+            transient_t& transient{ _transients[lifetime.resource] };
+
+            if (transient.in_heap && _heap.is_valid())
+            {
+                vkBindImageMemory(_device, transient.image, _heap.memory, _heap.offset + transient.heap_offset);
+            }
+            else
+            {
+                transient.in_heap = false;
+                transient.allocation = _allocator->allocate(lifetime.requirements, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT,
+                                                            resource_tiling::optimal);
+                if (!transient.allocation.is_valid())
+                {
+                    LOG_GRAPHICS_ERROR("[RenderGraph] Out of device memory for transient '{}', its passes are culled",
+                                       _resources[lifetime.resource].name);
+                    vkDestroyImage(_device, transient.image, nullptr);
+                    transient.image = VK_NULL_HANDLE;
+                    complete = false;
+                    continue;
+                }
+                vkBindImageMemory(_device, transient.image, transient.allocation.memory, transient.allocation.offset);
+                _stats.aliased_bytes += transient.allocation.size;
+            }
+
+            VkImageViewCreateInfo view_info{ };
+            view_info.sType = VK_STRUCTURE_TYPE_IMAGE_VIEW_CREATE_INFO;
+            view_info.image = transient.image;
+            view_info.viewType = desc.layers > 1 ? VK_IMAGE_VIEW_TYPE_2D_ARRAY : VK_IMAGE_VIEW_TYPE_2D;
+            view_info.format = desc.format;
+            view_info.subresourceRange = { desc.aspect, 0, desc.mip_levels, 0, desc.layers };
+            vkCreateImageView(_device, &view_info, nullptr, &transient.view);
+        }
+        return complete;
+    }
+
+    void render_graph_t::build_barriers(const scratch_vector_t<bool>& live)
+    {
+        scratch_vector_t<track_t> tracks{ scratch_vector<track_t>(_resources.size()) };
+        for (size_t r{ 0 }; r < _resources.size(); ++r)
+        {
+            const resource_t& resource{ _resources[r] };
+            if (resource.kind == resource_kind::transient_texture) continue;
+
+            // A state without access is only an execution dependency, like a read
+            tracks[r].layout = resource.initial.layout;
+            tracks[r].write_stages = resource.initial.access != 0 ? resource.initial.stages : 0;
+            tracks[r].write_access = resource.initial.access;
+            tracks[r].read_stages = resource.initial.access != 0 ? 0 : resource.initial.stages;
+        }
+
+        // Dry run to learn how each transient is left at the end of the frame. Its first use next frame, or the
+        // first use of another image aliasing its memory, has to wait for that.
+        scratch_vector_t<track_t> dry_run{ tracks };
+        plan(live, dry_run);
+
+        for (size_t r{ 0 }; r < _resources.size(); ++r)
+        {
+            if (r >= _transients.size() || _transients[r].image == VK_NULL_HANDLE) continue;
+
+            const transient_t& transient{ _transients[r] };
+            for (size_t other{ 0 }; other < _transients.size(); ++other)
+            {
+                const transient_t& other_transient{ _transients[other] };
+                if (other_transient.image == VK_NULL_HANDLE) continue;
+
+                const bool aliases{
+                    other == r || (transient.in_heap && other_transient.in_heap &&
+                                   transient.heap_offset < other_transient.heap_offset + other_transient.size &&
+                                   other_transient.heap_offset < transient.heap_offset + transient.size)
+                };
+                if (!aliases) continue;
+
+                tracks[r].read_stages |= dry_run[other].write_stages | dry_run[other].read_stages;
+                tracks[r].write_access |= dry_run[other].write_access;
+            }
+        }
+
+        plan(live, tracks);
+
+        _stats.pass_count = static_cast<uint32_t>(std::ranges::count(live, true));
+        _stats.culled_count = static_cast<uint32_t>(_passes.size()) - _stats.pass_count;
+        _stats.barrier_count = static_cast<uint32_t>(_barriers.size());
+    }
+
+    void render_graph_t::plan(const scratch_vector_t<bool>& live, scratch_vector_t<track_t>& tracks)
+    {
+        _steps.clear();
+        _barriers.clear();
+
+        const auto add_barrier = [this](step_t& step, const uint32_t resource, const VkAccessFlags src_access,
+                                        const VkAccessFlags dst_access, const VkImageLayout old_layout,
+                                        const VkImageLayout new_layout) {
+            // Several uses of one resource in a pass fold into one barrier
+            for (uint32_t i{ step.first_barrier }; i < step.first_barrier + step.barrier_count; ++i)
+            {
+                if (_barriers[i].resource != resource) continue;
+                CE_ASSERT(_barriers[i].new_layout == new_layout, "Pass uses one image in two layouts");
+                _barriers[i].src_access |= src_access;
+                _barriers[i].dst_access |= dst_access;
+                return;
+            }
+
+            _barriers.push_back({ resource, src_access, dst_access, old_layout, new_layout });
+            ++step.barrier_count;
+        };
+
+        for (uint32_t p{ 0 }; p < _passes.size(); ++p)
+        {
+            if (!live[p]) continue;
+
+            step_t& step{ _steps.emplace_back() };
+            step.pass = p;
+            step.first_barrier = static_cast<uint32_t>(_barriers.size());
+
+            for (uint32_t u{ _passes[p].first_use }; u < _passes[p].first_use + _passes[p].use_count; ++u)
+            {
+                const use_t& use{ _uses[u] };
+                const access_info_t& access{ info(use.access) };
+                track_t& track{ tracks[use.resource] };
+
+                const bool is_image{ _resources[use.resource].kind != resource_kind::imported_buffer };
+                const bool layout_change{ is_image && track.layout != access.layout };
+
+                if (access.write || layout_change)
+                {
+                    // Writes and transitions wait for every earlier access (WAW, WAR)
+                    const VkPipelineStageFlags src{ track.write_stages | track.read_stages };
+                    if (layout_change || src != 0)
+                    {
+                        add_barrier(step, use.resource, track.write_access, access.access,
+                                    is_image ? track.layout : VK_IMAGE_LAYOUT_UNDEFINED,
+                                    is_image ? access.layout : VK_IMAGE_LAYOUT_UNDEFINED);
+                        step.src_stages |= src != 0 ? src : k_no_stages;
+                        step.dst_stages |= access.stages;
+                    }
+
+                    // The transition itself counts as a write later readers in other stages must wait for
+                    track.layout = is_image ? access.layout : track.layout;
+                    track.write_stages = access.stages;
+                    track.write_access = access.write ? access.access & k_write_access : 0;
+                    track.read_stages = access.write ? 0 : access.stages;
+                    track.synced_stages = access.stages;
+                    continue;
+                }
+
+                // Reads only wait for the last write, and only once per stage (RAW)
+                if (track.write_stages != 0 && (access.stages & ~track.synced_stages) != 0)
+                {
+                    add_barrier(step, use.resource, track.write_access, access.access, track.layout, track.layout);
+                    step.src_stages |= track.write_stages;
+                    step.dst_stages |= access.stages;
+                    track.synced_stages |= access.stages;
+                }
+                track.read_stages |= access.stages;
+            }
+        }
+
+        // Hand imported images back in the state their owner expects
+        step_t& final_step{ _steps.emplace_back() };
+        final_step.first_barrier = static_cast<uint32_t>(_barriers.size());
+
+        for (uint32_t r{ 0 }; r < _resources.size(); ++r)
+        {
+            const resource_t& resource{ _resources[r] };
+            if (resource.kind != resource_kind::imported_texture || resource.final.layout == VK_IMAGE_LAYOUT_UNDEFINED)
+                continue;
+
+            const track_t& track{ tracks[r] };
+            if (track.layout == resource.final.layout && track.write_access == 0) continue;
+
+            const VkPipelineStageFlags src{ track.write_stages | track.read_stages };
+            add_barrier(final_step, r, track.write_access, resource.final.access, track.layout, resource.final.layout);
+            final_step.src_stages |= src != 0 ? src : k_no_stages;
+            final_step.dst_stages |= resource.final.stages;
+        }
+    }
+
+    void render_graph_t::retire_transients()
+    {
+        if (_transients.empty() && !_heap.is_valid()) return;
+
+        _retired.push_back({ _frame_timeline->pending, std::move(_transients), _heap });
+        _transients.clear();
+        _heap = { };
+    }
+
+    void render_graph_t::collect_retired(const bool force)
+    {
+        std::erase_if(_retired, [this, force](retired_t& retired) {
+            if (!force && !_frame_timeline->has_reached(retired.frame_value)) return false;
+
+            for (transient_t& transient: retired.transients)
+            {
+                if (transient.view != VK_NULL_HANDLE) vkDestroyImageView(_device, transient.view, nullptr);
+                _allocator->destroy_image(transient.image, transient.allocation);
+            }
+            _allocator->free(retired.heap);
+            return true;
+        });
+    }
+} // namespace carrot::rhi::vulkan
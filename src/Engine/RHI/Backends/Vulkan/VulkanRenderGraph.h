@@ -0,0 +1,284 @@
+//
+// Created by zshrout on 10/18/26.
+// Copyright (c) 2026 BunnySofty. All rights reserved.
+//
+
+#pragma once
+
+#include "VulkanAllocator.h"
+#include "VulkanCommandRecorder.h"
+#include "VulkanCommon.h"
+#include "VulkanCore.h"
+#include "VulkanGpuTimer.h"
+#include "Memory/StackAllocator.h"
+
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace carrot::rhi::vulkan {
+    struct rg_resource_t
+    {
+        uint32_t index{ ~0u };
+
+        [[nodiscard]] bool is_valid() const noexcept { return index != ~0u; }
+    };
+
+    // How a pass uses a resource. Stages, access masks and image layouts are derived from it, so passes never
+    // spell out barriers themselves
+    enum class rg_access : uint8_t
+    {
+        color_attachment,       // write
+        depth_attachment,       // write
+        depth_read,
+        sampled_graphics,
+        sampled_compute,
+        storage_read_graphics,
+        storage_read_compute,
+        storage_write_compute,  // write
+        transfer_read,
+        transfer_write,         // write
+        vertex_input,
+        indirect,
+        uniform_graphics,
+
+        count
+    };
+
+    struct rg_state_t
+    {
+        VkImageLayout           layout{ VK_IMAGE_LAYOUT_UNDEFINED };
+        VkPipelineStageFlags    stages{ VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT };
+        VkAccessFlags           access{ 0 };
+    };
+
+    // Graph-owned image, alive for the passes that use it; images with disjoint lifetimes share memory. Usage
+    // flags are derived from the declared accesses.
+    struct rg_texture_desc_t
+    {
+        VkFormat                format{ VK_FORMAT_UNDEFINED };
+        VkExtent2D              extent{ 0, 0 };
+        VkImageAspectFlags      aspect{ VK_IMAGE_ASPECT_COLOR_BIT };
+        uint32_t                mip_levels{ 1 };
+        uint32_t                layers{ 1 };
+    };
+
+    // Externally owned image; its handles may change every frame without forcing a rebuild. The graph moves it
+    // from `initial` and leaves it in `final` (when final.layout is not UNDEFINED) at the end of the frame.
+    struct rg_imported_texture_t
+    {
+        VkImage                 image{ VK_NULL_HANDLE };
+        VkImageView             view{ VK_NULL_HANDLE };
+        VkFormat                format{ VK_FORMAT_UNDEFINED };
+        VkExtent2D              extent{ 0, 0 };
+        VkImageAspectFlags      aspect{ VK_IMAGE_ASPECT_COLOR_BIT };
+        rg_state_t              initial;
+        rg_state_t              final;
+    };
+
+    struct rg_imported_buffer_t
+    {
+        VkBuffer                buffer{ VK_NULL_HANDLE };
+        VkDeviceSize            offset{ 0 };
+        VkDeviceSize            size{ VK_WHOLE_SIZE };
+        rg_state_t              initial;
+    };
+
+    struct rg_stats_t
+    {
+        uint32_t                pass_count{ 0 };
+        uint32_t                culled_count{ 0 };
+        uint32_t                barrier_count{ 0 };
+        uint32_t                transient_count{ 0 };
+        VkDeviceSize            transient_bytes{ 0 };  // sum of all transient images
+        VkDeviceSize            aliased_bytes{ 0 };    // memory actually allocated for them
+        uint64_t                rebuilds{ 0 };
+    };
+
+    // Per-frame render graph. Every frame the renderer declares its resources and passes again in the same order,
+    // then compiles and executes. Compiling hashes the declaration; only when that topology hash changes are
+    // passes culled, lifetimes and memory aliasing recomputed and the barrier plan rebuilt. Otherwise the cached
+    // plan is replayed against this frame's imported handles.
+    class render_graph_t
+    {
+    public:
+        class pass_builder_t
+        {
+        public:
+            pass_builder_t& use(rg_resource_t resource, rg_access access);
+            // Keeps the pass even when none of its writes are consumed
+            pass_builder_t& side_effect() noexcept;
+
+        private:
+            friend class render_graph_t;
+            pass_builder_t(render_graph_t& graph, const uint32_t pass) noexcept : _graph{ graph }, _pass{ pass } {}
+
+            render_graph_t& _graph;
+            uint32_t        _pass;
+        };
+
+        void init(VkDevice device, gpu_allocator_t& allocator, timeline_semaphore_t& frame_timeline);
+        void shutdown();
+
+        // Starts a new declaration; resources and passes from the previous frame are forgotten
+        void reset();
+
+        [[nodiscard]] rg_resource_t create_texture(std::string_view name, const rg_texture_desc_t& desc);
+        [[nodiscard]] rg_resource_t import_texture(std::string_view name, const rg_imported_texture_t& texture);
+        [[nodiscard]] rg_resource_t import_buffer(std::string_view name, const rg_imported_buffer_t& buffer);
+
+        // Passes run in declaration order; `record` is invoked on the primary command buffer after the barriers
+        pass_builder_t add_pass(std::string_view name, const record_delegate_t& record);
+
+        void compile();
+        // With a timer, every pass is recorded inside a GPU scope named after it
+        void execute(VkCommandBuffer cmd, gpu_timer_t* timer = nullptr);
+
+        // Valid for transients once compiled, and for imports of the current frame
+        [[nodiscard]] VkImage image(rg_resource_t resource) const noexcept;
+        [[nodiscard]] VkImageView view(rg_resource_t resource) const noexcept;
+        [[nodiscard]] VkBuffer buffer(rg_resource_t resource) const noexcept;
+
+        [[nodiscard]] const rg_stats_t& stats() const noexcept { return _stats; }
+
+    private:
+        enum class resource_kind : uint8_t
+        {
+            transient_texture,
+            imported_texture,
+            imported_buffer,
+        };
+
+        struct resource_t
+        {
+            std::string             name;
+            resource_kind           kind{ resource_kind::transient_texture };
+            rg_texture_desc_t       desc;
+            rg_state_t              initial;
+            rg_state_t              final;
+
+            VkImage                 image{ VK_NULL_HANDLE };
+            VkImageView             view{ VK_NULL_HANDLE };
+            VkBuffer                buffer{ VK_NULL_HANDLE };
+            VkDeviceSize            offset{ 0 };
+            VkDeviceSize            size{ VK_WHOLE_SIZE };
+        };
+
+        struct use_t
+        {
+            uint32_t                resource{ 0 };
+            rg_access               access{ rg_access::sampled_graphics };
+        };
+
+        struct pass_t
+        {
+            std::string             name;
+            record_delegate_t       record;
+            uint32_t                first_use{ 0 };
+            uint32_t                use_count{ 0 };
+            bool                    side_effect{ false };
+        };
+
+        struct barrier_t
+        {
+            uint32_t                resource{ 0 };
+            VkAccessFlags           src_access{ 0 };
+            VkAccessFlags           dst_access{ 0 };
+            VkImageLayout           old_layout{ VK_IMAGE_LAYOUT_UNDEFINED };
+            VkImageLayout           new_layout{ VK_IMAGE_LAYOUT_UNDEFINED };
+        };
+
+        // Barriers recorded before a live pass, or after the last one when pass == ~0u
+        struct step_t
+        {
+            uint32_t                pass{ ~0u };
+            uint32_t                first_barrier{ 0 };
+            uint32_t                barrier_count{ 0 };
+            VkPipelineStageFlags    src_stages{ 0 };
+            VkPipelineStageFlags    dst_stages{ 0 };
+        };
+
+        // Compiled images and their shared memory, kept until the topology changes
+        struct transient_t
+        {
+            VkImage                 image{ VK_NULL_HANDLE };
+            VkImageView             view{ VK_NULL_HANDLE };
+            gpu_allocation_t        allocation; // only set when the image could not join the shared heap
+            VkDeviceSize            heap_offset{ 0 };
+            VkDeviceSize            size{ 0 };
+            bool                    in_heap{ false };
+        };
+
+        // Hazard tracking of one resource while the plan is built
+        struct track_t
+        {
+            VkImageLayout           layout{ VK_IMAGE_LAYOUT_UNDEFINED };
+            VkPipelineStageFlags    write_stages{ 0 };  // last write, or layout transition
+            VkAccessFlags           write_access{ 0 };
+            VkPipelineStageFlags    read_stages{ 0 };   // reads since then
+            VkPipelineStageFlags    synced_stages{ 0 }; // stages that already wait for the last write
+        };
+
+        // Passes using a transient, first to last
+        struct lifetime_t
+        {
+            uint32_t                resource{ 0 };
+            uint32_t                first{ ~0u };
+            uint32_t                last{ 0 };
+            VkImageUsageFlags       usage{ 0 };
+            VkMemoryRequirements    requirements{ };
+        };
+
+        struct retired_t
+        {
+            uint64_t                        frame_value{ 0 };
+            graphics_vector_t<transient_t>  transients;
+            gpu_allocation_t                heap;
+        };
+
+        // Temporaries of compile(), on _scratch. Sized up front and freed in reverse order: a vector that grew would
+        // free a block below the top of the stack
+        template<typename T>
+        using scratch_vector_t = std::vector<T, memory::allocator_ref_t<T>>;
+
+        template<typename T>
+        [[nodiscard]] scratch_vector_t<T> scratch_vector(const size_t count)
+        {
+            return scratch_vector_t<T>(count, memory::allocator_ref_t<T>{ _scratch });
+        }
+
+        [[nodiscard]] uint64_t topology_hash() const noexcept;
+        [[nodiscard]] size_t scratch_capacity() const noexcept;
+        // `live` comes in all false
+        void cull_passes(scratch_vector_t<bool>& live);
+        // False when some transient got no memory; its image is left null
+        [[nodiscard]] bool build_transients(const scratch_vector_t<bool>& live);
+        void build_barriers(const scratch_vector_t<bool>& live);
+        void plan(const scratch_vector_t<bool>& live, scratch_vector_t<track_t>& tracks);
+        void retire_transients();
+        void collect_retired(bool force);
+
+        VkDevice                        _device{ VK_NULL_HANDLE };
+        gpu_allocator_t*                _allocator{ nullptr };
+        timeline_semaphore_t*           _frame_timeline{ nullptr };
+
+        // Declaration of the current frame
+        graphics_vector_t<resource_t>   _resources;
+        graphics_vector_t<pass_t>       _passes;
+        graphics_vector_t<use_t>        _uses;
+
+        // Compiled plan
+        uint64_t                        _compiled_hash{ 0 };
+        bool                            _compiled{ false };
+        graphics_vector_t<step_t>       _steps;
+        graphics_vector_t<barrier_t>    _barriers;
+        graphics_vector_t<transient_t>  _transients; // indexed like _resources, empty entries for imports
+        gpu_allocation_t                _heap;
+
+        graphics_vector_t<retired_t>    _retired;
+        graphics_vector_t<VkImageMemoryBarrier> _image_scratch;
+        graphics_vector_t<VkBufferMemoryBarrier> _buffer_scratch;
+        memory::stack_allocator_t       _scratch{ memory::memory_tag::graphics };
+        rg_stats_t                      _stats;
+    };
+} // namespace carrot::rhi::vulkan
@@ -6,20 +6,39 @@
 #include "VulkanRenderer.h"
 
 #include "VulkanContext.h"
+#include "Core/Profiler.h"
 #include "Window/Window.h"
 #include "Utils/ShaderUtils.h"
 #include "Debug/DebugOverlay.h"
 #include "Utils/Assert.h"
 
+#include <algorithm>
+#include <filesystem>
+#include <thread>
 #include <vector>
 
 namespace carrot::rhi::vulkan {
     namespace {
+        // Pass recording is short, a few workers beside the main thread are enough to hide it
+        constexpr uint32_t k_max_record_workers{ 3 };
 
+        // Matches the PushConstants block in triangle.vert
+        struct scene_push_t
+        {
+            float       view_projection[16];
+            uint32_t    frame_count;
+            uint32_t    instance_buffer;
+        };
+
+        // Modules are matched by file name, the hot-reload output directory differs from the load directory
+        std::string module_key(const std::string_view spv_path)
+        {
+            return std::filesystem::path{ spv_path }.filename().string();
+        }
     } // anonymous namespace
 
     // PUBLIC
-    void vulkan_renderer_t::init()
+    void vulkan_renderer_t::init(const renderer::renderer_config_t& config)
     {
         _ctx = new vulkan_context_t;
 
@@ -39,32 +58,53 @@ namespace carrot::rhi::vulkan {
             VK_KHR_WAYLAND_SURFACE_EXTENSION_NAME
         };
 
+        // Headless runs need no window system integration at all, so they work on CPU drivers without a compositor
         VkInstanceCreateInfo inst_info{ };
         inst_info.sType = VK_STRUCTURE_TYPE_INSTANCE_CREATE_INFO;
         inst_info.pApplicationInfo = &app_info;
-        inst_info.enabledExtensionCount = 2;
+        inst_info.enabledExtensionCount = config.headless ? 0 : 2;
         inst_info.ppEnabledExtensionNames = instance_extensions;
 
         VkInstance instance{ VK_NULL_HANDLE };
         vkCreateInstance(&inst_info, nullptr, &instance);
 
         // ── Surface from Wayland window ─────────────────────────────
-        const auto& win = window::get_primary_window();
-        VkWaylandSurfaceCreateInfoKHR surf_info{ };
-        surf_info.sType = VK_STRUCTURE_TYPE_WAYLAND_SURFACE_CREATE_INFO_KHR;
-        surf_info.display = win.get_wl_display();
-        surf_info.surface = win.get_wl_surface();
-
         VkSurfaceKHR surface{ VK_NULL_HANDLE };
-        vkCreateWaylandSurfaceKHR(instance, &surf_info, nullptr, &surface);
+        if (!config.headless)
+        {
+            const auto& win = window::get_primary_window();
+            VkWaylandSurfaceCreateInfoKHR surf_info{ };
+            surf_info.sType = VK_STRUCTURE_TYPE_WAYLAND_SURFACE_CREATE_INFO_KHR;
+            surf_info.display = win.get_wl_display();
+            surf_info.surface = win.get_wl_surface();
+            vkCreateWaylandSurfaceKHR(instance, &surf_info, nullptr, &surface);
+        }
 
-        // ── Vulkan context (device, queues, swapchain) ───────────────
+        // ── Vulkan context (device, queues, swapchain or offscreen targets) ──
         _ctx->init(instance, surface);
-        _ctx->create_swapchain(1280, 720);
+        if (config.headless)
+            _ctx->create_offscreen_targets(config.width, config.height);
+        else
+        {
+            _window_extent = { window::width(), window::height() };
+            _ctx->create_swapchain(_window_extent.width, _window_extent.height);
+        }
+
+        if (!config.capture_directory.empty())
+        {
+            if (config.headless)
+                _capture.init(*_ctx, config.capture_directory, config.capture_format);
+            else
+                LOG_GRAPHICS_WARN("[Vulkan] Frame capture needs headless mode, ignoring {}", config.capture_directory);
+        }
+
+        _gpu_timer.init(*_ctx);
 
         create_pipeline();
+        register_pipeline({ "triangle.vert.spv", "triangle.frag.spv" },
+                          pipeline_rebuild_delegate_t::bind<&vulkan_renderer_t::rebuild_pipeline>(this));
 
-        // Create the shared command pool ONCE — used by renderer AND debug overlay
+        // Primary command buffers only; everything inside the pass is recorded by _recorder
         VkCommandPoolCreateInfo pool_info{ };
         pool_info.sType = VK_STRUCTURE_TYPE_COMMAND_POOL_CREATE_INFO;
         pool_info.flags = VK_COMMAND_POOL_CREATE_RESET_COMMAND_BUFFER_BIT;
@@ -74,18 +114,33 @@ namespace carrot::rhi::vulkan {
         vkCreateCommandPool(_ctx->device(), &pool_info, nullptr, &raw_pool);
         _command_pool = command_pool_t{ _ctx->device(), raw_pool };
 
-        recreate_swapchain_dependent_resources();
+        create_frame_resources();
+
+        const uint32_t hardware_threads{ std::max(std::thread::hardware_concurrency(), 2u) };
+        _graph.init(_ctx->device(), _ctx->allocator(), _ctx->frame_timeline());
+        _recorder.init(_ctx->device(), _ctx->graphics_family(), std::min(hardware_threads - 1, k_max_record_workers));
+
+        create_scene();
+
+        _sprites.init(*_ctx);
+        register_pipeline({ "sprite.vert.spv", "sprite.frag.spv" },
+                          pipeline_rebuild_delegate_t::bind<&sprite_batcher_t::rebuild_pipelines>(&_sprites));
     }
 
     void vulkan_renderer_t::shutdown()
     {
         vkDeviceWaitIdle(_ctx->device());
 
-        destroy_pipeline();
+        _pipeline_rebuilds.clear();
+        _module_users.clear();
 
-        for (const auto fb: _swapchain_framebuffers)
-            vkDestroyFramebuffer(_ctx->device(), fb, nullptr);
-        _swapchain_framebuffers.clear();
+        _recorder.shutdown();
+        _capture.shutdown();
+        _gpu_timer.shutdown();
+        _scene.shutdown();
+        _sprites.shutdown();
+        _graph.shutdown();
+        destroy_pipeline();
 
         vkDestroyCommandPool(_ctx->device(), _command_pool.pool, nullptr);
 
@@ -95,12 +150,12 @@ namespace carrot::rhi::vulkan {
         {
             vkDestroySemaphore(_ctx->device(), frame.image_available, nullptr);
             vkDestroySemaphore(_ctx->device(), frame.render_finished, nullptr);
-            vkDestroyFence(_ctx->device(), frame.in_flight, nullptr);
         }
 
         _ctx->cleanup();
 
-        vkDestroySurfaceKHR(_ctx->instance(), _ctx->surface(), nullptr);
+        // Headless instances are created without VK_KHR_surface
+        if (!_ctx->is_headless()) vkDestroySurfaceKHR(_ctx->instance(), _ctx->surface(), nullptr);
         vkDestroyInstance(_ctx->instance(), nullptr);
 
         delete _ctx;
@@ -108,188 +163,299 @@ namespace carrot::rhi::vulkan {
     }
     void vulkan_renderer_t::begin_frame()
     {
+        CE_PROFILE_ZONE("renderer_begin_frame");
+
         const frame_resources_t& frame{ _frames[_current_frame] };
 
-        vkWaitForFences(_ctx->device(), 1, &frame.in_flight, VK_TRUE, ~0ULL);
-        vkResetFences(_ctx->device(), 1, &frame.in_flight);
+        // Frames retire in submission order, so reaching this slot's value means its command buffer is free again
+        {
+            CE_PROFILE_ZONE("wait_frame_slot");
+            _ctx->frame_timeline().wait(frame.timeline_value);
+        }
 
-        uint32_t image_index{ 0 };
+        // The GPU is done with everything this frame slot wrote last time around
+        _ctx->transient_ring().begin_frame(_current_frame);
+        _recorder.begin_frame(_current_frame);
 
-        const VkResult result{
-            vkAcquireNextImageKHR(_ctx->device(), *_ctx->swapchain(), ~0ULL, frame.image_available, VK_NULL_HANDLE,
-                                  &image_index)
-        };
+        // Uploads queued since the last frame go out as one batch
+        {
+            CE_PROFILE_ZONE("upload_flush");
+            _ctx->uploads().flush();
+        }
+
+        // The readback of the frame this slot rendered last time has landed too
+        if (_capture.is_enabled()) _capture.collect(_current_frame);
+        _gpu_timer.collect(_current_frame);
 
-        if (result == VK_ERROR_OUT_OF_DATE_KHR || result == VK_SUBOPTIMAL_KHR)
+        // Headless: each frame slot owns an offscreen target, free again now that the slot has retired
+        uint32_t image_index{ _current_frame };
+        VkResult result{ VK_SUCCESS };
+        if (!_ctx->is_headless())
         {
-            // TODO: proper resize handling later
-            recreate_swapchain_dependent_resources();
+            // Wayland never reports a resize as out of date: the surface takes whatever size the swapchain has,
+            // so a new size only shows up in the window's configure
+            if (window::width() != _window_extent.width || window::height() != _window_extent.height)
+                recreate_swapchain();
+
+            result = vkAcquireNextImageKHR(_ctx->device(), *_ctx->swapchain(), ~0ULL, frame.image_available,
+                                           VK_NULL_HANDLE, &image_index);
+        }
+
+        // Suboptimal still acquired an image and will signal image_available, so that frame is rendered and
+        // presented and the recreation happens after present
+        _frame_active = result == VK_SUCCESS || result == VK_SUBOPTIMAL_KHR;
+        if (!_frame_active)
+        {
+            // Nothing was acquired, so the frame is skipped and the next one uses the new swapchain
+            if (result == VK_ERROR_OUT_OF_DATE_KHR) recreate_swapchain();
             return;
         }
         _current_image_index = image_index;
+        _needs_recreate = result == VK_SUBOPTIMAL_KHR;
 
         vkResetCommandBuffer(frame.command_buffer, 0);
 
         VkCommandBufferBeginInfo begin_info{ };
         begin_info.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO;
         vkBeginCommandBuffer(frame.command_buffer, &begin_info);
-
-        constexpr VkClearValue clear_color{ { { 0.15f, 0.05f, 0.0f, 1.0f } } };
-
-        VkRenderPassBeginInfo rp_begin{ };
-        rp_begin.sType = VK_STRUCTURE_TYPE_RENDER_PASS_BEGIN_INFO;
-        rp_begin.renderPass = _render_pass.pass;
-        rp_begin.framebuffer = _swapchain_framebuffers[image_index];
-        rp_begin.renderArea.extent = _ctx->swapchain_extent();
-        rp_begin.clearValueCount = 1;
-        rp_begin.pClearValues = &clear_color;
-
-        vkCmdBeginRenderPass(frame.command_buffer, &rp_begin, VK_SUBPASS_CONTENTS_INLINE);
-
-        vkCmdBindPipeline(frame.command_buffer, VK_PIPELINE_BIND_POINT_GRAPHICS, _graphics_pipeline.pipeline);
-
-        const VkViewport viewport{
-            0.f, 0.f,
-            static_cast<float>(_ctx->swapchain_extent().width),
-            static_cast<float>(_ctx->swapchain_extent().height), 0.f, 1.f
-        };
-        vkCmdSetViewport(frame.command_buffer, 0, 1, &viewport);
-
-        const VkRect2D scissor{ { 0, 0 }, _ctx->swapchain_extent() };
-        vkCmdSetScissor(frame.command_buffer, 0, 1, &scissor);
-
-        vkCmdPushConstants(frame.command_buffer, _pipeline_layout.layout,
-                           VK_SHADER_STAGE_VERTEX_BIT, 0, sizeof(uint32_t), &_frame_counter);
+        _gpu_timer.begin_frame(frame.command_buffer, _current_frame);
     }
     void vulkan_renderer_t::render_frame()
     {
+        CE_PROFILE_ZONE("renderer_render_frame");
+
+        if (!_frame_active)
+        {
+            _sprites.clear();
+            return;
+        }
+
         const frame_resources_t& frame{ _frames[_current_frame] };
 
-        vkCmdDraw(frame.command_buffer, 3, 1, 0, 0);
+        // Declared every frame; the graph only recompiles when the declaration changes shape (e.g. on resize)
+        _graph.reset();
+
+        rg_imported_texture_t backbuffer_info{ };
+        backbuffer_info.image = _ctx->swapchain_image(_current_image_index);
+        backbuffer_info.view = _ctx->swapchain_views()[_current_image_index];
+        backbuffer_info.format = _ctx->swapchain_format();
+        backbuffer_info.extent = _ctx->swapchain_extent();
+        // Acquire waits at color attachment output, so the first transition has to start from that stage
+        backbuffer_info.initial = { VK_IMAGE_LAYOUT_UNDEFINED, VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT, 0 };
+        // Offscreen targets are never presented; their contents are discarded at the start of the next use
+        if (!_ctx->is_headless())
+            backbuffer_info.final = { VK_IMAGE_LAYOUT_PRESENT_SRC_KHR, VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT, 0 };
+        _backbuffer = _graph.import_texture("backbuffer", backbuffer_info);
+
+        // Culls on the GPU and leaves the scene's indirect draws for the main pass
+        _scene.add_passes(_graph);
+        // Copies glyphs baked this frame into the overlay's atlas ahead of the main pass drawing the text
+        const rg_resource_t glyph_atlas{ debug::add_passes(&_graph) };
+        debug::set_view_projection(_scene.view_projection());
+
+        render_graph_t::pass_builder_t main_pass{
+            _graph.add_pass("main", record_delegate_t::bind<&vulkan_renderer_t::record_main_pass>(this))
+        };
+        _scene.use_draw_resources(main_pass.use(_backbuffer, rg_access::color_attachment));
+        if (glyph_atlas.is_valid()) main_pass.use(glyph_atlas, rg_access::sampled_graphics);
 
-        // Debug overlay — always last in the render pass
-        // ← ONLY RENDER DEBUG OVERLAY AFTER IT'S INITIALIZED
-        if (debug::is_initialized()) debug::render(get_current_command_buffer());
+        if (_capture.is_enabled()) _capture.add_pass(_graph, _backbuffer, _current_frame, _frame_counter);
 
-        vkCmdEndRenderPass(frame.command_buffer);
+        {
+            CE_PROFILE_ZONE("graph_compile");
+            _graph.compile();
+        }
+        CE_PROFILE_ZONE("graph_record");
+        _graph.execute(frame.command_buffer, &_gpu_timer);
     }
 
     void vulkan_renderer_t::end_frame()
     {
-        const frame_resources_t& frame{ _frames[_current_frame] };
+        CE_PROFILE_ZONE("renderer_end_frame");
+
+        if (!_frame_active) return;
+        _frame_active = false;
+
+        frame_resources_t& frame{ _frames[_current_frame] };
 
         vkEndCommandBuffer(frame.command_buffer);
 
         constexpr VkPipelineStageFlags wait_stage{ VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT };
 
+        // Binary semaphores ignore their value slot; the frame timeline is signalled alongside render_finished.
+        // Headless frames neither acquire nor present, the timeline is all they signal.
+        const bool headless{ _ctx->is_headless() };
+        timeline_semaphore_t& timeline{ _ctx->frame_timeline() };
+        const uint64_t frame_value{ timeline.advance() };
+
+        constexpr uint64_t wait_values[]{ 0 };
+        const uint64_t signal_values[]{ frame_value, 0 };
+        const VkSemaphore signal_semaphores[]{ timeline, frame.render_finished };
+        const uint32_t signal_count{ headless ? 1u : 2u };
+
+        VkTimelineSemaphoreSubmitInfo timeline_info{ };
+        timeline_info.sType = VK_STRUCTURE_TYPE_TIMELINE_SEMAPHORE_SUBMIT_INFO;
+        timeline_info.waitSemaphoreValueCount = headless ? 0 : 1;
+        timeline_info.pWaitSemaphoreValues = wait_values;
+        timeline_info.signalSemaphoreValueCount = signal_count;
+        timeline_info.pSignalSemaphoreValues = signal_values;
+
         VkSubmitInfo submit{ };
         submit.sType = VK_STRUCTURE_TYPE_SUBMIT_INFO;
-        submit.waitSemaphoreCount = 1;
+        submit.pNext = &timeline_info;
+        submit.waitSemaphoreCount = headless ? 0 : 1;
         submit.pWaitSemaphores = &frame.image_available;
         submit.pWaitDstStageMask = &wait_stage;
         submit.commandBufferCount = 1;
         submit.pCommandBuffers = &frame.command_buffer;
-        submit.signalSemaphoreCount = 1;
-        submit.pSignalSemaphores = &frame.render_finished;
-
-        vkQueueSubmit(_ctx->graphics_queue(), 1, &submit, frame.in_flight);
+        submit.signalSemaphoreCount = signal_count;
+        submit.pSignalSemaphores = signal_semaphores;
 
-        VkPresentInfoKHR present{ };
-        present.sType = VK_STRUCTURE_TYPE_PRESENT_INFO_KHR;
-        present.waitSemaphoreCount = 1;
-        present.pWaitSemaphores = &frame.render_finished;
-        present.swapchainCount = 1;
-        present.pSwapchains = _ctx->swapchain();
-        present.pImageIndices = &_current_image_index; // set in begin_frame
+        vkQueueSubmit(_ctx->graphics_queue(), 1, &submit, VK_NULL_HANDLE);
+        frame.timeline_value = frame_value;
 
-        vkQueuePresentKHR(_ctx->present_queue(), &present);
+        VkResult result{ VK_SUCCESS };
+        if (!headless)
+        {
+            VkPresentInfoKHR present{ };
+            present.sType = VK_STRUCTURE_TYPE_PRESENT_INFO_KHR;
+            present.waitSemaphoreCount = 1;
+            present.pWaitSemaphores = &frame.render_finished;
+            present.swapchainCount = 1;
+            present.pSwapchains = _ctx->swapchain();
+            present.pImageIndices = &_current_image_index; // set in begin_frame
+
+            result = vkQueuePresentKHR(_ctx->present_queue(), &present);
+        }
 
         ++_frame_counter;
         _current_frame = (_current_frame + 1) % k_max_frames_in_flight;
+
+        if (_needs_recreate || result == VK_ERROR_OUT_OF_DATE_KHR || result == VK_SUBOPTIMAL_KHR)
+        {
+            _needs_recreate = false;
+            recreate_swapchain();
+        }
     }
     void vulkan_renderer_t::reload_pipeline()
     {
+        CE_PROFILE_ZONE("reload_pipeline");
+
         vkDeviceWaitIdle(_ctx->device());
-        destroy_pipeline();
-        create_pipeline();
+
+        for (const auto& rebuild: _pipeline_rebuilds)
+            rebuild.invoke();
+    }
+    void vulkan_renderer_t::reload_shaders(const std::vector<std::string>& spv_paths)
+    {
+        std::vector<uint32_t> dirty_pipelines;
+
+        for (const auto& spv_path: spv_paths)
+        {
+            override_archived_spv(spv_path);
+
+            const auto it{ _module_users.find(std::string_view{ module_key(spv_path) }) };
+            if (it == _module_users.end())
+            {
+                LOG_GRAPHICS_WARN("[HotReload] No pipeline uses {}, nothing to rebuild", spv_path);
+                continue;
+            }
+
+            for (const uint32_t index: it->second)
+                if (std::ranges::find(dirty_pipelines, index) == dirty_pipelines.end()) dirty_pipelines.push_back(index);
+        }
+
+        if (dirty_pipelines.empty()) return;
+
+        // One idle wait for the whole batch, not one per pipeline
+        vkDeviceWaitIdle(_ctx->device());
+
+        for (const uint32_t index: dirty_pipelines)
+            _pipeline_rebuilds[index].invoke();
+
+        LOG_GRAPHICS_INFO("[HotReload] Rebuilt {} of {} pipeline(s)", dirty_pipelines.size(), _pipeline_rebuilds.size());
+    }
+    renderer::sprite_atlas_id_t vulkan_renderer_t::create_sprite_atlas(const uint32_t width, const uint32_t height,
+                                                                       const std::span<const void* const> layers)
+    {
+        return _sprites.create_atlas(width, height, layers);
+    }
+    void vulkan_renderer_t::draw_sprites(const std::span<const renderer::sprite_t> sprites,
+                                         const renderer::sprite_atlas_id_t atlas, const renderer::sprite_blend blend)
+    {
+        _sprites.submit(sprites, atlas, blend);
+    }
+    uint32_t vulkan_renderer_t::add_triangles(const std::span<const renderer::triangle_instance_t> instances)
+    {
+        if (!_triangle_mesh.is_valid()) return 0;
+
+        uint32_t added{ 0 };
+        for (const renderer::triangle_instance_t& triangle: instances)
+        {
+            gpu_instance_t instance{ };
+            std::copy_n(triangle.position, 3, instance.position);
+            instance.scale = triangle.scale;
+            instance.rotation = triangle.rotation;
+            instance.mesh = _triangle_mesh.index;
+            if (!_scene.add_instance(instance).is_valid()) break;
+            ++added;
+        }
+        return added;
+    }
+    void vulkan_renderer_t::register_pipeline(const std::initializer_list<std::string_view> spv_modules,
+                                              const pipeline_rebuild_delegate_t& rebuild)
+    {
+        const uint32_t index{ static_cast<uint32_t>(_pipeline_rebuilds.size()) };
+        _pipeline_rebuilds.push_back(rebuild);
+
+        for (const std::string_view spv_module: spv_modules)
+            _module_users[graphics_string_t{ module_key(spv_module) }].push_back(index);
     }
 
     // PRIVATE
     void vulkan_renderer_t::create_pipeline()
     {
-        auto vert_spv = load_spv("shaders/triangle.vert.spv");
-        auto frag_spv = load_spv("shaders/triangle.frag.spv");
-
-        VkShaderModule vert_module{ VK_NULL_HANDLE };
-        VkShaderModule frag_module{ VK_NULL_HANDLE };
-
-        VkShaderModuleCreateInfo mod_info{ };
-        mod_info.sType = VK_STRUCTURE_TYPE_SHADER_MODULE_CREATE_INFO;
-        mod_info.codeSize = vert_spv.size() * sizeof(uint32_t);
-        mod_info.pCode = vert_spv.data();
-        vkCreateShaderModule(_ctx->device(), &mod_info, nullptr, &vert_module);
-
-        mod_info.codeSize = frag_spv.size() * sizeof(uint32_t);
-        mod_info.pCode = frag_spv.data();
-        vkCreateShaderModule(_ctx->device(), &mod_info, nullptr, &frag_module);
-
-        VkPushConstantRange push_range{ VK_SHADER_STAGE_VERTEX_BIT, 0, sizeof(uint32_t) };
-
-        VkPipelineLayoutCreateInfo layout_info{ };
-        layout_info.sType = VK_STRUCTURE_TYPE_PIPELINE_LAYOUT_CREATE_INFO;
-        layout_info.pushConstantRangeCount = 1;
-        layout_info.pPushConstantRanges = &push_range;
-
-        VkPipelineLayout raw_layout{ VK_NULL_HANDLE };
-        vkCreatePipelineLayout(_ctx->device(), &layout_info, nullptr, &raw_layout);
-        _pipeline_layout = pipeline_layout_t{ _ctx->device(), raw_layout };
-
-        // ── Render Pass ─────────────────────────────────────────────
-        VkAttachmentDescription color_att{ };
-        color_att.format = _ctx->swapchain_format();
-        color_att.samples = VK_SAMPLE_COUNT_1_BIT;
-        color_att.loadOp = VK_ATTACHMENT_LOAD_OP_CLEAR;
-        color_att.storeOp = VK_ATTACHMENT_STORE_OP_STORE;
-        color_att.stencilLoadOp = VK_ATTACHMENT_LOAD_OP_DONT_CARE;
-        color_att.stencilStoreOp = VK_ATTACHMENT_STORE_OP_DONT_CARE;
-        color_att.initialLayout = VK_IMAGE_LAYOUT_UNDEFINED;
-        color_att.finalLayout = VK_IMAGE_LAYOUT_PRESENT_SRC_KHR;
-
-        VkAttachmentReference color_ref{ 0, VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL };
-
-        VkSubpassDescription subpass{ };
-        subpass.pipelineBindPoint = VK_PIPELINE_BIND_POINT_GRAPHICS;
-        subpass.colorAttachmentCount = 1;
-        subpass.pColorAttachments = &color_ref;
-
-        VkRenderPassCreateInfo rp_info{ };
-        rp_info.sType = VK_STRUCTURE_TYPE_RENDER_PASS_CREATE_INFO;
-        rp_info.attachmentCount = 1;
-        rp_info.pAttachments = &color_att;
-        rp_info.subpassCount = 1;
-        rp_info.pSubpasses = &subpass;
-
-        VkRenderPass raw_rp{ VK_NULL_HANDLE };
-        vkCreateRenderPass(_ctx->device(), &rp_info, nullptr, &raw_rp);
-        _render_pass = render_pass_t{ _ctx->device(), raw_rp };
-
-        // Share the render pass with the debug overlay
-        vulkan_context_t::get()->set_render_pass(_render_pass.pass);
+        // Layout and vertex input come from the shaders themselves; variants only differ in specialization
+        // constants, so reflecting the base modules covers all of them
+        const spv_blob_t vert_spv{ load_spv("shaders/triangle.vert.spv") };
+        const spv_blob_t frag_spv{ load_spv("shaders/triangle.frag.spv") };
+
+        renderer::shader_reflection_t reflection{ };
+        if (!reflect_stages({ vert_spv, frag_spv }, reflection))
+        {
+            LOG_GRAPHICS_ERROR("[Vulkan] Scene pipeline not created, its shaders could not be reflected");
+            return;
+        }
+
+        _pipeline_layout = _ctx->layout_cache().pipeline_layout(reflection);
+        _vertex_input = build_vertex_input(reflection);
+        CE_ASSERT(_vertex_input.binding.stride == sizeof(scene_vertex_t), "scene_vertex_t does not match triangle.vert");
+
+        // Variants share the layout and are compiled lazily; start the one we draw with right away
+        _pipeline_variants.init(_ctx->device(), [this](const renderer::shader_variant_key_t key) {
+            return create_pipeline_variant(key);
+        });
+        _pipeline_variants.prewarm({ _variant_key });
+    }
+    VkPipeline vulkan_renderer_t::create_pipeline_variant(const renderer::shader_variant_key_t key) const
+    {
+        const variant_stage_t vert{ create_variant_module(_ctx->device(), "shaders/triangle.vert.spv", key) };
+        const variant_stage_t frag{ create_variant_module(_ctx->device(), "shaders/triangle.frag.spv", key) };
+        const specialization_t specialization{ key };
 
         // ── Graphics Pipeline ───────────────────────────────────────
         VkPipelineShaderStageCreateInfo stages[2]{
             {
                 VK_STRUCTURE_TYPE_PIPELINE_SHADER_STAGE_CREATE_INFO, nullptr, 0, VK_SHADER_STAGE_VERTEX_BIT,
-                vert_module, "main", nullptr
+                vert.module, "main", vert.baked ? nullptr : &specialization.info
             },
             {
                 VK_STRUCTURE_TYPE_PIPELINE_SHADER_STAGE_CREATE_INFO, nullptr, 0, VK_SHADER_STAGE_FRAGMENT_BIT,
-                frag_module, "main", nullptr
+                frag.module, "main", frag.baked ? nullptr : &specialization.info
             }
         };
 
-        VkPipelineVertexInputStateCreateInfo vertex_input{ };
-        vertex_input.sType = VK_STRUCTURE_TYPE_PIPELINE_VERTEX_INPUT_STATE_CREATE_INFO;
+        const VkPipelineVertexInputStateCreateInfo vertex_input{ _vertex_input.create_info() };
 
         VkPipelineInputAssemblyStateCreateInfo ia{ };
         ia.sType = VK_STRUCTURE_TYPE_PIPELINE_INPUT_ASSEMBLY_STATE_CREATE_INFO;
@@ -325,6 +491,13 @@ namespace carrot::rhi::vulkan {
         dyn.dynamicStateCount = 2;
         dyn.pDynamicStates = dyn_states;
 
+        // Only the attachment formats tie the pipeline to where it draws
+        const VkFormat color_format{ _ctx->swapchain_format() };
+        VkPipelineRenderingCreateInfo rendering{ };
+        rendering.sType = VK_STRUCTURE_TYPE_PIPELINE_RENDERING_CREATE_INFO;
+        rendering.colorAttachmentCount = 1;
+        rendering.pColorAttachmentFormats = &color_format;
+
         VkGraphicsPipelineCreateInfo pipe_info{ };
         pipe_info.sType = VK_STRUCTURE_TYPE_GRAPHICS_PIPELINE_CREATE_INFO;
         pipe_info.stageCount = 2;
@@ -336,65 +509,29 @@ namespace carrot::rhi::vulkan {
         pipe_info.pMultisampleState = &ms;
         pipe_info.pColorBlendState = &cb;
         pipe_info.pDynamicState = &dyn;
-        pipe_info.layout = _pipeline_layout.layout;
-        pipe_info.renderPass = _render_pass.pass;
+        pipe_info.layout = _pipeline_layout.pipeline_layout;
+        pipe_info.pNext = &rendering;
 
         VkPipeline raw_pipe{ VK_NULL_HANDLE };
-        vkCreateGraphicsPipelines(_ctx->device(), VK_NULL_HANDLE, 1, &pipe_info, nullptr, &raw_pipe);
-        _graphics_pipeline = pipeline_t{ _ctx->device(), raw_pipe };
+        vkCreateGraphicsPipelines(_ctx->device(), _ctx->pipeline_cache(), 1, &pipe_info, nullptr, &raw_pipe);
+
+        vkDestroyShaderModule(_ctx->device(), vert.module, nullptr);
+        vkDestroyShaderModule(_ctx->device(), frag.module, nullptr);
 
-        vkDestroyShaderModule(_ctx->device(), vert_module, nullptr);
-        vkDestroyShaderModule(_ctx->device(), frag_module, nullptr);
+        return raw_pipe;
     }
     void vulkan_renderer_t::destroy_pipeline()
     {
-        _graphics_pipeline = {};
-        _pipeline_layout = {};
-        _render_pass = {};
+        _pipeline_variants.shutdown();
+        _pipeline_layout = { }; // owned by the layout cache
     }
-    void vulkan_renderer_t::recreate_swapchain_dependent_resources()
+    void vulkan_renderer_t::rebuild_pipeline()
+    {
+        destroy_pipeline();
+        create_pipeline();
+    }
+    void vulkan_renderer_t::create_frame_resources()
     {
-        vkDeviceWaitIdle(_ctx->device());
-
-        // Framebuffers: auto-cleaned by RAII destructor
-        _swapchain_framebuffers = framebuffer_array_t{ _ctx->device() };
-        _swapchain_framebuffers.resize(_ctx->image_count());
-
-        for (uint32_t i = 0; i < _ctx->image_count(); ++i)
-        {
-            VkFramebufferCreateInfo fb_info{ };
-            fb_info.sType = VK_STRUCTURE_TYPE_FRAMEBUFFER_CREATE_INFO;
-            fb_info.renderPass = _render_pass.pass;
-            fb_info.attachmentCount = 1;
-            fb_info.pAttachments = &_ctx->swapchain_views()[i];
-            fb_info.width = _ctx->swapchain_extent().width;
-            fb_info.height = _ctx->swapchain_extent().height;
-            fb_info.layers = 1;
-
-            const VkResult result{ vkCreateFramebuffer(_ctx->device(), &fb_info, nullptr, &_swapchain_framebuffers[i]) };
-            // TODO: proper error checking
-            CE_ASSERT(result == VK_SUCCESS, "Failed to create framebuffer");
-        }
-
-        // Destroy old per-frame sync objects
-        for (auto& frame : _frames)
-        {
-            if (frame.image_available != VK_NULL_HANDLE) vkDestroySemaphore(_ctx->device(), frame.image_available, nullptr);
-            if (frame.render_finished != VK_NULL_HANDLE) vkDestroySemaphore(_ctx->device(), frame.render_finished, nullptr);
-            if (frame.in_flight != VK_NULL_HANDLE) vkDestroyFence(_ctx->device(), frame.in_flight, nullptr);
-
-            frame.image_available = VK_NULL_HANDLE;
-            frame.render_finished = VK_NULL_HANDLE;
-            frame.in_flight = VK_NULL_HANDLE;
-        }
-
-        // Only recreate command buffers — pool stays alive
-        if (!_frames.empty())
-        {
-            vkFreeCommandBuffers(_ctx->device(), _command_pool.pool, static_cast<uint32_t>(_frames.size()),
-                                 &_frames[0].command_buffer);
-        }
-
         VkCommandBufferAllocateInfo alloc_info{ };
         alloc_info.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_ALLOCATE_INFO;
         alloc_info.commandPool = _command_pool.pool;
@@ -404,26 +541,129 @@ namespace carrot::rhi::vulkan {
         std::array<VkCommandBuffer, k_max_frames_in_flight> cmd_buffers{};
         vkAllocateCommandBuffers(_ctx->device(), &alloc_info, cmd_buffers.data());
 
-        for (uint32_t i{ 0 }; i < k_max_frames_in_flight; ++i)
-        {
-            _frames[i].command_buffer = cmd_buffers[i];
-        }
-
-        // Recreate sync objects
+        // Created once: only the swapchain-sized resources depend on the window, so resizing keeps these
         VkSemaphoreCreateInfo sem_info{ };
         sem_info.sType = VK_STRUCTURE_TYPE_SEMAPHORE_CREATE_INFO;
 
-        VkFenceCreateInfo fence_info{ };
-        fence_info.sType = VK_STRUCTURE_TYPE_FENCE_CREATE_INFO;
-        fence_info.flags = VK_FENCE_CREATE_SIGNALED_BIT;
-
-        for (auto& frame : _frames)
+        for (uint32_t i{ 0 }; i < k_max_frames_in_flight; ++i)
         {
+            frame_resources_t& frame{ _frames[i] };
+            frame.command_buffer = cmd_buffers[i];
             vkCreateSemaphore(_ctx->device(), &sem_info, nullptr, &frame.image_available);
             vkCreateSemaphore(_ctx->device(), &sem_info, nullptr, &frame.render_finished);
-            vkCreateFence(_ctx->device(), &fence_info, nullptr, &frame.in_flight);
+            frame.timeline_value = 0;
         }
     }
+    void vulkan_renderer_t::create_scene()
+    {
+        _scene.init(*_ctx);
+        register_pipeline({ "cull.comp.spv" }, pipeline_rebuild_delegate_t::bind<&gpu_scene_t::rebuild_pipeline>(&_scene));
+
+        constexpr scene_vertex_t triangle[]{
+            { { 0.0f, -0.8f, 0.0f }, { 1.0f, 0.5f, 0.0f } }, // carrot orange
+            { { -0.7f, 0.7f, 0.0f }, { 1.0f, 0.6f, 0.2f } },
+            { { 0.7f, 0.7f, 0.0f }, { 1.0f, 0.7f, 0.3f } },
+        };
+        constexpr uint32_t triangle_indices[]{ 0, 1, 2 };
+
+        _triangle_mesh = _scene.add_mesh(triangle, triangle_indices);
+        if (!_triangle_mesh.is_valid()) return;
+
+        gpu_instance_t instance{ };
+        instance.mesh = _triangle_mesh.index;
+        static_cast<void>(_scene.add_instance(instance));
+    }
+    void vulkan_renderer_t::set_viewport_and_scissor(VkCommandBuffer cmd) const noexcept
+    {
+        const VkViewport viewport{
+            0.f, 0.f,
+            static_cast<float>(_ctx->swapchain_extent().width),
+            static_cast<float>(_ctx->swapchain_extent().height), 0.f, 1.f
+        };
+        vkCmdSetViewport(cmd, 0, 1, &viewport);
+
+        const VkRect2D scissor{ { 0, 0 }, _ctx->swapchain_extent() };
+        vkCmdSetScissor(cmd, 0, 1, &scissor);
+    }
+    void vulkan_renderer_t::record_main_pass(VkCommandBuffer cmd)
+    {
+        // The graph already moved the backbuffer into COLOR_ATTACHMENT_OPTIMAL
+        VkRenderingAttachmentInfo color{ };
+        color.sType = VK_STRUCTURE_TYPE_RENDERING_ATTACHMENT_INFO;
+        color.imageView = _graph.view(_backbuffer);
+        color.imageLayout = VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL;
+        color.loadOp = VK_ATTACHMENT_LOAD_OP_CLEAR;
+        color.storeOp = VK_ATTACHMENT_STORE_OP_STORE;
+        color.clearValue = { { { 0.15f, 0.05f, 0.0f, 1.0f } } };
+
+        // The contents are secondaries recorded in parallel, the primary only begins and ends rendering
+        VkRenderingInfo rendering{ };
+        rendering.sType = VK_STRUCTURE_TYPE_RENDERING_INFO;
+        rendering.flags = VK_RENDERING_CONTENTS_SECONDARY_COMMAND_BUFFERS_BIT;
+        rendering.renderArea.extent = _ctx->swapchain_extent();
+        rendering.layerCount = 1;
+        rendering.colorAttachmentCount = 1;
+        rendering.pColorAttachments = &color;
+        vkCmdBeginRendering(cmd, &rendering);
+
+        const VkFormat color_format{ _ctx->swapchain_format() };
+        VkCommandBufferInheritanceRenderingInfo inheritance{ };
+        inheritance.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_INHERITANCE_RENDERING_INFO;
+        inheritance.colorAttachmentCount = 1;
+        inheritance.pColorAttachmentFormats = &color_format;
+        inheritance.rasterizationSamples = VK_SAMPLE_COUNT_1_BIT;
+        _recorder.begin_rendering(inheritance);
+
+        // Jobs execute in the order they are added, whichever thread recorded them
+        _recorder.add(record_delegate_t::bind<&vulkan_renderer_t::record_scene>(this));
+        _recorder.add(record_delegate_t::bind<&vulkan_renderer_t::record_sprites>(this));
+
+        // Debug overlay — always last in the render pass
+        // ← ONLY RENDER DEBUG OVERLAY AFTER IT'S INITIALIZED
+        if (debug::is_initialized()) _recorder.add(record_delegate_t::bind<&vulkan_renderer_t::record_overlay>(this));
+
+        _recorder.execute(cmd);
+
+        vkCmdEndRendering(cmd);
+    }
+    void vulkan_renderer_t::record_scene(VkCommandBuffer cmd)
+    {
+        // Null when the scene shaders failed to load; the scene is skipped rather than drawn with no pipeline
+        const VkPipeline pipeline{ _pipeline_variants.get(_variant_key) };
+        if (pipeline == VK_NULL_HANDLE) return;
+
+        vkCmdBindPipeline(cmd, VK_PIPELINE_BIND_POINT_GRAPHICS, pipeline);
+        set_viewport_and_scissor(cmd);
+
+        scene_push_t push{ };
+        std::copy_n(_scene.view_projection(), 16, push.view_projection);
+        push.frame_count = _frame_counter;
+        push.instance_buffer = _scene.instance_buffer_index();
+        vkCmdPushConstants(cmd, _pipeline_layout.pipeline_layout,
+                           _pipeline_layout.push_range.stageFlags, 0, sizeof(push), &push);
+
+        _scene.draw(cmd, _pipeline_layout.pipeline_layout);
+    }
+    void vulkan_renderer_t::record_sprites(VkCommandBuffer cmd)
+    {
+        set_viewport_and_scissor(cmd);
+        _sprites.record(cmd, _current_frame, _ctx->swapchain_extent());
+    }
+    void vulkan_renderer_t::record_overlay(VkCommandBuffer cmd)
+    {
+        // Secondaries inherit no dynamic state from the primary or from each other
+        set_viewport_and_scissor(cmd);
+        debug::render(cmd);
+    }
+    void vulkan_renderer_t::recreate_swapchain()
+    {
+        vkDeviceWaitIdle(_ctx->device());
+
+        // Nothing else depends on the swapchain: pipelines only know its format and the render graph picks up
+        // the new extent through its topology hash. Surfaces with a fixed extent override the window's size.
+        _window_extent = { window::width(), window::height() };
+        _ctx->create_swapchain(_window_extent.width, _window_extent.height);
+    }
 } // namespace carrot::rhi::vulkan
 
 namespace carrot::renderer {
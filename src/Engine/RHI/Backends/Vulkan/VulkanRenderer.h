@@ -6,23 +6,48 @@
 #pragma once
 
 #include "Renderer/Renderer.h"
+#include "VulkanCommandRecorder.h"
 #include "VulkanCommon.h"
 #include "VulkanCore.h"
+#include "VulkanFrameCapture.h"
+#include "VulkanGpuScene.h"
+#include "VulkanGpuTimer.h"
+#include "VulkanLayoutCache.h"
+#include "VulkanRenderGraph.h"
+#include "VulkanShaderVariants.h"
+#include "VulkanSpriteBatcher.h"
+#include "Utils/MulticastDelegate.h"
+
+#include <initializer_list>
+#include <string_view>
 
 namespace carrot::rhi::vulkan {
     class vulkan_context_t;
 
+    using pipeline_rebuild_delegate_t = utils::single_delegate_t<void()>;
+
     class vulkan_renderer_t : public renderer::renderer_t
     {
     public:
-        void init() override;
+        void init(const renderer::renderer_config_t& config) override;
         void shutdown() override;
 
         void begin_frame() override;
-        void render_frame() override; // temporary triangle, will be replaced later
+        void render_frame() override;
         void end_frame() override;
 
         void reload_pipeline() override;
+        void reload_shaders(const std::vector<std::string>& spv_paths) override;
+
+        renderer::sprite_atlas_id_t create_sprite_atlas(uint32_t width, uint32_t height,
+                                                        std::span<const void* const> layers) override;
+        void draw_sprites(std::span<const renderer::sprite_t> sprites, renderer::sprite_atlas_id_t atlas,
+                          renderer::sprite_blend blend) override;
+        uint32_t add_triangles(std::span<const renderer::triangle_instance_t> instances) override;
+
+        // Ties a pipeline to the SPIR-V modules it is built from, so hot-reload only rebuilds what changed
+        void register_pipeline(std::initializer_list<std::string_view> spv_modules,
+                               const pipeline_rebuild_delegate_t& rebuild);
 
         [[nodiscard]] VkCommandBuffer get_current_command_buffer() const noexcept
         {
@@ -31,21 +56,47 @@ namespace carrot::rhi::vulkan {
 
     private:
         void create_pipeline();
+        [[nodiscard]] VkPipeline create_pipeline_variant(renderer::shader_variant_key_t key) const;
         void destroy_pipeline();
-        void recreate_swapchain_dependent_resources();
+        void rebuild_pipeline();
+        void create_frame_resources();
+        void create_scene();
+        void set_viewport_and_scissor(VkCommandBuffer cmd) const noexcept;
+
+        // Render graph pass, records on the frame's primary command buffer
+        void record_main_pass(VkCommandBuffer cmd);
+        // Recording jobs, run on the command recorder's threads
+        void record_scene(VkCommandBuffer cmd);
+        void record_sprites(VkCommandBuffer cmd);
+        void record_overlay(VkCommandBuffer cmd);
+        void recreate_swapchain();
 
         vulkan_context_t* _ctx{ nullptr };
 
-        pipeline_t _graphics_pipeline;
-        pipeline_layout_t _pipeline_layout;
-        render_pass_t _render_pass;
-        command_pool_t _command_pool;
+        pipeline_variant_cache_t _pipeline_variants;
+        renderer::shader_variant_key_t _variant_key{ renderer::variant_key({ renderer::shader_keyword::spin }) };
+        reflected_layout_t _pipeline_layout;
+        vertex_input_layout_t _vertex_input;
+        command_pool_t _command_pool; // primaries only, pass contents come from the recorder
+        command_recorder_t _recorder;
+        render_graph_t _graph;
+        rg_resource_t _backbuffer;
+        gpu_scene_t _scene;
+        scene_mesh_t _triangle_mesh;
+        sprite_batcher_t _sprites;
+        frame_capture_t _capture;
+        gpu_timer_t _gpu_timer;
 
-        framebuffer_array_t _swapchain_framebuffers;
         frame_data_t _frames;
 
         uint32_t _current_frame{ 0 };
         uint32_t _frame_counter{ 0 };
         uint32_t _current_image_index{ 0 };
+        bool _frame_active{ false };    // false when acquire failed and the frame is skipped
+        bool _needs_recreate{ false };  // swapchain reported suboptimal, recreate once the frame is presented
+        VkExtent2D _window_extent{ };   // window size the swapchain was last created for
+
+        graphics_vector_t<pipeline_rebuild_delegate_t>              _pipeline_rebuilds;
+        graphics_string_map_t<graphics_vector_t<uint32_t>>          _module_users; // spv file name → pipelines
     };
 } // namespace carrot::rhi::vulkan
@@ -0,0 +1,132 @@
+//
+// Created by zshrout on 10/18/26.
+// Copyright (c) 2026 BunnySofty. All rights reserved.
+//
+
+#include "VulkanShaderVariants.h"
+
+#include "Utils/ShaderUtils.h"
+
+#include <chrono>
+#include <filesystem>
+
+namespace carrot::rhi::vulkan {
+    namespace {
+        // A baked variant is only trusted while it is at least as new as its base module, hot-reload
+        // recompiles the base module but never the baked ones
+        bool is_baked_variant_current(const std::string& base_spv_path, const std::string& variant_path)
+        {
+            std::error_code ec;
+            const auto variant_time{ std::filesystem::last_write_time(variant_path, ec) };
+            if (ec) return false;
+
+            const auto base_time{ std::filesystem::last_write_time(base_spv_path, ec) };
+            return ec || variant_time >= base_time;
+        }
+
+        VkShaderModule create_module(VkDevice device, const spv_blob_t& spv)
+        {
+            if (spv.empty()) return VK_NULL_HANDLE;
+
+            VkShaderModuleCreateInfo mod_info{ };
+            mod_info.sType = VK_STRUCTURE_TYPE_SHADER_MODULE_CREATE_INFO;
+            mod_info.codeSize = spv.size_bytes();
+            mod_info.pCode = spv.data();
+
+            VkShaderModule module{ VK_NULL_HANDLE };
+            vkCreateShaderModule(device, &mod_info, nullptr, &module);
+            return module;
+        }
+    } // anonymous namespace
+
+    specialization_t::specialization_t(const renderer::shader_variant_key_t key) noexcept
+    {
+        for (uint32_t i{ 0 }; i < renderer::k_shader_keyword_count; ++i)
+        {
+            entries[i] = { i, static_cast<uint32_t>(i * sizeof(VkBool32)), sizeof(VkBool32) };
+            values[i] = (key & 1u << i) ? VK_TRUE : VK_FALSE;
+        }
+
+        info.mapEntryCount = renderer::k_shader_keyword_count;
+        info.pMapEntries = entries.data();
+        info.dataSize = sizeof(values);
+        info.pData = values.data();
+    }
+
+    variant_stage_t create_variant_module(VkDevice device, const std::string& base_spv_path,
+                                          const renderer::shader_variant_key_t key)
+    {
+        if (key != renderer::k_base_variant)
+        {
+            const std::string variant_path{ renderer::variant_spv_path(base_spv_path, key) };
+            // Archived variants were baked from the archived base, so they match as long as neither was hot-reloaded
+            const bool archived{ is_archived_spv(base_spv_path) && is_archived_spv(variant_path) };
+            if (archived || is_baked_variant_current(base_spv_path, variant_path))
+            {
+                if (VkShaderModule module{ create_module(device, load_spv(variant_path)) })
+                    return { module, true };
+            }
+        }
+
+        return { create_module(device, load_spv(base_spv_path)), false };
+    }
+
+    // ── pipeline_variant_cache_t ────────────────────────────────
+    // PUBLIC
+    void pipeline_variant_cache_t::init(VkDevice device, builder_t builder)
+    {
+        _device = device;
+        _builder = std::move(builder);
+    }
+
+    void pipeline_variant_cache_t::shutdown()
+    {
+        std::lock_guard<std::mutex> lock{ _mutex };
+
+        // get() waits for builds that are still running on worker threads
+        for (auto& [key, variant]: _variants)
+            if (const VkPipeline pipeline{ variant.get() }) vkDestroyPipeline(_device, pipeline, nullptr);
+
+        _variants.clear();
+        _builder = nullptr; // built for the shaders being replaced
+    }
+
+    void pipeline_variant_cache_t::prewarm(const std::initializer_list<renderer::shader_variant_key_t> keys)
+    {
+        for (const renderer::shader_variant_key_t key: keys)
+            (void)request(key);
+    }
+
+    VkPipeline pipeline_variant_cache_t::get(const renderer::shader_variant_key_t key)
+    {
+        return request(key).get();
+    }
+
+    VkPipeline pipeline_variant_cache_t::try_get(const renderer::shader_variant_key_t key)
+    {
+        const std::shared_future<VkPipeline> variant{ request(key) };
+        return variant.wait_for(std::chrono::seconds{ 0 }) == std::future_status::ready ? variant.get() : VK_NULL_HANDLE;
+    }
+
+    // PRIVATE
+    std::shared_future<VkPipeline> pipeline_variant_cache_t::request(const renderer::shader_variant_key_t key)
+    {
+        std::lock_guard<std::mutex> lock{ _mutex };
+
+        if (const auto it{ _variants.find(key) }; it != _variants.end()) return it->second;
+
+        // No builder when the pipeline's shaders failed to reflect. The null result is cached so it is reported
+        // once; shutdown() drops it along with the rest
+        if (!_builder)
+        {
+            LOG_GRAPHICS_ERROR("[Vulkan] No pipeline builder for variant {:#x}", key);
+            std::promise<VkPipeline> missing;
+            missing.set_value(VK_NULL_HANDLE);
+            return _variants.emplace(key, missing.get_future().share()).first->second;
+        }
+
+        std::shared_future<VkPipeline> variant{ std::async(std::launch::async, _builder, key).share() };
+        _variants.emplace(key, variant);
+        return variant;
+    }
+} // namespace carrot::rhi::vulkan
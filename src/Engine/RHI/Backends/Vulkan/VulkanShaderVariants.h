@@ -0,0 +1,74 @@
+//
+// Created by zshrout on 10/18/26.
+// Copyright (c) 2026 BunnySofty. All rights reserved.
+//
+
+#pragma once
+
+#include "VulkanCommon.h"
+#include "Renderer/ShaderVariant.h"
+
+#include <array>
+#include <functional>
+#include <future>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+
+namespace carrot::rhi::vulkan {
+    // Specialization data covering every engine keyword; constant ids a shader does not declare are ignored
+    struct specialization_t
+    {
+        std::array<VkSpecializationMapEntry, renderer::k_shader_keyword_count> entries{ };
+        std::array<VkBool32, renderer::k_shader_keyword_count> values{ };
+        VkSpecializationInfo info{ };
+
+        explicit specialization_t(renderer::shader_variant_key_t key) noexcept;
+
+        // info points into this object
+        DISABLE_COPY_AND_MOVE(specialization_t)
+    };
+
+    // A stage resolved for one variant: the build-time baked module when an up-to-date one exists (already
+    // specialized, so no specialization info is needed), otherwise the base module
+    struct variant_stage_t
+    {
+        VkShaderModule module{ VK_NULL_HANDLE };
+        bool baked{ false };
+    };
+
+    [[nodiscard]] variant_stage_t create_variant_module(VkDevice device, const std::string& base_spv_path,
+                                                        renderer::shader_variant_key_t key);
+
+    // Lazily builds pipeline variants on worker threads. All builds share the context's VkPipelineCache,
+    // which is internally synchronized, so independent variants compile in parallel.
+    class pipeline_variant_cache_t
+    {
+    public:
+        using builder_t = std::function<VkPipeline(renderer::shader_variant_key_t key)>;
+
+        pipeline_variant_cache_t() = default;
+        ~pipeline_variant_cache_t() { shutdown(); }
+
+        DISABLE_COPY_AND_MOVE(pipeline_variant_cache_t)
+
+        void init(VkDevice device, builder_t builder);
+        void shutdown();
+
+        // Kick off builds without waiting on them
+        void prewarm(std::initializer_list<renderer::shader_variant_key_t> keys);
+
+        // Blocks until the variant exists, building it now if nobody asked for it before
+        [[nodiscard]] VkPipeline get(renderer::shader_variant_key_t key);
+        // Never blocks, returns VK_NULL_HANDLE while the variant is still compiling
+        [[nodiscard]] VkPipeline try_get(renderer::shader_variant_key_t key);
+
+    private:
+        std::shared_future<VkPipeline> request(renderer::shader_variant_key_t key);
+
+        VkDevice                                                                    _device{ VK_NULL_HANDLE };
+        builder_t                                                                   _builder;
+        std::unordered_map<renderer::shader_variant_key_t, std::shared_future<VkPipeline>> _variants;
+        std::mutex                                                                  _mutex;
+    };
+} // namespace carrot::rhi::vulkan
@@ -0,0 +1,541 @@
+//
+// Created by zshrout on 10/18/26.
+// Copyright (c) 2026 BunnySofty. All rights reserved.
+//
+
+#include "VulkanSpriteBatcher.h"
+
+#include "VulkanContext.h"
+#include "Core/Profiler.h"
+#include "Renderer/ShaderReflection.h"
+#include "Utils/ShaderUtils.h"
+#include "Common/CommonHeaders.h"
+
+#include <algorithm>
+#include <bit>
+#include <cstring>
+#include <numeric>
+#include <utility>
+
+namespace carrot::rhi::vulkan {
+    namespace {
+        constexpr uint32_t k_min_sprite_capacity{ 4096 };
+        constexpr uint32_t k_max_sprite_atlases{ 1u << 14 }; // atlas bits of the sort key
+
+        // Word offsets of each stream inside a frame buffer, in multiples of its capacity; mirrors sprite.vert
+        constexpr uint32_t k_position_stream{ 0 };
+        constexpr uint32_t k_rotation_stream{ 2 };
+        constexpr uint32_t k_size_stream{ 3 };
+        constexpr uint32_t k_uv_stream{ 5 };
+        constexpr uint32_t k_color_stream{ 7 };
+        constexpr uint32_t k_layer_stream{ 8 };
+        constexpr uint32_t k_stream_words{ 9 };
+
+        // Matches the Push block in sprite.vert / sprite.frag
+        struct sprite_push_t
+        {
+            float       view_scale[2];  // 2 / extent, pixels to NDC
+            uint32_t    streams;
+            uint32_t    capacity;
+            uint32_t    texture_array;
+            uint32_t    sampler;
+        };
+        static_assert(sizeof(sprite_push_t) <= 128, "Push constants beyond the guaranteed minimum");
+
+        // Draw order first, then everything that would need a pipeline or push constant change
+        [[nodiscard]] uint32_t sort_key(const int16_t order, const renderer::sprite_blend blend,
+                                        const uint32_t atlas) noexcept
+        {
+            return (static_cast<uint32_t>(order + 32768) << 16) | (static_cast<uint32_t>(blend) << 14) | atlas;
+        }
+
+        [[nodiscard]] uint32_t pack_unorm16(const float x, const float y) noexcept
+        {
+            const auto unorm = [](const float v) {
+                return static_cast<uint32_t>(std::clamp(v, 0.0f, 1.0f) * 65535.0f + 0.5f);
+            };
+            return unorm(x) | (unorm(y) << 16);
+        }
+
+        template<typename T>
+        void gather(uint32_t* destination, const graphics_vector_t<T>& source, const std::span<const uint32_t> order,
+                    const uint32_t stride)
+        {
+            static_assert(sizeof(T) == sizeof(uint32_t));
+
+            if (order.empty())
+            {
+                std::memcpy(destination, source.data(), source.size() * sizeof(T));
+                return;
+            }
+
+            for (const uint32_t index: order)
+            {
+                std::memcpy(destination, source.data() + index * stride, stride * sizeof(T));
+                destination += stride;
+            }
+        }
+    } // anonymous namespace
+
+    // PUBLIC
+    void sprite_batcher_t::init(vulkan_context_t& ctx)
+    {
+        _ctx = &ctx;
+
+        VkSamplerCreateInfo sampler_info{ };
+        sampler_info.sType = VK_STRUCTURE_TYPE_SAMPLER_CREATE_INFO;
+        sampler_info.magFilter = VK_FILTER_LINEAR;
+        sampler_info.minFilter = VK_FILTER_LINEAR;
+        sampler_info.mipmapMode = VK_SAMPLER_MIPMAP_MODE_NEAREST;
+        sampler_info.addressModeU = VK_SAMPLER_ADDRESS_MODE_CLAMP_TO_EDGE;
+        sampler_info.addressModeV = VK_SAMPLER_ADDRESS_MODE_CLAMP_TO_EDGE;
+        sampler_info.addressModeW = VK_SAMPLER_ADDRESS_MODE_CLAMP_TO_EDGE;
+        vkCreateSampler(_ctx->device(), &sampler_info, nullptr, &_sampler);
+        _sampler_handle = _ctx->bindless().add_sampler(_sampler);
+
+        create_pipelines();
+    }
+
+    void sprite_batcher_t::shutdown()
+    {
+        if (_ctx == nullptr) return;
+
+        destroy_pipelines();
+        _layout = { }; // owned by the layout cache
+
+        bindless_heap_t& heap{ _ctx->bindless() };
+        for (frame_buffer_t& frame: _frames)
+        {
+            heap.release(frame.handle);
+            if (frame.buffer != VK_NULL_HANDLE) _ctx->destroy_buffer(frame.buffer, frame.allocation);
+            frame = { };
+        }
+
+        for (atlas_t& atlas: _atlases)
+        {
+            heap.release(atlas.texture);
+            vkDestroyImageView(_ctx->device(), atlas.view, nullptr);
+            _ctx->allocator().destroy_image(atlas.image, atlas.allocation);
+        }
+        _atlases.clear();
+
+        heap.release(_sampler_handle);
+        vkDestroySampler(_ctx->device(), _sampler, nullptr);
+        _sampler = VK_NULL_HANDLE;
+        _sampler_handle = { };
+
+        clear();
+        _ctx = nullptr;
+    }
+
+    void sprite_batcher_t::rebuild_pipelines()
+    {
+        destroy_pipelines();
+        create_pipelines();
+    }
+
+    renderer::sprite_atlas_id_t sprite_batcher_t::create_atlas(const uint32_t width, const uint32_t height,
+                                                               const std::span<const void* const> layers)
+    {
+        if (layers.empty() || width == 0 || height == 0) return { };
+        if (_atlases.size() >= k_max_sprite_atlases)
+        {
+            LOG_GRAPHICS_ERROR("[Vulkan] Sprite atlas limit ({}) reached", k_max_sprite_atlases);
+            return { };
+        }
+
+        atlas_t atlas{ };
+        atlas.layers = static_cast<uint32_t>(layers.size());
+
+        // ── Create device-local texture array; sprite sheets are authored in sRGB
+        VkImageCreateInfo img_info{ };
+        img_info.sType = VK_STRUCTURE_TYPE_IMAGE_CREATE_INFO;
+        img_info.imageType = VK_IMAGE_TYPE_2D;
+        img_info.format = VK_FORMAT_R8G8B8A8_SRGB;
+        img_info.extent = { width, height, 1 };
+        img_info.mipLevels = 1;
+        img_info.arrayLayers = atlas.layers;
+        img_info.samples = VK_SAMPLE_COUNT_1_BIT;
+        img_info.tiling = VK_IMAGE_TILING_OPTIMAL;
+        img_info.usage = VK_IMAGE_USAGE_SAMPLED_BIT | VK_IMAGE_USAGE_TRANSFER_DST_BIT;
+        img_info.initialLayout = VK_IMAGE_LAYOUT_UNDEFINED;
+        if (!_ctx->allocator().create_image(img_info, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT, atlas.image,
+                                            atlas.allocation))
+        {
+            LOG_GRAPHICS_ERROR("[Vulkan] Failed to create a {}x{}x{} sprite atlas", width, height, atlas.layers);
+            return { };
+        }
+
+        // ── Queue every layer; batches drawing from the atlas are skipped until the last copy has landed
+        image_upload_t upload{ };
+        upload.image = atlas.image;
+        upload.extent = { width, height, 1 };
+        for (uint32_t layer{ 0 }; layer < atlas.layers; ++layer)
+        {
+            upload.subresource.baseArrayLayer = layer;
+            atlas.ticket = _ctx->uploads().upload_image(upload, layers[layer], VkDeviceSize{ width } * height * 4);
+            if (!atlas.ticket.is_valid())
+            {
+                // Kept so earlier layers still in flight are torn down with the rest; an invalid ticket never draws
+                LOG_GRAPHICS_ERROR("[Vulkan] Failed to queue layer {} of a sprite atlas, it will not be drawn", layer);
+                break;
+            }
+        }
+
+        VkImageViewCreateInfo view_info{ };
+        view_info.sType = VK_STRUCTURE_TYPE_IMAGE_VIEW_CREATE_INFO;
+        view_info.image = atlas.image;
+        view_info.viewType = VK_IMAGE_VIEW_TYPE_2D_ARRAY;
+        view_info.format = img_info.format;
+        view_info.subresourceRange.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
+        view_info.subresourceRange.levelCount = 1;
+        view_info.subresourceRange.layerCount = atlas.layers;
+        vkCreateImageView(_ctx->device(), &view_info, nullptr, &atlas.view);
+
+        atlas.texture = _ctx->bindless().add_texture(atlas.view);
+
+        _atlases.push_back(atlas);
+        return { static_cast<uint32_t>(_atlases.size() - 1) };
+    }
+
+    void sprite_batcher_t::submit(const std::span<const renderer::sprite_t> sprites,
+                                  const renderer::sprite_atlas_id_t atlas, const renderer::sprite_blend blend)
+    {
+        if (sprites.empty()) return;
+        CE_ASSERT(atlas.is_valid() && atlas.index < _atlases.size(), "Sprites submitted with an unknown atlas");
+        CE_ASSERT(blend < renderer::sprite_blend::count, "Invalid sprite blend mode");
+
+        const size_t total{ _streams.size() + sprites.size() };
+        _streams.positions.reserve(total * 2);
+        _streams.rotations.reserve(total);
+        _streams.sizes.reserve(total * 2);
+        _streams.uv_rects.reserve(total * 2);
+        _streams.colors.reserve(total);
+        _streams.layers.reserve(total);
+        _streams.keys.reserve(total);
+
+        const uint32_t layer_count{ _atlases[atlas.index].layers };
+        for (const renderer::sprite_t& sprite: sprites)
+        {
+            _streams.positions.insert(_streams.positions.end(), { sprite.position[0], sprite.position[1] });
+            _streams.rotations.push_back(sprite.rotation);
+            _streams.sizes.insert(_streams.sizes.end(), { sprite.size[0], sprite.size[1] });
+            _streams.uv_rects.insert(_streams.uv_rects.end(), { pack_unorm16(sprite.uv_rect[0], sprite.uv_rect[1]),
+                                                                pack_unorm16(sprite.uv_rect[2], sprite.uv_rect[3]) });
+            _streams.colors.push_back(sprite.color);
+            _streams.layers.push_back(std::min<uint32_t>(sprite.layer, layer_count - 1));
+            _streams.keys.push_back(sort_key(sprite.order, blend, atlas.index));
+        }
+    }
+
+    void sprite_batcher_t::clear() noexcept
+    {
+        _streams.clear();
+        _batches.clear();
+    }
+
+    void sprite_batcher_t::record(VkCommandBuffer cmd, const uint32_t frame_index, const VkExtent2D extent)
+    {
+        CE_PROFILE_ZONE("sprite_record");
+
+        _stats = { };
+
+        const uint32_t count{ _streams.size() };
+        frame_buffer_t& frame{ _frames[frame_index] };
+        if (count == 0 || _layout.pipeline_layout == VK_NULL_HANDLE || extent.width == 0 || extent.height == 0 ||
+            !reserve(frame, count))
+        {
+            clear();
+            return;
+        }
+
+        const std::span<const uint32_t> order{ sort() };
+        write_streams(frame, order);
+        build_batches(order);
+
+        _stats.sprite_count = count;
+
+        sprite_push_t push{ };
+        push.view_scale[0] = 2.0f / static_cast<float>(extent.width);
+        push.view_scale[1] = 2.0f / static_cast<float>(extent.height);
+        push.streams = frame.handle.index;
+        push.capacity = frame.capacity;
+        push.sampler = _sampler_handle.index;
+
+        _ctx->bindless().bind(cmd, VK_PIPELINE_BIND_POINT_GRAPHICS, _layout.pipeline_layout);
+
+        const upload_service_t& uploads{ _ctx->uploads() };
+        VkPipeline bound{ VK_NULL_HANDLE };
+        for (const batch_t& batch: _batches)
+        {
+            const atlas_t& atlas{ _atlases[batch.atlas] };
+            const VkPipeline pipeline{ _pipelines[static_cast<size_t>(batch.blend)] };
+            if (pipeline == VK_NULL_HANDLE || !uploads.is_complete(atlas.ticket)) continue;
+
+            if (pipeline != bound)
+            {
+                vkCmdBindPipeline(cmd, VK_PIPELINE_BIND_POINT_GRAPHICS, pipeline);
+                bound = pipeline;
+            }
+
+            push.texture_array = atlas.texture.index;
+            vkCmdPushConstants(cmd, _layout.pipeline_layout, _layout.push_range.stageFlags, 0, sizeof(push), &push);
+
+            // Instance n reads element n of every stream; firstInstance offsets into the sorted streams
+            vkCmdDraw(cmd, 6, batch.count, 0, batch.first);
+            ++_stats.batch_count;
+        }
+
+        clear();
+    }
+
+    // PRIVATE
+    void sprite_batcher_t::streams_t::clear() noexcept
+    {
+        positions.clear();
+        rotations.clear();
+        sizes.clear();
+        uv_rects.clear();
+        colors.clear();
+        layers.clear();
+        keys.clear();
+    }
+
+    void sprite_batcher_t::create_pipelines()
+    {
+        const spv_blob_t vert_spv{ load_spv("shaders/sprite.vert.spv") };
+        const spv_blob_t frag_spv{ load_spv("shaders/sprite.frag.spv") };
+
+        renderer::shader_reflection_t reflection{ };
+        if (!reflect_stages({ vert_spv, frag_spv }, reflection)) return;
+
+        _layout = _ctx->layout_cache().pipeline_layout(reflection);
+        CE_ASSERT(_layout.push_range.size == sizeof(sprite_push_t), "sprite_push_t does not match sprite.vert");
+
+        VkShaderModule vert_mod{ VK_NULL_HANDLE };
+        VkShaderModule frag_mod{ VK_NULL_HANDLE };
+
+        VkShaderModuleCreateInfo mod_info{ };
+        mod_info.sType = VK_STRUCTURE_TYPE_SHADER_MODULE_CREATE_INFO;
+        mod_info.codeSize = vert_spv.size_bytes();
+        mod_info.pCode = vert_spv.data();
+        vkCreateShaderModule(_ctx->device(), &mod_info, nullptr, &vert_mod);
+
+        mod_info.codeSize = frag_spv.size_bytes();
+        mod_info.pCode = frag_spv.data();
+        vkCreateShaderModule(_ctx->device(), &mod_info, nullptr, &frag_mod);
+
+        for (size_t blend{ 0 }; blend < _pipelines.size(); ++blend)
+            _pipelines[blend] = create_pipeline(static_cast<renderer::sprite_blend>(blend), vert_mod, frag_mod);
+
+        vkDestroyShaderModule(_ctx->device(), vert_mod, nullptr);
+        vkDestroyShaderModule(_ctx->device(), frag_mod, nullptr);
+    }
+
+    void sprite_batcher_t::destroy_pipelines() noexcept
+    {
+        for (VkPipeline& pipeline: _pipelines)
+        {
+            vkDestroyPipeline(_ctx->device(), pipeline, nullptr);
+            pipeline = VK_NULL_HANDLE;
+        }
+    }
+
+    VkPipeline sprite_batcher_t::create_pipeline(const renderer::sprite_blend blend, VkShaderModule vert,
+                                                 VkShaderModule frag) const
+    {
+        VkPipelineShaderStageCreateInfo stages[2]{
+            {
+                VK_STRUCTURE_TYPE_PIPELINE_SHADER_STAGE_CREATE_INFO, nullptr, 0, VK_SHADER_STAGE_VERTEX_BIT,
+                vert, "main", nullptr
+            },
+            {
+                VK_STRUCTURE_TYPE_PIPELINE_SHADER_STAGE_CREATE_INFO, nullptr, 0, VK_SHADER_STAGE_FRAGMENT_BIT,
+                frag, "main", nullptr
+            }
+        };
+
+        // Quads are expanded from gl_VertexIndex and the streams are pulled, there is no vertex input
+        VkPipelineVertexInputStateCreateInfo vertex_input{ };
+        vertex_input.sType = VK_STRUCTURE_TYPE_PIPELINE_VERTEX_INPUT_STATE_CREATE_INFO;
+
+        VkPipelineInputAssemblyStateCreateInfo ia{ };
+        ia.sType = VK_STRUCTURE_TYPE_PIPELINE_INPUT_ASSEMBLY_STATE_CREATE_INFO;
+        ia.topology = VK_PRIMITIVE_TOPOLOGY_TRIANGLE_LIST;
+
+        VkPipelineViewportStateCreateInfo vp{ };
+        vp.sType = VK_STRUCTURE_TYPE_PIPELINE_VIEWPORT_STATE_CREATE_INFO;
+        vp.viewportCount = vp.scissorCount = 1;
+
+        VkPipelineRasterizationStateCreateInfo rs{ };
+        rs.sType = VK_STRUCTURE_TYPE_PIPELINE_RASTERIZATION_STATE_CREATE_INFO;
+        rs.lineWidth = 1.0f;
+        rs.cullMode = VK_CULL_MODE_NONE; // negative sizes mirror a sprite
+        rs.frontFace = VK_FRONT_FACE_COUNTER_CLOCKWISE;
+
+        VkPipelineMultisampleStateCreateInfo ms{ };
+        ms.sType = VK_STRUCTURE_TYPE_PIPELINE_MULTISAMPLE_STATE_CREATE_INFO;
+        ms.rasterizationSamples = VK_SAMPLE_COUNT_1_BIT;
+
+        VkPipelineColorBlendAttachmentState attachment{ };
+        attachment.colorWriteMask = 0xF;
+        attachment.colorBlendOp = VK_BLEND_OP_ADD;
+        attachment.alphaBlendOp = VK_BLEND_OP_ADD;
+        switch (blend)
+        {
+            case renderer::sprite_blend::alpha:
+                attachment.blendEnable = VK_TRUE;
+                attachment.srcColorBlendFactor = VK_BLEND_FACTOR_SRC_ALPHA;
+                attachment.dstColorBlendFactor = VK_BLEND_FACTOR_ONE_MINUS_SRC_ALPHA;
+                attachment.srcAlphaBlendFactor = VK_BLEND_FACTOR_ONE;
+                attachment.dstAlphaBlendFactor = VK_BLEND_FACTOR_ONE_MINUS_SRC_ALPHA;
+                break;
+            case renderer::sprite_blend::additive:
+                attachment.blendEnable = VK_TRUE;
+                attachment.srcColorBlendFactor = VK_BLEND_FACTOR_SRC_ALPHA;
+                attachment.dstColorBlendFactor = VK_BLEND_FACTOR_ONE;
+                attachment.srcAlphaBlendFactor = VK_BLEND_FACTOR_ZERO;
+                attachment.dstAlphaBlendFactor = VK_BLEND_FACTOR_ONE;
+                break;
+            default:
+                attachment.blendEnable = VK_FALSE;
+                break;
+        }
+
+        VkPipelineColorBlendStateCreateInfo cb{ };
+        cb.sType = VK_STRUCTURE_TYPE_PIPELINE_COLOR_BLEND_STATE_CREATE_INFO;
+        cb.attachmentCount = 1;
+        cb.pAttachments = &attachment;
+
+        VkDynamicState dyn[]{ VK_DYNAMIC_STATE_VIEWPORT, VK_DYNAMIC_STATE_SCISSOR };
+        VkPipelineDynamicStateCreateInfo dynamic{ };
+        dynamic.sType = VK_STRUCTURE_TYPE_PIPELINE_DYNAMIC_STATE_CREATE_INFO;
+        dynamic.dynamicStateCount = 2;
+        dynamic.pDynamicStates = dyn;
+
+        const VkFormat color_format{ _ctx->swapchain_format() };
+        VkPipelineRenderingCreateInfo rendering{ };
+        rendering.sType = VK_STRUCTURE_TYPE_PIPELINE_RENDERING_CREATE_INFO;
+        rendering.colorAttachmentCount = 1;
+        rendering.pColorAttachmentFormats = &color_format;
+
+        VkGraphicsPipelineCreateInfo pipe{ };
+        pipe.sType = VK_STRUCTURE_TYPE_GRAPHICS_PIPELINE_CREATE_INFO;
+        pipe.pNext = &rendering;
+        pipe.stageCount = 2;
+        pipe.pStages = stages;
+        pipe.pVertexInputState = &vertex_input;
+        pipe.pInputAssemblyState = &ia;
+        pipe.pViewportState = &vp;
+        pipe.pRasterizationState = &rs;
+        pipe.pMultisampleState = &ms;
+        pipe.pColorBlendState = &cb;
+        pipe.pDynamicState = &dynamic;
+        pipe.layout = _layout.pipeline_layout;
+
+        VkPipeline pipeline{ VK_NULL_HANDLE };
+        vkCreateGraphicsPipelines(_ctx->device(), _ctx->pipeline_cache(), 1, &pipe, nullptr, &pipeline);
+        return pipeline;
+    }
+
+    bool sprite_batcher_t::reserve(frame_buffer_t& frame, const uint32_t sprite_count)
+    {
+        if (sprite_count <= frame.capacity) return true;
+
+        // The slot's previous frame has completed, so its buffer can be replaced right away
+        if (frame.buffer != VK_NULL_HANDLE) _ctx->destroy_buffer(frame.buffer, frame.allocation);
+        frame.capacity = 0;
+
+        const uint32_t capacity{ std::max(k_min_sprite_capacity, std::bit_ceil(sprite_count)) };
+        const VkDeviceSize size{ VkDeviceSize{ capacity } * k_stream_words * sizeof(uint32_t) };
+        if (!_ctx->create_buffer(size, VK_BUFFER_USAGE_STORAGE_BUFFER_BIT,
+                                 VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT,
+                                 frame.buffer, frame.allocation))
+        {
+            LOG_GRAPHICS_ERROR("[Vulkan] Failed to create a sprite buffer for {} sprites", capacity);
+            return false;
+        }
+
+        bindless_heap_t& heap{ _ctx->bindless() };
+        if (frame.handle.is_valid())
+            heap.update_storage_buffer(frame.handle, frame.buffer);
+        else
+            frame.handle = heap.add_storage_buffer(frame.buffer);
+
+        frame.capacity = capacity;
+        return frame.handle.is_valid();
+    }
+
+    std::span<const uint32_t> sprite_batcher_t::sort()
+    {
+        const graphics_vector_t<uint32_t>& keys{ _streams.keys };
+        if (std::ranges::is_sorted(keys)) return { }; // submission order already is draw order
+
+        const uint32_t count{ _streams.size() };
+
+        // All four digit histograms in one pass over the keys
+        std::array<std::array<uint32_t, 256>, 4> histograms{ };
+        for (const uint32_t key: keys)
+            for (uint32_t digit{ 0 }; digit < 4; ++digit)
+                ++histograms[digit][(key >> (digit * 8)) & 0xFF];
+
+        _order.resize(count);
+        _scratch.resize(count);
+        std::iota(_order.begin(), _order.end(), 0u);
+
+        // LSD radix sort of indices; stable, so equal keys keep submission order
+        for (uint32_t digit{ 0 }; digit < 4; ++digit)
+        {
+            const uint32_t shift{ digit * 8 };
+            std::array<uint32_t, 256>& offsets{ histograms[digit] };
+
+            // Every key shares this digit, the pass would not move anything
+            if (offsets[(keys[0] >> shift) & 0xFF] == count) continue;
+
+            uint32_t sum{ 0 };
+            for (uint32_t& offset: offsets) sum += std::exchange(offset, sum);
+
+            for (const uint32_t index: _order) _scratch[offsets[(keys[index] >> shift) & 0xFF]++] = index;
+            _order.swap(_scratch);
+        }
+
+        _stats.sorted = true;
+        return _order;
+    }
+
+    void sprite_batcher_t::write_streams(const frame_buffer_t& frame, const std::span<const uint32_t> order) const
+    {
+        // Coherent memory: plain stores are visible to the submission that follows
+        auto* words{ static_cast<uint32_t*>(frame.allocation.mapped) };
+        const uint32_t capacity{ frame.capacity };
+
+        gather(words + k_position_stream * capacity, _streams.positions, order, 2);
+        gather(words + k_rotation_stream * capacity, _streams.rotations, order, 1);
+        gather(words + k_size_stream * capacity, _streams.sizes, order, 2);
+        gather(words + k_uv_stream * capacity, _streams.uv_rects, order, 2);
+        gather(words + k_color_stream * capacity, _streams.colors, order, 1);
+        gather(words + k_layer_stream * capacity, _streams.layers, order, 1);
+    }
+
+    void sprite_batcher_t::build_batches(const std::span<const uint32_t> order)
+    {
+        _batches.clear();
+
+        // Sorted runs of equal blend mode and atlas, whatever their order values, share a draw
+        constexpr uint32_t k_state_mask{ 0xFFFF };
+        uint32_t state{ ~0u };
+        for (uint32_t i{ 0 }; i < _streams.size(); ++i)
+        {
+            const uint32_t key{ _streams.keys[order.empty() ? i : order[i]] };
+            if ((key & k_state_mask) == state)
+            {
+                ++_batches.back().count;
+                continue;
+            }
+
+            state = key & k_state_mask;
+            _batches.push_back({ i, 1, key & (k_max_sprite_atlases - 1),
+                                 static_cast<renderer::sprite_blend>((key >> 14) & 0x3) });
+        }
+    }
+} // namespace carrot::rhi::vulkan
@@ -0,0 +1,124 @@
+//
+// Created by zshrout on 10/18/26.
+// Copyright (c) 2026 BunnySofty. All rights reserved.
+//
+
+#pragma once
+
+#include "VulkanAllocator.h"
+#include "VulkanBindless.h"
+#include "VulkanCommon.h"
+#include "VulkanCore.h"
+#include "VulkanLayoutCache.h"
+#include "VulkanUploadService.h"
+#include "Renderer/Sprite.h"
+
+#include <array>
+#include <span>
+#include <vector>
+
+namespace carrot::rhi::vulkan {
+    class vulkan_context_t;
+
+    struct sprite_stats_t
+    {
+        uint32_t                sprite_count{ 0 };
+        uint32_t                batch_count{ 0 };
+        bool                    sorted{ false };    // false when submission order already was draw order
+    };
+
+    // Instanced 2D sprites. Submissions are appended to structure-of-arrays streams (position, rotation, size,
+    // UV rect, color, layer) that already hold the GPU encoding. At record time sprites are radix-sorted by
+    // (order, blend mode, atlas), the streams are written straight into this frame slot's mapped buffer, and
+    // every run of equal blend mode and atlas becomes one instanced draw. Atlases are texture arrays, so the
+    // layer is per-sprite data and never splits a batch. The vertex shader pulls the streams through the
+    // bindless heap and expands each instance into a quad.
+    class sprite_batcher_t
+    {
+    public:
+        void init(vulkan_context_t& ctx);
+        void shutdown();
+        void rebuild_pipelines();
+
+        [[nodiscard]] renderer::sprite_atlas_id_t create_atlas(uint32_t width, uint32_t height,
+                                                               std::span<const void* const> layers);
+
+        void submit(std::span<const renderer::sprite_t> sprites, renderer::sprite_atlas_id_t atlas,
+                    renderer::sprite_blend blend);
+        // Drops this frame's submissions, e.g. when the frame is skipped
+        void clear() noexcept;
+
+        // Records into a pass rendering to `extent`; the frame slot's previous submission must have completed
+        void record(VkCommandBuffer cmd, uint32_t frame_index, VkExtent2D extent);
+
+        [[nodiscard]] const sprite_stats_t& stats() const noexcept { return _stats; }
+
+    private:
+        struct atlas_t
+        {
+            VkImage                 image{ VK_NULL_HANDLE };
+            VkImageView             view{ VK_NULL_HANDLE };
+            gpu_allocation_t        allocation;
+            texture_handle_t        texture;
+            upload_ticket_t         ticket;
+            uint32_t                layers{ 0 };
+        };
+
+        // GPU encoding, one entry (or pair) per sprite in every stream
+        struct streams_t
+        {
+            graphics_vector_t<float>    positions;  // x, y
+            graphics_vector_t<float>    rotations;
+            graphics_vector_t<float>    sizes;      // w, h
+            graphics_vector_t<uint32_t> uv_rects;   // unorm16 (u0, v0), (u1, v1)
+            graphics_vector_t<uint32_t> colors;
+            graphics_vector_t<uint32_t> layers;
+            graphics_vector_t<uint32_t> keys;       // sort key, CPU only
+
+            void clear() noexcept;
+            [[nodiscard]] uint32_t size() const noexcept { return static_cast<uint32_t>(rotations.size()); }
+        };
+
+        // Persistently mapped, laid out as the streams one after another, each `capacity` sprites long
+        struct frame_buffer_t
+        {
+            VkBuffer                buffer{ VK_NULL_HANDLE };
+            gpu_allocation_t        allocation;
+            storage_buffer_handle_t handle;
+            uint32_t                capacity{ 0 };
+        };
+
+        struct batch_t
+        {
+            uint32_t                first{ 0 };
+            uint32_t                count{ 0 };
+            uint32_t                atlas{ 0 };
+            renderer::sprite_blend  blend{ renderer::sprite_blend::alpha };
+        };
+
+        void create_pipelines();
+        void destroy_pipelines() noexcept;
+        [[nodiscard]] VkPipeline create_pipeline(renderer::sprite_blend blend, VkShaderModule vert,
+                                                 VkShaderModule frag) const;
+        [[nodiscard]] bool reserve(frame_buffer_t& frame, uint32_t sprite_count);
+        [[nodiscard]] std::span<const uint32_t> sort();
+        void write_streams(const frame_buffer_t& frame, std::span<const uint32_t> order) const;
+        void build_batches(std::span<const uint32_t> order);
+
+        vulkan_context_t*           _ctx{ nullptr };
+
+        graphics_vector_t<atlas_t>  _atlases;
+        VkSampler                   _sampler{ VK_NULL_HANDLE };
+        sampler_handle_t            _sampler_handle;
+
+        reflected_layout_t          _layout;
+        std::array<VkPipeline, static_cast<size_t>(renderer::sprite_blend::count)> _pipelines{ };
+
+        std::array<frame_buffer_t, k_max_frames_in_flight> _frames;
+        streams_t                   _streams;
+        graphics_vector_t<uint32_t> _order;     // radix sort ping-pong buffers
+        graphics_vector_t<uint32_t> _scratch;
+        graphics_vector_t<batch_t>  _batches;
+        sprite_stats_t              _stats;
+    };
+} // namespace carrot::rhi::vulkan
@@ -0,0 +1,97 @@
+//
+// Created by zshrout on 10/18/26.
+// Copyright (c) 2026 BunnySofty. All rights reserved.
+//
+
+#include "VulkanTransientRing.h"
+
+#include "VulkanCore.h"
+#include "Common/CommonHeaders.h"
+
+#include <algorithm>
+
+namespace carrot::rhi::vulkan {
+    namespace {
+        // Covers every minUniformBufferOffsetAlignment the spec allows, so each region starts suitably aligned
+        constexpr VkDeviceSize k_region_alignment{ 256 };
+
+        VkDeviceSize align_up(const VkDeviceSize value, const VkDeviceSize alignment) noexcept
+        {
+            return (value + alignment - 1) & ~(alignment - 1);
+        }
+    } // anonymous namespace
+
+    // PUBLIC
+    void transient_ring_t::init(VkPhysicalDevice physical_device, gpu_allocator_t& allocator,
+                                const VkDeviceSize bytes_per_frame)
+    {
+        VkPhysicalDeviceProperties props{ };
+        vkGetPhysicalDeviceProperties(physical_device, &props);
+        _uniform_alignment = std::max<VkDeviceSize>(props.limits.minUniformBufferOffsetAlignment, 16);
+        _storage_alignment = std::max<VkDeviceSize>(props.limits.minStorageBufferOffsetAlignment, 16);
+
+        _allocator = &allocator;
+        _bytes_per_frame = align_up(bytes_per_frame, k_region_alignment);
+
+        VkBufferCreateInfo info{ };
+        info.sType = VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO;
+        info.size = _bytes_per_frame * k_max_frames_in_flight;
+        info.usage = VK_BUFFER_USAGE_VERTEX_BUFFER_BIT | VK_BUFFER_USAGE_INDEX_BUFFER_BIT |
+                     VK_BUFFER_USAGE_UNIFORM_BUFFER_BIT | VK_BUFFER_USAGE_STORAGE_BUFFER_BIT |
+                     VK_BUFFER_USAGE_TRANSFER_SRC_BIT;
+        info.sharingMode = VK_SHARING_MODE_EXCLUSIVE;
+
+        // Coherent so writers never have to flush; the CPU only ever writes sequentially into it
+        if (!_allocator->create_buffer(info, VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT,
+                                       _buffer, _allocation))
+        {
+            LOG_GRAPHICS_ERROR("[Vulkan] Failed to create the {} KiB transient ring", info.size / 1024);
+            _bytes_per_frame = 0;
+            return;
+        }
+
+        _mapped = static_cast<std::byte*>(_allocation.mapped);
+        _frame_base = 0;
+        _head.store(0, std::memory_order_relaxed);
+    }
+
+    void transient_ring_t::shutdown() noexcept
+    {
+        if (_allocator) _allocator->destroy_buffer(_buffer, _allocation);
+
+        _allocator = nullptr;
+        _mapped = nullptr;
+        _bytes_per_frame = 0;
+        _head.store(0, std::memory_order_relaxed);
+    }
+
+    void transient_ring_t::begin_frame(const uint32_t frame_index) noexcept
+    {
+        _peak = std::max(_peak, _head.load(std::memory_order_relaxed));
+        if (_overflowed.exchange(false, std::memory_order_relaxed))
+            LOG_GRAPHICS_WARN("[Vulkan] Transient ring ran out of its {} KiB per frame", _bytes_per_frame / 1024);
+
+        _frame_base = frame_index % k_max_frames_in_flight * _bytes_per_frame;
+        _head.store(0, std::memory_order_relaxed);
+    }
+
+    transient_slice_t transient_ring_t::allocate(const VkDeviceSize size, const VkDeviceSize alignment) noexcept
+    {
+        if (size == 0 || _mapped == nullptr) return { };
+
+        VkDeviceSize head{ _head.load(std::memory_order_relaxed) };
+        VkDeviceSize offset{ 0 };
+        do
+        {
+            offset = align_up(head, alignment);
+            if (offset + size > _bytes_per_frame)
+            {
+                _overflowed.store(true, std::memory_order_relaxed);
+                return { };
+            }
+        }
+        while (!_head.compare_exchange_weak(head, offset + size, std::memory_order_relaxed));
+
+        return { _buffer, _frame_base + offset, size, _mapped + _frame_base + offset };
+    }
+} // namespace carrot::rhi::vulkan
@@ -0,0 +1,78 @@
+//
+// Created by zshrout on 10/18/26.
+// Copyright (c) 2026 BunnySofty. All rights reserved.
+//
+
+#pragma once
+
+#include "VulkanAllocator.h"
+#include "VulkanCommon.h"
+
+#include <atomic>
+#include <cstring>
+#include <span>
+
+namespace carrot::rhi::vulkan {
+    struct transient_slice_t
+    {
+        VkBuffer        buffer{ VK_NULL_HANDLE };
+        VkDeviceSize    offset{ 0 };
+        VkDeviceSize    size{ 0 };
+        void*           data{ nullptr };
+
+        [[nodiscard]] bool is_valid() const noexcept { return buffer != VK_NULL_HANDLE; }
+    };
+
+    // Per-frame scratch memory for data the GPU reads once: vertices, indices, uniforms. One persistently mapped
+    // buffer is split into a region per frame in flight and handed out with an atomic bump pointer. A region is
+    // recycled by begin_frame(), which the renderer calls once the frame timeline reached that slot's value,
+    // so nothing written here may be referenced beyond the frame it was allocated in.
+    class transient_ring_t
+    {
+    public:
+        void init(VkPhysicalDevice physical_device, gpu_allocator_t& allocator, VkDeviceSize bytes_per_frame);
+        void shutdown() noexcept;
+
+        void begin_frame(uint32_t frame_index) noexcept;
+
+        // Thread-safe; `alignment` is a power of two up to 256. Returns an invalid slice when the frame's region
+        // is exhausted
+        [[nodiscard]] transient_slice_t allocate(VkDeviceSize size, VkDeviceSize alignment = 16) noexcept;
+        [[nodiscard]] transient_slice_t allocate_uniform(const VkDeviceSize size) noexcept
+        {
+            return allocate(size, _uniform_alignment);
+        }
+        [[nodiscard]] transient_slice_t allocate_storage(const VkDeviceSize size) noexcept
+        {
+            return allocate(size, _storage_alignment);
+        }
+
+        template<typename T>
+        [[nodiscard]] transient_slice_t push(const std::span<const T> values, const VkDeviceSize alignment = alignof(T)) noexcept
+        {
+            const transient_slice_t slice{ allocate(values.size_bytes(), alignment) };
+            if (slice.is_valid()) std::memcpy(slice.data, values.data(), values.size_bytes());
+            return slice;
+        }
+
+        [[nodiscard]] VkBuffer buffer() const noexcept { return _buffer; }
+        [[nodiscard]] VkDeviceSize bytes_per_frame() const noexcept { return _bytes_per_frame; }
+        [[nodiscard]] VkDeviceSize frame_used() const noexcept { return _head.load(std::memory_order_relaxed); }
+        [[nodiscard]] VkDeviceSize peak_used() const noexcept { return _peak; }
+
+    private:
+        gpu_allocator_t*            _allocator{ nullptr };
+        VkBuffer                    _buffer{ VK_NULL_HANDLE };
+        gpu_allocation_t            _allocation;
+        std::byte*                  _mapped{ nullptr };
+
+        VkDeviceSize                _bytes_per_frame{ 0 };
+        VkDeviceSize                _frame_base{ 0 };
+        VkDeviceSize                _uniform_alignment{ 16 };
+        VkDeviceSize                _storage_alignment{ 16 };
+        VkDeviceSize                _peak{ 0 };
+
+        std::atomic<VkDeviceSize>   _head{ 0 }; // relative to _frame_base
+        std::atomic<bool>           _overflowed{ false };
+    };
+} // namespace carrot::rhi::vulkan
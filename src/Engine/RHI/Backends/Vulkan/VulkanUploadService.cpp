@@ -0,0 +1,386 @@
+//
+// Created by zshrout on 10/18/26.
+// Copyright (c) 2026 BunnySofty. All rights reserved.
+//
+
+#include "VulkanUploadService.h"
+
+#include "Common/CommonHeaders.h"
+
+#include <algorithm>
+#include <cstring>
+
+namespace carrot::rhi::vulkan {
+    namespace {
+        constexpr VkDeviceSize k_staging_chunk_size{ 8 * 1024 * 1024 }; // 8 MiB
+        constexpr uint32_t k_max_free_chunks{ 4 };
+
+        VkDeviceSize align_up(const VkDeviceSize value, const VkDeviceSize alignment) noexcept
+        {
+            return (value + alignment - 1) & ~(alignment - 1);
+        }
+
+        VkCommandPool create_pool(VkDevice device, const uint32_t family)
+        {
+            VkCommandPoolCreateInfo info{ };
+            info.sType = VK_STRUCTURE_TYPE_COMMAND_POOL_CREATE_INFO;
+            info.flags = VK_COMMAND_POOL_CREATE_TRANSIENT_BIT;
+            info.queueFamilyIndex = family;
+
+            VkCommandPool pool{ VK_NULL_HANDLE };
+            vkCreateCommandPool(device, &info, nullptr, &pool);
+            return pool;
+        }
+
+        VkCommandBuffer begin_commands(VkDevice device, VkCommandPool pool)
+        {
+            VkCommandBufferAllocateInfo alloc_info{ };
+            alloc_info.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_ALLOCATE_INFO;
+            alloc_info.commandPool = pool;
+            alloc_info.level = VK_COMMAND_BUFFER_LEVEL_PRIMARY;
+            alloc_info.commandBufferCount = 1;
+
+            VkCommandBuffer cmd{ VK_NULL_HANDLE };
+            vkAllocateCommandBuffers(device, &alloc_info, &cmd);
+
+            VkCommandBufferBeginInfo begin_info{ };
+            begin_info.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO;
+            begin_info.flags = VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT;
+            vkBeginCommandBuffer(cmd, &begin_info);
+            return cmd;
+        }
+    } // anonymous namespace
+
+    // PUBLIC
+    void upload_service_t::init(VkPhysicalDevice physical_device, VkDevice device, gpu_allocator_t& allocator,
+                                const uint32_t transfer_family, VkQueue transfer_queue,
+                                const uint32_t graphics_family, VkQueue graphics_queue)
+    {
+        _device = device;
+        _allocator = &allocator;
+        _transfer_family = transfer_family;
+        _transfer_queue = transfer_queue;
+        _graphics_family = graphics_family;
+        _graphics_queue = graphics_queue;
+
+        // Buffer-to-image copies want texel-size and 4-byte aligned offsets; 16 covers every format we upload
+        VkPhysicalDeviceProperties props{ };
+        vkGetPhysicalDeviceProperties(physical_device, &props);
+        _copy_alignment = std::max<VkDeviceSize>(props.limits.optimalBufferCopyOffsetAlignment, 16);
+
+        _transfer_pool = create_pool(_device, _transfer_family);
+        if (has_dedicated_queue()) _acquire_pool = create_pool(_device, _graphics_family);
+
+        _timeline = timeline_semaphore_t{ _device };
+        if (has_dedicated_queue()) _transfer_timeline = timeline_semaphore_t{ _device };
+
+        LOG_GRAPHICS_INFO("[Vulkan] Uploads use {} (queue family {})",
+                          has_dedicated_queue() ? "a dedicated transfer queue" : "the graphics queue", _transfer_family);
+    }
+
+    void upload_service_t::shutdown()
+    {
+        if (_device == VK_NULL_HANDLE) return;
+
+        std::lock_guard<std::mutex> lock{ _mutex };
+
+        // Work that was queued but never flushed is dropped, its resources are being torn down anyway
+        if (_has_open)
+        {
+            vkEndCommandBuffer(_open.transfer_cmd);
+            release_batch(_open);
+            _has_open = false;
+        }
+
+        // Each acquire waits on its copies, so the last acquire value covers the transfer queue as well
+        _timeline.wait(_timeline.pending);
+        while (!_in_flight.empty())
+        {
+            release_batch(_in_flight.front());
+            _in_flight.pop_front();
+        }
+
+        for (staging_chunk_t& chunk: _free_chunks)
+            destroy_chunk(chunk);
+        _free_chunks.clear();
+
+        _timeline = { };
+        _transfer_timeline = { };
+        vkDestroyCommandPool(_device, _transfer_pool, nullptr);
+        if (_acquire_pool) vkDestroyCommandPool(_device, _acquire_pool, nullptr);
+
+        _transfer_pool = VK_NULL_HANDLE;
+        _acquire_pool = VK_NULL_HANDLE;
+        _device = VK_NULL_HANDLE;
+    }
+
+    upload_ticket_t upload_service_t::upload_buffer(const buffer_upload_t& upload, const void* data,
+                                                    const VkDeviceSize size)
+    {
+        std::lock_guard<std::mutex> lock{ _mutex };
+
+        const staging_t staging{ stage(data, size) };
+        if (staging.buffer == VK_NULL_HANDLE) return { };
+
+        batch_t& batch{ open_batch() };
+
+        const VkBufferCopy region{ staging.offset, upload.offset, size };
+        vkCmdCopyBuffer(batch.transfer_cmd, staging.buffer, upload.buffer, 1, &region);
+
+        VkBufferMemoryBarrier barrier{ };
+        barrier.sType = VK_STRUCTURE_TYPE_BUFFER_MEMORY_BARRIER;
+        barrier.srcAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
+        barrier.dstAccessMask = upload.dst_access;
+        barrier.srcQueueFamilyIndex = has_dedicated_queue() ? _transfer_family : VK_QUEUE_FAMILY_IGNORED;
+        barrier.dstQueueFamilyIndex = has_dedicated_queue() ? _graphics_family : VK_QUEUE_FAMILY_IGNORED;
+        barrier.buffer = upload.buffer;
+        barrier.offset = upload.offset;
+        barrier.size = size;
+        batch.buffer_barriers.push_back(barrier);
+        batch.dst_stages |= upload.dst_stage;
+
+        return { batch.value };
+    }
+
+    upload_ticket_t upload_service_t::upload_image(const image_upload_t& upload, const void* data,
+                                                   const VkDeviceSize size)
+    {
+        std::lock_guard<std::mutex> lock{ _mutex };
+
+        const staging_t staging{ stage(data, size) };
+        if (staging.buffer == VK_NULL_HANDLE) return { };
+
+        batch_t& batch{ open_batch() };
+
+        const VkImageSubresourceRange range{
+            upload.subresource.aspectMask, upload.subresource.mipLevel, 1,
+            upload.subresource.baseArrayLayer, upload.subresource.layerCount
+        };
+
+        VkImageMemoryBarrier to_transfer{ };
+        to_transfer.sType = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER;
+        to_transfer.srcAccessMask = 0;
+        to_transfer.dstAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
+        to_transfer.oldLayout = VK_IMAGE_LAYOUT_UNDEFINED;
+        to_transfer.newLayout = VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL;
+        to_transfer.srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+        to_transfer.dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+        to_transfer.image = upload.image;
+        to_transfer.subresourceRange = range;
+        vkCmdPipelineBarrier(batch.transfer_cmd, VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT, VK_PIPELINE_STAGE_TRANSFER_BIT,
+                             0, 0, nullptr, 0, nullptr, 1, &to_transfer);
+
+        VkBufferImageCopy region{ };
+        region.bufferOffset = staging.offset;
+        region.imageSubresource = upload.subresource;
+        region.imageExtent = upload.extent;
+        vkCmdCopyBufferToImage(batch.transfer_cmd, staging.buffer, upload.image, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL,
+                               1, &region);
+
+        // The layout change happens as part of the ownership transfer, release and acquire must agree on it
+        VkImageMemoryBarrier barrier{ to_transfer };
+        barrier.srcAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
+        barrier.dstAccessMask = upload.dst_access;
+        barrier.oldLayout = VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL;
+        barrier.newLayout = upload.final_layout;
+        barrier.srcQueueFamilyIndex = has_dedicated_queue() ? _transfer_family : VK_QUEUE_FAMILY_IGNORED;
+        barrier.dstQueueFamilyIndex = has_dedicated_queue() ? _graphics_family : VK_QUEUE_FAMILY_IGNORED;
+        batch.image_barriers.push_back(barrier);
+        batch.dst_stages |= upload.dst_stage;
+
+        return { batch.value };
+    }
+
+    upload_ticket_t upload_service_t::flush()
+    {
+        std::lock_guard<std::mutex> lock{ _mutex };
+
+        collect();
+
+        if (_has_open)
+        {
+            submit(_open);
+            _in_flight.push_back(std::move(_open));
+            _open = { };
+            _has_open = false;
+        }
+
+        return { _timeline.pending };
+    }
+
+    bool upload_service_t::is_complete(const upload_ticket_t ticket) const noexcept
+    {
+        return ticket.is_valid() && _timeline.has_reached(ticket.value);
+    }
+
+    void upload_service_t::wait(const upload_ticket_t ticket) const noexcept
+    {
+        if (ticket.is_valid()) _timeline.wait(ticket.value);
+    }
+
+    // PRIVATE
+    upload_service_t::batch_t& upload_service_t::open_batch()
+    {
+        if (_has_open) return _open;
+
+        _open.transfer_cmd = begin_commands(_device, _transfer_pool);
+        _open.value = _timeline.pending + 1;
+        _has_open = true;
+        return _open;
+    }
+
+    upload_service_t::staging_t upload_service_t::stage(const void* data, const VkDeviceSize size)
+    {
+        batch_t& batch{ open_batch() };
+
+        staging_chunk_t* chunk{ batch.chunks.empty() ? nullptr : &batch.chunks.back() };
+        if (chunk && align_up(chunk->head, _copy_alignment) + size > chunk->allocation.size) chunk = nullptr;
+
+        if (!chunk)
+        {
+            const auto reusable{
+                std::ranges::find_if(_free_chunks, [size](const staging_chunk_t& free_chunk) {
+                    return free_chunk.allocation.size >= size;
+                })
+            };
+
+            if (reusable != _free_chunks.end())
+            {
+                batch.chunks.push_back(*reusable);
+                _free_chunks.erase(reusable);
+            }
+            else
+            {
+                VkBufferCreateInfo info{ };
+                info.sType = VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO;
+                info.size = std::max(size, k_staging_chunk_size);
+                info.usage = VK_BUFFER_USAGE_TRANSFER_SRC_BIT;
+                info.sharingMode = VK_SHARING_MODE_EXCLUSIVE;
+
+                staging_chunk_t created{ };
+                if (!_allocator->create_buffer(info, VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT |
+                                                     VK_MEMORY_PROPERTY_HOST_COHERENT_BIT,
+                                               created.buffer, created.allocation))
+                {
+                    LOG_GRAPHICS_ERROR("[Vulkan] Failed to allocate {} bytes of upload staging memory", info.size);
+                    return { };
+                }
+                batch.chunks.push_back(created);
+            }
+
+            chunk = &batch.chunks.back();
+            chunk->head = 0;
+        }
+
+        const VkDeviceSize offset{ align_up(chunk->head, _copy_alignment) };
+        std::memcpy(static_cast<std::byte*>(chunk->allocation.mapped) + offset, data, size);
+        chunk->head = offset + size;
+
+        return { chunk->buffer, offset };
+    }
+
+    void upload_service_t::submit(batch_t& batch)
+    {
+        const bool transfer_ownership{ has_dedicated_queue() };
+
+        // Same family: a plain barrier makes the data visible to its consumers. Otherwise this is the release half
+        // of the ownership transfer, its destination access is ignored and the acquire below does the rest.
+        const VkPipelineStageFlags release_stages{
+            transfer_ownership ? static_cast<VkPipelineStageFlags>(VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT) : batch.dst_stages
+        };
+        vkCmdPipelineBarrier(batch.transfer_cmd, VK_PIPELINE_STAGE_TRANSFER_BIT, release_stages, 0,
+                             0, nullptr,
+                             static_cast<uint32_t>(batch.buffer_barriers.size()), batch.buffer_barriers.data(),
+                             static_cast<uint32_t>(batch.image_barriers.size()), batch.image_barriers.data());
+        vkEndCommandBuffer(batch.transfer_cmd);
+
+        // The copies may finish while earlier acquires are still queued behind frames on the graphics queue, so
+        // they never signal the public timeline: it would have to go backwards
+        timeline_semaphore_t& copies{ transfer_ownership ? _transfer_timeline : _timeline };
+        const uint64_t transfer_value{ transfer_ownership ? _transfer_timeline.advance() : batch.value };
+        _timeline.pending = batch.value;
+
+        VkTimelineSemaphoreSubmitInfo transfer_timeline{ };
+        transfer_timeline.sType = VK_STRUCTURE_TYPE_TIMELINE_SEMAPHORE_SUBMIT_INFO;
+        transfer_timeline.signalSemaphoreValueCount = 1;
+        transfer_timeline.pSignalSemaphoreValues = &transfer_value;
+
+        VkSubmitInfo transfer_submit{ };
+        transfer_submit.sType = VK_STRUCTURE_TYPE_SUBMIT_INFO;
+        transfer_submit.pNext = &transfer_timeline;
+        transfer_submit.commandBufferCount = 1;
+        transfer_submit.pCommandBuffers = &batch.transfer_cmd;
+        transfer_submit.signalSemaphoreCount = 1;
+        transfer_submit.pSignalSemaphores = &copies.semaphore;
+        vkQueueSubmit(_transfer_queue, 1, &transfer_submit, VK_NULL_HANDLE);
+
+        if (transfer_ownership)
+        {
+            // Acquire on the graphics queue, ordered after the copies by the transfer timeline wait
+            batch.acquire_cmd = begin_commands(_device, _acquire_pool);
+            for (auto& barrier: batch.buffer_barriers)
+                barrier.srcAccessMask = 0;
+            for (auto& barrier: batch.image_barriers)
+                barrier.srcAccessMask = 0;
+            vkCmdPipelineBarrier(batch.acquire_cmd, VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT, batch.dst_stages, 0,
+                                 0, nullptr,
+                                 static_cast<uint32_t>(batch.buffer_barriers.size()), batch.buffer_barriers.data(),
+                                 static_cast<uint32_t>(batch.image_barriers.size()), batch.image_barriers.data());
+            vkEndCommandBuffer(batch.acquire_cmd);
+
+            VkTimelineSemaphoreSubmitInfo acquire_timeline{ };
+            acquire_timeline.sType = VK_STRUCTURE_TYPE_TIMELINE_SEMAPHORE_SUBMIT_INFO;
+            acquire_timeline.waitSemaphoreValueCount = 1;
+            acquire_timeline.pWaitSemaphoreValues = &transfer_value;
+            acquire_timeline.signalSemaphoreValueCount = 1;
+            acquire_timeline.pSignalSemaphoreValues = &batch.value;
+
+            const VkPipelineStageFlags wait_stage{ batch.dst_stages };
+
+            VkSubmitInfo acquire_submit{ };
+            acquire_submit.sType = VK_STRUCTURE_TYPE_SUBMIT_INFO;
+            acquire_submit.pNext = &acquire_timeline;
+            acquire_submit.waitSemaphoreCount = 1;
+            acquire_submit.pWaitSemaphores = &_transfer_timeline.semaphore;
+            acquire_submit.pWaitDstStageMask = &wait_stage;
+            acquire_submit.commandBufferCount = 1;
+            acquire_submit.pCommandBuffers = &batch.acquire_cmd;
+            acquire_submit.signalSemaphoreCount = 1;
+            acquire_submit.pSignalSemaphores = &_timeline.semaphore;
+            vkQueueSubmit(_graphics_queue, 1, &acquire_submit, VK_NULL_HANDLE);
+        }
+    }
+
+    void upload_service_t::collect()
+    {
+        if (_in_flight.empty()) return;
+
+        const uint64_t completed{ _timeline.completed() };
+
+        while (!_in_flight.empty() && _in_flight.front().value <= completed)
+        {
+            release_batch(_in_flight.front());
+            _in_flight.pop_front();
+        }
+    }
+
+    void upload_service_t::release_batch(batch_t& batch) noexcept
+    {
+        vkFreeCommandBuffers(_device, _transfer_pool, 1, &batch.transfer_cmd);
+        if (batch.acquire_cmd) vkFreeCommandBuffers(_device, _acquire_pool, 1, &batch.acquire_cmd);
+
+        // Keep a few chunks around for the next batches, a streaming burst should not pin its peak forever
+        for (staging_chunk_t& chunk: batch.chunks)
+        {
+            if (_free_chunks.size() < k_max_free_chunks) _free_chunks.push_back(chunk);
+            else destroy_chunk(chunk);
+        }
+
+        batch = { };
+    }
+
+    void upload_service_t::destroy_chunk(staging_chunk_t& chunk) noexcept
+    {
+        _allocator->destroy_buffer(chunk.buffer, chunk.allocation);
+    }
+} // namespace carrot::rhi::vulkan
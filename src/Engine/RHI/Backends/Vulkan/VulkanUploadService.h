@@ -0,0 +1,128 @@
+//
+// Created by zshrout on 10/18/26.
+// Copyright (c) 2026 BunnySofty. All rights reserved.
+//
+
+#pragma once
+
+#include "VulkanAllocator.h"
+#include "VulkanCommon.h"
+#include "VulkanCore.h"
+
+#include <mutex>
+#include <vector>
+
+namespace carrot::rhi::vulkan {
+    // Completion handle of a batch: the value its timeline semaphore reaches once the data is usable. An invalid
+    // ticket means the data was never queued and never completes.
+    struct upload_ticket_t
+    {
+        uint64_t value{ ~0ull };
+
+        [[nodiscard]] bool is_valid() const noexcept { return value != ~0ull; }
+    };
+
+    struct buffer_upload_t
+    {
+        VkBuffer                buffer{ VK_NULL_HANDLE };
+        VkDeviceSize            offset{ 0 };
+        VkPipelineStageFlags    dst_stage{ VK_PIPELINE_STAGE_VERTEX_INPUT_BIT };
+        VkAccessFlags           dst_access{ VK_ACCESS_VERTEX_ATTRIBUTE_READ_BIT | VK_ACCESS_INDEX_READ_BIT };
+    };
+
+    // The previous contents of the subresource are discarded; tightly packed source data is expected
+    struct image_upload_t
+    {
+        VkImage                     image{ VK_NULL_HANDLE };
+        VkExtent3D                  extent{ 0, 0, 1 };
+        VkImageSubresourceLayers    subresource{ VK_IMAGE_ASPECT_COLOR_BIT, 0, 0, 1 };
+        VkImageLayout               final_layout{ VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL };
+        VkPipelineStageFlags        dst_stage{ VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT };
+        VkAccessFlags               dst_access{ VK_ACCESS_SHADER_READ_BIT };
+    };
+
+    // Copies data into device-local resources without stalling the graphics queue. Uploads from any thread are
+    // recorded into one open batch; flush() submits it to the transfer queue (a dedicated family when the device
+    // has one) and hands ownership over to the graphics family. Batches complete on a timeline semaphore, so
+    // callers poll or wait on their ticket instead of idling a queue. With a dedicated queue the copies signal a
+    // timeline of their own and only the acquire signals the public one, so every value on it is signalled by the
+    // graphics queue, in submission order, after the data is owned by the graphics family.
+    class upload_service_t
+    {
+    public:
+        void init(VkPhysicalDevice physical_device, VkDevice device, gpu_allocator_t& allocator,
+                  uint32_t transfer_family, VkQueue transfer_queue, uint32_t graphics_family, VkQueue graphics_queue);
+        void shutdown();
+
+        // The source data is copied into staging memory before returning; the ticket is invalid if that failed
+        [[nodiscard]] upload_ticket_t upload_buffer(const buffer_upload_t& upload, const void* data, VkDeviceSize size);
+        [[nodiscard]] upload_ticket_t upload_image(const image_upload_t& upload, const void* data, VkDeviceSize size);
+
+        // Submits the open batch, if any, and recycles the staging memory of finished ones. Submits to the
+        // graphics queue when ownership moves between families, so call it from the thread that owns that queue.
+        upload_ticket_t flush();
+
+        [[nodiscard]] bool is_complete(upload_ticket_t ticket) const noexcept;
+        void wait(upload_ticket_t ticket) const noexcept;
+
+        // Graphics submissions that consume uploads directly can wait on this instead of polling
+        [[nodiscard]] VkSemaphore timeline() const noexcept { return _timeline.semaphore; }
+        [[nodiscard]] bool has_dedicated_queue() const noexcept { return _transfer_family != _graphics_family; }
+
+    private:
+        struct staging_chunk_t
+        {
+            VkBuffer            buffer{ VK_NULL_HANDLE };
+            gpu_allocation_t    allocation;
+            VkDeviceSize        head{ 0 };
+        };
+
+        struct staging_t
+        {
+            VkBuffer            buffer{ VK_NULL_HANDLE };
+            VkDeviceSize        offset{ 0 };
+        };
+
+        struct batch_t
+        {
+            VkCommandBuffer                             transfer_cmd{ VK_NULL_HANDLE };
+            VkCommandBuffer                             acquire_cmd{ VK_NULL_HANDLE };
+            graphics_vector_t<staging_chunk_t>          chunks;
+
+            // Recorded at flush: as releases on the transfer queue, or as plain barriers when there is one family
+            graphics_vector_t<VkBufferMemoryBarrier>    buffer_barriers;
+            graphics_vector_t<VkImageMemoryBarrier>     image_barriers;
+            VkPipelineStageFlags                        dst_stages{ 0 };
+
+            uint64_t                                    value{ 0 };
+        };
+
+        [[nodiscard]] batch_t& open_batch();
+        [[nodiscard]] staging_t stage(const void* data, VkDeviceSize size);
+        void submit(batch_t& batch);
+        void collect();
+        void release_batch(batch_t& batch) noexcept;
+        void destroy_chunk(staging_chunk_t& chunk) noexcept;
+
+        VkDevice                    _device{ VK_NULL_HANDLE };
+        gpu_allocator_t*            _allocator{ nullptr };
+        VkDeviceSize                _copy_alignment{ 16 };
+
+        uint32_t                    _transfer_family{ ~0u };
+        uint32_t                    _graphics_family{ ~0u };
+        VkQueue                     _transfer_queue{ VK_NULL_HANDLE };
+        VkQueue                     _graphics_queue{ VK_NULL_HANDLE };
+        VkCommandPool               _transfer_pool{ VK_NULL_HANDLE };
+        VkCommandPool               _acquire_pool{ VK_NULL_HANDLE };
+
+        timeline_semaphore_t        _timeline;
+        timeline_semaphore_t        _transfer_timeline; // Only with a dedicated queue, orders acquires after copies
+
+        bool                        _has_open{ false };
+        batch_t                     _open;
+        graphics_deque_t<batch_t>   _in_flight;
+        graphics_vector_t<staging_chunk_t> _free_chunks;
+
+        mutable std::mutex          _mutex;
+    };
+} // namespace carrot::rhi::vulkan
@@ -5,14 +5,29 @@
 
 #pragma once
 
+#include "RendererConfig.h"
+#include "Sprite.h"
+
+#include <span>
+#include <string>
+#include <vector>
+
 namespace carrot::renderer {
+    // A copy of the built-in triangle mesh, placed in clip space by the default camera
+    struct triangle_instance_t
+    {
+        float       position[3]{ 0.f, 0.f, 0.f };
+        float       scale{ 1.f };
+        float       rotation{ 0.f };                    // radians, around z
+    };
+
     class renderer_t
     {
     public:
         renderer_t() = default;
         virtual ~renderer_t() = default;
 
-        virtual void init() = 0;
+        virtual void init(const renderer_config_t& config) = 0;
         virtual void shutdown() = 0;
 
         virtual void begin_frame() = 0;
@@ -20,6 +35,19 @@ namespace carrot::renderer {
         virtual void end_frame() = 0;
 
         virtual void reload_pipeline() = 0;
+        // Rebuilds only the pipelines built from the given (recompiled) SPIR-V modules
+        virtual void reload_shaders(const std::vector<std::string>& spv_paths) = 0;
+
+        // One RGBA8 image of width x height per layer; lives until the renderer shuts down
+        virtual sprite_atlas_id_t create_sprite_atlas(uint32_t width, uint32_t height,
+                                                      std::span<const void* const> layers) = 0;
+        // Queues sprites for the next render_frame(); they are batched by blend mode and atlas, and drawn in
+        // sprite_t::order
+        virtual void draw_sprites(std::span<const sprite_t> sprites, sprite_atlas_id_t atlas,
+                                  sprite_blend blend = sprite_blend::alpha) = 0;
+
+        // Persistent scene instances; returns how many fit into the scene
+        virtual uint32_t add_triangles(std::span<const triangle_instance_t> instances) = 0;
     };
 
     extern renderer_t* create_backend();
@@ -0,0 +1,31 @@
+//
+// Created by zshrout on 10/18/26.
+// Copyright (c) 2026 BunnySofty. All rights reserved.
+//
+
+#pragma once
+
+#include <cstdint>
+#include <string>
+
+namespace carrot::renderer {
+    enum class image_file_format : uint8_t
+    {
+        ppm,
+        png,
+    };
+
+    struct renderer_config_t
+    {
+        uint32_t          width{ 1280 };
+        uint32_t          height{ 720 };
+        // No window or surface: frames render into offscreen images standing in for the swapchain
+        bool              headless{ false };
+        // Every rendered frame is read back and written here as frame_<number>.<format>; empty disables capture
+        std::string       capture_directory;
+        image_file_format capture_format{ image_file_format::ppm };
+        // Framebuffer pixels per overlay unit. Set by hand: the window does not render at the output's scale, the
+        // compositor upscales it, so this is only needed when the framebuffer itself is high resolution
+        float             ui_scale{ 1.f };
+    };
+} // namespace carrot::renderer
@@ -0,0 +1,513 @@
+//
+// Created by zshrout on 10/18/26.
+// Copyright (c) 2026 BunnySofty. All rights reserved.
+//
+
+#include "ShaderReflection.h"
+
+#include <algorithm>
+#include <unordered_map>
+
+namespace carrot::renderer {
+    namespace {
+        // Only the handful of SPIR-V enumerants reflection needs, see the SPIR-V specification §3
+        constexpr uint32_t k_spirv_magic{ 0x07230203 };
+        constexpr uint32_t k_header_words{ 5 };
+
+        constexpr uint32_t op_entry_point{ 15 };
+        constexpr uint32_t op_execution_mode{ 16 };
+        constexpr uint32_t op_type_bool{ 20 };
+        constexpr uint32_t op_type_int{ 21 };
+        constexpr uint32_t op_type_float{ 22 };
+        constexpr uint32_t op_type_vector{ 23 };
+        constexpr uint32_t op_type_matrix{ 24 };
+        constexpr uint32_t op_type_image{ 25 };
+        constexpr uint32_t op_type_sampler{ 26 };
+        constexpr uint32_t op_type_sampled_image{ 27 };
+        constexpr uint32_t op_type_array{ 28 };
+        constexpr uint32_t op_type_runtime_array{ 29 };
+        constexpr uint32_t op_type_struct{ 30 };
+        constexpr uint32_t op_type_pointer{ 32 };
+        constexpr uint32_t op_constant{ 43 };
+        constexpr uint32_t op_variable{ 59 };
+        constexpr uint32_t op_decorate{ 71 };
+        constexpr uint32_t op_member_decorate{ 72 };
+
+        constexpr uint32_t decoration_block{ 2 };
+        constexpr uint32_t decoration_buffer_block{ 3 };
+        constexpr uint32_t decoration_array_stride{ 6 };
+        constexpr uint32_t decoration_matrix_stride{ 7 };
+        constexpr uint32_t decoration_built_in{ 11 };
+        constexpr uint32_t decoration_location{ 30 };
+        constexpr uint32_t decoration_binding{ 33 };
+        constexpr uint32_t decoration_descriptor_set{ 34 };
+        constexpr uint32_t decoration_offset{ 35 };
+
+        constexpr uint32_t storage_uniform_constant{ 0 };
+        constexpr uint32_t storage_input{ 1 };
+        constexpr uint32_t storage_uniform{ 2 };
+        constexpr uint32_t storage_push_constant{ 9 };
+        constexpr uint32_t storage_storage_buffer{ 12 };
+
+        constexpr uint32_t model_vertex{ 0 };
+        constexpr uint32_t model_fragment{ 4 };
+        constexpr uint32_t model_gl_compute{ 5 };
+
+        constexpr uint32_t mode_local_size{ 17 };
+        constexpr uint32_t dim_buffer{ 5 };
+
+        constexpr uint32_t k_unset{ ~0u };
+
+        struct id_info_t
+        {
+            uint32_t opcode{ 0 };
+            uint32_t word_offset{ 0 }; // start of the defining instruction
+
+            uint32_t binding{ k_unset };
+            uint32_t set{ k_unset };
+            uint32_t location{ k_unset };
+            uint32_t array_stride{ 0 };
+            bool     built_in{ false };
+            bool     block{ false };
+            bool     buffer_block{ false };
+        };
+
+        struct member_info_t
+        {
+            uint32_t offset{ 0 };
+            uint32_t matrix_stride{ 0 };
+            bool     built_in{ false };
+        };
+
+        struct module_t
+        {
+            std::span<const uint32_t>                   words;
+            std::vector<id_info_t>                      ids;
+            std::unordered_map<uint64_t, member_info_t> members;
+            std::vector<uint32_t>                       variables;
+            std::vector<uint32_t>                       interface_ids;
+            uint32_t                                    execution_model{ k_unset };
+            uint32_t                                    entry_point{ k_unset };
+            std::array<uint32_t, 3>                     local_size{ 1, 1, 1 };
+
+            // Operand `index` of the instruction defining `id` (operand 0 is the first word after the opcode)
+            [[nodiscard]] uint32_t operand(const uint32_t id, const uint32_t index) const noexcept
+            {
+                return words[ids[id].word_offset + 1 + index];
+            }
+
+            [[nodiscard]] uint32_t word_count(const uint32_t id) const noexcept
+            {
+                return words[ids[id].word_offset] >> 16;
+            }
+
+            [[nodiscard]] const member_info_t* member(const uint32_t struct_id, const uint32_t index) const noexcept
+            {
+                const auto it{ members.find(static_cast<uint64_t>(struct_id) << 32 | index) };
+                return it != members.end() ? &it->second : nullptr;
+            }
+        };
+
+        // Number of words taken by a nul-terminated literal string starting at `first`
+        uint32_t string_words(const std::span<const uint32_t> words, const uint32_t first, const uint32_t end) noexcept
+        {
+            for (uint32_t i{ first }; i < end; ++i)
+            {
+                const uint32_t word{ words[i] };
+                if ((word & 0xFF000000u) == 0 || (word & 0x00FF0000u) == 0 ||
+                    (word & 0x0000FF00u) == 0 || (word & 0x000000FFu) == 0)
+                    return i - first + 1;
+            }
+            return end - first;
+        }
+
+        bool parse_module(const std::span<const uint32_t> spv, module_t& module)
+        {
+            if (spv.size() < k_header_words || spv[0] != k_spirv_magic) return false;
+
+            const uint32_t bound{ spv[3] };
+            module.words = spv;
+            module.ids.resize(bound);
+
+            uint32_t offset{ k_header_words };
+            while (offset < spv.size())
+            {
+                const uint32_t count{ spv[offset] >> 16 };
+                const uint32_t opcode{ spv[offset] & 0xFFFFu };
+                if (count == 0 || offset + count > spv.size()) return false;
+
+                const uint32_t* ops{ spv.data() + offset + 1 };
+                const uint32_t op_count{ count - 1 };
+
+                switch (opcode)
+                {
+                    case op_entry_point:
+                    {
+                        if (module.entry_point != k_unset) break; // reflect the first entry point only
+                        module.execution_model = ops[0];
+                        module.entry_point = ops[1];
+
+                        const uint32_t name_words{ string_words(spv, offset + 3, offset + count) };
+                        for (uint32_t i{ 2 + name_words }; i < op_count; ++i)
+                            module.interface_ids.push_back(ops[i]);
+                        break;
+                    }
+                    case op_execution_mode:
+                    {
+                        if (ops[1] == mode_local_size && op_count >= 5)
+                            module.local_size = { ops[2], ops[3], ops[4] };
+                        break;
+                    }
+                    case op_decorate:
+                    {
+                        if (ops[0] >= bound) return false;
+                        id_info_t& info{ module.ids[ops[0]] };
+                        switch (ops[1])
+                        {
+                            case decoration_block: info.block = true; break;
+                            case decoration_buffer_block: info.buffer_block = true; break;
+                            case decoration_built_in: info.built_in = true; break;
+                            case decoration_array_stride: info.array_stride = ops[2]; break;
+                            case decoration_location: info.location = ops[2]; break;
+                            case decoration_binding: info.binding = ops[2]; break;
+                            case decoration_descriptor_set: info.set = ops[2]; break;
+                            default: break;
+                        }
+                        break;
+                    }
+                    case op_member_decorate:
+                    {
+                        member_info_t& info{ module.members[static_cast<uint64_t>(ops[0]) << 32 | ops[1]] };
+                        switch (ops[2])
+                        {
+                            case decoration_offset: info.offset = ops[3]; break;
+                            case decoration_matrix_stride: info.matrix_stride = ops[3]; break;
+                            case decoration_built_in: info.built_in = true; break;
+                            default: break;
+                        }
+                        break;
+                    }
+                    case op_variable:
+                    case op_constant:
+                    {
+                        // Result id is the second operand for value-producing instructions
+                        if (ops[1] >= bound) return false;
+                        module.ids[ops[1]].opcode = opcode;
+                        module.ids[ops[1]].word_offset = offset;
+                        if (opcode == op_variable) module.variables.push_back(ops[1]);
+                        break;
+                    }
+                    default:
+                    {
+                        // Types have the result id as their first operand
+                        if (opcode >= op_type_bool && opcode <= op_type_pointer && op_count > 0)
+                        {
+                            if (ops[0] >= bound) return false;
+                            module.ids[ops[0]].opcode = opcode;
+                            module.ids[ops[0]].word_offset = offset;
+                        }
+                        break;
+                    }
+                }
+
+                offset += count;
+            }
+
+            return module.entry_point != k_unset;
+        }
+
+        uint32_t array_length(const module_t& module, const uint32_t array_type)
+        {
+            if (module.ids[array_type].opcode == op_type_runtime_array) return 0;
+
+            const uint32_t length_id{ module.operand(array_type, 2) };
+            return module.ids[length_id].opcode == op_constant ? module.operand(length_id, 2) : 1;
+        }
+
+        uint32_t type_size(const module_t& module, const uint32_t type, const uint32_t matrix_stride = 0)
+        {
+            switch (module.ids[type].opcode)
+            {
+                case op_type_bool: return 4;
+                case op_type_int:
+                case op_type_float: return module.operand(type, 1) / 8;
+                case op_type_vector: return module.operand(type, 2) * type_size(module, module.operand(type, 1));
+                case op_type_matrix:
+                {
+                    const uint32_t columns{ module.operand(type, 2) };
+                    return matrix_stride ? columns * matrix_stride : columns * type_size(module, module.operand(type, 1));
+                }
+                case op_type_array:
+                {
+                    const uint32_t stride{ module.ids[type].array_stride };
+                    const uint32_t element{ module.operand(type, 1) };
+                    return array_length(module, type) * (stride ? stride : type_size(module, element, matrix_stride));
+                }
+                case op_type_runtime_array: return 0;
+                case op_type_struct:
+                {
+                    uint32_t size{ 0 };
+                    const uint32_t member_count{ module.word_count(type) - 2 };
+                    for (uint32_t i{ 0 }; i < member_count; ++i)
+                    {
+                        const member_info_t* member{ module.member(type, i) };
+                        const uint32_t offset{ member ? member->offset : 0 };
+                        const uint32_t stride{ member ? member->matrix_stride : 0 };
+                        size = std::max(size, offset + type_size(module, module.operand(type, 1 + i), stride));
+                    }
+                    return size;
+                }
+                case op_type_pointer: return 8;
+                default: return 0;
+            }
+        }
+
+        shader_stage_flags_t stage_of(const uint32_t execution_model) noexcept
+        {
+            switch (execution_model)
+            {
+                case model_vertex: return k_stage_vertex;
+                case model_fragment: return k_stage_fragment;
+                case model_gl_compute: return k_stage_compute;
+                default: return 0;
+            }
+        }
+
+        vertex_format format_of(const module_t& module, const uint32_t type)
+        {
+            uint32_t scalar{ type };
+            uint32_t components{ 1 };
+            if (module.ids[type].opcode == op_type_vector)
+            {
+                scalar = module.operand(type, 1);
+                components = module.operand(type, 2);
+            }
+            if (components < 1 || components > 4 || module.operand(scalar, 1) != 32) return vertex_format::unknown;
+
+            const uint32_t base{ components - 1 };
+            switch (module.ids[scalar].opcode)
+            {
+                case op_type_float: return static_cast<vertex_format>(static_cast<uint32_t>(vertex_format::float1) + base);
+                case op_type_int:
+                {
+                    const vertex_format first{ module.operand(scalar, 2) ? vertex_format::int1 : vertex_format::uint1 };
+                    return static_cast<vertex_format>(static_cast<uint32_t>(first) + base);
+                }
+                default: return vertex_format::unknown;
+            }
+        }
+
+        // Strips arrays off a descriptor type, accumulating the total descriptor count
+        uint32_t strip_arrays(const module_t& module, uint32_t type, uint32_t& count)
+        {
+            count = 1;
+            while (module.ids[type].opcode == op_type_array || module.ids[type].opcode == op_type_runtime_array)
+            {
+                count *= array_length(module, type);
+                type = module.operand(type, 1);
+            }
+            return type;
+        }
+
+        bool descriptor_kind_of(const module_t& module, const uint32_t storage, const uint32_t type,
+                                descriptor_kind& kind)
+        {
+            const uint32_t opcode{ module.ids[type].opcode };
+
+            if (storage == storage_storage_buffer)
+            {
+                kind = descriptor_kind::storage_buffer;
+                return true;
+            }
+            if (storage == storage_uniform)
+            {
+                kind = module.ids[type].buffer_block ? descriptor_kind::storage_buffer : descriptor_kind::uniform_buffer;
+                return true;
+            }
+            if (storage != storage_uniform_constant) return false;
+
+            switch (opcode)
+            {
+                case op_type_sampler: kind = descriptor_kind::sampler; return true;
+                case op_type_sampled_image: kind = descriptor_kind::combined_image_sampler; return true;
+                case op_type_image:
+                {
+                    const bool is_buffer{ module.operand(type, 2) == dim_buffer };
+                    const bool is_storage{ module.operand(type, 6) == 2 };
+                    if (is_buffer) kind = is_storage ? descriptor_kind::storage_texel_buffer : descriptor_kind::uniform_texel_buffer;
+                    else kind = is_storage ? descriptor_kind::storage_image : descriptor_kind::sampled_image;
+                    return true;
+                }
+                default: return false;
+            }
+        }
+    } // anonymous namespace
+
+    bool reflect_spirv(const std::span<const uint32_t> spv, shader_reflection_t& out)
+    {
+        module_t module;
+        if (!parse_module(spv, module)) return false;
+
+        shader_reflection_t result;
+        result.stages = stage_of(module.execution_model);
+        result.local_size = module.local_size;
+
+        for (const uint32_t variable: module.variables)
+        {
+            const uint32_t pointer_type{ module.operand(variable, 0) };
+            const uint32_t storage{ module.operand(variable, 2) };
+            if (module.ids[pointer_type].opcode != op_type_pointer) continue;
+
+            const uint32_t pointee{ module.operand(pointer_type, 2) };
+            const id_info_t& info{ module.ids[variable] };
+
+            if (storage == storage_push_constant)
+            {
+                uint32_t first{ k_unset };
+                const uint32_t member_count{ module.word_count(pointee) - 2 };
+                for (uint32_t i{ 0 }; i < member_count; ++i)
+                {
+                    const member_info_t* member{ module.member(pointee, i) };
+                    first = std::min(first, member ? member->offset : 0);
+                }
+
+                const uint32_t end{ type_size(module, pointee) };
+                if (first == k_unset || end <= first) continue;
+
+                result.push_constants = { first, end - first, result.stages };
+                continue;
+            }
+
+            if (storage == storage_input)
+            {
+                if (result.stages != k_stage_vertex || info.built_in || info.location == k_unset) continue;
+                if (std::ranges::find(module.interface_ids, variable) == module.interface_ids.end()) continue;
+
+                result.vertex_inputs.push_back({ info.location, format_of(module, pointee) });
+                continue;
+            }
+
+            if (info.binding == k_unset) continue;
+
+            descriptor_binding_t binding{ };
+            binding.set = info.set == k_unset ? 0 : info.set;
+            binding.binding = info.binding;
+            binding.stages = result.stages;
+
+            const uint32_t element{ strip_arrays(module, pointee, binding.count) };
+            if (!descriptor_kind_of(module, storage, element, binding.kind)) continue;
+
+            result.bindings.push_back(binding);
+        }
+
+        std::ranges::sort(result.bindings, [](const descriptor_binding_t& a, const descriptor_binding_t& b) {
+            return a.set != b.set ? a.set < b.set : a.binding < b.binding;
+        });
+        std::ranges::sort(result.vertex_inputs, { }, &vertex_input_t::location);
+
+        out = std::move(result);
+        return true;
+    }
+
+    void merge_reflection(shader_reflection_t& into, const shader_reflection_t& other)
+    {
+        into.stages |= other.stages;
+
+        for (const descriptor_binding_t& binding: other.bindings)
+        {
+            const auto it{
+                std::ranges::find_if(into.bindings, [&](const descriptor_binding_t& existing) {
+                    return existing.set == binding.set && existing.binding == binding.binding;
+                })
+            };
+
+            if (it != into.bindings.end())
+            {
+                it->stages |= binding.stages;
+                it->count = std::max(it->count, binding.count);
+            }
+            else
+            {
+                into.bindings.push_back(binding);
+            }
+        }
+
+        std::ranges::sort(into.bindings, [](const descriptor_binding_t& a, const descriptor_binding_t& b) {
+            return a.set != b.set ? a.set < b.set : a.binding < b.binding;
+        });
+
+        if (other.push_constants.size != 0)
+        {
+            push_constant_range_t& range{ into.push_constants };
+            if (range.size == 0)
+            {
+                range = other.push_constants;
+            }
+            else
+            {
+                const uint32_t begin{ std::min(range.offset, other.push_constants.offset) };
+                const uint32_t end{
+                    std::max(range.offset + range.size, other.push_constants.offset + other.push_constants.size)
+                };
+                range = { begin, end - begin, range.stages | other.push_constants.stages };
+            }
+        }
+
+        if (other.stages & k_stage_vertex) into.vertex_inputs = other.vertex_inputs;
+        if (other.stages & k_stage_compute) into.local_size = other.local_size;
+    }
+
+    void serialize_reflection(const shader_reflection_t& reflection, std::vector<uint32_t>& out)
+    {
+        out.push_back(reflection.stages);
+        out.insert(out.end(), reflection.local_size.begin(), reflection.local_size.end());
+
+        const push_constant_range_t& push{ reflection.push_constants };
+        out.insert(out.end(), { push.offset, push.size, push.stages });
+
+        out.push_back(static_cast<uint32_t>(reflection.bindings.size()));
+        for (const descriptor_binding_t& binding: reflection.bindings)
+            out.insert(out.end(), { binding.set, binding.binding, binding.count, static_cast<uint32_t>(binding.kind), binding.stages });
+
+        out.push_back(static_cast<uint32_t>(reflection.vertex_inputs.size()));
+        for (const vertex_input_t& input: reflection.vertex_inputs)
+            out.insert(out.end(), { input.location, static_cast<uint32_t>(input.format) });
+    }
+
+    bool deserialize_reflection(std::span<const uint32_t> words, shader_reflection_t& out)
+    {
+        constexpr size_t k_fixed_words{ 7 }; // stages, local size, push constant range
+        constexpr size_t k_binding_words{ 5 };
+        constexpr size_t k_input_words{ 2 };
+
+        if (words.size() < k_fixed_words + 2) return false;
+
+        shader_reflection_t result;
+        result.stages = words[0];
+        result.local_size = { words[1], words[2], words[3] };
+        result.push_constants = { words[4], words[5], words[6] };
+        words = words.subspan(k_fixed_words);
+
+        const uint32_t binding_count{ words[0] };
+        if (words.size() < 1 + binding_count * k_binding_words + 1) return false;
+        for (uint32_t i{ 0 }; i < binding_count; ++i)
+        {
+            const uint32_t* b{ words.data() + 1 + i * k_binding_words };
+            if (b[3] > static_cast<uint32_t>(descriptor_kind::storage_buffer)) return false;
+            result.bindings.push_back({ b[0], b[1], b[2], static_cast<descriptor_kind>(b[3]), b[4] });
+        }
+        words = words.subspan(1 + binding_count * k_binding_words);
+
+        const uint32_t input_count{ words[0] };
+        if (words.size() != 1 + input_count * k_input_words) return false;
+        for (uint32_t i{ 0 }; i < input_count; ++i)
+        {
+            const uint32_t* v{ words.data() + 1 + i * k_input_words };
+            if (v[1] > static_cast<uint32_t>(vertex_format::uint4)) return false;
+            result.vertex_inputs.push_back({ v[0], static_cast<vertex_format>(v[1]) });
+        }
+
+        out = std::move(result);
+        return true;
+    }
+} // namespace carrot::renderer
@@ -0,0 +1,95 @@
+//
+// Created by zshrout on 10/18/26.
+// Copyright (c) 2026 BunnySofty. All rights reserved.
+//
+
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <span>
+#include <vector>
+
+namespace carrot::renderer {
+    // API-agnostic view of what a SPIR-V module expects from its pipeline. Kept free of engine and Vulkan
+    // dependencies so offline tools can reflect shaders too.
+    using shader_stage_flags_t = uint32_t;
+
+    constexpr shader_stage_flags_t k_stage_vertex{ 1u << 0 };
+    constexpr shader_stage_flags_t k_stage_fragment{ 1u << 1 };
+    constexpr shader_stage_flags_t k_stage_compute{ 1u << 2 };
+
+    enum class descriptor_kind : uint8_t
+    {
+        sampler,
+        combined_image_sampler,
+        sampled_image,
+        storage_image,
+        uniform_texel_buffer,
+        storage_texel_buffer,
+        uniform_buffer,
+        storage_buffer,
+    };
+
+    enum class vertex_format : uint8_t
+    {
+        unknown,
+        float1, float2, float3, float4,
+        int1, int2, int3, int4,
+        uint1, uint2, uint3, uint4,
+    };
+
+    struct descriptor_binding_t
+    {
+        uint32_t                set{ 0 };
+        uint32_t                binding{ 0 };
+        uint32_t                count{ 1 }; // 0 = runtime-sized array
+        descriptor_kind         kind{ descriptor_kind::uniform_buffer };
+        shader_stage_flags_t    stages{ 0 };
+    };
+
+    struct push_constant_range_t
+    {
+        uint32_t                offset{ 0 };
+        uint32_t                size{ 0 }; // 0 = no push constants
+        shader_stage_flags_t    stages{ 0 };
+    };
+
+    struct vertex_input_t
+    {
+        uint32_t                location{ 0 };
+        vertex_format           format{ vertex_format::unknown };
+    };
+
+    struct shader_reflection_t
+    {
+        shader_stage_flags_t                stages{ 0 };
+        std::vector<descriptor_binding_t>   bindings;       // sorted by (set, binding)
+        push_constant_range_t               push_constants;
+        std::vector<vertex_input_t>         vertex_inputs;  // vertex stage only, sorted by location
+        std::array<uint32_t, 3>             local_size{ 1, 1, 1 }; // compute stage only
+    };
+
+    // Returns false when the blob is not valid SPIR-V; `out` is left untouched in that case
+    [[nodiscard]] bool reflect_spirv(std::span<const uint32_t> spv, shader_reflection_t& out);
+
+    // Folds another stage into `into`: bindings shared by both stages get both stage bits, push constant
+    // ranges are widened to cover both
+    void merge_reflection(shader_reflection_t& into, const shader_reflection_t& other);
+
+    // Flat word encoding used to store reflection next to the SPIR-V in shader archives. Appends to `out`.
+    void serialize_reflection(const shader_reflection_t& reflection, std::vector<uint32_t>& out);
+    [[nodiscard]] bool deserialize_reflection(std::span<const uint32_t> words, shader_reflection_t& out);
+
+    [[nodiscard]] constexpr uint32_t vertex_format_size(const vertex_format format) noexcept
+    {
+        switch (format)
+        {
+            case vertex_format::float1: case vertex_format::int1: case vertex_format::uint1: return 4;
+            case vertex_format::float2: case vertex_format::int2: case vertex_format::uint2: return 8;
+            case vertex_format::float3: case vertex_format::int3: case vertex_format::uint3: return 12;
+            case vertex_format::float4: case vertex_format::int4: case vertex_format::uint4: return 16;
+            default: return 0;
+        }
+    }
+} // namespace carrot::renderer
@@ -0,0 +1,27 @@
+//
+// Created by zshrout on 10/18/26.
+// Copyright (c) 2026 BunnySofty. All rights reserved.
+//
+
+#include "ShaderVariant.h"
+
+namespace carrot::renderer {
+    std::string variant_spv_path(std::string_view base_spv_path, const shader_variant_key_t key)
+    {
+        if (key == k_base_variant) return std::string{ base_spv_path };
+
+        if (base_spv_path.ends_with(".spv")) base_spv_path.remove_suffix(4);
+
+        std::string path{ base_spv_path };
+        for (uint32_t i{ 0 }; i < k_shader_keyword_count; ++i)
+        {
+            if (!(key & 1u << i)) continue;
+
+            path += '.';
+            path += k_shader_keyword_names[i];
+        }
+
+        path += ".spv";
+        return path;
+    }
+} // namespace carrot::renderer
@@ -0,0 +1,53 @@
+//
+// Created by zshrout on 10/18/26.
+// Copyright (c) 2026 BunnySofty. All rights reserved.
+//
+
+#pragma once
+
+#include <cstdint>
+#include <initializer_list>
+#include <iterator>
+#include <string>
+#include <string_view>
+
+namespace carrot::renderer {
+    // Engine-wide shader keywords. Keyword N is the boolean specialization constant with `constant_id = N`
+    // in every shader that declares it, e.g. `layout(constant_id = 0) const bool SPIN = false;`
+    // NOTE: keep in sync with CARROT_SHADER_KEYWORDS in CMakeLists.txt
+    enum class shader_keyword : uint32_t
+    {
+        spin = 0,
+
+        count
+    };
+
+    constexpr const char* k_shader_keyword_names[]{
+        "SPIN",
+    };
+
+    constexpr uint32_t k_shader_keyword_count{ static_cast<uint32_t>(shader_keyword::count) };
+    static_assert(std::size(k_shader_keyword_names) == k_shader_keyword_count, "Every keyword needs a name");
+    static_assert(k_shader_keyword_count <= 32, "Variant keys are 32-bit keyword masks");
+
+    // One bit per enabled keyword
+    using shader_variant_key_t = uint32_t;
+    constexpr shader_variant_key_t k_base_variant{ 0 };
+
+    [[nodiscard]] constexpr shader_variant_key_t variant_key(const std::initializer_list<shader_keyword> keywords) noexcept
+    {
+        shader_variant_key_t key{ k_base_variant };
+        for (const shader_keyword keyword: keywords)
+            key |= 1u << static_cast<uint32_t>(keyword);
+        return key;
+    }
+
+    [[nodiscard]] constexpr bool has_keyword(const shader_variant_key_t key, const shader_keyword keyword) noexcept
+    {
+        return (key & 1u << static_cast<uint32_t>(keyword)) != 0;
+    }
+
+    // "shaders/triangle.vert.spv" + { spin } → "shaders/triangle.vert.SPIN.spv", the name a build-time baked
+    // variant gets from the CompileShaders target
+    [[nodiscard]] std::string variant_spv_path(std::string_view base_spv_path, shader_variant_key_t key);
+} // namespace carrot::renderer
@@ -0,0 +1,38 @@
+//
+// Created by zshrout on 10/18/26.
+// Copyright (c) 2026 BunnySofty. All rights reserved.
+//
+
+#pragma once
+
+#include <cstdint>
+
+namespace carrot::renderer {
+    enum class sprite_blend : uint8_t
+    {
+        opaque,
+        alpha,
+        additive,
+
+        count
+    };
+
+    // Texture array whose layers hold sprite sheets of one size; sprites pick a layer and a UV rect inside it
+    struct sprite_atlas_id_t
+    {
+        uint32_t index{ ~0u };
+
+        [[nodiscard]] bool is_valid() const noexcept { return index != ~0u; }
+    };
+
+    struct sprite_t
+    {
+        float       position[2]{ 0.f, 0.f };            // center, framebuffer pixels from the top-left corner
+        float       size[2]{ 1.f, 1.f };                // pixels
+        float       rotation{ 0.f };                    // radians, clockwise on screen
+        float       uv_rect[4]{ 0.f, 0.f, 1.f, 1.f };   // u0, v0, u1, v1 inside the layer
+        uint32_t    color{ 0xFFFFFFFF };                // RGBA8 tint, red in the low byte
+        uint16_t    layer{ 0 };                         // texture array layer
+        int16_t     order{ 0 };                         // higher orders draw on top
+    };
+} // namespace carrot::renderer
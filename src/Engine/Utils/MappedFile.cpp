@@ -0,0 +1,58 @@
+//
+// Created by zshrout on 10/18/26.
+// Copyright (c) 2026 BunnySofty. All rights reserved.
+//
+
+#include "MappedFile.h"
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace carrot::utils {
+    // PUBLIC
+    mapped_file_t& mapped_file_t::operator=(mapped_file_t&& other) noexcept
+    {
+        if (this != &other)
+        {
+            close();
+            _data = other._data;
+            _size = other._size;
+            other._data = nullptr;
+            other._size = 0;
+        }
+        return *this;
+    }
+
+    bool mapped_file_t::open(const std::string& path) noexcept
+    {
+        close();
+
+        const int fd{ ::open(path.c_str(), O_RDONLY | O_CLOEXEC) };
+        if (fd == -1) return false;
+
+        struct stat info{ };
+        if (fstat(fd, &info) != 0 || info.st_size <= 0)
+        {
+            ::close(fd);
+            return false;
+        }
+
+        void* mapping{ mmap(nullptr, static_cast<size_t>(info.st_size), PROT_READ, MAP_PRIVATE, fd, 0) };
+        ::close(fd); // the mapping keeps its own reference to the file
+
+        if (mapping == MAP_FAILED) return false;
+
+        _data = static_cast<const std::byte*>(mapping);
+        _size = static_cast<size_t>(info.st_size);
+        return true;
+    }
+
+    void mapped_file_t::close() noexcept
+    {
+        if (_data) munmap(const_cast<std::byte *>(_data), _size);
+        _data = nullptr;
+        _size = 0;
+    }
+} // namespace carrot::utils
@@ -0,0 +1,37 @@
+//
+// Created by zshrout on 10/18/26.
+// Copyright (c) 2026 BunnySofty. All rights reserved.
+//
+
+#pragma once
+
+#include "Common/CommonHeaders.h"
+
+#include <cstddef>
+#include <span>
+#include <string>
+
+namespace carrot::utils {
+    // Read-only memory mapping of a whole file. Move-only; the bytes stay valid for the lifetime of the object.
+    struct mapped_file_t
+    {
+    public:
+        mapped_file_t() = default;
+        ~mapped_file_t() { close(); }
+
+        DISABLE_COPY(mapped_file_t)
+        mapped_file_t(mapped_file_t&& other) noexcept { *this = std::move(other); }
+        mapped_file_t& operator=(mapped_file_t&& other) noexcept;
+
+        [[nodiscard]] bool open(const std::string& path) noexcept;
+        void close() noexcept;
+
+        [[nodiscard]] bool is_open() const noexcept { return _data != nullptr; }
+        [[nodiscard]] std::span<const std::byte> bytes() const noexcept { return { _data, _size }; }
+        [[nodiscard]] size_t size() const noexcept { return _size; }
+
+    private:
+        const std::byte*    _data{ nullptr };
+        size_t              _size{ 0 };
+    };
+} // namespace carrot::utils
@@ -0,0 +1,114 @@
+//
+// Created by zshrout on 10/18/26.
+// Copyright (c) 2026 BunnySofty. All rights reserved.
+//
+
+#include "ShaderArchive.h"
+
+#include <bit>
+
+namespace carrot::utils {
+    namespace {
+        bool in_bounds(const uint64_t offset, const uint64_t size, const uint64_t file_size) noexcept
+        {
+            return offset <= file_size && size <= file_size - offset;
+        }
+    } // anonymous namespace
+
+    // PUBLIC
+    bool shader_archive_t::open(const std::string& path)
+    {
+        close();
+        if (!_file.open(path)) return false;
+
+        const std::span<const std::byte> bytes{ _file.bytes() };
+        const auto* header{ reinterpret_cast<const shader_archive_header_t*>(bytes.data()) };
+
+        const bool header_ok{
+            bytes.size() >= sizeof(shader_archive_header_t) &&
+            header->magic == k_shader_archive_magic &&
+            header->version == k_shader_archive_version &&
+            header->file_size == bytes.size() &&
+            std::has_single_bit(header->slot_count) && header->slot_count > header->entry_count &&
+            header->entries_offset % alignof(shader_archive_entry_t) == 0 &&
+            header->slots_offset % alignof(uint32_t) == 0 &&
+            in_bounds(header->entries_offset, uint64_t{ header->entry_count } * sizeof(shader_archive_entry_t), bytes.size()) &&
+            in_bounds(header->slots_offset, uint64_t{ header->slot_count } * sizeof(uint32_t), bytes.size())
+        };
+        if (!header_ok)
+        {
+            _file.close();
+            return false;
+        }
+
+        const auto* entries{ reinterpret_cast<const shader_archive_entry_t*>(bytes.data() + header->entries_offset) };
+        for (uint32_t i{ 0 }; i < header->entry_count; ++i)
+        {
+            const shader_archive_entry_t& entry{ entries[i] };
+            const bool entry_ok{
+                in_bounds(entry.name_offset, entry.name_size, bytes.size()) &&
+                in_bounds(entry.spv_offset, entry.spv_size, bytes.size()) &&
+                in_bounds(entry.reflection_offset, entry.reflection_size, bytes.size()) &&
+                entry.spv_offset % alignof(uint32_t) == 0 && entry.spv_size % sizeof(uint32_t) == 0 &&
+                entry.reflection_offset % alignof(uint32_t) == 0 && entry.reflection_size % sizeof(uint32_t) == 0
+            };
+            if (!entry_ok)
+            {
+                _file.close();
+                return false;
+            }
+        }
+
+        _header = header;
+        _entries = entries;
+        _slots = reinterpret_cast<const uint32_t*>(bytes.data() + header->slots_offset);
+        return true;
+    }
+
+    void shader_archive_t::close() noexcept
+    {
+        _file.close();
+        _header = nullptr;
+        _entries = nullptr;
+        _slots = nullptr;
+    }
+
+    const shader_archive_entry_t* shader_archive_t::find(const std::string_view name) const noexcept
+    {
+        if (!_header) return nullptr;
+
+        const uint64_t hash{ fnv1a_64(name) };
+        const uint32_t mask{ _header->slot_count - 1 };
+        const char* base{ reinterpret_cast<const char*>(_file.bytes().data()) };
+
+        uint32_t slot{ static_cast<uint32_t>(hash) & mask };
+        for (uint32_t probe{ 0 }; probe < _header->slot_count; ++probe, slot = (slot + 1) & mask)
+        {
+            const uint32_t index{ _slots[slot] };
+            if (index == 0 || index > _header->entry_count) return nullptr;
+
+            const shader_archive_entry_t& entry{ _entries[index - 1] };
+            if (entry.name_hash == hash && std::string_view{ base + entry.name_offset, entry.name_size } == name)
+                return &entry;
+        }
+
+        return nullptr;
+    }
+
+    std::span<const uint32_t> shader_archive_t::spv(const shader_archive_entry_t& entry) const noexcept
+    {
+        return words_at(entry.spv_offset, entry.spv_size);
+    }
+
+    std::span<const uint32_t> shader_archive_t::reflection(const shader_archive_entry_t& entry) const noexcept
+    {
+        return words_at(entry.reflection_offset, entry.reflection_size);
+    }
+
+    // PRIVATE
+    std::span<const uint32_t> shader_archive_t::words_at(const uint64_t offset, const uint32_t size) const noexcept
+    {
+        if (size == 0) return { };
+        return { reinterpret_cast<const uint32_t*>(_file.bytes().data() + offset), size / sizeof(uint32_t) };
+    }
+} // namespace carrot::utils
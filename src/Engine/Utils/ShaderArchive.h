@@ -0,0 +1,43 @@
+//
+// Created by zshrout on 10/18/26.
+// Copyright (c) 2026 BunnySofty. All rights reserved.
+//
+
+#pragma once
+
+#include "MappedFile.h"
+#include "ShaderArchiveFormat.h"
+
+#include <span>
+#include <string>
+#include <string_view>
+
+namespace carrot::utils {
+    // Read-only view of a shaders.pak built by CarrotShaderPacker. The whole file is mapped once, lookups hash
+    // the name and probe the table, and the returned spans point straight into the mapping.
+    class shader_archive_t
+    {
+    public:
+        // Validates the header and every entry's bounds up front, so lookups never have to
+        [[nodiscard]] bool open(const std::string& path);
+        void close() noexcept;
+
+        [[nodiscard]] bool is_open() const noexcept { return _header != nullptr; }
+        [[nodiscard]] uint32_t size() const noexcept { return _header ? _header->entry_count : 0; }
+        [[nodiscard]] uint64_t content_hash() const noexcept { return _header ? _header->content_hash : 0; }
+
+        // `name` is the shader's file name, e.g. "triangle.vert.spv"
+        [[nodiscard]] const shader_archive_entry_t* find(std::string_view name) const noexcept;
+
+        [[nodiscard]] std::span<const uint32_t> spv(const shader_archive_entry_t& entry) const noexcept;
+        [[nodiscard]] std::span<const uint32_t> reflection(const shader_archive_entry_t& entry) const noexcept;
+
+    private:
+        [[nodiscard]] std::span<const uint32_t> words_at(uint64_t offset, uint32_t size) const noexcept;
+
+        mapped_file_t                       _file;
+        const shader_archive_header_t*      _header{ nullptr };
+        const shader_archive_entry_t*       _entries{ nullptr };
+        const uint32_t*                     _slots{ nullptr };
+    };
+} // namespace carrot::utils
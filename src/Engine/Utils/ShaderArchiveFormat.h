@@ -0,0 +1,59 @@
+//
+// Created by zshrout on 10/18/26.
+// Copyright (c) 2026 BunnySofty. All rights reserved.
+//
+
+#pragma once
+
+#include <cstdint>
+#include <string_view>
+
+// On-disk layout of shaders.pak, shared by the runtime reader and the CarrotShaderPacker tool. Everything is
+// little-endian and all offsets are absolute from the start of the file:
+//
+//   header | entries[entry_count] | slots[slot_count] | names | (spv, reflection)[entry_count]
+//
+// Slots form an open-addressed hash table (linear probing) over the FNV-1a hash of the shader file name; a slot
+// holds entry index + 1, or 0 when empty. SPIR-V and reflection blobs are word data, aligned to k_shader_archive_alignment.
+namespace carrot::utils {
+    constexpr uint32_t k_shader_archive_magic{ 0x4B505343 }; // "CSPK"
+    constexpr uint32_t k_shader_archive_version{ 1 };
+    constexpr uint32_t k_shader_archive_alignment{ 16 };
+
+    struct shader_archive_header_t
+    {
+        uint32_t    magic{ k_shader_archive_magic };
+        uint32_t    version{ k_shader_archive_version };
+        uint32_t    entry_count{ 0 };
+        uint32_t    slot_count{ 0 };     // power of two, at least twice entry_count
+        uint64_t    content_hash{ 0 };   // hash over every name and blob, identifies the shader set
+        uint64_t    entries_offset{ 0 };
+        uint64_t    slots_offset{ 0 };
+        uint64_t    file_size{ 0 };
+    };
+
+    struct shader_archive_entry_t
+    {
+        uint64_t    name_hash{ 0 };
+        uint64_t    name_offset{ 0 };
+        uint64_t    spv_offset{ 0 };
+        uint64_t    reflection_offset{ 0 };
+        uint32_t    name_size{ 0 };
+        uint32_t    spv_size{ 0 };           // bytes
+        uint32_t    reflection_size{ 0 };    // bytes, 0 if the module could not be reflected
+        uint32_t    padding{ 0 };
+    };
+
+    static_assert(sizeof(shader_archive_header_t) == 48);
+    static_assert(sizeof(shader_archive_entry_t) == 48);
+
+    [[nodiscard]] constexpr uint64_t fnv1a_64(const std::string_view text, uint64_t hash = 0xCBF29CE484222325ull) noexcept
+    {
+        for (const char c: text)
+        {
+            hash ^= static_cast<uint8_t>(c);
+            hash *= 0x100000001B3ull;
+        }
+        return hash;
+    }
+} // namespace carrot::utils
@@ -6,22 +6,106 @@
 #include "ShaderUtils.h"
 
 #include "Common/CommonHeaders.h"
+#include "ShaderArchive.h"
 
-#include <fstream>
+#include <cstring>
+#include <filesystem>
+#include <mutex>
+#include <unordered_set>
 
-std::vector<uint32_t> load_spv(const std::string& path)
+namespace {
+    constexpr uint32_t k_spirv_magic{ 0x07230203 };
+    constexpr size_t k_spirv_header_size{ 5 * sizeof(uint32_t) };
+
+    // Variant pipelines load modules on worker threads, the override set is written by hot-reload
+    carrot::utils::shader_archive_t     g_archive;
+    std::unordered_set<std::string>     g_overrides;
+    std::mutex                          g_overrides_mutex;
+
+    std::string spv_name(const std::string& path)
+    {
+        return std::filesystem::path{ path }.filename().string();
+    }
+
+    const carrot::utils::shader_archive_entry_t* find_archived(const std::string& name)
+    {
+        if (!g_archive.is_open()) return nullptr;
+
+        {
+            std::lock_guard<std::mutex> lock{ g_overrides_mutex };
+            if (g_overrides.contains(name)) return nullptr;
+        }
+
+        return g_archive.find(name);
+    }
+} // anonymous namespace
+
+bool validate_spv(const std::span<const std::byte> bytes) noexcept
 {
-    std::ifstream file(path, std::ios::ate | std::ios::binary);
-    if (!file.is_open())
+    if (bytes.size() < k_spirv_header_size || bytes.size() % sizeof(uint32_t) != 0) return false;
+
+    uint32_t magic{ 0 };
+    std::memcpy(&magic, bytes.data(), sizeof(magic));
+    return magic == k_spirv_magic;
+}
+
+spv_blob_t load_spv(const std::string& path)
+{
+    spv_blob_t blob{ };
+
+    // The packer validated every module when it built the archive
+    if (const carrot::utils::shader_archive_entry_t* entry{ find_archived(spv_name(path)) })
+    {
+        blob._words = g_archive.spv(*entry);
+        blob._reflection = g_archive.reflection(*entry);
+        return blob;
+    }
+
+    if (!blob._file.open(path))
     {
         LOG_GRAPHICS_ERROR("Failed to open SPV: {}", path);
         return { };
     }
 
-    const size_t size{ static_cast<size_t>(file.tellg()) };
-    file.seekg(0);
-    std::vector<uint32_t> buffer((size + 3) / 4);
-    file.read(reinterpret_cast<char *>(buffer.data()), static_cast<std::streamsize>(size));
-    file.close();
-    return buffer;
+    const std::span<const std::byte> bytes{ blob._file.bytes() };
+    if (!validate_spv(bytes))
+    {
+        LOG_GRAPHICS_ERROR("Not a valid SPIR-V module: {} ({} bytes)", path, bytes.size());
+        return { };
+    }
+
+    // mmap hands out page-aligned memory, so the words can be viewed in place
+    blob._words = { reinterpret_cast<const uint32_t *>(bytes.data()), bytes.size() / sizeof(uint32_t) };
+    return blob;
+}
+
+bool mount_shader_archive(const std::string& path)
+{
+    if (!g_archive.open(path))
+    {
+        LOG_GRAPHICS_INFO("No valid shader archive at {}, loading loose SPIR-V files", path);
+        return false;
+    }
+
+    std::lock_guard<std::mutex> lock{ g_overrides_mutex };
+    g_overrides.clear();
+
+    LOG_GRAPHICS_INFO("Mounted shader archive {} ({} modules, set {:016x})", path, g_archive.size(), g_archive.content_hash());
+    return true;
+}
+
+void unmount_shader_archive() noexcept
+{
+    g_archive.close();
+}
+
+void override_archived_spv(const std::string& path)
+{
+    std::lock_guard<std::mutex> lock{ g_overrides_mutex };
+    g_overrides.insert(spv_name(path));
+}
+
+bool is_archived_spv(const std::string& path)
+{
+    return find_archived(spv_name(path)) != nullptr;
 }
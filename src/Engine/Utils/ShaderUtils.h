@@ -5,8 +5,49 @@
 
 #pragma once
 
+#include "MappedFile.h"
+
 #include <cstdint>
-#include <vector>
+#include <span>
 #include <string>
 
-std::vector<uint32_t> load_spv(const std::string& path);
\ No newline at end of file
+// SPIR-V module mapped straight from disk, or from the mounted shader archive. words() is a non-owning view that
+// can be handed to vkCreateShaderModule as-is; it stays valid for as long as the blob lives (and the archive stays
+// mounted). Archived modules also carry their build-time reflection, see serialize_reflection().
+struct spv_blob_t
+{
+public:
+    spv_blob_t() = default;
+
+    [[nodiscard]] std::span<const uint32_t> words() const noexcept { return _words; }
+    [[nodiscard]] const uint32_t* data() const noexcept { return _words.data(); }
+    [[nodiscard]] size_t size_bytes() const noexcept { return _words.size_bytes(); }
+    [[nodiscard]] bool empty() const noexcept { return _words.empty(); }
+
+    // Serialized reflection words, empty for loose files
+    [[nodiscard]] std::span<const uint32_t> reflection() const noexcept { return _reflection; }
+
+    operator std::span<const uint32_t>() const noexcept { return _words; }
+
+private:
+    friend spv_blob_t load_spv(const std::string& path);
+
+    carrot::utils::mapped_file_t    _file;
+    std::span<const uint32_t>       _words;
+    std::span<const uint32_t>       _reflection;
+};
+
+// Checks the SPIR-V magic number and that the size is a whole number of words (and at least a header)
+[[nodiscard]] bool validate_spv(std::span<const std::byte> bytes) noexcept;
+
+// Returns an empty blob (and logs) if the file is missing or is not SPIR-V. Modules in the mounted archive are
+// looked up by file name and never touch the file system.
+[[nodiscard]] spv_blob_t load_spv(const std::string& path);
+
+// Mounts a shaders.pak for load_spv. Returns false (and keeps loading loose files) if it is missing or invalid.
+bool mount_shader_archive(const std::string& path);
+void unmount_shader_archive() noexcept;
+
+// Hot-reloaded modules are newer than the archive; from now on load_spv reads this one from disk
+void override_archived_spv(const std::string& path);
+[[nodiscard]] bool is_archived_spv(const std::string& path);
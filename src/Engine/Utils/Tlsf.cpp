@@ -0,0 +1,252 @@
+//
+// Created by zshrout on 10/18/26.
+// Copyright (c) 2026 BunnySofty. All rights reserved.
+//
+
+#include "Tlsf.h"
+
+#include <algorithm>
+#include <bit>
+
+namespace carrot::utils {
+    namespace {
+        struct mapping_t
+        {
+            uint32_t fl{ 0 };
+            uint32_t sl{ 0 };
+        };
+
+        // Sizes below k_sl_count get one exact list each (fl 0), larger sizes split every power of two into
+        // k_sl_count linear sub-ranges
+        template<uint32_t SlBits>
+        mapping_t map_size(const uint64_t size) noexcept
+        {
+            if (size < 1ull << SlBits) return { 0, static_cast<uint32_t>(size) };
+
+            const uint32_t msb{ static_cast<uint32_t>(std::bit_width(size)) - 1 };
+            return {
+                msb - SlBits + 1,
+                static_cast<uint32_t>(size >> (msb - SlBits)) ^ (1u << SlBits)
+            };
+        }
+
+        // Rounds up to the next list boundary so every block in the returned list is large enough
+        template<uint32_t SlBits>
+        uint64_t round_to_list(const uint64_t size) noexcept
+        {
+            if (size < 1ull << SlBits) return size;
+
+            const uint32_t msb{ static_cast<uint32_t>(std::bit_width(size)) - 1 };
+            const uint64_t round{ (1ull << (msb - SlBits)) - 1 };
+            return size + round < size ? size : size + round;
+        }
+
+        uint64_t align_up(const uint64_t value, const uint64_t alignment) noexcept
+        {
+            return (value + alignment - 1) & ~(alignment - 1);
+        }
+    } // anonymous namespace
+
+    // PUBLIC
+    void tlsf_t::init(const uint64_t capacity)
+    {
+        _capacity = capacity;
+        _used = 0;
+        _allocation_count = 0;
+        _free_region_count = 0;
+        _fl_bitmap = 0;
+        _sl_bitmaps.fill(0);
+        for (auto& lists: _heads) lists.fill(k_invalid_node);
+        _nodes.clear();
+        _unused_nodes.clear();
+
+        if (capacity == 0) return;
+
+        const uint32_t node{ new_node() };
+        _nodes[node].size = capacity;
+        insert_free(node);
+    }
+
+    tlsf_t::allocation_t tlsf_t::allocate(const uint64_t size, const uint64_t alignment)
+    {
+        if (size == 0 || size > _capacity) return { };
+
+        // A good fit usually satisfies the alignment already; only when it does not, pay for the worst-case padding
+        uint32_t node{ find_free(size) };
+        if (node != k_invalid_node && align_up(_nodes[node].offset, alignment) + size > _nodes[node].offset + _nodes[node].size)
+            node = k_invalid_node;
+        if (node == k_invalid_node && alignment > 1) node = find_free(size + alignment - 1);
+        if (node == k_invalid_node) return { };
+
+        remove_free(node);
+
+        const uint64_t padding{ align_up(_nodes[node].offset, alignment) - _nodes[node].offset };
+        if (padding != 0)
+        {
+            // The front padding stays free, the allocation continues in the split-off remainder
+            const uint32_t rest{ split(node, padding) };
+            insert_free(node);
+            node = rest;
+        }
+
+        if (_nodes[node].size > size)
+        {
+            const uint32_t tail{ split(node, size) };
+            insert_free(tail);
+        }
+
+        _used += size;
+        ++_allocation_count;
+        return { _nodes[node].offset, node };
+    }
+
+    void tlsf_t::free(uint32_t node) noexcept
+    {
+        if (node >= _nodes.size() || _nodes[node].is_free || _nodes[node].size == 0) return;
+
+        _used -= _nodes[node].size;
+        --_allocation_count;
+
+        // Free blocks never touch each other, so at most one merge in each direction
+        if (const uint32_t prev{ _nodes[node].prev_physical }; prev != k_invalid_node && _nodes[prev].is_free)
+        {
+            remove_free(prev);
+            _nodes[prev].size += _nodes[node].size;
+            _nodes[prev].next_physical = _nodes[node].next_physical;
+            if (_nodes[node].next_physical != k_invalid_node) _nodes[_nodes[node].next_physical].prev_physical = prev;
+            release_node(node);
+            node = prev;
+        }
+
+        if (const uint32_t next{ _nodes[node].next_physical }; next != k_invalid_node && _nodes[next].is_free)
+        {
+            remove_free(next);
+            _nodes[node].size += _nodes[next].size;
+            _nodes[node].next_physical = _nodes[next].next_physical;
+            if (_nodes[next].next_physical != k_invalid_node) _nodes[_nodes[next].next_physical].prev_physical = node;
+            release_node(next);
+        }
+
+        insert_free(node);
+    }
+
+    uint64_t tlsf_t::largest_free_region() const noexcept
+    {
+        if (_fl_bitmap == 0) return 0;
+
+        // Only the highest non-empty list can hold the largest block
+        const uint32_t fl{ static_cast<uint32_t>(std::bit_width(_fl_bitmap)) - 1 };
+        const uint32_t sl{ static_cast<uint32_t>(std::bit_width(_sl_bitmaps[fl])) - 1 };
+
+        uint64_t largest{ 0 };
+        for (uint32_t node{ _heads[fl][sl] }; node != k_invalid_node; node = _nodes[node].next_free)
+            largest = std::max(largest, _nodes[node].size);
+        return largest;
+    }
+
+    // PRIVATE
+    uint32_t tlsf_t::find_free(const uint64_t size) const noexcept
+    {
+        // Every block in the rounded-up list or above is large enough, no need to walk a list
+        const mapping_t mapping{ map_size<k_sl_bits>(round_to_list<k_sl_bits>(size)) };
+        if (mapping.fl < k_fl_count)
+        {
+            uint32_t fl{ mapping.fl };
+            uint32_t sl_map{ _sl_bitmaps[fl] & (~0u << mapping.sl) };
+            if (sl_map == 0)
+            {
+                const uint64_t fl_map{ fl + 1 < 64 ? _fl_bitmap & (~0ull << (fl + 1)) : 0 };
+                fl = static_cast<uint32_t>(std::countr_zero(fl_map));
+                sl_map = fl_map != 0 ? _sl_bitmaps[fl] : 0;
+            }
+
+            if (sl_map != 0) return _heads[fl][static_cast<uint32_t>(std::countr_zero(sl_map))];
+        }
+
+        // Rounding up skips blocks in the request's own list that would still fit, which matters for requests
+        // close to the largest free block (e.g. a whole empty range)
+        const mapping_t exact{ map_size<k_sl_bits>(size) };
+        for (uint32_t node{ _heads[exact.fl][exact.sl] }; node != k_invalid_node; node = _nodes[node].next_free)
+            if (_nodes[node].size >= size) return node;
+
+        return k_invalid_node;
+    }
+
+    void tlsf_t::insert_free(const uint32_t node) noexcept
+    {
+        const auto [fl, sl]{ map_size<k_sl_bits>(_nodes[node].size) };
+        const uint32_t head{ _heads[fl][sl] };
+
+        _nodes[node].is_free = true;
+        _nodes[node].prev_free = k_invalid_node;
+        _nodes[node].next_free = head;
+        if (head != k_invalid_node) _nodes[head].prev_free = node;
+
+        _heads[fl][sl] = node;
+        _sl_bitmaps[fl] |= 1u << sl;
+        _fl_bitmap |= 1ull << fl;
+        ++_free_region_count;
+    }
+
+    void tlsf_t::remove_free(const uint32_t node) noexcept
+    {
+        const auto [fl, sl]{ map_size<k_sl_bits>(_nodes[node].size) };
+        node_t& entry{ _nodes[node] };
+
+        if (entry.prev_free != k_invalid_node) _nodes[entry.prev_free].next_free = entry.next_free;
+        if (entry.next_free != k_invalid_node) _nodes[entry.next_free].prev_free = entry.prev_free;
+
+        if (_heads[fl][sl] == node)
+        {
+            _heads[fl][sl] = entry.next_free;
+            if (entry.next_free == k_invalid_node)
+            {
+                _sl_bitmaps[fl] &= ~(1u << sl);
+                if (_sl_bitmaps[fl] == 0) _fl_bitmap &= ~(1ull << fl);
+            }
+        }
+
+        entry.is_free = false;
+        entry.prev_free = k_invalid_node;
+        entry.next_free = k_invalid_node;
+        --_free_region_count;
+    }
+
+    uint32_t tlsf_t::split(const uint32_t node, const uint64_t size)
+    {
+        const uint32_t rest{ new_node() }; // may reallocate _nodes, index only after this
+
+        node_t& first{ _nodes[node] };
+        node_t& second{ _nodes[rest] };
+        second.offset = first.offset + size;
+        second.size = first.size - size;
+        second.prev_physical = node;
+        second.next_physical = first.next_physical;
+        if (first.next_physical != k_invalid_node) _nodes[first.next_physical].prev_physical = rest;
+
+        first.size = size;
+        first.next_physical = rest;
+        return rest;
+    }
+
+    uint32_t tlsf_t::new_node()
+    {
+        if (!_unused_nodes.empty())
+        {
+            const uint32_t node{ _unused_nodes.back() };
+            _unused_nodes.pop_back();
+            _nodes[node] = { };
+            return node;
+        }
+
+        _nodes.emplace_back();
+        return static_cast<uint32_t>(_nodes.size() - 1);
+    }
+
+    void tlsf_t::release_node(const uint32_t node) noexcept
+    {
+        _nodes[node].is_free = false;
+        _nodes[node].size = 0;
+        _unused_nodes.push_back(node);
+    }
+} // namespace carrot::utils
@@ -0,0 +1,77 @@
+//
+// Created by zshrout on 10/18/26.
+// Copyright (c) 2026 BunnySofty. All rights reserved.
+//
+
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <vector>
+
+namespace carrot::utils {
+    // Two-level segregated fit allocator over an abstract [0, capacity) range. It only does the bookkeeping and
+    // never touches the memory itself, so it can manage GPU memory blocks or anything else addressed by offset.
+    // Allocation and free are O(1); free neighbours are merged immediately.
+    struct tlsf_t
+    {
+    public:
+        static constexpr uint32_t k_invalid_node{ ~0u };
+
+        struct allocation_t
+        {
+            uint64_t    offset{ 0 };
+            uint32_t    node{ k_invalid_node }; // k_invalid_node when the request did not fit
+
+            [[nodiscard]] bool is_valid() const noexcept { return node != k_invalid_node; }
+        };
+
+        void init(uint64_t capacity);
+
+        // `alignment` must be a power of two
+        [[nodiscard]] allocation_t allocate(uint64_t size, uint64_t alignment = 1);
+        void free(uint32_t node) noexcept;
+
+        [[nodiscard]] uint64_t capacity() const noexcept { return _capacity; }
+        [[nodiscard]] uint64_t used() const noexcept { return _used; }
+        [[nodiscard]] uint32_t allocation_count() const noexcept { return _allocation_count; }
+        [[nodiscard]] uint32_t free_region_count() const noexcept { return _free_region_count; }
+        [[nodiscard]] uint64_t largest_free_region() const noexcept;
+        [[nodiscard]] bool empty() const noexcept { return _allocation_count == 0; }
+
+    private:
+        static constexpr uint32_t k_sl_bits{ 5 };
+        static constexpr uint32_t k_sl_count{ 1u << k_sl_bits };
+        static constexpr uint32_t k_fl_count{ 64 - k_sl_bits + 1 };
+
+        struct node_t
+        {
+            uint64_t    offset{ 0 };
+            uint64_t    size{ 0 };
+            uint32_t    prev_physical{ k_invalid_node };
+            uint32_t    next_physical{ k_invalid_node };
+            uint32_t    prev_free{ k_invalid_node };
+            uint32_t    next_free{ k_invalid_node };
+            bool        is_free{ false };
+        };
+
+        [[nodiscard]] uint32_t find_free(uint64_t size) const noexcept;
+        void insert_free(uint32_t node) noexcept;
+        void remove_free(uint32_t node) noexcept;
+        [[nodiscard]] uint32_t split(uint32_t node, uint64_t size);
+        [[nodiscard]] uint32_t new_node();
+        void release_node(uint32_t node) noexcept;
+
+        uint64_t                                                    _capacity{ 0 };
+        uint64_t                                                    _used{ 0 };
+        uint32_t                                                    _allocation_count{ 0 };
+        uint32_t                                                    _free_region_count{ 0 };
+
+        uint64_t                                                    _fl_bitmap{ 0 };
+        std::array<uint32_t, k_fl_count>                            _sl_bitmaps{ };
+        std::array<std::array<uint32_t, k_sl_count>, k_fl_count>    _heads{ };
+
+        std::vector<node_t>                                         _nodes;
+        std::vector<uint32_t>                                       _unused_nodes;
+    };
+} // namespace carrot::utils
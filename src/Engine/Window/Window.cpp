@@ -35,4 +35,19 @@ namespace carrot::window {
     {
         return g_primary_window ? g_primary_window->should_close() : true;
     }
+
+    [[nodiscard]] bool was_key_pressed(const key k) noexcept
+    {
+        return g_primary_window && g_primary_window->was_key_pressed(static_cast<uint32_t>(k));
+    }
+
+    [[nodiscard]] uint32_t width() noexcept
+    {
+        return g_primary_window ? g_primary_window->width() : 0;
+    }
+
+    [[nodiscard]] uint32_t height() noexcept
+    {
+        return g_primary_window ? g_primary_window->height() : 0;
+    }
 } // namespace carrot::window
@@ -8,10 +8,25 @@
 #include "Core/Platform/Wayland/WaylandWindow.h"
 
 namespace carrot::window {
+    // Linux evdev codes of the keys the engine binds
+    enum class key : uint32_t
+    {
+        p       = 25,
+        f3      = 61,
+        f4      = 62,
+        left    = 105,
+        right   = 106,
+    };
+
     void create_primary_window(uint32_t width, uint32_t height, const char* title) noexcept;
     void destroy_primary_window() noexcept;
     void poll_events() noexcept;
 
     [[nodiscard]] platform::wayland_window_t& get_primary_window() noexcept;
     [[nodiscard]] bool should_close() noexcept;
+    // False without a window
+    [[nodiscard]] bool was_key_pressed(key k) noexcept;
+    // Current surface size in pixels, as last configured by the compositor; 0 without a window
+    [[nodiscard]] uint32_t width() noexcept;
+    [[nodiscard]] uint32_t height() noexcept;
 } // namespace carrot::window
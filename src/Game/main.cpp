@@ -7,8 +7,10 @@
 
 #include <CarrotEngine.h>
 
-int main()
+int main(const int argc, const char* argv[])
 {
+    carrot::engine_t::configure(carrot::core::parse_command_line(argc, argv));
+
     sandbox::sandbox_t* game{ new sandbox::sandbox_t() };
     carrot::engine_t::get().run(game);
 
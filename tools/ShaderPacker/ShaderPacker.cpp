@@ -0,0 +1,199 @@
+//
+// Created by zshrout on 10/18/26.
+// Copyright (c) 2026 BunnySofty. All rights reserved.
+//
+
+// CarrotShaderPacker <output.pak> <module.spv>...
+//
+// Packs compiled SPIR-V modules and their reflection into a single archive, see Utils/ShaderArchiveFormat.h.
+// Modules are keyed by file name. The archive is written next to the output and renamed into place, so the
+// engine only ever sees a complete shader set.
+
+#include "Renderer/ShaderReflection.h"
+#include "Utils/ShaderArchiveFormat.h"
+
+#include <algorithm>
+#include <bit>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <print>
+#include <string>
+#include <vector>
+
+namespace {
+    namespace fs = std::filesystem;
+    using namespace carrot;
+
+    constexpr uint32_t k_spirv_magic{ 0x07230203 };
+
+    struct module_t
+    {
+        std::string             name;
+        std::vector<uint32_t>   spv;
+        std::vector<uint32_t>   reflection;
+    };
+
+    uint64_t align_up(const uint64_t value, const uint64_t alignment) noexcept
+    {
+        return (value + alignment - 1) & ~(alignment - 1);
+    }
+
+    bool read_module(const fs::path& path, module_t& module)
+    {
+        std::ifstream file{ path, std::ios::binary | std::ios::ate };
+        if (!file.is_open())
+        {
+            std::println(stderr, "error: cannot open {}", path.string());
+            return false;
+        }
+
+        const auto size{ static_cast<size_t>(file.tellg()) };
+        if (size < 5 * sizeof(uint32_t) || size % sizeof(uint32_t) != 0)
+        {
+            std::println(stderr, "error: {} is not a SPIR-V module ({} bytes)", path.string(), size);
+            return false;
+        }
+
+        module.name = path.filename().string();
+        module.spv.resize(size / sizeof(uint32_t));
+        file.seekg(0);
+        file.read(reinterpret_cast<char*>(module.spv.data()), static_cast<std::streamsize>(size));
+
+        if (!file || module.spv[0] != k_spirv_magic)
+        {
+            std::println(stderr, "error: {} is not a SPIR-V module", path.string());
+            return false;
+        }
+
+        // Not fatal, the engine falls back to reflecting at load time
+        renderer::shader_reflection_t reflection;
+        if (renderer::reflect_spirv(module.spv, reflection))
+            renderer::serialize_reflection(reflection, module.reflection);
+        else
+            std::println(stderr, "warning: could not reflect {}, storing it without reflection", path.string());
+
+        return true;
+    }
+
+    template<typename T>
+    void write_at(std::vector<std::byte>& out, const uint64_t offset, const T* data, const size_t count)
+    {
+        std::memcpy(out.data() + offset, data, count * sizeof(T));
+    }
+
+    std::vector<std::byte> build_archive(const std::vector<module_t>& modules)
+    {
+        const auto entry_count{ static_cast<uint32_t>(modules.size()) };
+        const uint32_t slot_count{ std::bit_ceil(std::max(entry_count * 2, 2u)) };
+
+        utils::shader_archive_header_t header{ };
+        header.entry_count = entry_count;
+        header.slot_count = slot_count;
+        header.entries_offset = sizeof(utils::shader_archive_header_t);
+        header.slots_offset = header.entries_offset + entry_count * sizeof(utils::shader_archive_entry_t);
+
+        std::vector<utils::shader_archive_entry_t> entries(entry_count);
+        std::vector<uint32_t> slots(slot_count, 0);
+
+        uint64_t offset{ header.slots_offset + slot_count * sizeof(uint32_t) };
+        for (uint32_t i{ 0 }; i < entry_count; ++i)
+        {
+            entries[i].name_hash = utils::fnv1a_64(modules[i].name);
+            entries[i].name_offset = offset;
+            entries[i].name_size = static_cast<uint32_t>(modules[i].name.size());
+            offset += modules[i].name.size();
+        }
+
+        header.content_hash = utils::fnv1a_64({ });
+        for (uint32_t i{ 0 }; i < entry_count; ++i)
+        {
+            const module_t& module{ modules[i] };
+            utils::shader_archive_entry_t& entry{ entries[i] };
+
+            offset = align_up(offset, utils::k_shader_archive_alignment);
+            entry.spv_offset = offset;
+            entry.spv_size = static_cast<uint32_t>(module.spv.size() * sizeof(uint32_t));
+            offset += entry.spv_size;
+
+            offset = align_up(offset, utils::k_shader_archive_alignment);
+            entry.reflection_offset = offset;
+            entry.reflection_size = static_cast<uint32_t>(module.reflection.size() * sizeof(uint32_t));
+            offset += entry.reflection_size;
+
+            const std::string_view spv_bytes{ reinterpret_cast<const char*>(module.spv.data()), entry.spv_size };
+            header.content_hash = utils::fnv1a_64(spv_bytes, utils::fnv1a_64(module.name, header.content_hash));
+
+            uint32_t slot{ static_cast<uint32_t>(entry.name_hash) & (slot_count - 1) };
+            while (slots[slot] != 0) slot = (slot + 1) & (slot_count - 1);
+            slots[slot] = i + 1;
+        }
+        header.file_size = offset;
+
+        std::vector<std::byte> out(offset);
+        write_at(out, 0, &header, 1);
+        write_at(out, header.entries_offset, entries.data(), entries.size());
+        write_at(out, header.slots_offset, slots.data(), slots.size());
+        for (uint32_t i{ 0 }; i < entry_count; ++i)
+        {
+            write_at(out, entries[i].name_offset, modules[i].name.data(), modules[i].name.size());
+            write_at(out, entries[i].spv_offset, modules[i].spv.data(), modules[i].spv.size());
+            write_at(out, entries[i].reflection_offset, modules[i].reflection.data(), modules[i].reflection.size());
+        }
+
+        return out;
+    }
+} // anonymous namespace
+
+int main(const int argc, char** argv)
+{
+    if (argc < 3)
+    {
+        std::println(stderr, "usage: {} <output.pak> <module.spv>...", argv[0]);
+        return 1;
+    }
+
+    std::vector<module_t> modules;
+    for (int i{ 2 }; i < argc; ++i)
+    {
+        module_t module;
+        if (!read_module(argv[i], module)) return 1;
+        modules.push_back(std::move(module));
+    }
+
+    // Sorted so identical inputs always produce a byte-identical archive
+    std::ranges::sort(modules, { }, &module_t::name);
+    const auto duplicate{ std::ranges::adjacent_find(modules, { }, &module_t::name) };
+    if (duplicate != modules.end())
+    {
+        std::println(stderr, "error: two modules are named {}", duplicate->name);
+        return 1;
+    }
+
+    const std::vector<std::byte> archive{ build_archive(modules) };
+
+    const fs::path output{ argv[1] };
+    fs::path staging{ output };
+    staging += ".tmp";
+
+    {
+        std::ofstream file{ staging, std::ios::binary | std::ios::trunc };
+        file.write(reinterpret_cast<const char*>(archive.data()), static_cast<std::streamsize>(archive.size()));
+        if (!file)
+        {
+            std::println(stderr, "error: failed to write {}", staging.string());
+            return 1;
+        }
+    }
+
+    std::error_code ec;
+    fs::rename(staging, output, ec);
+    if (ec)
+    {
+        std::println(stderr, "error: failed to move archive into place: {}", ec.message());
+        return 1;
+    }
+
+    std::println("Packed {} shader module(s) into {} ({} bytes)", modules.size(), output.string(), archive.size());
+    return 0;
+}